@@ -0,0 +1,112 @@
+#include "BenchHarness.hpp"
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory::bench {
+namespace {
+
+/**
+ * @brief Resize the last allocation back and forth, which stays in place
+ *
+ * @param state Benchmark state, range(0) is the size grown to
+ */
+void BM_LinearResizeInPlace(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    BenchBuffer buffer;
+    LinearAllocator arena = LinearAllocator::create(buffer.data, buffer.length);
+    LatencySampler sampler;
+
+    void* block = arena.alloc_uninit(size / 2).value();
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            // Alternate between growing and shrinking the same block
+            size_t from = (i % 2 == 0) ? size / 2 : size;
+            size_t to = (i % 2 == 0) ? size : size / 2;
+            block = arena.resize_align_uninit(block, from, to, LinearAllocator::DEFAULT_ALIGNMENT).value();
+            benchmark::DoNotOptimize(block);
+        }
+        sampler.add(start, LatencySampler::Clock::now(), BATCH_SIZE);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+    sampler.report(state);
+}
+BENCHMARK(BM_LinearResizeInPlace)->RangeMultiplier(8)->Range(64, 64 * 1024);
+
+/**
+ * @brief Resize an allocation that is no longer the last one, which has to copy
+ *
+ * @param state Benchmark state, range(0) is the size grown to
+ */
+void BM_LinearResizeCopy(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    BenchBuffer buffer;
+    LinearAllocator arena = LinearAllocator::create(buffer.data, buffer.length);
+    LatencySampler sampler;
+
+    for (auto _ : state) {
+        // Each resize copies the block behind a fresh one, so reset regularly
+        state.PauseTiming();
+        arena.free_all();
+        void* blocks[BATCH_SIZE];
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            blocks[i] = arena.alloc_uninit(size / 2).value();
+        }
+        state.ResumeTiming();
+
+        auto start = LatencySampler::Clock::now();
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            void* moved = arena.resize_align_uninit(blocks[i], size / 2, size,
+                                                    LinearAllocator::DEFAULT_ALIGNMENT).value();
+            benchmark::DoNotOptimize(moved);
+        }
+        sampler.add(start, LatencySampler::Clock::now(), BATCH_SIZE);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE * (size / 2)));
+    sampler.report(state);
+}
+BENCHMARK(BM_LinearResizeCopy)->RangeMultiplier(8)->Range(64, 64 * 1024);
+
+/**
+ * @brief Open a scratch scope, allocate in it and close it again
+ *
+ * @param state Benchmark state, range(0) is the number of allocations per scope
+ */
+void BM_TempArenaMemory(benchmark::State& state) {
+    const size_t allocations = static_cast<size_t>(state.range(0));
+    BenchBuffer buffer;
+    LinearAllocator arena = LinearAllocator::create(buffer.data, buffer.length);
+    LatencySampler sampler;
+
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        TempArenaMemory scratch = TempArenaMemory::begin(&arena);
+        for (size_t i = 0; i < allocations; ++i) {
+            benchmark::DoNotOptimize(scratch.alloc(64));
+        }
+        scratch.end();
+        sampler.add(start, LatencySampler::Clock::now(), 1);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    sampler.report(state);
+}
+BENCHMARK(BM_TempArenaMemory)->Arg(0)->Arg(1)->Arg(16)->Arg(256);
+
+[[maybe_unused]] const bool registered = [] {
+    register_allocator_suite<LinearAllocator>();
+    register_allocator_suite<ConcurrentLinearAllocator>();
+    register_allocator_suite<StackAllocator>();
+    register_allocator_suite<PoolAllocator>();
+    register_allocator_suite<ThreadCachedPool>();
+    register_allocator_suite<FreeListAllocator>();
+    register_allocator_suite<BuddyAllocator>();
+    register_allocator_suite<HeapAllocator>();
+    return true;
+}();
+
+} // namespace
+} // namespace memory::bench
@@ -0,0 +1,261 @@
+#pragma once
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "memory/Allocator.hpp"
+#include "memory/BuddyAllocator.hpp"
+#include "memory/ConcurrentLinearAllocator.hpp"
+#include "memory/FreeListAllocator.hpp"
+#include "memory/HeapAllocator.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/PoolAllocator.hpp"
+#include "memory/StackAllocator.hpp"
+#include "memory/ThreadCachedPool.hpp"
+
+namespace memory::bench {
+
+/**
+ * @brief Size of the backing buffer every allocator under test gets
+ */
+inline constexpr size_t ARENA_SIZE = 64 * 1024 * 1024;
+
+/**
+ * @brief Number of allocations timed together as one sample
+ *
+ * A single allocation is too short to time with steady_clock, so latencies are
+ * sampled per batch and reported per operation.
+ */
+inline constexpr size_t BATCH_SIZE = 64;
+
+/**
+ * @brief Backing buffer aligned for every alignment the benchmarks ask for
+ */
+struct BenchBuffer {
+    static constexpr std::align_val_t ALIGNMENT{4096};
+
+    unsigned char* data; ///< Start of the buffer
+    size_t length;       ///< Length of the buffer in bytes
+
+    /**
+     * @brief Allocate a buffer
+     *
+     * @param length Length of the buffer in bytes
+     */
+    explicit BenchBuffer(size_t length = ARENA_SIZE)
+        : data(static_cast<unsigned char*>(::operator new(length, ALIGNMENT))), length(length) {}
+
+    /**
+     * @brief Free the buffer
+     */
+    ~BenchBuffer() { ::operator delete(data, ALIGNMENT); }
+
+    BenchBuffer(const BenchBuffer&) = delete;
+    BenchBuffer& operator=(const BenchBuffer&) = delete;
+};
+
+/**
+ * @brief Collect per-operation latencies and report them as percentiles
+ *
+ * Samples are batch means (batch duration divided by the operations in it), so
+ * the percentiles describe batches of BATCH_SIZE operations, not single calls.
+ */
+struct LatencySampler {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector<double> samples; ///< Nanoseconds per operation, one entry per batch
+
+    /**
+     * @brief Record one batch
+     *
+     * @param start Time the batch started
+     * @param stop Time the batch ended
+     * @param operations Number of operations in the batch
+     */
+    void add(Clock::time_point start, Clock::time_point stop, size_t operations) {
+        double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+        samples.push_back(ns / static_cast<double>(operations));
+    }
+
+    /**
+     * @brief Add p50, p99 and p99.9 latency counters (in ns per operation) to a run
+     *
+     * @param state Benchmark state to report to
+     */
+    void report(benchmark::State& state) {
+        if (samples.empty()) {
+            return;
+        }
+        std::sort(samples.begin(), samples.end());
+        auto percentile = [&](double p) {
+            size_t index = static_cast<size_t>(p * static_cast<double>(samples.size() - 1));
+            return samples[index];
+        };
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p999_ns"] = percentile(0.999);
+    }
+};
+
+/**
+ * @brief How the harness creates and resets an allocator under test
+ *
+ * Specialize this to plug a new allocator into the harness:
+ *
+ * - NAME: Name used in the benchmark names
+ * - create(buffer, size, align): Build the allocator over a BenchBuffer for
+ *   allocations of size bytes with the given alignment
+ * - RESET_WITH_FREE_ALL: Release a batch with free_all instead of freeing every
+ *   allocation in reverse order
+ *
+ * @tparam A Allocator type
+ */
+template <typename A>
+struct BenchBackend;
+
+template <>
+struct BenchBackend<LinearAllocator> {
+    static constexpr const char* NAME = "LinearAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = true;
+    static LinearAllocator create(BenchBuffer& buffer, size_t, size_t) {
+        return LinearAllocator::create(buffer.data, buffer.length);
+    }
+};
+
+template <>
+struct BenchBackend<ConcurrentLinearAllocator> {
+    static constexpr const char* NAME = "ConcurrentLinearAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = true;
+    static ConcurrentLinearAllocator create(BenchBuffer& buffer, size_t, size_t) {
+        return ConcurrentLinearAllocator::create(buffer.data, buffer.length);
+    }
+};
+
+template <>
+struct BenchBackend<StackAllocator> {
+    static constexpr const char* NAME = "StackAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static StackAllocator create(BenchBuffer& buffer, size_t, size_t) {
+        return StackAllocator::create(buffer.data, buffer.length);
+    }
+};
+
+template <>
+struct BenchBackend<PoolAllocator> {
+    static constexpr const char* NAME = "PoolAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static PoolAllocator create(BenchBuffer& buffer, size_t size, size_t align) {
+        return PoolAllocator::create(buffer.data, buffer.length, size, align).value();
+    }
+};
+
+template <>
+struct BenchBackend<ThreadCachedPool> {
+    static constexpr const char* NAME = "ThreadCachedPool";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static ThreadCachedPool create(BenchBuffer& buffer, size_t size, size_t align) {
+        return ThreadCachedPool::create(buffer.data, buffer.length, size, align).value();
+    }
+};
+
+template <>
+struct BenchBackend<FreeListAllocator> {
+    static constexpr const char* NAME = "FreeListAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static FreeListAllocator create(BenchBuffer& buffer, size_t, size_t) {
+        return FreeListAllocator::create(buffer.data, buffer.length).value();
+    }
+};
+
+template <>
+struct BenchBackend<BuddyAllocator> {
+    static constexpr const char* NAME = "BuddyAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static BuddyAllocator create(BenchBuffer& buffer, size_t, size_t) {
+        return BuddyAllocator::create(buffer.data, buffer.length).value();
+    }
+};
+
+template <>
+struct BenchBackend<HeapAllocator> {
+    static constexpr const char* NAME = "HeapAllocator";
+    static constexpr bool RESET_WITH_FREE_ALL = false;
+    static HeapAllocator create(BenchBuffer&, size_t, size_t) {
+        return HeapAllocator{};
+    }
+};
+
+/**
+ * @brief Allocate BATCH_SIZE blocks and release them again, per iteration
+ *
+ * Arguments are the allocation size and alignment. Reports allocations/sec,
+ * bytes/sec and per-allocation latency percentiles of the allocation half.
+ *
+ * @tparam A Allocator type with a BenchBackend specialization
+ * @param state Benchmark state
+ */
+template <typename A>
+void BM_AllocAlign(benchmark::State& state) {
+    const size_t size = static_cast<size_t>(state.range(0));
+    const size_t align = static_cast<size_t>(state.range(1));
+
+    BenchBuffer buffer;
+    A allocator = BenchBackend<A>::create(buffer, size, align);
+    void* blocks[BATCH_SIZE];
+    LatencySampler sampler;
+
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        for (size_t i = 0; i < BATCH_SIZE; ++i) {
+            auto result = detail::allocate_from(allocator, size, align);
+            blocks[i] = result ? result.value() : nullptr;
+            benchmark::DoNotOptimize(blocks[i]);
+        }
+        auto stop = LatencySampler::Clock::now();
+        sampler.add(start, stop, BATCH_SIZE);
+
+        if constexpr (BenchBackend<A>::RESET_WITH_FREE_ALL) {
+            allocator.free_all();
+        } else {
+            // Reverse order keeps LIFO allocators happy
+            for (size_t i = BATCH_SIZE; i > 0; --i) {
+                if (blocks[i - 1] != nullptr) {
+                    detail::deallocate_to(allocator, blocks[i - 1], size, align);
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * BATCH_SIZE * size));
+    sampler.report(state);
+}
+
+/**
+ * @brief Register the allocation benchmarks for an allocator
+ *
+ * Covers sizes from 16 bytes to 4 KiB at 8, 16 and 64 byte alignment.
+ *
+ * @tparam A Allocator type with a BenchBackend specialization
+ */
+template <typename A>
+void register_allocator_suite() {
+    std::string name = std::string("alloc_align/") + BenchBackend<A>::NAME;
+    auto* bench = benchmark::RegisterBenchmark(name.c_str(), BM_AllocAlign<A>);
+    for (int64_t size : {16, 64, 256, 4096}) {
+        for (int64_t align : {8, 16, 64}) {
+            bench->Args({size, align});
+        }
+    }
+    bench->ArgNames({"size", "align"});
+}
+
+} // namespace memory::bench
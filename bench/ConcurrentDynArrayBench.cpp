@@ -0,0 +1,89 @@
+#include "BenchHarness.hpp"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "memory/ConcurrentDynArray.hpp"
+#include "memory/DynArray.hpp"
+
+namespace memory::bench {
+namespace {
+
+/**
+ * @brief Appends per timed batch, so the clock is read rarely compared to the pushes
+ */
+constexpr size_t BATCH = 1024;
+
+/**
+ * @brief DynArray shared between threads behind a mutex, the usual workaround
+ */
+struct LockedCollector {
+    static constexpr const char* NAME = "DynArray+mutex";
+    std::mutex lock;
+    DynArray<uint64_t> items;
+    void push_back(uint64_t value) {
+        std::lock_guard<std::mutex> guard(lock);
+        items.push_back(value);
+    }
+};
+
+/**
+ * @brief Lock-free segmented counterpart of LockedCollector
+ */
+struct ConcurrentCollector {
+    static constexpr const char* NAME = "ConcurrentDynArray";
+    ConcurrentDynArray<uint64_t> items;
+    void push_back(uint64_t value) { items.push_back(value); }
+};
+
+/**
+ * @brief Every benchmark thread appends to one shared collector
+ *
+ * @param state Benchmark state, threads set by ->Threads()
+ */
+template <typename Collector>
+void BM_SharedPushBack(benchmark::State& state) {
+    // Thread 0 sets up before and tears down after the loop; the loop itself starts
+    // and ends on a barrier across all threads
+    static Collector* collector = nullptr;
+    if (state.thread_index() == 0) {
+        collector = new Collector;
+    }
+
+    LatencySampler sampler;
+    uint64_t next = static_cast<uint64_t>(state.thread_index()) << 40;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        for (size_t i = 0; i < BATCH; ++i) {
+            collector->push_back(next++);
+        }
+        sampler.add(start, LatencySampler::Clock::now(), BATCH);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * BATCH));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * BATCH * sizeof(uint64_t)));
+
+    // Counters add up over threads, so percentiles come from one of them
+    if (state.thread_index() == 0) {
+        sampler.report(state);
+        delete collector;
+        collector = nullptr;
+    }
+}
+
+template <typename Collector>
+void register_shared_push_back() {
+    benchmark::RegisterBenchmark((std::string("concurrent_push_back/") + Collector::NAME).c_str(),
+                                 BM_SharedPushBack<Collector>)
+        ->ThreadRange(1, 8)
+        ->UseRealTime();
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_shared_push_back<LockedCollector>();
+    register_shared_push_back<ConcurrentCollector>();
+    return true;
+}();
+
+} // namespace
+} // namespace memory::bench
@@ -0,0 +1,302 @@
+#include "BenchHarness.hpp"
+
+#include <string>
+#include <vector>
+
+#include "memory/DynArray.hpp"
+#include "memory/FixedDynArray.hpp"
+#include "memory/InlineArena.hpp"
+#include "memory/SoaArray.hpp"
+
+namespace memory::bench {
+namespace {
+
+/**
+ * @brief Element value for index i, cheap for int and heap-allocating for std::string
+ */
+template <typename T>
+T make_value(size_t i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::string(32, static_cast<char>('a' + i % 26));
+    } else {
+        return static_cast<T>(i);
+    }
+}
+
+/**
+ * @brief Uniform wrapper so one benchmark body drives both containers
+ */
+template <typename T>
+struct VectorOps {
+    static constexpr const char* NAME = "std::vector";
+    std::vector<T> items;
+    void push_back(T value) { items.push_back(std::move(value)); }
+    void insert_front(T value) { items.insert(items.begin(), std::move(value)); }
+    void erase_front() { items.erase(items.begin()); }
+    void reserve(size_t n) { items.reserve(n); }
+    size_t size() const { return items.size(); }
+};
+
+/**
+ * @brief DynArray counterpart of VectorOps
+ */
+template <typename T>
+struct DynArrayOps {
+    static constexpr const char* NAME = "DynArray";
+    DynArray<T> items;
+    void push_back(T value) { items.push_back(std::move(value)); }
+    void insert_front(T value) { items.insert(0, std::move(value)); }
+    void erase_front() { items.erase(0); }
+    void reserve(size_t n) { items.reserve(n); }
+    size_t size() const { return items.get_size(); }
+};
+
+/**
+ * @brief Push n elements into an empty container, letting it grow
+ *
+ * @param state Benchmark state, range(0) is the element count
+ */
+template <typename Ops, typename T>
+void BM_PushBack(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        Ops ops;
+        for (size_t i = 0; i < count; ++i) {
+            ops.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(ops.size());
+        sampler.add(start, LatencySampler::Clock::now(), count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(T)));
+    sampler.report(state);
+}
+
+/**
+ * @brief Push n elements after reserving room for all of them
+ *
+ * @param state Benchmark state, range(0) is the element count
+ */
+template <typename Ops, typename T>
+void BM_ReservePushBack(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        Ops ops;
+        ops.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            ops.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(ops.size());
+        sampler.add(start, LatencySampler::Clock::now(), count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(T)));
+    sampler.report(state);
+}
+
+/**
+ * @brief Insert at the front of a container of n elements, then erase it again
+ *
+ * @param state Benchmark state, range(0) is the element count
+ */
+template <typename Ops, typename T>
+void BM_InsertEraseFront(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    Ops ops;
+    for (size_t i = 0; i < count; ++i) {
+        ops.push_back(make_value<T>(i));
+    }
+    T value = make_value<T>(count);
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        ops.insert_front(value);
+        ops.erase_front();
+        sampler.add(start, LatencySampler::Clock::now(), 2);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * 2));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 2 * count * sizeof(T)));
+    sampler.report(state);
+}
+
+/**
+ * @brief Particle record as the array-of-structs layout stores it, 32 bytes
+ */
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    uint32_t id;
+};
+
+/**
+ * @brief Sum one field of n records stored as DynArray<Particle>
+ *
+ * @param state Benchmark state, range(0) is the element count
+ */
+void BM_ScanFieldAos(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    DynArray<Particle> particles;
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        particles.push_back({f, f, f, 0.0f, 0.0f, 0.0f, 1.0f, static_cast<uint32_t>(i)});
+    }
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (const Particle& p : particles) {
+            sum += p.mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+/**
+ * @brief Sum one column of n records stored as SoaArray, the layout counterpart of BM_ScanFieldAos
+ *
+ * @param state Benchmark state, range(0) is the element count
+ */
+void BM_ScanFieldSoa(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    SoaArray<float, float, float, float, float, float, float, uint32_t> particles;
+    for (size_t i = 0; i < count; ++i) {
+        float f = static_cast<float>(i);
+        particles.emplace_back(f, f, f, 0.0f, 0.0f, 0.0f, 1.0f, static_cast<uint32_t>(i));
+    }
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (float mass : particles.column<6>()) {
+            sum += mass;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+}
+
+/**
+ * @brief Elements per short-lived batch, small enough for stack storage
+ */
+constexpr size_t SMALL_BATCH = 32;
+
+/**
+ * @brief Batch container on the heap, the baseline for the fixed-capacity ones
+ */
+struct VectorBatch {
+    static constexpr const char* NAME = "std::vector";
+    std::vector<uint32_t> items;
+    VectorBatch() { items.reserve(SMALL_BATCH); }
+    void push_back(uint32_t value) { items.push_back(value); }
+    uint32_t last() const { return items.back(); }
+};
+
+/**
+ * @brief DynArray counterpart of VectorBatch
+ */
+struct DynArrayBatch {
+    static constexpr const char* NAME = "DynArray";
+    DynArray<uint32_t> items;
+    DynArrayBatch() : items(SMALL_BATCH) {}
+    void push_back(uint32_t value) { items.push_back(value); }
+    uint32_t last() const { return items.back().value(); }
+};
+
+/**
+ * @brief DynArray drawing from a stack InlineArena
+ */
+struct InlineArenaBatch {
+    static constexpr const char* NAME = "DynArray+InlineArena";
+    InlineArena<SMALL_BATCH * sizeof(uint32_t)> scratch;
+    DynArray<uint32_t, InlineArena<SMALL_BATCH * sizeof(uint32_t)>*> items;
+    InlineArenaBatch() : items(SMALL_BATCH, &scratch) {}
+    void push_back(uint32_t value) { items.push_back(value); }
+    uint32_t last() const { return items.back().value(); }
+};
+
+/**
+ * @brief FixedDynArray with the checked push_back
+ */
+struct FixedBatch {
+    static constexpr const char* NAME = "FixedDynArray";
+    FixedDynArray<uint32_t, SMALL_BATCH> items;
+    void push_back(uint32_t value) { items.push_back(value); }
+    uint32_t last() const { return items.back().value(); }
+};
+
+/**
+ * @brief FixedDynArray with push_back_unchecked, the loop bound proves it fits
+ */
+struct FixedUncheckedBatch {
+    static constexpr const char* NAME = "FixedDynArray+unchecked";
+    FixedDynArray<uint32_t, SMALL_BATCH> items;
+    void push_back(uint32_t value) { items.push_back_unchecked(value); }
+    uint32_t last() const { return items.back().value(); }
+};
+
+/**
+ * @brief Fill a fresh batch container and drop it, as a scratch list inside a hot loop would
+ *
+ * @param state Benchmark state
+ */
+template <typename Batch>
+void BM_SmallBatch(benchmark::State& state) {
+    LatencySampler sampler;
+    uint32_t seed = 0;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        Batch batch;
+        for (size_t i = 0; i < SMALL_BATCH; ++i) {
+            batch.push_back(seed + static_cast<uint32_t>(i));
+        }
+        benchmark::DoNotOptimize(batch.last());
+        sampler.add(start, LatencySampler::Clock::now(), SMALL_BATCH);
+        ++seed;
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * SMALL_BATCH));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * SMALL_BATCH * sizeof(uint32_t)));
+    sampler.report(state);
+}
+
+/**
+ * @brief Register every container benchmark for one container and element type
+ *
+ * @param type_name Element type name used in the benchmark names
+ */
+template <template <typename> typename Ops, typename T>
+void register_container_suite(const char* type_name) {
+    std::string suffix = std::string("/") + Ops<T>::NAME + "<" + type_name + ">";
+    benchmark::RegisterBenchmark(("push_back" + suffix).c_str(), BM_PushBack<Ops<T>, T>)
+        ->RangeMultiplier(16)->Range(16, 64 * 1024);
+    benchmark::RegisterBenchmark(("reserve_push_back" + suffix).c_str(), BM_ReservePushBack<Ops<T>, T>)
+        ->RangeMultiplier(16)->Range(16, 64 * 1024);
+    benchmark::RegisterBenchmark(("insert_erase_front" + suffix).c_str(), BM_InsertEraseFront<Ops<T>, T>)
+        ->RangeMultiplier(16)->Range(16, 16 * 1024);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_container_suite<VectorOps, int>("int");
+    register_container_suite<DynArrayOps, int>("int");
+    register_container_suite<VectorOps, std::string>("string");
+    register_container_suite<DynArrayOps, std::string>("string");
+    benchmark::RegisterBenchmark("scan_field/DynArray<Particle>", BM_ScanFieldAos)
+        ->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+    benchmark::RegisterBenchmark("scan_field/SoaArray<Particle>", BM_ScanFieldSoa)
+        ->RangeMultiplier(16)->Range(1024, 1024 * 1024);
+    benchmark::RegisterBenchmark((std::string("small_batch/") + VectorBatch::NAME).c_str(),
+                                 BM_SmallBatch<VectorBatch>);
+    benchmark::RegisterBenchmark((std::string("small_batch/") + DynArrayBatch::NAME).c_str(),
+                                 BM_SmallBatch<DynArrayBatch>);
+    benchmark::RegisterBenchmark((std::string("small_batch/") + InlineArenaBatch::NAME).c_str(),
+                                 BM_SmallBatch<InlineArenaBatch>);
+    benchmark::RegisterBenchmark((std::string("small_batch/") + FixedBatch::NAME).c_str(),
+                                 BM_SmallBatch<FixedBatch>);
+    benchmark::RegisterBenchmark((std::string("small_batch/") + FixedUncheckedBatch::NAME).c_str(),
+                                 BM_SmallBatch<FixedUncheckedBatch>);
+    return true;
+}();
+
+} // namespace
+} // namespace memory::bench
@@ -0,0 +1,116 @@
+#include "BenchHarness.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+#include "memory/FlatHashMap.hpp"
+
+namespace memory::bench {
+namespace {
+
+/**
+ * @brief Keys spread over the whole 64-bit range, the same for every container
+ */
+std::vector<uint64_t> make_keys(size_t count) {
+    std::vector<uint64_t> keys(count);
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+    for (uint64_t& key : keys) {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        key = state;
+    }
+    return keys;
+}
+
+/**
+ * @brief Uniform wrapper so one benchmark body drives both maps
+ */
+struct UnorderedMapOps {
+    static constexpr const char* NAME = "std::unordered_map";
+    std::unordered_map<uint64_t, uint64_t> items;
+    void insert(uint64_t key, uint64_t value) { items.try_emplace(key, value); }
+    bool contains(uint64_t key) const { return items.find(key) != items.end(); }
+};
+
+/**
+ * @brief FlatHashMap counterpart of UnorderedMapOps
+ */
+struct FlatHashMapOps {
+    static constexpr const char* NAME = "FlatHashMap";
+    FlatHashMap<uint64_t, uint64_t> items;
+    void insert(uint64_t key, uint64_t value) { items.try_emplace(key, value); }
+    bool contains(uint64_t key) const { return items.contains(key); }
+};
+
+/**
+ * @brief Insert n distinct keys into an empty map, letting it grow
+ *
+ * @param state Benchmark state, range(0) is the key count
+ */
+template <typename Ops>
+void BM_MapInsert(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> keys = make_keys(count);
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        Ops ops;
+        for (size_t i = 0; i < count; ++i) {
+            ops.insert(keys[i], i);
+        }
+        benchmark::DoNotOptimize(ops.items);
+        sampler.add(start, LatencySampler::Clock::now(), count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    sampler.report(state);
+}
+
+/**
+ * @brief Look up n keys in a map of n entries, half of them present
+ *
+ * @param state Benchmark state, range(0) is the key count
+ */
+template <typename Ops>
+void BM_MapLookup(benchmark::State& state) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<uint64_t> keys = make_keys(count * 2);
+    Ops ops;
+    for (size_t i = 0; i < count; ++i) {
+        ops.insert(keys[i * 2], i);
+    }
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        size_t found = 0;
+        for (size_t i = 0; i < count; ++i) {
+            found += ops.contains(keys[i]);
+        }
+        benchmark::DoNotOptimize(found);
+        sampler.add(start, LatencySampler::Clock::now(), count);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    sampler.report(state);
+}
+
+/**
+ * @brief Register the map benchmarks for one map
+ */
+template <typename Ops>
+void register_map_suite() {
+    std::string suffix = std::string("/") + Ops::NAME;
+    benchmark::RegisterBenchmark(("map_insert" + suffix).c_str(), BM_MapInsert<Ops>)
+        ->RangeMultiplier(16)->Range(64, 1024 * 1024);
+    benchmark::RegisterBenchmark(("map_lookup" + suffix).c_str(), BM_MapLookup<Ops>)
+        ->RangeMultiplier(16)->Range(64, 1024 * 1024);
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_map_suite<UnorderedMapOps>();
+    register_map_suite<FlatHashMapOps>();
+    return true;
+}();
+
+} // namespace
+} // namespace memory::bench
@@ -0,0 +1,123 @@
+#include "BenchHarness.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "memory/SimdKernels.hpp"
+
+namespace memory::bench {
+namespace {
+
+/**
+ * @brief Input with no element equal to the needle, so find and count scan everything
+ */
+template <typename T>
+std::vector<T> make_column(size_t count) {
+    std::vector<T> column(count);
+    for (size_t i = 0; i < count; ++i) {
+        column[i] = static_cast<T>(i % 1000);
+    }
+    return column;
+}
+
+/**
+ * @brief Run one kernel over a column at a fixed instruction set
+ *
+ * @param state Benchmark state, range(0) is the element count
+ * @param level Instruction set to dispatch to, restored afterwards
+ * @param kernel Callable taking the column as a span and returning a value to keep
+ */
+template <typename T, typename Kernel>
+void run_kernel(benchmark::State& state, simd::SimdLevel level, Kernel kernel) {
+    const size_t count = static_cast<size_t>(state.range(0));
+    std::vector<T> column = make_column<T>(count);
+    const simd::SimdLevel original = simd::active_level();
+    simd::set_level(level);
+
+    LatencySampler sampler;
+    for (auto _ : state) {
+        auto start = LatencySampler::Clock::now();
+        benchmark::DoNotOptimize(kernel(std::span<T>(column)));
+        benchmark::ClobberMemory();
+        sampler.add(start, LatencySampler::Clock::now(), count);
+    }
+    simd::set_level(original);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * count * sizeof(T)));
+    sampler.report(state);
+}
+
+/**
+ * @brief Register the kernel benchmarks for one element type at one level
+ */
+template <typename T>
+void register_level(simd::SimdLevel level, const char* type_name) {
+    std::string suffix = std::string("/") + type_name + "/" + simd::level_name(level);
+    auto add = [&](const char* name, auto kernel) {
+        benchmark::RegisterBenchmark((std::string("simd_") + name + suffix).c_str(),
+                                     [level, kernel](benchmark::State& state) {
+                                         run_kernel<T>(state, level, kernel);
+                                     })
+            ->RangeMultiplier(16)->Range(4096, 16 * 1024 * 1024);
+    };
+
+    add("fill", [](std::span<T> column) { simd::fill(column, T(1)); return column[0]; });
+    add("find", [](std::span<T> column) { return simd::find(std::span<const T>(column), T(-1)); });
+    add("count", [](std::span<T> column) { return simd::count(std::span<const T>(column), T(-1)); });
+    add("min", [](std::span<T> column) { return simd::min(std::span<const T>(column)); });
+    add("sum", [](std::span<T> column) { return simd::sum(std::span<const T>(column)); });
+    add("transform", [](std::span<T> column) {
+        simd::transform(std::span<const T>(column), column, [](T x) { return static_cast<T>(x / 2 + 1); });
+        return column[0];
+    });
+}
+
+/**
+ * @brief The same operations with the standard algorithms, for reference
+ */
+template <typename T>
+void register_std(const char* type_name) {
+    std::string suffix = std::string("/") + type_name + "/std";
+    auto add = [&](const char* name, auto kernel) {
+        benchmark::RegisterBenchmark((std::string("simd_") + name + suffix).c_str(),
+                                     [kernel](benchmark::State& state) {
+                                         run_kernel<T>(state, simd::active_level(), kernel);
+                                     })
+            ->RangeMultiplier(16)->Range(4096, 16 * 1024 * 1024);
+    };
+
+    add("fill", [](std::span<T> column) { std::fill(column.begin(), column.end(), T(1)); return column[0]; });
+    add("find", [](std::span<T> column) { return std::find(column.begin(), column.end(), T(-1)) - column.begin(); });
+    add("count", [](std::span<T> column) { return std::count(column.begin(), column.end(), T(-1)); });
+    add("min", [](std::span<T> column) { return *std::min_element(column.begin(), column.end()); });
+    add("sum", [](std::span<T> column) { return std::accumulate(column.begin(), column.end(), simd::sum_t<T>(0)); });
+    add("transform", [](std::span<T> column) {
+        std::transform(column.begin(), column.end(), column.begin(), [](T x) { return static_cast<T>(x / 2 + 1); });
+        return column[0];
+    });
+}
+
+/**
+ * @brief Register the standard algorithms and every level the CPU supports for one type
+ */
+template <typename T>
+void register_simd_suite(const char* type_name) {
+    register_std<T>(type_name);
+    for (auto level : {simd::SimdLevel::Scalar, simd::SimdLevel::SSE42, simd::SimdLevel::AVX2,
+                       simd::SimdLevel::AVX512, simd::SimdLevel::NEON}) {
+        if (simd::is_supported(level)) {
+            register_level<T>(level, type_name);
+        }
+    }
+}
+
+[[maybe_unused]] const bool registered = [] {
+    register_simd_suite<int32_t>("int32");
+    register_simd_suite<float>("float");
+    return true;
+}();
+
+} // namespace
+} // namespace memory::bench
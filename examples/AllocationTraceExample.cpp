@@ -0,0 +1,154 @@
+#include "memory/AllocationTrace.hpp"
+#include "memory/DynArray.hpp"
+#include "memory/FreeListAllocator.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/ThreadCachedPool.hpp"
+#include "memory/TraceReplay.hpp"
+#include <cstdio>
+#include <fmt/core.h>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr const char* TRACE_FILE = "allocation_trace.bin";
+
+void print_replay(const char* name, const memory::ReplayReport& report) {
+    fmt::print("  {:<18} failures: {}, peak: {} bytes, fragmentation: {:.1f}%\n", name, report.failures,
+               report.peak_footprint, report.fragmentation() * 100.0);
+}
+
+} // namespace
+
+int main() {
+    // The ring lives in a caller buffer like any allocator's backing memory
+    std::vector<unsigned char> ring_buffer(4096 * sizeof(memory::TraceSlot) + alignof(memory::TraceSlot));
+    auto trace_result = memory::TraceBuffer::create(ring_buffer.data(), ring_buffer.size());
+    if (!trace_result) {
+        fmt::print("Failed to create trace buffer: {}\n", static_cast<int>(trace_result.error()));
+        return 1;
+    }
+    memory::TraceBuffer trace = std::move(trace_result.value());
+    fmt::print("Trace ring holds {} events\n", trace.capacity());
+
+    std::FILE* file = std::fopen(TRACE_FILE, "wb");
+    if (file == nullptr || !memory::write_trace_header(file)) {
+        fmt::print("Failed to open {}\n", TRACE_FILE);
+        return 1;
+    }
+
+    // Example 1: Frame arena with scratch scopes
+    {
+        fmt::print("\n=== Example 1: Tracing a frame arena ===\n");
+
+        alignas(16) unsigned char arena_buffer[16 * 1024];
+        auto arena = memory::LinearAllocator::create(arena_buffer, sizeof(arena_buffer));
+        auto traced = memory::TracedAllocator<memory::LinearAllocator>::create(&arena, &trace);
+
+        for (int frame = 0; frame < 8; ++frame) {
+            // Per-frame data, grown once it turns out to be too small
+            void* entities = traced.alloc_align_uninit(256, 16).value();
+            entities = traced.resize_align_uninit(entities, 256, 512, 16).value();
+
+            // Scratch memory only needed while building the frame
+            memory::TempArenaMemory scratch = traced.begin_scope();
+            for (int i = 0; i < 4; ++i) {
+                traced.alloc_align_uninit(static_cast<size_t>(128 * (i + 1)), 16).value();
+            }
+            traced.end_scope(scratch);
+
+            traced.free_all();
+        }
+        fmt::print("Traced 8 frames as allocator #{}\n", traced.id);
+    }
+
+    // Example 2: A DynArray and free-list churn through the same trace
+    {
+        fmt::print("\n=== Example 2: Tracing a free list allocator ===\n");
+
+        alignas(16) unsigned char heap_buffer[64 * 1024];
+        auto heap = memory::FreeListAllocator::create(heap_buffer, sizeof(heap_buffer)).value();
+        auto traced = memory::TracedAllocator<memory::FreeListAllocator>::create(&heap, &trace);
+
+        {
+            // The wrapper is an allocator in its own right
+            memory::DynArray<int, memory::TracedAllocator<memory::FreeListAllocator>*> values(&traced);
+            for (int i = 0; i < 1000; ++i) {
+                values.push_back(i);
+            }
+            fmt::print("DynArray grew to {} elements through the traced allocator\n", values.get_size());
+        }
+
+        void* blocks[32];
+        for (size_t i = 0; i < 32; ++i) {
+            blocks[i] = traced.alloc_align(32 + i * 24, 8).value();
+        }
+        for (size_t i = 0; i < 32; i += 2) {
+            traced.free(blocks[i]);
+        }
+        for (size_t i = 1; i < 32; i += 2) {
+            traced.free(blocks[i]);
+        }
+
+        auto written = trace.flush(file);
+        fmt::print("Flushed {} events to {}\n", written.value_or(0), TRACE_FILE);
+    }
+
+    // Example 3: Recording from several threads at once
+    {
+        fmt::print("\n=== Example 3: Tracing from several threads ===\n");
+
+        std::vector<unsigned char> pool_buffer(1024 * 1024);
+        auto pool = memory::ThreadCachedPool::create(pool_buffer.data(), pool_buffer.size(), 64).value();
+        auto traced = memory::TracedAllocator<memory::ThreadCachedPool>::create(&pool, &trace);
+
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&traced] {
+                for (int i = 0; i < 200; ++i) {
+                    void* chunk = traced.alloc_align_uninit(64, 16).value();
+                    traced.free(chunk);
+                }
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+
+        auto written = trace.flush(file);
+        fmt::print("Flushed {} events, {} dropped while the ring was full\n", written.value_or(0),
+                   trace.dropped_events());
+    }
+    std::fclose(file);
+
+    // Example 4: Replaying the trace against other allocators
+    {
+        fmt::print("\n=== Example 4: Replaying the trace ===\n");
+
+        std::FILE* input = std::fopen(TRACE_FILE, "rb");
+        auto events = memory::read_trace(input);
+        std::fclose(input);
+        if (!events) {
+            fmt::print("Failed to read {}\n", TRACE_FILE);
+            return 1;
+        }
+        fmt::print("Read {} events (the trace_replay tool does the same for every allocator)\n", events->size());
+
+        std::vector<unsigned char> replay_buffer(1024 * 1024);
+        for (uint16_t id : memory::trace_allocators(events.value())) {
+            auto program = memory::ReplayProgram::compile(events.value(), id);
+            fmt::print("Allocator #{}: {} operations, peak live {} bytes\n", id, program.ops.size(),
+                       program.peak_live_bytes);
+
+            auto linear = memory::LinearAllocator::create(replay_buffer.data(), replay_buffer.size());
+            print_replay("LinearAllocator", memory::replay(program, linear, replay_buffer.data()));
+            linear.destroy();
+
+            auto free_list = memory::FreeListAllocator::create(replay_buffer.data(), replay_buffer.size()).value();
+            print_replay("FreeListAllocator", memory::replay(program, free_list, replay_buffer.data()));
+        }
+    }
+    std::remove(TRACE_FILE);
+
+    return 0;
+}
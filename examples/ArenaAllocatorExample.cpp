@@ -0,0 +1,83 @@
+#include "memory/ArenaAllocator.hpp"
+#include "memory/FreeListAllocator.hpp"
+#include <fmt/core.h>
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+int main() {
+    // Example 1: std::vector and std::string on a linear allocator
+    {
+        fmt::print("\n=== Example 1: STL containers on an arena ===\n");
+
+        constexpr size_t BUFFER_SIZE = 64 * 1024;
+        unsigned char backing_buffer[BUFFER_SIZE];
+        auto arena = memory::LinearAllocator::create(backing_buffer, BUFFER_SIZE);
+
+        using ArenaString = std::basic_string<char, std::char_traits<char>, memory::ArenaAllocator<char>>;
+        std::vector<int, memory::ArenaAllocator<int>> numbers(&arena);
+        for (int i = 0; i < 100; ++i) {
+            numbers.push_back(i * i);
+        }
+        ArenaString text("a string long enough to leave the small string buffer", &arena);
+
+        fmt::print("Vector of {} ints and a {} char string, arena used: {} bytes\n",
+                  numbers.size(), text.size(), arena.curr_offset);
+    }
+
+    // Example 2: pmr containers on a free list allocator
+    {
+        fmt::print("\n=== Example 2: pmr containers on a free list allocator ===\n");
+
+        constexpr size_t BUFFER_SIZE = 64 * 1024;
+        alignas(16) unsigned char backing_buffer[BUFFER_SIZE];
+        auto free_list = memory::FreeListAllocator::create(backing_buffer, BUFFER_SIZE).value();
+        memory::ArenaResource<memory::FreeListAllocator> resource(&free_list);
+
+        {
+            std::pmr::unordered_map<int, std::pmr::string> names(&resource);
+            for (int i = 0; i < 50; ++i) {
+                names.emplace(i, fmt::format("name number {} with some padding", i));
+            }
+            fmt::print("Map of {} entries, bytes in use: {}\n", names.size(), free_list.used);
+        }
+
+        // Node frees went back to the free list
+        fmt::print("After the map is gone, bytes in use: {}\n", free_list.used);
+    }
+
+    // Example 3: TempArenaMemory as a scope around containers
+    {
+        fmt::print("\n=== Example 3: Containers inside a temporary scope ===\n");
+
+        constexpr size_t BUFFER_SIZE = 64 * 1024;
+        unsigned char backing_buffer[BUFFER_SIZE];
+        auto arena = memory::LinearAllocator::create(backing_buffer, BUFFER_SIZE);
+        arena.alloc(128);
+
+        auto temp = memory::TempArenaMemory::begin(&arena);
+        {
+            memory::ArenaResource<memory::TempArenaMemory> scratch(&temp);
+            std::pmr::vector<std::pmr::string> words(&scratch);
+            for (int i = 0; i < 20; ++i) {
+                words.emplace_back(fmt::format("temporary word {:02} of the scope", i));
+            }
+            fmt::print("Scratch words: {}, arena used: {} bytes\n", words.size(), arena.curr_offset);
+        }
+        temp.end();
+        fmt::print("After end(): arena used {} bytes\n", arena.curr_offset);
+
+        // Running out of arena memory surfaces as std::bad_alloc
+        unsigned char small_buffer[64];
+        auto small = memory::LinearAllocator::create(small_buffer, sizeof(small_buffer));
+        std::vector<int, memory::ArenaAllocator<int>> too_big(&small);
+        try {
+            too_big.resize(1000);
+        } catch (const std::bad_alloc&) {
+            fmt::print("Exhausted arena throws std::bad_alloc\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include "memory/ArenaString.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/StringInterner.hpp"
+#include <cstdint>
+#include <fmt/core.h>
+
+int main() {
+    alignas(16) unsigned char backing_buffer[16384];
+    auto arena = memory::LinearAllocator::create(backing_buffer, sizeof(backing_buffer));
+
+    // Example 1: Building strings at the top of the arena
+    {
+        fmt::print("\n=== Example 1: String builder ===\n");
+
+        memory::ArenaString path(&arena);
+        path.append("/users/");
+        path.append_number(uint64_t{4711});
+        path.append("/orders?limit=");
+        path.append_number(25);
+        fmt::print("Built '{}' ({} chars, capacity {})\n", path.view(), path.get_size(), path.get_capacity());
+
+        // Growing the most recent allocation extends it where it is
+        const char* before = path.c_str();
+        path.append(200, '.');
+        path.push_back('!');
+        fmt::print("Grew to {} chars (capacity {}) without moving: {}\n", path.get_size(), path.get_capacity(),
+                   path.c_str() == before);
+
+        // finish() hands the slack back and detaches the string from the builder
+        size_t offset_before = arena.curr_offset;
+        std::string_view done = path.finish();
+        fmt::print("Finished a {} char string, arena end went from {} to {}\n", done.size(), offset_before,
+                   arena.curr_offset);
+    }
+
+    // Example 2: Interning repeated strings
+    {
+        fmt::print("\n=== Example 2: String interning ===\n");
+
+        memory::StringInterner names(&arena);
+        const char* words[] = {"GET", "POST", "GET", "PUT", "GET", "POST"};
+        std::string_view first_get;
+        for (const char* word : words) {
+            auto interned = names.intern(word);
+            if (!interned) {
+                fmt::print("Out of arena memory\n");
+                break;
+            }
+            if (first_get.empty() && interned.value() == "GET") {
+                first_get = interned.value();
+            }
+        }
+        fmt::print("{} words, {} distinct, {} bytes of characters\n", std::size(words), names.get_size(),
+                   names.get_bytes());
+
+        // Every copy of a string maps to the same arena memory
+        auto again = names.intern("GET");
+        fmt::print("Interned views share storage: {}\n", again && again->data() == first_get.data());
+
+        // Drop the table, then the whole arena in one go
+        names.reset();
+    }
+
+    arena.free_all();
+    return 0;
+}
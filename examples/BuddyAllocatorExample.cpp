@@ -0,0 +1,58 @@
+#include "memory/BuddyAllocator.hpp"
+#include <fmt/core.h>
+#include <memory>
+
+int main() {
+    // Example 1: Buddy allocator over its own buffer
+    {
+        fmt::print("\n=== Example 1: Buddy allocator over a buffer ===\n");
+
+        constexpr size_t BUFFER_SIZE = 1024 * 1024 + 4096;
+        auto backing_buffer = std::make_unique<unsigned char[]>(BUFFER_SIZE);
+        auto buddy_result = memory::BuddyAllocator::create(backing_buffer.get(), BUFFER_SIZE, 256);
+        if (!buddy_result) {
+            fmt::print("Failed to create buddy allocator: {}\n", static_cast<int>(buddy_result.error()));
+            return 1;
+        }
+        auto buddy = buddy_result.value();
+        fmt::print("Region: {} bytes, {} levels, bitmaps: {} bytes\n", buddy.region_size, buddy.level_count,
+                  memory::BuddyAllocator::metadata_size(buddy.region_size, buddy.min_block_size));
+
+        // Sizes are rounded up to a power of two
+        void* small = buddy.alloc(300).value();
+        void* packet = buddy.alloc(4096).value();
+        fmt::print("300 byte request uses a {} byte block\n", buddy.block_size(small).value());
+        fmt::print("Used: {} bytes\n", buddy.used);
+
+        // Growing within the block stays in place
+        auto grown = buddy.resize(small, 300, 500);
+        fmt::print("Grown to 500 in place: {}\n", grown && grown.value() == small);
+
+        // Freeing merges buddies back into the whole region
+        buddy.free(grown.value());
+        buddy.free(packet);
+        fmt::print("Used after free: {} bytes, whole region free: {}\n", buddy.used, buddy.free_lists[0] != nullptr);
+    }
+
+    // Example 2: Buddy allocator carved out of a startup reservation
+    {
+        fmt::print("\n=== Example 2: Buddy allocator carved out of an arena ===\n");
+
+        constexpr size_t BUFFER_SIZE = 512 * 1024;
+        auto backing_buffer = std::make_unique<unsigned char[]>(BUFFER_SIZE);
+        auto arena = memory::LinearAllocator::create(backing_buffer.get(), BUFFER_SIZE);
+
+        auto buddy_result = memory::BuddyAllocator::create(&arena, 256 * 1024, 256);
+        if (!buddy_result) {
+            fmt::print("Failed to create buddy allocator: {}\n", static_cast<int>(buddy_result.error()));
+            return 1;
+        }
+        auto buddy = buddy_result.value();
+        fmt::print("Region: {} bytes, arena used: {} bytes\n", buddy.region_size, arena.curr_offset);
+
+        auto too_big = buddy.alloc(512 * 1024);
+        fmt::print("Request larger than the region fails: {}\n", !too_big.has_value());
+    }
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "memory/ConcurrentDynArray.hpp"
+#include "memory/ConcurrentLinearAllocator.hpp"
+#include "memory/DynArray.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fmt/core.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Example record produced by many threads at once
+ */
+struct Sample {
+    uint32_t producer;
+    uint32_t sequence;
+    double value;
+};
+
+int main() {
+    constexpr uint32_t THREADS = 4;
+    constexpr uint32_t PER_THREAD = 250'000;
+
+    // Example 1: A shared collector without a lock
+    {
+        fmt::print("=== Example 1: Concurrent appends ===\n");
+
+        memory::ConcurrentDynArray<Sample> samples;
+        std::vector<const Sample*> first(THREADS);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < THREADS; ++t) {
+            producers.emplace_back([&, t] {
+                for (uint32_t i = 0; i < PER_THREAD; ++i) {
+                    Sample& sample = samples.emplace_back(t, i, t + i * 0.5).value().get();
+                    if (i == 0) {
+                        first[t] = &sample;
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+        fmt::print("{} samples from {} threads in {:.1f} ms, {} segments\n", samples.get_size(), THREADS,
+                   elapsed.count(), samples.segment_count());
+
+        // Growth never moved anything, so references taken at the start still hold
+        bool stable = true;
+        for (uint32_t t = 0; t < THREADS; ++t) {
+            stable = stable && first[t]->producer == t && first[t]->sequence == 0;
+        }
+        fmt::print("First sample of every thread still in place: {}\n", stable);
+
+        // Consumers walk contiguous runs, one per segment
+        double total = 0.0;
+        size_t longest = 0;
+        samples.for_each([&](std::span<Sample> run) {
+            longest = run.size() > longest ? run.size() : longest;
+            for (const Sample& sample : run) {
+                total += sample.value;
+            }
+        });
+        fmt::print("Sum of values: {:.1f}, longest contiguous run {}\n", total, longest);
+    }
+
+    // Example 2: The same collector behind a mutex, for comparison
+    {
+        fmt::print("\n=== Example 2: DynArray behind a mutex ===\n");
+
+        memory::DynArray<Sample> samples;
+        std::mutex lock;
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < THREADS; ++t) {
+            producers.emplace_back([&, t] {
+                for (uint32_t i = 0; i < PER_THREAD; ++i) {
+                    std::lock_guard<std::mutex> guard(lock);
+                    samples.push_back(Sample{t, i, t + i * 0.5});
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+        fmt::print("{} samples in {:.1f} ms\n", samples.get_size(), elapsed.count());
+    }
+
+    // Example 3: Segments from a shared arena
+    {
+        fmt::print("\n=== Example 3: Segments from a concurrent arena ===\n");
+
+        // The arena is lock-free too, and runs out: appends then fail instead of blocking
+        std::vector<unsigned char> buffer(1 << 20);
+        auto arena = memory::ConcurrentLinearAllocator::create(buffer.data(), buffer.size());
+        memory::ConcurrentDynArray<uint64_t, memory::ConcurrentLinearAllocator*> ids(&arena);
+
+        std::atomic<size_t> failed{0};
+        std::vector<std::thread> producers;
+        for (uint32_t t = 0; t < THREADS; ++t) {
+            producers.emplace_back([&, t] {
+                for (uint64_t i = 0; i < 50'000; ++i) {
+                    if (!ids.push_back((uint64_t{t} << 32) | i)) {
+                        ++failed;
+                    }
+                }
+            });
+        }
+        for (auto& producer : producers) {
+            producer.join();
+        }
+        fmt::print("Stored {} ids in a 1 MiB arena, {} appends failed once it was full\n", ids.get_size(),
+                   failed.load());
+        fmt::print("Id at index 1000 has producer {}\n", ids[1000] >> 32);
+    }
+
+    return 0;
+}
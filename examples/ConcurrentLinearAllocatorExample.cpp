@@ -0,0 +1,73 @@
+#include "memory/ConcurrentLinearAllocator.hpp"
+#include <fmt/core.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Example output record produced by parallel builders
+ */
+struct Record {
+    int builder;
+    int index;
+    double value;
+};
+
+int main() {
+    // Example 1: Many threads filling one shared output arena
+    {
+        fmt::print("\n=== Example 1: Shared output arena ===\n");
+
+        constexpr size_t BUFFER_SIZE = 1024 * 1024;
+        std::vector<unsigned char> backing_buffer(BUFFER_SIZE);
+        auto arena = memory::ConcurrentLinearAllocator::create(backing_buffer.data(), backing_buffer.size());
+
+        constexpr int BUILDERS = 4;
+        constexpr int RECORDS = 4096;
+        std::atomic<int> failures{0};
+        std::vector<std::thread> builders;
+        for (int b = 0; b < BUILDERS; ++b) {
+            builders.emplace_back([&arena, &failures, b] {
+                for (int i = 0; i < RECORDS; ++i) {
+                    auto result = arena.alloc_align_uninit(sizeof(Record), alignof(Record));
+                    if (!result) {
+                        failures.fetch_add(1);
+                        return;
+                    }
+                    *static_cast<Record*>(result.value()) = Record{b, i, b * 0.5 + i};
+                }
+            });
+        }
+        for (std::thread& builder : builders) {
+            builder.join();
+        }
+        fmt::print("Records: {}, failures: {}, bytes used: {}\n",
+                  BUILDERS * RECORDS, failures.load(), arena.used());
+
+        // One reset frees everything the builders produced
+        arena.free_all();
+        fmt::print("After reset: used {} bytes, epoch {}\n", arena.used(), arena.epoch());
+    }
+
+    // Example 2: Resizing the last allocation
+    {
+        fmt::print("\n=== Example 2: Resizing ===\n");
+
+        unsigned char backing_buffer[256];
+        auto arena = memory::ConcurrentLinearAllocator::create(backing_buffer, sizeof(backing_buffer));
+
+        void* first = arena.alloc(32).value();
+        void* grown = arena.resize(first, 32, 64).value();
+        fmt::print("Last allocation grows in place: {}\n", grown == first);
+
+        // Once another allocation follows, growing has to move
+        arena.alloc(16).value();
+        void* moved = arena.resize(grown, 64, 96).value();
+        fmt::print("Earlier allocation is moved: {}\n", moved != grown);
+
+        auto too_big = arena.alloc(1024);
+        fmt::print("Request larger than the buffer fails: {}\n", !too_big.has_value());
+    }
+
+    return 0;
+}
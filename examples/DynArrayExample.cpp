@@ -1,7 +1,17 @@
 #include "memory/DynArray.hpp"
+#include "memory/ArenaAllocator.hpp"
+#include "memory/FreeListAllocator.hpp"
 #include "memory/LinearAllocator.hpp"
 #include <fmt/core.h>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <sstream>
+#include <iterator>
 #include <string>
+#include <thread>
+#include <vector>
 
 /**
  * @brief Simple struct to demonstrate complex types in DynArray
@@ -138,6 +148,159 @@ void test_custom_objects() {
     }
 }
 
+/**
+ * @brief Test bulk insertion APIs
+ */
+void test_bulk_insertion() {
+    fmt::print("\n=== Bulk Insertion Test ===\n");
+
+    // Contiguous trivially copyable source: one reservation, one memcpy
+    std::vector<int> source = {1, 2, 3, 4, 5, 6, 7, 8};
+    memory::DynArray<int> numbers;
+    numbers.append_range(source);
+    numbers.insert_range(4, source.begin(), source.begin() + 2);
+    fmt::print("After append_range and insert_range:");
+    for (int n : numbers) {
+        fmt::print(" {}", n);
+    }
+    fmt::print("\n");
+
+    // Single-pass input is appended and rotated into place
+    std::istringstream stream("10 20 30");
+    numbers.insert_range(0, std::istream_iterator<int>(stream), std::istream_iterator<int>());
+    fmt::print("After inserting from a stream, front: {}, size: {}\n",
+              numbers.front().value().get(), numbers.get_size());
+
+    // Objects are constructed directly in their slot
+    memory::DynArray<Person> people;
+    people.emplace_back("Dana", 41).value().get().print();
+    fmt::print("\n");
+
+    // Fill a byte buffer in place without zeroing it first
+    memory::DynArray<char> bytes;
+    const char message[] = "written in place";
+    bytes.resize_uninitialized(sizeof(message) - 1);
+    std::memcpy(bytes.data, message, sizeof(message) - 1);
+    fmt::print("Uninitialized resize to {} bytes: {}\n", bytes.get_size(),
+              std::string_view(bytes.data, bytes.get_size()));
+}
+
+/**
+ * @brief Push ints into an array and report how often it reallocated
+ */
+template <typename Array>
+void count_reallocations(const char* name) {
+    Array numbers;
+    size_t reallocations = 0;
+    size_t last_capacity = numbers.get_capacity();
+    for (int i = 0; i < 100000; ++i) {
+        numbers.push_back(i);
+        if (numbers.get_capacity() != last_capacity) {
+            ++reallocations;
+            last_capacity = numbers.get_capacity();
+        }
+    }
+    fmt::print("  {:<24} {:>2} reallocations, final capacity {}\n", name, reallocations, last_capacity);
+}
+
+/**
+ * @brief Test growth policies
+ */
+void test_growth_policies() {
+    fmt::print("\n=== Growth Policy Test ===\n");
+    fmt::print("Pushing 100000 ints:\n");
+
+    count_reallocations<memory::DynArray<int>>("1.5x (default)");
+    count_reallocations<memory::DynArray<int, memory::HeapAllocator, memory::GeometricGrowth<2, 1>>>("2x");
+    count_reallocations<memory::DynArray<int, memory::HeapAllocator, memory::PowerOfTwoGrowth>>("power of two");
+    count_reallocations<memory::DynArray<int, memory::HeapAllocator, memory::PageGrowth<4096, 64 * 1024>>>(
+        "pages, 64 KiB max step");
+    count_reallocations<memory::DynArray<int, memory::HeapAllocator, memory::UsableSizeGrowth<>>>(
+        "1.5x + usable size");
+}
+
+/**
+ * @brief Bump one counter per thread and time it
+ *
+ * @param counters Array with at least thread_count counters, reached through operator*
+ */
+template <typename Array>
+double time_counters(Array& counters, size_t thread_count) {
+    constexpr size_t INCREMENTS = 2'000'000;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&counters, t] {
+            for (size_t i = 0; i < INCREMENTS; ++i) {
+                // volatile keeps every increment a load and store on the shared array
+                volatile uint64_t& counter = *counters.get_data()[t];
+                counter = counter + 1;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Plain counter with the same interface as CacheLinePadded
+ */
+struct PackedCounter {
+    uint64_t value;
+    uint64_t& operator*() { return value; }
+};
+
+/**
+ * @brief Test alignment policies and cache-line padded elements
+ */
+void test_alignment_policies() {
+    fmt::print("\n=== Alignment Policy Test ===\n");
+
+    auto offset_in = [](const void* ptr, size_t boundary) {
+        return reinterpret_cast<uintptr_t>(ptr) % boundary;
+    };
+
+    // The policy is passed to alloc_align on every growth, on the heap and in arenas
+    memory::DynArray<float> natural;
+    memory::DynArray<float, memory::HeapAllocator, memory::GeometricGrowth<>, memory::CacheLineAlignment> line;
+    memory::DynArray<float, memory::HeapAllocator, memory::GeometricGrowth<>, memory::PageAlignment<>> page;
+    for (int i = 0; i < 1000; ++i) {
+        natural.push_back(1.0f);
+        line.push_back(1.0f);
+        page.push_back(1.0f);
+    }
+    fmt::print("Natural:    alignment {:4}, data offset within a 64-byte line {}\n", natural.ALIGNMENT,
+               offset_in(natural.get_data(), 64));
+    fmt::print("Cache line: alignment {:4}, data offset within a 64-byte line {}\n", line.ALIGNMENT,
+               offset_in(line.get_data(), 64));
+    fmt::print("Page:       alignment {:4}, data offset within a 4 KiB page {}\n", page.ALIGNMENT,
+               offset_in(page.get_data(), 4096));
+
+    alignas(64) unsigned char buffer[4096];
+    auto arena = memory::LinearAllocator::create(buffer, sizeof(buffer));
+    (void)arena.alloc(3); // Knock the arena off its alignment
+    memory::DynArray<double, memory::LinearAllocator*, memory::GeometricGrowth<2, 1>, memory::CacheLineAlignment>
+        samples(&arena);
+    samples.resize(100, 0.0);
+    fmt::print("Arena-backed cache line array: data offset within a line {}\n", offset_in(samples.get_data(), 64));
+
+    // One counter per thread: packed counters share lines, padded ones do not
+    const size_t thread_count = 4;
+    memory::DynArray<PackedCounter> packed;
+    packed.resize(thread_count, PackedCounter{0});
+    memory::DynArray<memory::CacheLinePadded<uint64_t>, memory::HeapAllocator, memory::GeometricGrowth<>,
+                     memory::CacheLineAlignment> padded;
+    padded.resize(thread_count, memory::CacheLinePadded<uint64_t>{0});
+
+    fmt::print("sizeof(CacheLinePadded<uint64_t>) = {}\n", sizeof(memory::CacheLinePadded<uint64_t>));
+    double packed_ms = time_counters(packed, thread_count);
+    double padded_ms = time_counters(padded, thread_count);
+    fmt::print("{} threads bumping packed counters: {:.1f} ms, padded counters: {:.1f} ms\n", thread_count,
+               packed_ms, padded_ms);
+}
+
 /**
  * @brief Test with custom allocator
  */
@@ -151,8 +314,8 @@ void test_custom_allocator() {
     // Create a linear allocator
     auto allocator = memory::LinearAllocator::create(backing_buffer, BUFFER_SIZE);
 
-    // Create a dynamic array using our custom allocator (not taking ownership)
-    memory::DynArray<int> numbers(10, &allocator, false);
+    // Create a dynamic array that allocates through a pointer to our arena
+    memory::DynArray<int, memory::LinearAllocator*> numbers(10, &allocator);
 
     // Add some elements
     for (int i = 0; i < 5; ++i) {
@@ -166,6 +329,46 @@ void test_custom_allocator() {
     fmt::print("\n");
 
     fmt::print("Memory used from buffer: {} bytes\n", allocator.curr_offset);
+
+    // Grow past the initial capacity; the array is the arena's last allocation,
+    // so its block is extended in place instead of being copied
+    for (int i = 5; i < 40; ++i) {
+        numbers.push_back(i * 100);
+    }
+    fmt::print("After growing to {} elements (capacity {}): {} bytes used\n",
+              numbers.get_size(), numbers.get_capacity(), allocator.curr_offset);
+}
+
+/**
+ * @brief Test other allocator backends
+ */
+void test_allocator_backends() {
+    fmt::print("\n=== Allocator Backends Test ===\n");
+
+    // The default heap allocator takes no space in the array
+    fmt::print("sizeof(DynArray<int>): {} bytes, with an arena pointer: {} bytes\n",
+              sizeof(memory::DynArray<int>), sizeof(memory::DynArray<int, memory::LinearAllocator*>));
+
+    // A free list allocator gets the old block back on every growth
+    alignas(16) unsigned char backing_buffer[4096];
+    auto free_list = memory::FreeListAllocator::create(backing_buffer, sizeof(backing_buffer)).value();
+    {
+        memory::DynArray<Person, memory::FreeListAllocator*> people(2, &free_list);
+        for (int i = 0; i < 20; ++i) {
+            people.push_back(Person("Person " + std::to_string(i), 20 + i));
+        }
+        fmt::print("{} people on the free list, bytes in use: {}\n", people.get_size(), free_list.used);
+    }
+    fmt::print("After destruction, bytes in use: {}\n", free_list.used);
+
+    // Any std::pmr::memory_resource works through ResourceAllocator
+    std::pmr::monotonic_buffer_resource monotonic;
+    memory::ResourceAllocator resource{&monotonic};
+    memory::DynArray<double, memory::ResourceAllocator*> values(4, &resource);
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(i * 0.5);
+    }
+    fmt::print("{} values from a pmr resource, last: {}\n", values.get_size(), values.back().value().get());
 }
 
 /**
@@ -250,7 +453,11 @@ int main() {
     test_initializer_list();
     test_resize();
     test_custom_objects();
+    test_bulk_insertion();
+    test_growth_policies();
+    test_alignment_policies();
     test_custom_allocator();
+    test_allocator_backends();
     test_error_handling();
     test_rule_of_five();
 
@@ -0,0 +1,59 @@
+#include "memory/FlatHashMap.hpp"
+#include "memory/LinearAllocator.hpp"
+#include <cstdint>
+#include <fmt/core.h>
+#include <string>
+
+int main() {
+    // Example 1: A throwaway map per request on an arena
+    {
+        fmt::print("\n=== Example 1: Per-request map on a LinearAllocator ===\n");
+
+        alignas(64) unsigned char backing_buffer[64 * 1024];
+        auto arena = memory::LinearAllocator::create(backing_buffer, sizeof(backing_buffer));
+
+        for (int request = 0; request < 3; ++request) {
+            memory::FlatHashMap<uint32_t, uint32_t, memory::LinearAllocator*> counts(&arena);
+            for (uint32_t i = 0; i < 500; ++i) {
+                uint32_t key = (i * 7 + static_cast<uint32_t>(request)) % 97;
+                auto entry = counts.try_emplace(key, 0u);
+                if (entry) {
+                    ++entry->first->value;
+                }
+            }
+            fmt::print("Request {}: {} distinct keys in {} slots, arena used: {} bytes\n", request,
+                       counts.get_size(), counts.get_capacity(), arena.curr_offset);
+
+            // Every rehash left its old table behind in the arena; all of it goes at once
+            counts.reset();
+            arena.free_all();
+        }
+    }
+
+    // Example 2: String keys on the default heap allocator
+    {
+        fmt::print("\n=== Example 2: String keys ===\n");
+
+        memory::FlatHashMap<std::string, int> ages;
+        ages.try_emplace("ada", 36);
+        ages.try_emplace("grace", 85);
+        ages.insert_or_assign("linus", 54);
+
+        // try_emplace leaves an existing entry alone, insert_or_assign overwrites it
+        auto again = ages.try_emplace("ada", 0);
+        fmt::print("Inserting ada again inserted: {}, value stays {}\n", again && again->second,
+                   ages.at("ada")->get());
+        ages.insert_or_assign("ada", 37);
+        fmt::print("After insert_or_assign: {}\n", ages.at("ada")->get());
+
+        ages.erase("grace");
+        fmt::print("Contains grace: {}, lookup of grace fails: {}\n", ages.contains("grace"),
+                   !ages.at("grace").has_value());
+
+        for (const auto& entry : ages) {
+            fmt::print("  {} -> {}\n", entry.key, entry.value);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include "memory/FreeListAllocator.hpp"
+#include <fmt/core.h>
+
+/**
+ * @brief Print the free blocks of a free list allocator
+ */
+void print_free_blocks(const memory::FreeListAllocator& allocator) {
+    fmt::print("  Free blocks:");
+    for (const memory::FreeListNode* node = allocator.head; node != nullptr; node = node->next) {
+        fmt::print(" [{} +{}]", reinterpret_cast<const unsigned char*>(node) - allocator.buf, node->block_size);
+    }
+    fmt::print("\n");
+}
+
+int main() {
+    constexpr size_t BUFFER_SIZE = 4096;
+    alignas(16) unsigned char backing_buffer[BUFFER_SIZE];
+
+    for (auto policy : {memory::PlacementPolicy::FirstFit, memory::PlacementPolicy::BestFit}) {
+        fmt::print("\n=== {} ===\n", policy == memory::PlacementPolicy::FirstFit ? "First fit" : "Best fit");
+
+        auto allocator_result = memory::FreeListAllocator::create(backing_buffer, BUFFER_SIZE, policy);
+        if (!allocator_result) {
+            fmt::print("Failed to create allocator: {}\n", static_cast<int>(allocator_result.error()));
+            return 1;
+        }
+        auto allocator = allocator_result.value();
+
+        // Allocate blocks of different sizes and free some of them in random order
+        void* a = allocator.alloc(256).value();
+        void* b = allocator.alloc(64).value();
+        void* c = allocator.alloc(128).value();
+        void* d = allocator.alloc(512).value();
+        allocator.free(a);
+        allocator.free(c);
+        print_free_blocks(allocator);
+
+        // A small request goes to the first hole (first fit) or the tightest one (best fit)
+        void* e = allocator.alloc(100).value();
+        fmt::print("  100 byte block placed at offset {}\n", static_cast<unsigned char*>(e) - allocator.buf);
+
+        // Freeing b merges it with its free neighbours
+        allocator.free(b);
+        print_free_blocks(allocator);
+
+        // d is followed by free space, so it grows in place
+        auto grown = allocator.resize(d, 512, 1024);
+        fmt::print("  Grown in place: {}\n", grown && grown.value() == d);
+
+        allocator.free(e);
+        allocator.free(grown.value());
+        fmt::print("  Used after freeing everything: {} bytes\n", allocator.used);
+        print_free_blocks(allocator);
+    }
+
+    return 0;
+}
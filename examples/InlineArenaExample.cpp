@@ -0,0 +1,106 @@
+#include "memory/DynArray.hpp"
+#include "memory/FixedDynArray.hpp"
+#include "memory/InlineArena.hpp"
+#include <cstdint>
+#include <fmt/core.h>
+#include <string>
+
+/**
+ * @brief Example per-frame header placed at the start of a scratch buffer
+ */
+struct FrameHeader {
+    uint32_t frame;
+    uint32_t visible;
+    double time;
+};
+
+/**
+ * @brief Example edge appended to the scratch buffer at runtime
+ */
+struct Edge {
+    uint32_t from;
+    uint32_t to;
+};
+
+/**
+ * @brief Offsets where carve places a header, 256 indices and 256 weights
+ */
+constexpr auto FRAME_LAYOUT = memory::detail::inline_layout<FrameHeader, uint32_t[256], float[256]>();
+
+// align_forward is constexpr, so the layout is known while compiling
+static_assert(memory::LinearAllocator::align_forward(13, 8).value() == 16);
+static_assert(FRAME_LAYOUT[1] == sizeof(FrameHeader));
+static_assert(memory::InlineArena<4096>::fits<FrameHeader, uint32_t[256], float[256]>);
+static_assert(!memory::InlineArena<1024>::fits<FrameHeader, uint32_t[256], float[256]>);
+
+int main() {
+    // Example 1: Carve a stack buffer with a compile-time layout
+    {
+        fmt::print("=== Example 1: Compile-time carved scratch ===\n");
+
+        memory::InlineArena<4096> scratch;
+        for (uint32_t frame = 0; frame < 3; ++frame) {
+            // Resets the arena; every pointer is the buffer address plus a constant
+            auto [header, indices, weights] = scratch.carve<FrameHeader, uint32_t[256], float[256]>();
+            header->frame = frame;
+            for (uint32_t i = 0; i < 256; i += 2) {
+                indices[header->visible] = i;
+                weights[header->visible] = 1.0f / static_cast<float>(i + 1);
+                ++header->visible;
+            }
+            fmt::print("Frame {}: {} visible, {} of {} bytes used\n", header->frame, header->visible,
+                       scratch.get_used(), scratch.CAPACITY);
+        }
+        fmt::print("Layout offsets: header {}, indices {}, weights {}, end {}\n", FRAME_LAYOUT[0], FRAME_LAYOUT[1],
+                   FRAME_LAYOUT[2], FRAME_LAYOUT[3]);
+    }
+
+    // Example 2: The rest of the buffer through the allocator interface
+    {
+        fmt::print("\n=== Example 2: Containers on an inline buffer ===\n");
+
+        memory::InlineArena<4096> scratch;
+        auto [header] = scratch.carve<FrameHeader>();
+        header->frame = 7;
+
+        // Sizes only known at runtime go through the usual checked path
+        memory::DynArray<Edge, memory::InlineArena<4096>*> edges(&scratch);
+        uint32_t added = 0;
+        for (uint32_t i = 0; i < 1000; ++i) {
+            if (!edges.push_back(Edge{i, i + 1})) {
+                break;
+            }
+            ++added;
+        }
+        fmt::print("Frame {}: growth stopped at {} edges, {} of {} bytes used\n", header->frame, added,
+                   scratch.get_used(), scratch.CAPACITY);
+    }
+
+    // Example 3: A fixed-capacity array without an allocator
+    {
+        fmt::print("\n=== Example 3: FixedDynArray ===\n");
+
+        memory::FixedDynArray<std::string, 4> names{"alpha", "beta"};
+        names.push_back("gamma");
+        names.insert(0, "omega");
+        auto overflow = names.push_back("delta");
+        fmt::print("Size {} of {}, fifth push_back {}\n", names.get_size(), names.get_capacity(),
+                   overflow ? "succeeded" : "failed with OutOfMemory");
+        for (const auto& name : names) {
+            fmt::print("  {}\n", name);
+        }
+
+        // The loop bound proves the array never overflows, so the check can go
+        constexpr uint32_t seeds[] = {2, 3, 5, 7, 11, 13, 17, 19};
+        memory::FixedDynArray<uint32_t, 64> squares;
+        for (uint32_t seed : seeds) {
+            squares.push_back_unchecked(seed * seed);
+        }
+        memory::FixedDynArray<uint32_t, 8> copy(seeds);
+        fmt::print("{} squares, last {}, sum {}; {} seeds copied from a built-in array\n", squares.get_size(),
+                   squares.back().value().get(), squares.sum(), copy.get_size());
+        fmt::print("sizeof(FixedDynArray<uint32_t, 64>) = {} bytes, no heap\n", sizeof(squares));
+    }
+
+    return 0;
+}
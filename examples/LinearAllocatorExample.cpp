@@ -85,8 +85,8 @@ int main() {
             fmt::print("\nTemporary arena memory scope:\n");
             auto temp = memory::TempArenaMemory::begin(&allocator);
 
-            // Allocate within the temporary scope
-            auto temp_data_result = allocator.alloc(100);
+            // Allocate within the temporary scope (scratch memory is not zeroed)
+            auto temp_data_result = temp.alloc(100);
             if (temp_data_result) {
                 fmt::print("  Allocated 100 bytes of temporary memory\n");
 
@@ -98,6 +98,14 @@ int main() {
             fmt::print("  Temporary scope ended, memory restored to previous state\n");
         }
 
+        // Usage statistics (all zero unless built with MEMORY_ENABLE_STATS)
+        memory::AllocatorStats stats = allocator.stats();
+        fmt::print("\nStatistics (enabled: {}):\n", memory::STATS_ENABLED);
+        fmt::print("  {} allocations, {} bytes, {} bytes of padding\n",
+                  stats.allocations, stats.bytes_allocated, stats.padding_bytes);
+        fmt::print("  {} resizes in place, {} moved, peak usage {} of {} bytes\n",
+                  stats.resizes_in_place, stats.resizes_moved, stats.peak_bytes_in_use, BUFFER_SIZE);
+
         // Free all memory
         allocator.free_all();
         fmt::print("All memory freed\n");
@@ -139,5 +147,34 @@ int main() {
         // Dynamic buffer will be freed when it goes out of scope
     }
 
+    // Example 3: Reserving a large address range and committing lazily
+    {
+        fmt::print("\n=== Example 3: Reserved virtual memory ===\n");
+
+        // Reserve 64 GiB of address space, keep at most 4 MiB committed across resets
+        memory::ReserveOptions options;
+        options.retain_committed = 4 * 1024 * 1024;
+        auto reserved = memory::LinearAllocator::create_reserved(64ull * 1024 * 1024 * 1024, options);
+        if (!reserved) {
+            fmt::print("Failed to reserve address space: {}\n", static_cast<int>(reserved.error()));
+            return 0;
+        }
+        auto allocator = reserved.value();
+        fmt::print("Reserved {} GiB, committed {} bytes\n", allocator.buf_len >> 30, allocator.committed);
+
+        // Grow one allocation in place far beyond a fixed buffer
+        auto block = allocator.alloc(1024);
+        void* data = block.value();
+        auto grown = allocator.resize(data, 1024, 64 * 1024 * 1024);
+        fmt::print("Grown to 64 MiB in place: {}, committed {} MiB\n",
+                  grown && grown.value() == data, allocator.committed >> 20);
+
+        // Resetting hands memory above the retained mark back to the OS
+        allocator.free_all();
+        fmt::print("After free_all committed {} MiB\n", allocator.committed >> 20);
+
+        allocator.destroy();
+    }
+
     return 0;
 }
@@ -0,0 +1,111 @@
+#include "memory/NumaLocal.hpp"
+#include "memory/ThreadCachedPool.hpp"
+#include "memory/VirtualMemory.hpp"
+#include <atomic>
+#include <fmt/core.h>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Example work item handed between worker threads
+ */
+struct Task {
+    int worker;
+    int sequence;
+    char payload[56];
+};
+
+int main() {
+    fmt::print("NUMA nodes: {}, main thread on node {}\n", memory::VirtualMemory::numa_node_count(),
+               memory::thread_numa_node());
+
+    // Example 1: Interleaving one shared arena over every node
+    {
+        fmt::print("\n=== Example 1: Interleaved arena ===\n");
+
+        // Data every socket reads equally (a lookup table, a shared index) is spread
+        // page by page, so no single node's memory controller serves all the traffic
+        memory::ReserveOptions options;
+        options.numa.policy = memory::NumaPolicy::Interleave;
+        auto reserved = memory::LinearAllocator::create_reserved(256 * 1024 * 1024, options);
+        if (!reserved) {
+            fmt::print("Failed to reserve address space: {}\n", static_cast<int>(reserved.error()));
+            return 1;
+        }
+        auto arena = reserved.value();
+
+        auto table = arena.alloc(16 * 1024 * 1024);
+        if (!table) {
+            fmt::print("Failed to allocate the table: {}\n", static_cast<int>(table.error()));
+            return 1;
+        }
+        fmt::print("Allocated a 16 MiB table from the interleaved arena, {} MiB committed\n", arena.committed >> 20);
+        arena.destroy();
+    }
+
+    // Example 2: A thread-cached pool per node
+    {
+        fmt::print("\n=== Example 2: Node-local pools ===\n");
+
+        auto created = memory::NumaLocal<memory::ThreadCachedPool>::create(
+            64 * 1024 * 1024, [](memory::LinearAllocator* arena, size_t) {
+                return memory::ThreadCachedPool::create(arena, 32 * 1024 * 1024, sizeof(Task), alignof(Task));
+            });
+        if (!created) {
+            fmt::print("Failed to create pools: {}\n", static_cast<int>(created.error()));
+            return 1;
+        }
+        auto& pools = created.value();
+        fmt::print("One pool on each of {} nodes\n", pools.node_count());
+
+        // Each worker allocates from its own node's pool and hands every task to the
+        // next worker, which frees it; free() routes it back to the owning node
+        constexpr int THREADS = 4;
+        constexpr int ROUNDS = 20000;
+        std::vector<std::atomic<Task*>> mailboxes(THREADS);
+        std::atomic<int> local_tasks{0};
+        std::atomic<int> failures{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&, t] {
+                for (int round = 0; round < ROUNDS; ++round) {
+                    auto memory = pools.local().alloc_align(sizeof(Task), alignof(Task));
+                    if (!memory) {
+                        ++failures;
+                        continue;
+                    }
+                    Task* task = static_cast<Task*>(memory.value());
+                    task->worker = t;
+                    task->sequence = round;
+                    if (pools.node_of(task) == memory::thread_numa_node()) {
+                        ++local_tasks;
+                    }
+
+                    if (Task* previous = mailboxes[(t + 1) % THREADS].exchange(task)) {
+                        if (!pools.free(previous)) {
+                            ++failures;
+                        }
+                    }
+                }
+                pools.local().release_thread_cache();
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        for (auto& mailbox : mailboxes) {
+            if (Task* task = mailbox.exchange(nullptr)) {
+                pools.free(task);
+            }
+        }
+
+        fmt::print("{} of {} tasks came from the allocating thread's node, {} failures\n", local_tasks.load(),
+                   THREADS * ROUNDS, failures.load());
+        for (size_t node = 0; node < pools.node_count(); ++node) {
+            fmt::print("Node {}: {} spans carved\n", node, pools.on_node(node).spans_in_use());
+        }
+        pools.destroy();
+    }
+
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "memory/DynArray.hpp"
+#include "memory/PersistentArena.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <string>
+#include <string_view>
+
+namespace {
+
+// Everything reachable from the root links through OffsetPtr, never through raw
+// pointers, so the table reads back at whatever address the file is mapped
+struct City {
+    memory::OffsetPtr<const char> name;
+    uint32_t population;
+    float latitude;
+};
+
+struct Atlas {
+    uint32_t generation;
+    memory::OffsetPtr<memory::PersistentArray<City>> cities;
+};
+
+} // namespace
+
+// Both only link through OffsetPtr, so they may be stored in the file
+template <>
+struct memory::is_persistable<City> : std::true_type {};
+
+template <>
+struct memory::is_persistable<Atlas> : std::true_type {};
+
+namespace {
+
+// Copy a NUL-terminated string into the arena
+const char* store_name(memory::PersistentArena& file, std::string_view name) {
+    auto memory = file.arena.alloc_align_uninit(name.size() + 1, 1);
+    if (!memory) {
+        return nullptr;
+    }
+    char* chars = static_cast<char*>(memory.value());
+    std::memcpy(chars, name.data(), name.size());
+    chars[name.size()] = '\0';
+    return chars;
+}
+
+void print_atlas(const Atlas& atlas) {
+    fmt::print("Generation {}, {} cities:\n", atlas.generation, atlas.cities->get_size());
+    for (const City& city : *atlas.cities) {
+        fmt::print("  {:<10} population {:>8}, latitude {:.2f}\n", city.name.get(), city.population, city.latitude);
+    }
+}
+
+} // namespace
+
+int main() {
+    const std::string path = (std::filesystem::temp_directory_path() / "persistent_arena_example.arena").string();
+
+    // Example 1: Build a table in a file-backed arena
+    {
+        fmt::print("=== Example 1: Building the file ===\n");
+
+        auto created = memory::PersistentArena::create(path.c_str(), 1 << 20);
+        if (!created) {
+            fmt::print("Could not create {}\n", path);
+            return 1;
+        }
+        memory::PersistentArena& file = created.value();
+
+        // Stage the rows in an ordinary DynArray, then copy them into the file in one go
+        memory::DynArray<City> rows;
+        const char* names[] = {"Lisbon", "Oslo", "Quito", "Nairobi"};
+        const uint32_t populations[] = {545000, 709000, 2011000, 4397000};
+        const float latitudes[] = {38.72f, 59.91f, -0.18f, -1.29f};
+        for (size_t i = 0; i < 4; ++i) {
+            City& city = rows.emplace_back().value().get();
+            city.name = store_name(file, names[i]);
+            city.population = populations[i];
+            city.latitude = latitudes[i];
+        }
+
+        auto* atlas = file.make<Atlas>().value();
+        atlas->generation = 1;
+        atlas->cities = file.store_array(rows).value();
+        file.set_root(atlas);
+
+        fmt::print("Wrote {} bytes of data to {}\n", file.arena.curr_offset, path);
+        fmt::print("Synced to disk: {}\n", file.sync().has_value());
+        file.close();
+    }
+
+    // Example 2: Map it again read-only, as a restarted process or a worker would
+    {
+        fmt::print("\n=== Example 2: Reading it back ===\n");
+
+        // Pages come in from the page cache as they are touched; read-only openers in
+        // other processes share the same copy
+        auto opened = memory::PersistentArena::open(path.c_str(), memory::PersistentMode::ReadOnly);
+        if (!opened) {
+            fmt::print("Could not open {}\n", path);
+            return 1;
+        }
+        memory::PersistentArena& file = opened.value();
+
+        print_atlas(*file.root<Atlas>());
+        fmt::print("Out-of-range lookup fails: {}\n", !file.root<Atlas>()->cities->at(10).has_value());
+        fmt::print("Allocating from a read-only arena fails: {}\n", !file.make<uint64_t>(0).has_value());
+        fmt::print("Setting the root of a read-only arena fails: {}\n", !file.set_root(nullptr).has_value());
+        file.close();
+    }
+
+    // Example 3: Reopen for writing and publish a new generation
+    {
+        fmt::print("\n=== Example 3: Appending a generation ===\n");
+
+        auto opened = memory::PersistentArena::open(path.c_str(), memory::PersistentMode::ReadWrite);
+        memory::PersistentArena& file = opened.value();
+        size_t resumed_at = file.arena.curr_offset;
+
+        // The old generation stays in place; the new one is built after it and the root
+        // is switched last, so a reader sees either table, never a half-written one
+        const Atlas& previous = *file.root<Atlas>();
+        memory::DynArray<City> rows;
+        rows.append_range(previous.cities->span());
+        City& added = rows.emplace_back().value().get();
+        added.name = store_name(file, "Hobart");
+        added.population = 251000;
+        added.latitude = -42.88f;
+
+        auto* atlas = file.make<Atlas>().value();
+        atlas->generation = previous.generation + 1;
+        atlas->cities = file.store_array(rows).value();
+        file.set_root(atlas);
+
+        fmt::print("Resumed at offset {}, now at {}\n", resumed_at, file.arena.curr_offset);
+        file.sync();
+        file.close();
+
+        auto reread = memory::PersistentArena::open(path.c_str(), memory::PersistentMode::ReadOnly);
+        print_atlas(*reread.value().root<Atlas>());
+        reread.value().close();
+    }
+
+    // Example 4: Files that are not arenas are rejected
+    {
+        fmt::print("\n=== Example 4: Validation ===\n");
+
+        std::FILE* junk = std::fopen(path.c_str(), "wb");
+        std::fputs("not an arena", junk);
+        std::fclose(junk);
+
+        auto opened = memory::PersistentArena::open(path.c_str(), memory::PersistentMode::ReadOnly);
+        fmt::print("Opening a text file reports InvalidFormat: {}\n",
+                   !opened && opened.error() == memory::PersistentArenaError::InvalidFormat);
+    }
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "memory/PoolAllocator.hpp"
+#include <fmt/core.h>
+
+/**
+ * @brief Example object with churn (allocated and freed in any order)
+ */
+struct Connection {
+    int id;
+    unsigned int bytes_in;
+    unsigned int bytes_out;
+};
+
+int main() {
+    // Example 1: Pool over a fixed array
+    {
+        fmt::print("\n=== Example 1: Pool over a fixed buffer ===\n");
+
+        alignas(16) unsigned char backing_buffer[1024];
+        auto pool_result = memory::PoolAllocator::create(backing_buffer, sizeof(backing_buffer),
+                                                         sizeof(Connection), alignof(Connection));
+        if (!pool_result) {
+            fmt::print("Failed to create pool: {}\n", static_cast<int>(pool_result.error()));
+            return 1;
+        }
+        auto pool = pool_result.value();
+        fmt::print("Chunk size: {} bytes, chunks: {}\n", pool.chunk_size, pool.chunk_count());
+
+        // Allocate a few connections
+        Connection* connections[4];
+        for (int i = 0; i < 4; ++i) {
+            connections[i] = static_cast<Connection*>(pool.alloc().value());
+            connections[i]->id = i;
+        }
+
+        // Free out of order; the most recently freed chunk is handed out first
+        pool.free(connections[1]);
+        pool.free(connections[2]);
+        auto* reused = static_cast<Connection*>(pool.alloc().value());
+        fmt::print("Reused chunk is the last one freed: {}\n", static_cast<void*>(reused) == connections[2]);
+
+        // Freeing a pointer that is not ours is reported
+        int not_ours = 0;
+        auto bad_free = pool.free(&not_ours);
+        fmt::print("Freeing a foreign pointer fails: {}\n", !bad_free.has_value());
+
+        // Requests larger than a chunk fail
+        auto too_big = pool.alloc_align(pool.chunk_size + 1, alignof(Connection));
+        fmt::print("Oversized request fails: {}\n", !too_big.has_value());
+
+        pool.free_all();
+        fmt::print("All chunks returned to the pool\n");
+    }
+
+    // Example 2: Pool carved out of a linear allocator
+    {
+        fmt::print("\n=== Example 2: Pool carved out of an arena ===\n");
+
+        constexpr size_t BUFFER_SIZE = 4096;
+        unsigned char backing_buffer[BUFFER_SIZE];
+        auto arena = memory::LinearAllocator::create(backing_buffer, BUFFER_SIZE);
+
+        auto pool_result = memory::PoolAllocator::create(&arena, 32, 64, 64);
+        if (!pool_result) {
+            fmt::print("Failed to create pool: {}\n", static_cast<int>(pool_result.error()));
+            return 1;
+        }
+        auto pool = pool_result.value();
+        fmt::print("Pool of {} x {} byte chunks, arena used: {} bytes\n",
+                  pool.chunk_count(), pool.chunk_size, arena.curr_offset);
+    }
+
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "memory/DynArray.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/ScopedArena.hpp"
+#include <cstring>
+#include <fmt/core.h>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Build the words of a sentence in out, using scratch memory for the work
+ *
+ * The result lives in the caller's arena, so the scratch arena must not be that one.
+ */
+const char** split_words(memory::LinearAllocator* out, const char* text, size_t* count) {
+    auto scratch = memory::get_scratch(out).value();
+
+    // Stage word offsets in a scratch array that grows as needed
+    memory::DynArray<size_t, memory::ScopedArena*> starts(&scratch);
+    size_t length = std::strlen(text);
+    for (size_t i = 0; i < length; ++i) {
+        if (text[i] != ' ' && (i == 0 || text[i - 1] == ' ')) {
+            starts.push_back(i);
+        }
+    }
+
+    *count = starts.get_size();
+    auto* words = static_cast<const char**>(out->alloc_align(*count * sizeof(const char*), alignof(const char*)).value());
+    for (size_t w = 0; w < *count; ++w) {
+        size_t begin = starts[w];
+        size_t end = begin;
+        while (end < length && text[end] != ' ') {
+            ++end;
+        }
+        char* word = static_cast<char*>(out->alloc(end - begin + 1).value());
+        std::memcpy(word, text + begin, end - begin);
+        words[w] = word;
+    }
+    return words;
+} // scratch is rolled back here, the words stay in out
+
+/**
+ * @brief Throw halfway through filling a scope
+ */
+void fail_after_allocating(memory::LinearAllocator* arena) {
+    memory::ScopedArena scope(arena);
+    scope.alloc(512).value();
+    throw std::runtime_error("parse error");
+}
+
+} // namespace
+
+int main() {
+    alignas(16) unsigned char backing_buffer[4096];
+    auto arena = memory::LinearAllocator::create(backing_buffer, sizeof(backing_buffer));
+
+    // Example 1: The scope ends itself, even on early exit or exceptions
+    {
+        fmt::print("\n=== Example 1: RAII scopes ===\n");
+
+        arena.alloc(64).value();
+        fmt::print("Offset before the scopes: {}\n", arena.curr_offset);
+        {
+            memory::ScopedArena scope(&arena);
+            scope.alloc(1024).value();
+            {
+                memory::ScopedArena nested(&arena);
+                nested.alloc(256).value();
+                fmt::print("Offset inside the nested scope: {}\n", arena.curr_offset);
+            }
+            fmt::print("Offset after the nested scope: {}\n", arena.curr_offset);
+        }
+        fmt::print("Offset after the outer scope: {}\n", arena.curr_offset);
+
+        try {
+            fail_after_allocating(&arena);
+        } catch (const std::exception& e) {
+            fmt::print("Caught '{}', offset is back at {}\n", e.what(), arena.curr_offset);
+        }
+    }
+
+    // Example 2: Per-thread scratch arenas that never clobber the caller's arena
+    {
+        fmt::print("\n=== Example 2: Scratch arenas ===\n");
+
+        size_t count = 0;
+        const char** words = split_words(&arena, "scratch memory is bump and rollback", &count);
+        for (size_t i = 0; i < count; ++i) {
+            fmt::print("Word {}: {}\n", i, words[i]);
+        }
+
+        // A function handed a scratch arena as its output gets the other one for temporaries
+        auto outer = memory::get_scratch().value();
+        auto inner = memory::get_scratch(&outer).value();
+        fmt::print("Scratch arenas are distinct: {}\n", outer.arena() != inner.arena());
+
+        // Asking while every scratch arena conflicts fails
+        auto none = memory::get_scratch(outer.arena(), inner.arena());
+        fmt::print("No scratch arena left with both in use: {}\n", !none.has_value());
+    }
+
+    arena.free_all();
+    return 0;
+}
@@ -0,0 +1,93 @@
+#include "memory/DynArray.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/SimdKernels.hpp"
+#include <chrono>
+#include <cstdint>
+#include <fmt/core.h>
+#include <span>
+#include <vector>
+
+int main() {
+    fmt::print("Detected instruction set: {}\n", memory::simd::level_name(memory::simd::detect_level()));
+
+    // Example 1: Column statistics through the DynArray members
+    {
+        fmt::print("\n=== Example 1: Bulk operations on a DynArray ===\n");
+
+        memory::DynArray<int32_t> latencies;
+        latencies.resize(2'000'000, 0);
+        for (size_t i = 0; i < latencies.get_size(); ++i) {
+            latencies[i] = static_cast<int32_t>((i * 2654435761u) % 1000);
+        }
+
+        fmt::print("Elements: {}\n", latencies.get_size());
+        fmt::print("Sum: {} (summed in 64 bits)\n", latencies.sum());
+        fmt::print("Min: {}, max: {}\n", latencies.min().value(), latencies.max().value());
+        fmt::print("Samples at 999: {}, first at index {}\n", latencies.count(999), latencies.find(999));
+        fmt::print("Contains 1000: {}\n", latencies.contains(1000));
+
+        // Plain arithmetic in the lambda is compiled for the active instruction set
+        latencies.transform([](int32_t x) { return x * 2 + 1; });
+        fmt::print("After x * 2 + 1: min {}, max {}\n", latencies.min().value(), latencies.max().value());
+
+        latencies.fill(7);
+        fmt::print("After fill(7): count of 7 is {}\n", latencies.count(7));
+
+        memory::DynArray<int32_t> empty;
+        fmt::print("min() of an empty array fails: {}\n", !empty.min().has_value());
+    }
+
+    // Example 2: The kernels on raw spans over arena memory
+    {
+        fmt::print("\n=== Example 2: Spans over an arena ===\n");
+
+        std::vector<unsigned char> backing(1 << 20);
+        auto arena = memory::LinearAllocator::create(backing.data(), backing.size());
+
+        // Nothing needs to be aligned, but a cache-line aligned block keeps vectors
+        // from straddling lines
+        const size_t count = 100'000;
+        auto block = arena.alloc_align(count * sizeof(double), 64);
+        std::span<double> prices(static_cast<double*>(block.value()), count);
+
+        memory::simd::fill(prices, 1.25);
+        memory::simd::transform(std::span<const double>(prices), prices, [](double p) { return p * 1.1; });
+        fmt::print("Sum of {} prices: {:.2f}, max {:.4f}\n", count,
+                   memory::simd::sum(std::span<const double>(prices)),
+                   memory::simd::max(std::span<const double>(prices)));
+    }
+
+    // Example 3: Every supported instruction set returns the same answers
+    {
+        fmt::print("\n=== Example 3: Comparing instruction sets ===\n");
+
+        // Halves summed in doubles stay exact; float sums would differ in the last bits
+        // between levels, since each one adds in its own lane order
+        std::vector<double> values(4'000'000);
+        for (size_t i = 0; i < values.size(); ++i) {
+            values[i] = static_cast<double>(i % 1024) * 0.5;
+        }
+        std::span<const double> view(values);
+
+        const memory::simd::SimdLevel original = memory::simd::active_level();
+        for (auto level : {memory::simd::SimdLevel::Scalar, memory::simd::SimdLevel::SSE42,
+                           memory::simd::SimdLevel::AVX2, memory::simd::SimdLevel::AVX512,
+                           memory::simd::SimdLevel::NEON}) {
+            if (!memory::simd::set_level(level)) {
+                continue; // Not available on this CPU
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            double total = memory::simd::sum(view);
+            size_t zeros = memory::simd::count(view, 0.0);
+            double largest = memory::simd::max(view);
+            auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+
+            fmt::print("{:>7}: sum {:.0f}, zeros {}, max {:.1f} in {:.0f} us\n", memory::simd::level_name(level),
+                       total, zeros, largest, elapsed.count());
+        }
+        memory::simd::set_level(original);
+    }
+
+    return 0;
+}
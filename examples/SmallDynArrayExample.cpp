@@ -0,0 +1,57 @@
+#include "memory/SmallDynArray.hpp"
+#include "memory/LinearAllocator.hpp"
+#include <fmt/core.h>
+#include <string>
+
+int main() {
+    // Example 1: Small arrays never touch the allocator
+    {
+        fmt::print("\n=== Example 1: Inline storage ===\n");
+
+        constexpr size_t BUFFER_SIZE = 4096;
+        unsigned char backing_buffer[BUFFER_SIZE];
+        auto arena = memory::LinearAllocator::create(backing_buffer, BUFFER_SIZE);
+
+        memory::SmallDynArray<int, 8, memory::LinearAllocator*> numbers(&arena);
+        for (int i = 0; i < 8; ++i) {
+            numbers.push_back(i);
+        }
+        fmt::print("8 elements inline: {}, arena used: {} bytes\n", numbers.is_inline(), arena.curr_offset);
+
+        // The ninth element spills to the arena
+        numbers.push_back(8);
+        fmt::print("After 9 elements inline: {}, capacity: {}, arena used: {} bytes\n",
+                  numbers.is_inline(), numbers.get_capacity(), arena.curr_offset);
+
+        // Shrinking below N moves the elements back inline
+        numbers.resize(4);
+        numbers.shrink_to_fit();
+        fmt::print("After shrink_to_fit with 4 elements inline: {}\n", numbers.is_inline());
+    }
+
+    // Example 2: Same API as DynArray, with non-trivial elements
+    {
+        fmt::print("\n=== Example 2: Strings on the default heap allocator ===\n");
+
+        memory::SmallDynArray<std::string, 4> words = {"alpha", "beta", "gamma"};
+        words.insert(1, "inserted");
+        words.push_back("spilled to the heap once there are five");
+        words.erase(0);
+
+        fmt::print("Words ({}, inline: {}):", words.get_size(), words.is_inline());
+        for (const auto& word : words) {
+            fmt::print(" [{}]", word);
+        }
+        fmt::print("\n");
+
+        // Moving an inline array moves the elements, moving a spilled one steals the block
+        memory::SmallDynArray<std::string, 4> moved(std::move(words));
+        fmt::print("Moved array has {} words, source has {}\n", moved.get_size(), words.get_size());
+
+        memory::SmallDynArray<std::string, 4> empty;
+        fmt::print("sizeof(SmallDynArray<std::string, 4>): {} bytes, empty and inline: {}\n",
+                  sizeof(empty), empty.is_inline());
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+#include "memory/SoaArray.hpp"
+#include "memory/LinearAllocator.hpp"
+#include <cstdint>
+#include <fmt/core.h>
+#include <string>
+
+int main() {
+    // Example 1: Columns in one arena block
+    {
+        fmt::print("\n=== Example 1: Particles as columns ===\n");
+
+        alignas(64) unsigned char backing_buffer[16384];
+        auto arena = memory::LinearAllocator::create(backing_buffer, sizeof(backing_buffer));
+
+        // x, y and an id in three columns of one block
+        memory::BasicSoaArray<memory::LinearAllocator*, float, float, uint32_t> particles(&arena);
+        for (uint32_t i = 0; i < 100; ++i) {
+            particles.push_back({static_cast<float>(i), static_cast<float>(i) * 0.5f, i});
+        }
+        // The block was the top of the arena every time, so it grew in place
+        fmt::print("{} particles, capacity {}, arena used: {} bytes\n", particles.get_size(),
+                   particles.get_capacity(), arena.curr_offset);
+
+        // Each column starts on its own cache line
+        const float* xs = particles.column<0>().data();
+        const uint32_t* ids = particles.column<2>().data();
+        fmt::print("Columns are cache-line aligned: {}\n",
+                   reinterpret_cast<uintptr_t>(xs) % memory::SOA_COLUMN_ALIGNMENT == 0 &&
+                       reinterpret_cast<uintptr_t>(ids) % memory::SOA_COLUMN_ALIGNMENT == 0);
+
+        // A scan of one field reads nothing but that field
+        for (float& x : particles.column<0>()) {
+            x += 1.0f;
+        }
+        float sum = 0.0f;
+        for (float x : particles.column<0>()) {
+            sum += x;
+        }
+        fmt::print("Sum of x after the update: {}\n", sum);
+
+        // Whole elements through proxy references
+        for (auto [x, y, id] : particles) {
+            if (id % 40 == 20) {
+                y = -y;
+                fmt::print("Particle {}: ({}, {})\n", id, x, y);
+            }
+        }
+        auto [x, y, id] = particles[60];
+        fmt::print("particles[60].y after writing through the proxy: {}\n", y);
+    }
+
+    // Example 2: Non-trivial columns on the default heap allocator
+    {
+        fmt::print("\n=== Example 2: Names and scores ===\n");
+
+        memory::SoaArray<std::string, int> scores;
+        scores.emplace_back("ada", 92);
+        scores.emplace_back("grace", 87);
+        scores.push_back({"linus", 75});
+        for (int i = 0; i < 20; ++i) {
+            scores.emplace_back(fmt::format("player {}", i), i);
+        }
+        scores.pop_back();
+
+        int best = 0;
+        for (int score : scores.column<1>()) {
+            best = score > best ? score : best;
+        }
+        fmt::print("{} entries, best score {}\n", scores.get_size(), best);
+
+        auto first = scores.at(0);
+        if (first) {
+            fmt::print("First entry: {} with {}\n", std::get<0>(first.value()), std::get<1>(first.value()));
+        }
+        auto missing = scores.at(100);
+        fmt::print("at(100) is out of range: {}\n", !missing.has_value());
+
+        // Copies allocate a block of their own
+        memory::SoaArray<std::string, int> copy = scores;
+        std::get<0>(copy[0]) = "changed";
+        fmt::print("Copy: {}, original: {}\n", std::get<0>(copy[0]), std::get<0>(scores[0]));
+    }
+
+    return 0;
+}
@@ -0,0 +1,36 @@
+#include "memory/StackAllocator.hpp"
+#include <fmt/core.h>
+
+int main() {
+    fmt::print("\n=== Stack Allocator ===\n");
+
+    constexpr size_t BUFFER_SIZE = 1024;
+    alignas(16) unsigned char backing_buffer[BUFFER_SIZE];
+    auto stack = memory::StackAllocator::create(backing_buffer, BUFFER_SIZE);
+
+    // Push three allocations
+    void* a = stack.alloc(64).value();
+    void* b = stack.alloc(128).value();
+    void* c = stack.alloc(32).value();
+    fmt::print("Offset after three allocations: {}\n", stack.curr_offset);
+
+    // Grow the top allocation in place
+    auto grown = stack.resize(c, 32, 96);
+    fmt::print("Top grown in place: {}, offset: {}\n", grown && grown.value() == c, stack.curr_offset);
+
+    // Out-of-order frees are rejected in debug builds
+    auto bad_free = stack.free(a);
+    if (!bad_free) {
+        fmt::print("Freeing a non-top allocation: error {}\n", static_cast<int>(bad_free.error()));
+    }
+
+    // Free in LIFO order
+    stack.free(c);
+    fmt::print("Offset after freeing top: {}\n", stack.curr_offset);
+    stack.free(b);
+    fmt::print("Offset after freeing next: {}\n", stack.curr_offset);
+    stack.free(a);
+    fmt::print("Offset after freeing all: {}\n", stack.curr_offset);
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "memory/ThreadCachedPool.hpp"
+#include <fmt/core.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Example message passed between worker threads
+ */
+struct Message {
+    int producer;
+    int sequence;
+    char payload[48];
+};
+
+int main() {
+    // Example 1: Workers allocating and freeing from their own caches
+    {
+        fmt::print("\n=== Example 1: Per-thread caches ===\n");
+
+        constexpr size_t BUFFER_SIZE = 4 * 1024 * 1024;
+        std::vector<unsigned char> backing_buffer(BUFFER_SIZE);
+        auto pool_result = memory::ThreadCachedPool::create(backing_buffer.data(), backing_buffer.size(),
+                                                            sizeof(Message), alignof(Message));
+        if (!pool_result) {
+            fmt::print("Failed to create pool: {}\n", static_cast<int>(pool_result.error()));
+            return 1;
+        }
+        auto pool = pool_result.value();
+        fmt::print("Chunk size: {} bytes, {} chunks per span, {} spans\n",
+                  pool.chunk_size, pool.chunks_per_span, pool.span_count);
+
+        constexpr int THREADS = 4;
+        constexpr int ROUNDS = 10000;
+        std::atomic<int> failures{0};
+        std::vector<std::thread> workers;
+        for (int t = 0; t < THREADS; ++t) {
+            workers.emplace_back([&pool, &failures, t] {
+                Message* batch[64];
+                for (int round = 0; round < ROUNDS / 64; ++round) {
+                    for (int i = 0; i < 64; ++i) {
+                        auto result = pool.alloc_uninit();
+                        if (!result) {
+                            failures.fetch_add(1);
+                            return;
+                        }
+                        batch[i] = static_cast<Message*>(result.value());
+                        batch[i]->producer = t;
+                        batch[i]->sequence = i;
+                    }
+                    for (Message* message : batch) {
+                        pool.free(message);
+                    }
+                }
+                pool.release_thread_cache();
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        fmt::print("Failures: {}, spans carved: {}\n", failures.load(), pool.spans_in_use());
+    }
+
+    // Example 2: Producer allocates, consumer frees (remote frees)
+    {
+        fmt::print("\n=== Example 2: Cross-thread frees ===\n");
+
+        constexpr size_t BUFFER_SIZE = 1024 * 1024;
+        std::vector<unsigned char> backing_buffer(BUFFER_SIZE);
+        memory::ThreadCacheOptions options;
+        options.max_threads = 2;
+        options.span_size = 16 * 1024;
+        auto pool = memory::ThreadCachedPool::create(backing_buffer.data(), backing_buffer.size(),
+                                                     sizeof(Message), alignof(Message), options).value();
+
+        constexpr int MESSAGES = 100000;
+        constexpr int QUEUE_SIZE = 256;
+        std::atomic<Message*> queue[QUEUE_SIZE] = {};
+
+        std::thread consumer([&] {
+            for (int i = 0; i < MESSAGES; ++i) {
+                std::atomic<Message*>& slot = queue[i % QUEUE_SIZE];
+                Message* message;
+                while ((message = slot.exchange(nullptr, std::memory_order_acquire)) == nullptr) {
+                    std::this_thread::yield();
+                }
+                // The consumer never allocated, so this is a lock-free remote free
+                pool.free(message);
+            }
+        });
+
+        int failures = 0;
+        for (int i = 0; i < MESSAGES; ++i) {
+            auto result = pool.alloc_uninit();
+            if (!result) {
+                ++failures;
+                break;
+            }
+            Message* message = static_cast<Message*>(result.value());
+            message->producer = 0;
+            message->sequence = i;
+
+            std::atomic<Message*>& slot = queue[i % QUEUE_SIZE];
+            while (slot.load(std::memory_order_relaxed) != nullptr) {
+                std::this_thread::yield();
+            }
+            slot.store(message, std::memory_order_release);
+        }
+        consumer.join();
+
+        // The producer recycled the chunks the consumer freed instead of carving new spans
+        fmt::print("Messages: {}, failures: {}, spans carved: {} of {}\n",
+                  MESSAGES, failures, pool.spans_in_use(), pool.span_count);
+    }
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "memory/VirtualArena.hpp"
+#include <fmt/core.h>
+
+/**
+ * @brief Count the blocks currently chained into an arena
+ */
+size_t count_blocks(const memory::VirtualArena& arena) {
+    size_t count = 0;
+    for (const memory::ArenaBlock* b = arena.block; b != nullptr; b = b->prev) {
+        ++count;
+    }
+    return count;
+}
+
+int main() {
+    // Start with a tiny first block so the chaining is visible
+    auto arena = memory::VirtualArena::create(1024);
+
+    fmt::print("\n=== Growing past the first block ===\n");
+    for (int i = 0; i < 8; ++i) {
+        auto result = arena.alloc(700);
+        if (!result) {
+            fmt::print("Allocation failed: {}\n", static_cast<int>(result.error()));
+            return 1;
+        }
+    }
+    fmt::print("Blocks after 8 x 700 bytes: {}\n", count_blocks(arena));
+
+    fmt::print("\n=== Temporary scope across block boundaries ===\n");
+    {
+        auto temp = memory::TempArenaMemory::begin(&arena);
+        for (int i = 0; i < 16; ++i) {
+            arena.alloc(4096);
+        }
+        fmt::print("Blocks inside scope: {}\n", count_blocks(arena));
+        temp.end();
+        fmt::print("Blocks after end: {}\n", count_blocks(arena));
+    }
+
+    fmt::print("\n=== Reset keeps one block ===\n");
+    arena.free_all();
+    fmt::print("Blocks after free_all: {} (retained spare: {} bytes)\n",
+              count_blocks(arena), arena.spare ? arena.spare->size : 0);
+    arena.alloc(100);
+    fmt::print("Blocks after next allocation: {}\n", count_blocks(arena));
+
+    arena.destroy();
+    return 0;
+}
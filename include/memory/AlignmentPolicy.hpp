@@ -0,0 +1,129 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+
+namespace memory {
+
+/**
+ * @brief Assumed size of a cache line, used to keep per-thread state apart
+ */
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Compile-time rule for the alignment a container asks its allocator for
+ *
+ * alignment gets the natural alignment of the element type and returns the
+ * alignment to pass to alloc_align. The result must be a power of two and at least
+ * the natural alignment.
+ *
+ * @tparam P Policy type
+ */
+template <typename P>
+concept AlignmentPolicy = requires(size_t natural) {
+    { P::alignment(natural) } -> std::same_as<size_t>;
+};
+
+/**
+ * @brief Align the storage like the element type, the default
+ */
+struct NaturalAlignment {
+    /**
+     * @brief Compute the alignment
+     *
+     * @param natural alignof of the element type
+     * @return Alignment to allocate with
+     */
+    static constexpr size_t alignment(size_t natural) {
+        return natural;
+    }
+};
+
+/**
+ * @brief Align the storage to at least Align bytes
+ *
+ * With 64 the first element starts a cache line, so full-width vector loads over
+ * the array never straddle two lines and the block shares no line with other
+ * allocations at its start.
+ *
+ * @tparam Align Minimum alignment in bytes (must be a power of two)
+ */
+template <size_t Align>
+struct FixedAlignment {
+    static_assert(std::has_single_bit(Align), "Alignment has to be a power of two");
+
+    /**
+     * @brief Compute the alignment
+     *
+     * @param natural alignof of the element type
+     * @return Alignment to allocate with, the larger of Align and natural
+     */
+    static constexpr size_t alignment(size_t natural) {
+        return natural > Align ? natural : Align;
+    }
+};
+
+/**
+ * @brief Start the storage on a cache line
+ */
+using CacheLineAlignment = FixedAlignment<CACHE_LINE_SIZE>;
+
+/**
+ * @brief Start the storage on a page, e.g. before handing it to madvise or DMA
+ *
+ * @tparam PageSize Page size in bytes (must be a power of two)
+ */
+template <size_t PageSize = 4096>
+using PageAlignment = FixedAlignment<PageSize>;
+
+/**
+ * @brief Element padded out to its own cache line
+ *
+ * For arrays with one slot per thread or core: every element is aligned to and
+ * padded to a multiple of CACHE_LINE_SIZE, so writes to one slot never invalidate
+ * the line holding its neighbour. Put it in a container with CacheLineAlignment
+ * so the first slot does not share a line with whatever precedes the block:
+ *
+ * @code
+ * DynArray<CacheLinePadded<uint64_t>, HeapAllocator, GeometricGrowth<>, CacheLineAlignment> hits;
+ * hits.resize(thread_count);
+ * ++*hits[thread_index]; // no false sharing between threads
+ * @endcode
+ *
+ * @tparam T Element type
+ */
+template <typename T>
+struct alignas(CACHE_LINE_SIZE) CacheLinePadded {
+    T value; ///< The padded element
+
+    /**
+     * @brief Access the element
+     *
+     * @return Reference to the element
+     */
+    T& operator*() { return value; }
+
+    /**
+     * @brief Access the element
+     *
+     * @return Const reference to the element
+     */
+    const T& operator*() const { return value; }
+
+    /**
+     * @brief Access a member of the element
+     *
+     * @return Pointer to the element
+     */
+    T* operator->() { return &value; }
+
+    /**
+     * @brief Access a member of the element
+     *
+     * @return Const pointer to the element
+     */
+    const T* operator->() const { return &value; }
+};
+
+} // namespace memory
@@ -0,0 +1,368 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <expected>
+#include <vector>
+
+#include "memory/Allocator.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/VirtualArena.hpp"
+
+namespace memory {
+
+/**
+ * @brief Error types for reading and writing allocation traces
+ */
+enum class TraceError {
+    IoError,       ///< Reading from or writing to the trace file failed
+    InvalidFormat  ///< The file is not a trace or was written by an incompatible version
+};
+
+/**
+ * @brief Kind of a traced allocator operation
+ */
+enum class TraceOp : uint8_t {
+    Alloc,      ///< alloc_align or alloc_align_uninit
+    Resize,     ///< resize_align, resize_align_uninit or a successful try_resize_in_place
+    Free,       ///< free
+    FreeAll,    ///< free_all
+    ScopeBegin, ///< TempArenaMemory::begin
+    ScopeEnd    ///< TempArenaMemory::end
+};
+
+/**
+ * @brief One traced operation, written to trace files as is
+ *
+ * Only operations that succeeded are traced. Addresses identify allocations; the
+ * replayer maps them to its own blocks, so they never have to be valid again.
+ */
+struct TraceEvent {
+    uint64_t timestamp_ns; ///< Nanoseconds since the trace buffer was created
+    uint64_t address;      ///< Allocation (the new one for resizes), 0 for free_all and scopes
+    uint64_t old_address;  ///< Allocation before a resize, 0 otherwise
+    uint64_t size;         ///< Requested size (the new size for resizes), 0 for frees
+    uint32_t align;        ///< Requested alignment, 0 where the operation takes none
+    uint16_t allocator;    ///< Id of the traced allocator, see TraceBuffer::register_allocator
+    TraceOp op;            ///< Operation
+    uint8_t reserved;      ///< Padding, always 0
+};
+
+static_assert(sizeof(TraceEvent) == 40, "TraceEvent is part of the trace file format");
+
+/**
+ * @brief Slot of a TraceBuffer ring
+ */
+struct TraceSlot {
+    std::atomic<uint64_t> sequence; ///< Ring position the slot is ready for (written) or expects next (free)
+    TraceEvent event;               ///< Recorded event
+};
+
+/**
+ * @brief Lock-free ring buffer that traced allocators record their operations into
+ *
+ * Any number of threads record at the same time; one thread at a time drains the
+ * buffer, typically to a file with flush. Recording never blocks: when the ring is
+ * full the event is dropped and counted, so size the ring for the rate at which it
+ * is drained.
+ *
+ * The ring lives in a caller-provided buffer, like the allocators' backing buffers.
+ */
+struct TraceBuffer {
+    using Clock = std::chrono::steady_clock;
+
+    TraceSlot* slots;                ///< Ring of slots in the backing buffer
+    size_t mask;                     ///< Number of slots minus one (a power of two minus one)
+    std::atomic<uint64_t> head;      ///< Next position to record at
+    uint64_t tail;                   ///< Next position to drain from
+    std::atomic<uint64_t> dropped;   ///< Events dropped because the ring was full
+    std::atomic<uint32_t> next_id;   ///< Id handed out by the next register_allocator
+    Clock::time_point origin;        ///< Time timestamps are relative to
+
+    /**
+     * @brief Initialize a trace buffer over a backing buffer
+     *
+     * The ring gets the largest power of two of slots that fits.
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @return std::expected<TraceBuffer, AllocatorError> Initialized buffer or error
+     */
+    static std::expected<TraceBuffer, AllocatorError> create(void* backing_buffer, size_t backing_buffer_length);
+
+    /**
+     * @brief Construct over a ring of slots, see create
+     *
+     * @param ring First slot
+     * @param capacity Number of slots (must be a power of two)
+     */
+    TraceBuffer(TraceSlot* ring, size_t capacity);
+
+    /**
+     * @brief Move constructor (not thread-safe, the source must not be in use)
+     *
+     * @param other Buffer to move from
+     */
+    TraceBuffer(TraceBuffer&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator (not thread-safe, neither side may be in use)
+     *
+     * @param other Buffer to move from
+     * @return Reference to this buffer
+     */
+    TraceBuffer& operator=(TraceBuffer&& other) noexcept;
+
+    /**
+     * @brief Hand out the id of a new traced allocator
+     *
+     * @return Id to record the allocator's events under
+     */
+    uint16_t register_allocator();
+
+    /**
+     * @brief Record an event, from any thread
+     *
+     * @param op Operation
+     * @param allocator Id of the allocator
+     * @param address Allocation, nullptr where there is none
+     * @param old_address Allocation before a resize, nullptr otherwise
+     * @param size Requested size
+     * @param align Requested alignment
+     * @return true if the event was recorded, false if the ring was full
+     */
+    bool record(TraceOp op, uint16_t allocator, const void* address, const void* old_address,
+                size_t size, size_t align);
+
+    /**
+     * @brief Take recorded events out of the ring, oldest first (one thread at a time)
+     *
+     * Stops at the first event that is still being written.
+     *
+     * @param out Where to store the events
+     * @param max_events Maximum number of events to take
+     * @return Number of events taken
+     */
+    size_t drain(TraceEvent* out, size_t max_events);
+
+    /**
+     * @brief Drain every recorded event and append it to a trace file
+     *
+     * @param file File opened for binary writing, after write_trace_header
+     * @return std::expected<size_t, TraceError> Number of events written or error
+     */
+    std::expected<size_t, TraceError> flush(std::FILE* file);
+
+    /**
+     * @brief Get the number of slots in the ring
+     *
+     * @return Capacity in events
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Get the number of events dropped because the ring was full
+     *
+     * @return Dropped events
+     */
+    uint64_t dropped_events() const;
+};
+
+/**
+ * @brief Write the header that starts every trace file
+ *
+ * @param file File opened for binary writing
+ * @return std::expected<void, TraceError> Nothing or error
+ */
+std::expected<void, TraceError> write_trace_header(std::FILE* file);
+
+/**
+ * @brief Read a whole trace file
+ *
+ * @param file File opened for binary reading, positioned at the header
+ * @return std::expected<std::vector<TraceEvent>, TraceError> Events in recording order or error
+ */
+std::expected<std::vector<TraceEvent>, TraceError> read_trace(std::FILE* file);
+
+/**
+ * @brief Allocator wrapper that records every operation into a TraceBuffer
+ *
+ * Forwards to the wrapped allocator and records the operations that succeeded,
+ * so it drops in wherever the allocator itself is used (DynArray, ArenaAllocator,
+ * ...). Members the wrapped allocator does not have are not offered either.
+ *
+ * @tparam A Allocator type
+ *
+ * @note The wrapper owns neither the allocator nor the trace buffer, which both have
+ *       to outlive it.
+ */
+template <BasicAllocator A>
+struct TracedAllocator {
+    A* allocator;       ///< Allocator operations are forwarded to
+    TraceBuffer* trace; ///< Buffer operations are recorded into
+    uint16_t id;        ///< Id the operations are recorded under
+
+    /**
+     * @brief Wrap an allocator, registering it with the trace buffer
+     *
+     * @param a Allocator to forward to
+     * @param t Trace buffer to record into
+     * @return TracedAllocator Initialized wrapper
+     */
+    static TracedAllocator create(A* a, TraceBuffer* t) { return TracedAllocator{a, t, t->register_allocator()}; }
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align) {
+        auto result = allocator->alloc_align(size, align);
+        if (result) {
+            trace->record(TraceOp::Alloc, id, result.value(), nullptr, size, align);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align)
+        requires requires(A& a) { a.alloc_align_uninit(size, align); }
+    {
+        auto result = allocator->alloc_align_uninit(size, align);
+        if (result) {
+            trace->record(TraceOp::Alloc, id, result.value(), nullptr, size, align);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size, size_t new_size, size_t align)
+        requires requires(A& a) { a.resize_align(old_memory, old_size, new_size, align); }
+    {
+        auto result = allocator->resize_align(old_memory, old_size, new_size, align);
+        if (result) {
+            trace->record(TraceOp::Resize, id, result.value(), old_memory, new_size, align);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resize an existing allocation without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size, size_t new_size,
+                                                             size_t align)
+        requires requires(A& a) { a.resize_align_uninit(old_memory, old_size, new_size, align); }
+    {
+        auto result = allocator->resize_align_uninit(old_memory, old_size, new_size, align);
+        if (result) {
+            trace->record(TraceOp::Resize, id, result.value(), old_memory, new_size, align);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Try to resize an allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size)
+        requires requires(A& a) { a.try_resize_in_place(old_memory, old_size, new_size); }
+    {
+        bool resized = allocator->try_resize_in_place(old_memory, old_size, new_size);
+        if (resized) {
+            trace->record(TraceOp::Resize, id, old_memory, old_memory, new_size, 0);
+        }
+        return resized;
+    }
+
+    /**
+     * @brief Free an allocation
+     *
+     * @param ptr Pointer to the allocation
+     * @return std::expected<void, AllocatorError> Nothing or error
+     */
+    std::expected<void, AllocatorError> free(void* ptr)
+        requires requires(A& a) { { a.free(ptr) } -> std::same_as<std::expected<void, AllocatorError>>; }
+    {
+        auto result = allocator->free(ptr);
+        if (result && ptr != nullptr) {
+            trace->record(TraceOp::Free, id, ptr, nullptr, 0, 0);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Free all allocations at once
+     */
+    void free_all()
+        requires requires(A& a) { a.free_all(); }
+    {
+        allocator->free_all();
+        trace->record(TraceOp::FreeAll, id, nullptr, nullptr, 0, 0);
+    }
+
+    /**
+     * @brief Begin a temporary memory scope on the wrapped arena
+     *
+     * Allocate through this wrapper while the scope is open so the scratch
+     * allocations are traced too.
+     *
+     * @return TempArenaMemory Temporary memory scope object
+     */
+    TempArenaMemory begin_scope()
+        requires std::same_as<A, LinearAllocator> || std::same_as<A, VirtualArena>
+    {
+        TempArenaMemory scope = TempArenaMemory::begin(allocator);
+        trace->record(TraceOp::ScopeBegin, id, nullptr, nullptr, 0, 0);
+        return scope;
+    }
+
+    /**
+     * @brief End a temporary memory scope taken with begin_scope
+     *
+     * @param scope Scope to end
+     */
+    void end_scope(TempArenaMemory& scope)
+        requires std::same_as<A, LinearAllocator> || std::same_as<A, VirtualArena>
+    {
+        scope.end();
+        trace->record(TraceOp::ScopeEnd, id, nullptr, nullptr, 0, 0);
+    }
+};
+
+/**
+ * @brief Tracing does not change the order an allocator can free in
+ */
+template <BasicAllocator A>
+struct is_lifo_allocator<TracedAllocator<A>> : is_lifo_allocator<A> {};
+
+} // namespace memory
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <expected>
+#include <type_traits>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Anything that hands out aligned memory the way the allocators in this library do
+ *
+ * Every allocator here qualifies, as does TempArenaMemory. A free member is optional;
+ * without one, deallocation is a no-op and memory comes back with the allocator's
+ * own reset (free_all, TempArenaMemory::end, ...).
+ *
+ * @tparam A Allocator type
+ */
+template <typename A>
+concept BasicAllocator = requires(A& a, size_t size, size_t align) {
+    { a.alloc_align(size, align) } -> std::same_as<std::expected<void*, AllocatorError>>;
+};
+
+/**
+ * @brief Allocator that can also resize and free individual allocations
+ *
+ * free may take just the pointer, or the pointer, size and alignment for backends
+ * that need them (such as std::pmr::memory_resource).
+ *
+ * @tparam A Allocator type
+ */
+template <typename A>
+concept ResizableAllocator = BasicAllocator<A> && requires(A& a, void* ptr, size_t size, size_t align) {
+    { a.resize_align(ptr, size, size, align) } -> std::same_as<std::expected<void*, AllocatorError>>;
+} && (requires(A& a, void* ptr) { a.free(ptr); } ||
+      requires(A& a, void* ptr, size_t size, size_t align) { a.free(ptr, size, align); });
+
+/**
+ * @brief A ResizableAllocator held by value (typically stateless) or by pointer
+ *
+ * @tparam A Allocator type or pointer to one
+ */
+template <typename A>
+concept AllocatorHandle = ResizableAllocator<std::remove_pointer_t<A>> &&
+                          (std::is_pointer_v<A> || std::is_copy_constructible_v<A>);
+
+/**
+ * @brief A BasicAllocator held by value or by pointer, for containers that never resize
+ *
+ * @tparam A Allocator type or pointer to one
+ */
+template <typename A>
+concept BasicAllocatorHandle = BasicAllocator<std::remove_pointer_t<A>> &&
+                               (std::is_pointer_v<A> || std::is_copy_constructible_v<A>);
+
+/**
+ * @brief Whether an allocator can only free its most recent allocation
+ *
+ * Such allocators (StackAllocator) release everything above a freed block, so they
+ * must not sit behind adapters whose clients free in arbitrary order, such as the
+ * standard containers freeing the old block after a reallocation. The library's
+ * growable containers free the same way and reject them too.
+ *
+ * @tparam A Allocator type
+ */
+template <typename A>
+struct is_lifo_allocator : std::false_type {};
+
+/**
+ * @brief Convenience variable template for is_lifo_allocator
+ *
+ * @tparam A Allocator type
+ */
+template <typename A>
+inline constexpr bool is_lifo_allocator_v = is_lifo_allocator<A>::value;
+
+namespace detail {
+
+/**
+ * @brief Get the allocator behind a handle
+ *
+ * @param handle Allocator or pointer to one
+ * @return Reference to the allocator
+ */
+template <typename A>
+constexpr auto& allocator_of(A& handle) {
+    if constexpr (std::is_pointer_v<A>) {
+        return *handle;
+    } else {
+        return handle;
+    }
+}
+
+/**
+ * @brief Allocate without zeroing where the allocator supports it
+ *
+ * @param a Allocator to allocate from
+ * @param size Size in bytes to allocate
+ * @param align Alignment of the allocation (must be a power of two)
+ * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+ */
+template <BasicAllocator A>
+std::expected<void*, AllocatorError> allocate_from(A& a, size_t size, size_t align) {
+    if constexpr (requires { a.alloc_align_uninit(size, align); }) {
+        return a.alloc_align_uninit(size, align);
+    } else {
+        return a.alloc_align(size, align);
+    }
+}
+
+/**
+ * @brief Resize without zeroing the grown tail where the allocator supports it
+ *
+ * @param a Allocator the memory came from
+ * @param ptr Pointer to the allocation
+ * @param old_size Previous allocation size
+ * @param new_size New allocation size
+ * @param align Alignment of the allocation (must be a power of two)
+ * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+ */
+template <ResizableAllocator A>
+std::expected<void*, AllocatorError> resize_in(A& a, void* ptr, size_t old_size, size_t new_size, size_t align) {
+    if constexpr (requires { a.resize_align_uninit(ptr, old_size, new_size, align); }) {
+        return a.resize_align_uninit(ptr, old_size, new_size, align);
+    } else {
+        return a.resize_align(ptr, old_size, new_size, align);
+    }
+}
+
+/**
+ * @brief Try to resize in place, if the allocator can do that at all
+ *
+ * @param a Allocator the memory came from
+ * @param ptr Pointer to the allocation
+ * @param old_size Previous allocation size
+ * @param new_size New allocation size
+ * @return true if the allocation was resized in place, false otherwise
+ */
+template <BasicAllocator A>
+bool try_resize_in_place_in(A& a, void* ptr, size_t old_size, size_t new_size) {
+    if constexpr (requires { { a.try_resize_in_place(ptr, old_size, new_size) } -> std::same_as<bool>; }) {
+        return a.try_resize_in_place(ptr, old_size, new_size);
+    } else {
+        return false;
+    }
+}
+
+/**
+ * @brief Get the usable size of an allocation if the allocator can tell
+ *
+ * @param a Allocator the memory came from
+ * @param ptr Pointer to the allocation
+ * @param size Size the allocation was requested with
+ * @param align Alignment the allocation was requested with
+ * @return Usable size in bytes, size if the allocator has no usable_size member
+ */
+template <BasicAllocator A>
+size_t usable_size_in(A& a, void* ptr, size_t size, size_t align) {
+    if constexpr (requires { { a.usable_size(ptr, size, align) } -> std::same_as<size_t>; }) {
+        return a.usable_size(ptr, size, align);
+    } else {
+        return size;
+    }
+}
+
+/**
+ * @brief Hand memory back to the allocator if it supports individual frees
+ *
+ * @param a Allocator the memory came from
+ * @param ptr Pointer to the memory
+ * @param size Size of the allocation
+ * @param align Alignment of the allocation
+ * @return false if the allocator rejected the free (e.g. out of LIFO order), true otherwise
+ */
+template <BasicAllocator A>
+bool deallocate_to(A& a, void* ptr, size_t size, size_t align) {
+    if constexpr (requires { { a.free(ptr, size, align) } -> std::same_as<std::expected<void, AllocatorError>>; }) {
+        return a.free(ptr, size, align).has_value();
+    } else if constexpr (requires { a.free(ptr, size, align); }) {
+        a.free(ptr, size, align);
+    } else if constexpr (requires { { a.free(ptr) } -> std::same_as<std::expected<void, AllocatorError>>; }) {
+        return a.free(ptr).has_value();
+    } else if constexpr (requires { a.free(ptr); }) {
+        a.free(ptr);
+    }
+    return true;
+}
+
+} // namespace detail
+
+} // namespace memory
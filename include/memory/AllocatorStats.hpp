@@ -0,0 +1,216 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @brief Set to 1 (the MEMORY_ENABLE_STATS CMake option) to collect allocator statistics
+ *
+ * Has to be the same for every translation unit, as it changes the layout of the
+ * allocators. When 0, the recorders are empty and every hook compiles away.
+ */
+#ifndef MEMORY_ENABLE_STATS
+#define MEMORY_ENABLE_STATS 0
+#endif
+
+namespace memory {
+
+/**
+ * @brief Whether allocator statistics are collected in this build
+ */
+inline constexpr bool STATS_ENABLED = MEMORY_ENABLE_STATS != 0;
+
+/**
+ * @brief Snapshot of an allocator's (or container's) usage counters
+ *
+ * Counters are cumulative since creation; bytes_in_use is whatever the allocator
+ * considers used right now (the offset for linear and stack allocators, the
+ * allocated blocks otherwise) and peak_bytes_in_use its high-water mark, which
+ * survives free_all. All fields are zero when STATS_ENABLED is false.
+ */
+struct AllocatorStats {
+    size_t allocations = 0;         ///< Successful allocations
+    size_t failed_allocations = 0;  ///< Allocations and growing resizes that failed
+    size_t frees = 0;               ///< Individual frees
+    size_t resets = 0;              ///< free_all calls and scope rewinds
+    size_t resizes_in_place = 0;    ///< Resizes that kept the memory where it was
+    size_t resizes_moved = 0;       ///< Resizes that had to allocate and copy
+    size_t bytes_allocated = 0;     ///< Total bytes requested by successful allocations
+    size_t padding_bytes = 0;       ///< Total bytes lost to alignment padding and headers
+    size_t bytes_in_use = 0;        ///< Bytes in use right now
+    size_t peak_bytes_in_use = 0;   ///< Largest bytes_in_use seen
+};
+
+namespace detail {
+
+/**
+ * @brief Counters behind AllocatorStats, updated by the allocators' hooks
+ *
+ * Counters are relaxed atomics so the concurrent allocators can share the same
+ * recorder; copies and moves take a snapshot of the counters.
+ *
+ * @tparam Enabled Whether to record anything at all
+ */
+template <bool Enabled>
+struct StatsRecorderImpl {
+    std::atomic<size_t> allocations{0};        ///< See AllocatorStats::allocations
+    std::atomic<size_t> failed_allocations{0}; ///< See AllocatorStats::failed_allocations
+    std::atomic<size_t> frees{0};              ///< See AllocatorStats::frees
+    std::atomic<size_t> resets{0};             ///< See AllocatorStats::resets
+    std::atomic<size_t> resizes_in_place{0};   ///< See AllocatorStats::resizes_in_place
+    std::atomic<size_t> resizes_moved{0};      ///< See AllocatorStats::resizes_moved
+    std::atomic<size_t> bytes_allocated{0};    ///< See AllocatorStats::bytes_allocated
+    std::atomic<size_t> padding_bytes{0};      ///< See AllocatorStats::padding_bytes
+    std::atomic<size_t> bytes_in_use{0};       ///< See AllocatorStats::bytes_in_use
+    std::atomic<size_t> peak_bytes_in_use{0};  ///< See AllocatorStats::peak_bytes_in_use
+
+    StatsRecorderImpl() = default;
+
+    /**
+     * @brief Copy the counters of another recorder
+     *
+     * @param other Recorder to copy from
+     */
+    StatsRecorderImpl(const StatsRecorderImpl& other) noexcept { assign(other.snapshot()); }
+
+    /**
+     * @brief Copy the counters of another recorder
+     *
+     * @param other Recorder to copy from
+     * @return Reference to this recorder
+     */
+    StatsRecorderImpl& operator=(const StatsRecorderImpl& other) noexcept {
+        if (this != &other) {
+            assign(other.snapshot());
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Record a successful allocation
+     *
+     * @param size Bytes requested
+     * @param padding Bytes lost to alignment padding and headers
+     */
+    void record_alloc(size_t size, size_t padding = 0) noexcept {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated.fetch_add(size, std::memory_order_relaxed);
+        padding_bytes.fetch_add(padding, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record a failed allocation or growing resize
+     */
+    void record_failure() noexcept { failed_allocations.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Record an individual free
+     */
+    void record_free() noexcept { frees.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a free_all or scope rewind
+     */
+    void record_reset() noexcept { resets.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Record a resize
+     *
+     * @param in_place Whether the memory stayed where it was
+     */
+    void record_resize(bool in_place) noexcept {
+        (in_place ? resizes_in_place : resizes_moved).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Record the bytes in use now and update the high-water mark
+     *
+     * @param bytes Bytes in use
+     */
+    void record_in_use(size_t bytes) noexcept {
+        bytes_in_use.store(bytes, std::memory_order_relaxed);
+        size_t peak = peak_bytes_in_use.load(std::memory_order_relaxed);
+        while (bytes > peak && !peak_bytes_in_use.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Add to the bytes in use, for allocators that do not track their usage
+     *
+     * @param bytes Bytes that went into use
+     */
+    void add_in_use(size_t bytes) noexcept {
+        size_t now = bytes_in_use.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        size_t peak = peak_bytes_in_use.load(std::memory_order_relaxed);
+        while (now > peak && !peak_bytes_in_use.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @brief Subtract from the bytes in use
+     *
+     * @param bytes Bytes that are no longer in use
+     */
+    void sub_in_use(size_t bytes) noexcept { bytes_in_use.fetch_sub(bytes, std::memory_order_relaxed); }
+
+    /**
+     * @brief Read all counters
+     *
+     * @return AllocatorStats Snapshot of the counters (not atomic as a whole)
+     */
+    AllocatorStats snapshot() const noexcept {
+        AllocatorStats s;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.failed_allocations = failed_allocations.load(std::memory_order_relaxed);
+        s.frees = frees.load(std::memory_order_relaxed);
+        s.resets = resets.load(std::memory_order_relaxed);
+        s.resizes_in_place = resizes_in_place.load(std::memory_order_relaxed);
+        s.resizes_moved = resizes_moved.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.padding_bytes = padding_bytes.load(std::memory_order_relaxed);
+        s.bytes_in_use = bytes_in_use.load(std::memory_order_relaxed);
+        s.peak_bytes_in_use = peak_bytes_in_use.load(std::memory_order_relaxed);
+        return s;
+    }
+
+private:
+    void assign(const AllocatorStats& s) noexcept {
+        allocations.store(s.allocations, std::memory_order_relaxed);
+        failed_allocations.store(s.failed_allocations, std::memory_order_relaxed);
+        frees.store(s.frees, std::memory_order_relaxed);
+        resets.store(s.resets, std::memory_order_relaxed);
+        resizes_in_place.store(s.resizes_in_place, std::memory_order_relaxed);
+        resizes_moved.store(s.resizes_moved, std::memory_order_relaxed);
+        bytes_allocated.store(s.bytes_allocated, std::memory_order_relaxed);
+        padding_bytes.store(s.padding_bytes, std::memory_order_relaxed);
+        bytes_in_use.store(s.bytes_in_use, std::memory_order_relaxed);
+        peak_bytes_in_use.store(s.peak_bytes_in_use, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Disabled recorder: empty, every hook is a no-op
+ */
+template <>
+struct StatsRecorderImpl<false> {
+    void record_alloc(size_t, size_t = 0) noexcept {}
+    void record_failure() noexcept {}
+    void record_free() noexcept {}
+    void record_reset() noexcept {}
+    void record_resize(bool) noexcept {}
+    void record_in_use(size_t) noexcept {}
+    void add_in_use(size_t) noexcept {}
+    void sub_in_use(size_t) noexcept {}
+    AllocatorStats snapshot() const noexcept { return {}; }
+};
+
+} // namespace detail
+
+/**
+ * @brief Statistics recorder embedded in every allocator and DynArray
+ *
+ * Declared [[no_unique_address]], so it takes no space when statistics are disabled.
+ */
+using StatsRecorder = detail::StatsRecorderImpl<STATS_ENABLED>;
+
+} // namespace memory
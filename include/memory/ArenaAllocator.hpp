@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+#include "memory/Allocator.hpp"
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief std::pmr::memory_resource backed by one of the library's allocators
+ *
+ * do_allocate forwards to alloc_align (without zeroing), do_deallocate to free.
+ * Failures are reported as std::bad_alloc, as the standard containers expect.
+ *
+ * @tparam Alloc Allocator type (not a LIFO-only one such as StackAllocator, see is_lifo_allocator)
+ *
+ * @note The resource does not own the allocator, which has to outlive it.
+ */
+template <BasicAllocator Alloc>
+struct ArenaResource : std::pmr::memory_resource {
+    static_assert(!is_lifo_allocator_v<Alloc>,
+                  "Containers free out of order, which would roll a LIFO allocator back over live memory");
+
+    Alloc* allocator; ///< Allocator memory is taken from
+
+    /**
+     * @brief Construct a resource over an allocator
+     *
+     * @param a Allocator to take memory from
+     */
+    explicit ArenaResource(Alloc* a) noexcept : allocator(a) {}
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        auto result = detail::allocate_from(*allocator, bytes, alignment);
+        if (!result) {
+            throw std::bad_alloc();
+        }
+        return result.value();
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        detail::deallocate_to(*allocator, p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const auto* resource = dynamic_cast<const ArenaResource*>(&other);
+        return resource != nullptr && resource->allocator == allocator;
+    }
+};
+
+/**
+ * @brief Stateful STL allocator backed by one of the library's allocators
+ *
+ * Lets std::vector, std::basic_string, std::unordered_map and friends allocate from
+ * an arena without going through a polymorphic memory resource.
+ *
+ * @tparam T Type of the elements allocated
+ * @tparam Alloc Allocator type (not a LIFO-only one such as StackAllocator, see is_lifo_allocator)
+ *
+ * @note Two ArenaAllocators compare equal when they share the same allocator.
+ */
+template <typename T, BasicAllocator Alloc = LinearAllocator>
+struct ArenaAllocator {
+    static_assert(!is_lifo_allocator_v<Alloc>,
+                  "Containers free out of order, which would roll a LIFO allocator back over live memory");
+
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Alloc* allocator; ///< Allocator memory is taken from
+
+    /**
+     * @brief Construct an STL allocator over an allocator
+     *
+     * @param a Allocator to take memory from
+     */
+    ArenaAllocator(Alloc* a) noexcept : allocator(a) {}
+
+    /**
+     * @brief Converting constructor used when containers rebind to their node types
+     *
+     * @tparam U Element type of the other allocator
+     * @param other Allocator to share the backing allocator with
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U, Alloc>& other) noexcept : allocator(other.allocator) {}
+
+    /**
+     * @brief Allocate uninitialized storage for n objects
+     *
+     * @param n Number of objects
+     * @return T* Pointer to the storage
+     *
+     * @throws std::bad_array_new_length if n * sizeof(T) overflows
+     * @throws std::bad_alloc if the allocator runs out of memory
+     */
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        auto result = detail::allocate_from(*allocator, n * sizeof(T), alignof(T));
+        if (!result) {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(result.value());
+    }
+
+    /**
+     * @brief Return storage to the allocator
+     *
+     * @param p Pointer returned by allocate
+     * @param n Number of objects passed to allocate
+     */
+    void deallocate(T* p, size_t n) noexcept {
+        detail::deallocate_to(*allocator, p, n * sizeof(T), alignof(T));
+    }
+
+    /**
+     * @brief Compare two STL allocators
+     *
+     * @tparam U Element type of the other allocator
+     * @param other Allocator to compare with
+     * @return true if both use the same backing allocator
+     */
+    template <typename U>
+    bool operator==(const ArenaAllocator<U, Alloc>& other) const noexcept {
+        return allocator == other.allocator;
+    }
+};
+
+/**
+ * @brief Library-style allocator over a std::pmr::memory_resource
+ *
+ * The reverse of ArenaResource: lets library containers such as DynArray allocate
+ * from any memory resource. Exceptions thrown by the resource are turned into
+ * AllocatorError::OutOfMemory.
+ *
+ * @note The adapter does not own the memory resource, which has to outlive it.
+ */
+struct ResourceAllocator {
+    std::pmr::memory_resource* resource; ///< Memory resource to allocate from
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align) {
+        if (!LinearAllocator::is_power_of_two(align)) {
+            return std::unexpected(AllocatorError::InvalidAlignment);
+        }
+        try {
+            return resource->allocate(size, align);
+        } catch (const std::bad_alloc&) {
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+    }
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align) {
+        auto result = alloc_align_uninit(size, align);
+        if (result) {
+            // Zero new memory by default
+            std::memset(result.value(), 0, size);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resize an allocation by moving it to a new one without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align) {
+        auto result = alloc_align_uninit(new_size, align);
+        if (result && old_memory != nullptr) {
+            std::memcpy(result.value(), old_memory, old_size < new_size ? old_size : new_size);
+            free(old_memory, old_size, align);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Resize an allocation by moving it to a new one
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align) {
+        auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+        if (result && new_size > old_size) {
+            // Zero the new memory by default (everything for fresh allocations)
+            size_t kept = (old_memory == nullptr) ? 0 : old_size;
+            std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Return memory to the resource
+     *
+     * @param ptr Pointer to memory previously allocated through this adapter
+     * @param size Size of the allocation
+     * @param align Alignment of the allocation
+     * @return std::expected<void, AllocatorError> Success or error code
+     */
+    std::expected<void, AllocatorError> free(void* ptr, size_t size, size_t align) {
+        if (ptr == nullptr) {
+            return std::unexpected(AllocatorError::NullPointer);
+        }
+        resource->deallocate(ptr, size, align);
+        return {};
+    }
+};
+
+} // namespace memory
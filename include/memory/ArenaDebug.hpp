@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Set to 1 (the MEMORY_ARENA_DEBUG CMake option) to guard and poison arena memory
+ *
+ * Has to be the same for every translation unit, as it changes the layout of the
+ * arenas. When 0, the debug state is empty and every check compiles away.
+ */
+#ifndef MEMORY_ARENA_DEBUG
+#define MEMORY_ARENA_DEBUG 0
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#define MEMORY_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define MEMORY_HAS_ASAN 1
+#endif
+#endif
+#ifndef MEMORY_HAS_ASAN
+#define MEMORY_HAS_ASAN 0
+#endif
+
+namespace memory {
+
+/**
+ * @brief Whether arenas guard and poison their memory in this build
+ *
+ * In debug mode LinearAllocator (and VirtualArena, which bump-allocates through one):
+ *
+ * - Follows every allocation with a red zone of ARENA_GUARD_BYTE, checked when the
+ *   memory behind it is rolled back by free_all or TempArenaMemory::end.
+ * - Fills rolled-back memory with ARENA_FREED_BYTE, so stale reads stand out.
+ * - Under AddressSanitizer, additionally poisons red zones and rolled-back memory, so
+ *   overflows and use-after-free_all/end are reported where they happen.
+ *
+ * A corrupted red zone is reported on stderr and aborts the program.
+ */
+inline constexpr bool ARENA_DEBUG_ENABLED = MEMORY_ARENA_DEBUG != 0;
+
+/**
+ * @brief Byte red zones are filled with
+ */
+inline constexpr unsigned char ARENA_GUARD_BYTE = 0xFD;
+
+/**
+ * @brief Byte rolled-back memory is filled with
+ */
+inline constexpr unsigned char ARENA_FREED_BYTE = 0xDD;
+
+/**
+ * @brief Minimum number of guard bytes behind every allocation
+ */
+inline constexpr size_t ARENA_REDZONE_SIZE = 16;
+
+/**
+ * @brief Upper bound on what a red zone adds to an allocation
+ *
+ * Up to 7 bytes rounding the allocation end to 8 bytes, the guard bytes and the
+ * trailer linking the red zones together.
+ */
+inline constexpr size_t ARENA_MAX_GUARD_OVERHEAD = 7 + ARENA_REDZONE_SIZE + 2 * sizeof(uint64_t);
+
+namespace detail {
+
+/**
+ * @brief Red zone bookkeeping of an arena
+ *
+ * @tparam Enabled Whether arena debugging is on
+ */
+template <bool Enabled>
+struct ArenaDebugStateImpl {
+    size_t last_guard = 0; ///< Offset one past the newest red zone, 0 if there is none
+};
+
+/**
+ * @brief Disabled debug state: empty
+ */
+template <>
+struct ArenaDebugStateImpl<false> {};
+
+/**
+ * @brief Mark memory as no longer in use: fill it with ARENA_FREED_BYTE and poison it
+ *
+ * @param ptr Start of the region
+ * @param size Size of the region in bytes
+ */
+void arena_poison(void* ptr, size_t size);
+
+/**
+ * @brief Mark memory as handed out again (unpoison it)
+ *
+ * @param ptr Start of the region
+ * @param size Size of the region in bytes
+ */
+void arena_unpoison(void* ptr, size_t size);
+
+/**
+ * @brief Write and poison the red zone [data_end, guard_end) of an allocation
+ *
+ * @param buf Start of the arena buffer
+ * @param data_end Offset one past the allocation
+ * @param guard_end Offset one past the red zone (see arena_guard_end)
+ * @param prev_guard Offset one past the previous red zone, 0 if there is none
+ */
+void arena_write_guard(unsigned char* buf, size_t data_end, size_t guard_end, size_t prev_guard);
+
+/**
+ * @brief Get the previous red zone linked from a red zone
+ *
+ * @param buf Start of the arena buffer
+ * @param guard_end Offset one past the red zone
+ * @return Offset one past the previous red zone, 0 if there is none
+ */
+size_t arena_prev_guard(const unsigned char* buf, size_t guard_end);
+
+/**
+ * @brief Validate the red zones from newest to oldest, aborting on corruption
+ *
+ * @param buf Start of the arena buffer
+ * @param last_guard Offset one past the newest red zone to check
+ * @param stop_guard Offset one past the newest red zone to leave unchecked (0 checks all)
+ */
+void arena_check_guards(const unsigned char* buf, size_t last_guard, size_t stop_guard);
+
+/**
+ * @brief Offset one past the red zone of an allocation ending at data_end
+ *
+ * @param data_end Offset one past the allocation
+ * @return Offset one past its red zone
+ */
+constexpr size_t arena_guard_end(size_t data_end) {
+    return ((data_end + 7) & ~static_cast<size_t>(7)) + ARENA_REDZONE_SIZE + 2 * sizeof(uint64_t);
+}
+
+} // namespace detail
+
+/**
+ * @brief Debug state embedded in every arena and TempArenaMemory
+ *
+ * Declared [[no_unique_address]], so it takes no space when arena debugging is disabled.
+ */
+using ArenaDebugState = detail::ArenaDebugStateImpl<ARENA_DEBUG_ENABLED>;
+
+} // namespace memory
@@ -0,0 +1,244 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+#include "memory/Allocator.hpp"
+#include "memory/AllocatorStats.hpp"
+#include "memory/GrowthPolicy.hpp"
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief String builder that appends into an allocator block
+ *
+ * Keeps the characters in one block, always NUL-terminated, and grows it through
+ * resize_align. When the string is the most recent allocation of a LinearAllocator
+ * (the usual case while building one string at a time) the arena extends the block
+ * where it is, so appending never copies what was built so far:
+ *
+ * @code
+ * BasicArenaString<LinearAllocator*> path(&arena);
+ * path.append("/users/");
+ * path.append_number(user_id);
+ * std::string_view done = path.finish(); // gives back the unused tail of the block
+ * @endcode
+ *
+ * Every operation reports failure through std::expected, nothing throws.
+ *
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle)
+ */
+template <AllocatorHandle Alloc = LinearAllocator*>
+struct BasicArenaString {
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "ArenaString frees the old buffer after copying into a new one, out of LIFO order");
+    // Data members first (following data-oriented approach)
+    char*           data;        ///< Characters, NUL-terminated (nullptr until the first append)
+    size_t          size;        ///< Number of characters, without the terminator
+    size_t          capacity;    ///< Characters the block has room for, without the terminator
+    [[no_unique_address]] Alloc allocator; ///< Allocator (or pointer to it) the block comes from
+    [[no_unique_address]] StatsRecorder recorder; ///< Growth statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Capacity allocated by the first append to an empty string
+     */
+    static constexpr size_t DEFAULT_CAPACITY = 32;
+
+    /**
+     * @brief Default constructor, for allocators held by value
+     */
+    BasicArenaString();
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Allocator to use, or pointer to it
+     */
+    explicit BasicArenaString(Alloc alloc);
+
+    /**
+     * @brief Destructor, hands the block back unless finish() detached it
+     */
+    ~BasicArenaString();
+
+    BasicArenaString(const BasicArenaString&) = delete;
+    BasicArenaString& operator=(const BasicArenaString&) = delete;
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other String to move from, left empty
+     */
+    BasicArenaString(BasicArenaString&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator
+     *
+     * @param other String to move from, left empty
+     * @return Reference to this string
+     */
+    BasicArenaString& operator=(BasicArenaString&& other) noexcept;
+
+    /**
+     * @brief Append characters
+     *
+     * @param text Characters to append (may point into this string)
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> append(std::string_view text);
+
+    /**
+     * @brief Append count copies of a character
+     *
+     * @param count Number of characters to append
+     * @param ch Character to append
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> append(size_t count, char ch);
+
+    /**
+     * @brief Append one character
+     *
+     * @param ch Character to append
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> push_back(char ch);
+
+    /**
+     * @brief Append the decimal representation of a number
+     *
+     * Formatted with std::to_chars straight into the block, so no temporary string.
+     *
+     * @param value Integer or floating point value
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    template <typename N>
+        requires (std::is_arithmetic_v<N> && !std::same_as<N, bool> && !std::same_as<N, char>)
+    std::expected<void, AllocatorError> append_number(N value);
+
+    /**
+     * @brief Make room for at least new_capacity characters
+     *
+     * @param new_capacity Minimum capacity, without the terminator
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> reserve(size_t new_capacity);
+
+    /**
+     * @brief Forget the characters, keeping the block
+     */
+    void clear();
+
+    /**
+     * @brief Hand the string over and start a new one
+     *
+     * Shrinks the block to the characters and their terminator when it is still the
+     * most recent allocation, and detaches it: the returned view stays valid until
+     * the allocator reclaims the memory (free_all on an arena) and is no longer freed
+     * by this builder. Meant for arenas; with HeapAllocator the caller would have to
+     * free the block.
+     *
+     * @return std::string_view The built string, NUL-terminated
+     */
+    std::string_view finish();
+
+    /**
+     * @brief Get the characters built so far
+     *
+     * @return std::string_view View of the string, valid until the next append
+     */
+    std::string_view view() const;
+
+    /**
+     * @brief Get the characters as a NUL-terminated C string
+     *
+     * @return const char* The string, "" if nothing was appended
+     */
+    const char* c_str() const;
+
+    /**
+     * @brief Get the number of characters
+     *
+     * @return Current size without the terminator
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the number of characters the block has room for
+     *
+     * @return Current capacity without the terminator
+     */
+    size_t get_capacity() const;
+
+    /**
+     * @brief Check if the string is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get a snapshot of the growth statistics
+     *
+     * allocations counts the first block, resizes_in_place and resizes_moved the
+     * growths after it, and bytes_in_use the size of the block.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the allocator the string allocates from
+     *
+     * @return Reference to the allocator (the pointee if Alloc is a pointer)
+     */
+    std::remove_pointer_t<Alloc>& get_allocator();
+
+private:
+    /**
+     * @brief Make room for extra more characters
+     *
+     * @param extra Number of characters about to be appended
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> ensure(size_t extra);
+
+    /**
+     * @brief Grow the block to hold at least min_capacity characters
+     *
+     * @param min_capacity Minimum capacity needed, without the terminator
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> grow(size_t min_capacity);
+
+    /**
+     * @brief Resize the block to new_capacity characters
+     *
+     * @param new_capacity Capacity of the block, without the terminator
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> reallocate(size_t new_capacity);
+
+    /**
+     * @brief Hand the current block back to the allocator
+     */
+    void release();
+};
+
+/**
+ * @brief String builder on a LinearAllocator
+ */
+using ArenaString = BasicArenaString<LinearAllocator*>;
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/ArenaString.tpp"
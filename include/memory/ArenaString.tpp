@@ -0,0 +1,289 @@
+#pragma once
+
+#include "memory/ArenaString.hpp"
+
+namespace memory {
+
+
+template <AllocatorHandle Alloc>
+BasicArenaString<Alloc>::BasicArenaString()
+    : data(nullptr), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Default constructor, nothing is allocated until the first append
+}
+
+
+template <AllocatorHandle Alloc>
+BasicArenaString<Alloc>::BasicArenaString(Alloc alloc)
+    : data(nullptr), size(0), capacity(0), allocator(alloc) {
+    // Constructor with custom allocator, nothing is allocated until the first append
+}
+
+
+template <AllocatorHandle Alloc>
+BasicArenaString<Alloc>::~BasicArenaString() {
+    release();
+
+    // Reset all members for safety
+    data = nullptr;
+    size = 0;
+    capacity = 0;
+}
+
+
+template <AllocatorHandle Alloc>
+BasicArenaString<Alloc>::BasicArenaString(BasicArenaString&& other) noexcept
+    : data(other.data), size(other.size), capacity(other.capacity), allocator(other.allocator) {
+    // Reset the source object; it keeps its allocator so it stays usable
+    other.data = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+}
+
+
+template <AllocatorHandle Alloc>
+BasicArenaString<Alloc>& BasicArenaString<Alloc>::operator=(BasicArenaString&& other) noexcept {
+    if (this != &other) {
+        release();
+
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+        allocator = other.allocator;
+
+        other.data = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+    }
+    return *this;
+}
+
+// Append characters
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::append(std::string_view text) {
+    if (text.empty()) {
+        return {};
+    }
+
+    // text may be a view of this string, which a moving resize would leave dangling
+    size_t self_offset = SIZE_MAX;
+    if (data != nullptr && text.data() >= data && text.data() < data + size) {
+        self_offset = static_cast<size_t>(text.data() - data);
+    }
+
+    auto result = ensure(text.size());
+    if (!result) {
+        return result;
+    }
+
+    const char* source = self_offset != SIZE_MAX ? data + self_offset : text.data();
+    std::memmove(data + size, source, text.size());
+    size += text.size();
+    data[size] = '\0';
+    return {};
+}
+
+// Append a run of one character
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::append(size_t count, char ch) {
+    if (count == 0) {
+        return {};
+    }
+
+    auto result = ensure(count);
+    if (!result) {
+        return result;
+    }
+
+    std::memset(data + size, ch, count);
+    size += count;
+    data[size] = '\0';
+    return {};
+}
+
+// Append one character
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::push_back(char ch) {
+    if (size >= capacity) [[unlikely]] {
+        auto result = ensure(1);
+        if (!result) {
+            return result;
+        }
+    }
+
+    data[size] = ch;
+    data[++size] = '\0';
+    return {};
+}
+
+// Append a number
+template <AllocatorHandle Alloc>
+template <typename N>
+    requires (std::is_arithmetic_v<N> && !std::same_as<N, bool> && !std::same_as<N, char>)
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::append_number(N value) {
+    // Enough for any integer and for the shortest round-trip form of a double
+    constexpr size_t MAX_CHARS = 32;
+    auto result = ensure(MAX_CHARS);
+    if (!result) {
+        return result;
+    }
+
+    auto [end, error] = std::to_chars(data + size, data + size + MAX_CHARS, value);
+    if (error != std::errc()) {
+        data[size] = '\0';
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+    size = static_cast<size_t>(end - data);
+    data[size] = '\0';
+    return {};
+}
+
+// Reserve room for characters
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::reserve(size_t new_capacity) {
+    if (new_capacity <= capacity) {
+        return {}; // Nothing to do
+    }
+    if (new_capacity == std::numeric_limits<size_t>::max()) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    return reallocate(new_capacity);
+}
+
+// Clear string
+template <AllocatorHandle Alloc>
+void BasicArenaString<Alloc>::clear() {
+    size = 0;
+    if (data != nullptr) {
+        data[0] = '\0';
+    }
+}
+
+// Detach the string
+template <AllocatorHandle Alloc>
+std::string_view BasicArenaString<Alloc>::finish() {
+    if (data == nullptr) {
+        return {};
+    }
+
+    // Hand the unused tail back to the arena if nothing was allocated after the string
+    detail::try_resize_in_place_in(detail::allocator_of(allocator), data, capacity + 1, size + 1);
+
+    std::string_view result(data, size);
+    data = nullptr;
+    size = 0;
+    capacity = 0;
+    return result;
+}
+
+// View of the characters
+template <AllocatorHandle Alloc>
+std::string_view BasicArenaString<Alloc>::view() const {
+    return {data != nullptr ? data : "", size};
+}
+
+// C string of the characters
+template <AllocatorHandle Alloc>
+const char* BasicArenaString<Alloc>::c_str() const {
+    return data != nullptr ? data : "";
+}
+
+// Get size
+template <AllocatorHandle Alloc>
+size_t BasicArenaString<Alloc>::get_size() const {
+    return size;
+}
+
+// Get capacity
+template <AllocatorHandle Alloc>
+size_t BasicArenaString<Alloc>::get_capacity() const {
+    return capacity;
+}
+
+// Check if empty
+template <AllocatorHandle Alloc>
+bool BasicArenaString<Alloc>::empty() const {
+    return size == 0;
+}
+
+// Get growth statistics
+template <AllocatorHandle Alloc>
+AllocatorStats BasicArenaString<Alloc>::stats() const {
+    return recorder.snapshot();
+}
+
+// Get the allocator
+template <AllocatorHandle Alloc>
+std::remove_pointer_t<Alloc>& BasicArenaString<Alloc>::get_allocator() {
+    return detail::allocator_of(allocator);
+}
+
+// Make room for an append
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::ensure(size_t extra) {
+    if (extra <= capacity - size) [[likely]] {
+        return {};
+    }
+    if (extra >= std::numeric_limits<size_t>::max() - size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    return grow(size + extra);
+}
+
+// Grow string capacity
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::grow(size_t min_capacity) {
+    // The first allocation takes at least DEFAULT_CAPACITY characters. Doubling costs
+    // nothing at the top of an arena, finish() gives the slack back
+    size_t target = capacity == 0 ? std::max(min_capacity, DEFAULT_CAPACITY)
+                                  : GeometricGrowth<2, 1>::next_capacity(capacity, min_capacity, 1);
+    auto result = reserve(target);
+    if (!result && target > min_capacity) {
+        // The allocator may still have room for exactly what is needed
+        result = reserve(min_capacity);
+    }
+    return result;
+}
+
+// Resize the block
+template <AllocatorHandle Alloc>
+std::expected<void, AllocatorError> BasicArenaString<Alloc>::reallocate(size_t new_capacity) {
+    auto& backend = detail::allocator_of(allocator);
+
+    if (data == nullptr) {
+        auto alloc_result = detail::allocate_from(backend, new_capacity + 1, alignof(char));
+        if (!alloc_result) {
+            recorder.record_failure();
+            return std::unexpected(alloc_result.error());
+        }
+        data = static_cast<char*>(alloc_result.value());
+        data[0] = '\0';
+        capacity = new_capacity;
+        recorder.record_alloc(new_capacity + 1);
+        recorder.record_in_use(new_capacity + 1);
+        return {};
+    }
+
+    // Extends in place when the string is the arena's last allocation, copies otherwise
+    auto resize_result = detail::resize_in(backend, data, capacity + 1, new_capacity + 1, alignof(char));
+    if (!resize_result) {
+        recorder.record_failure();
+        return std::unexpected(resize_result.error());
+    }
+    recorder.record_resize(resize_result.value() == data);
+    data = static_cast<char*>(resize_result.value());
+    capacity = new_capacity;
+    recorder.record_in_use(new_capacity + 1);
+    return {};
+}
+
+// Hand the block back
+template <AllocatorHandle Alloc>
+void BasicArenaString<Alloc>::release() {
+    if (data != nullptr) {
+        detail::deallocate_to(detail::allocator_of(allocator), data, capacity + 1, alignof(char));
+    }
+}
+
+} // namespace memory
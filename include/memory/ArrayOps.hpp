@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace memory {
+
+/**
+ * @brief Trait for types that can be relocated with a plain memcpy/memmove
+ *
+ * Relocating an object means move-constructing it at a new address and destroying
+ * the original. For trivially copyable types that is a bitwise copy, so DynArray
+ * moves them in bulk. Types that are safe to move bitwise but are not trivially
+ * copyable (e.g. a handle owning a heap pointer) can opt in by specializing this
+ * trait to std::true_type.
+ *
+ * @tparam T The type to query
+ */
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+/**
+ * @brief Convenience variable template for is_trivially_relocatable
+ *
+ * @tparam T The type to query
+ */
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace detail {
+
+/**
+ * @brief Relocate elements into non-overlapping uninitialized memory
+ *
+ * Trivially relocatable types are copied with a single memcpy; other types are
+ * moved with std::uninitialized_move and the originals destroyed.
+ *
+ * @param dst Destination (uninitialized) storage
+ * @param src Source elements, left destroyed afterwards
+ * @param count Number of elements to relocate
+ */
+template <typename T>
+void relocate_elements(T* dst, T* src, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // Bitwise relocation, the source needs no destructor call
+        std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * count);
+    } else {
+        std::uninitialized_move(src, src + count, dst);
+        std::destroy(src, src + count);
+    }
+}
+
+/**
+ * @brief Open a gap by relocating the elements [position, size) up by count slots
+ *
+ * @param data First element of the array
+ * @param size Number of elements in the array
+ * @param position Index of the first element to shift
+ * @param count Number of slots to open (the storage must already allow it)
+ */
+template <typename T>
+void shift_elements_right(T* data, size_t size, size_t position, size_t count) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // Ranges overlap, so this has to be a memmove
+        std::memmove(static_cast<void*>(data + position + count),
+                     static_cast<const void*>(data + position),
+                     sizeof(T) * (size - position));
+    } else {
+        // Walk backwards so every destination slot is already vacated
+        for (size_t i = size; i > position; --i) {
+            new (data + i - 1 + count) T(std::move(data[i - 1])); // Move construct at new position
+            data[i - 1].~T(); // Destroy original
+        }
+    }
+}
+
+/**
+ * @brief Close a gap by relocating the elements [position + count, size) down by count slots
+ *
+ * @param data First element of the array
+ * @param size Number of elements in the array, gap included
+ * @param position Index of the first (already destroyed) slot of the gap
+ * @param count Number of slots in the gap
+ */
+template <typename T>
+void shift_elements_left(T* data, size_t size, size_t position, size_t count) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // Ranges overlap, so this has to be a memmove
+        std::memmove(static_cast<void*>(data + position),
+                     static_cast<const void*>(data + position + count),
+                     sizeof(T) * (size - position - count));
+    } else {
+        // Walk forwards so every destination slot is already vacated
+        for (size_t i = position; i < size - count; ++i) {
+            new (data + i) T(std::move(data[i + count])); // Move construct at new position
+            data[i + count].~T(); // Destroy original
+        }
+    }
+}
+
+/**
+ * @brief Insert count elements from a forward iterator at position
+ *
+ * Shifts the tail once, then copies the new elements into the gap; trivially
+ * copyable elements from contiguous iterators are copied with a single memcpy.
+ *
+ * @param data First element of the array
+ * @param size Number of elements in the array
+ * @param position Index to insert at (at most size)
+ * @param first Iterator to the first element to insert (must not point into the array)
+ * @param count Number of elements to insert (the storage must already allow size + count)
+ */
+template <typename T, std::forward_iterator It>
+void insert_elements(T* data, size_t size, size_t position, It first, size_t count) {
+    if (position < size) {
+        shift_elements_right(data, size, position, count);
+    }
+
+    using Source = std::iter_value_t<It>;
+    if constexpr (std::contiguous_iterator<It> && std::is_trivially_copyable_v<T> &&
+                  std::is_same_v<std::remove_cv_t<Source>, T>) {
+        std::memcpy(static_cast<void*>(data + position), static_cast<const void*>(std::to_address(first)),
+                    sizeof(T) * count);
+    } else {
+        T* slot = data + position;
+        for (size_t i = 0; i < count; ++i, ++first, ++slot) {
+            new (slot) T(*first);
+        }
+    }
+}
+
+} // namespace detail
+
+} // namespace memory
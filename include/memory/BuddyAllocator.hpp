@@ -0,0 +1,231 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Intrusive doubly linked free list node stored inside every free block
+ */
+struct BuddyFreeNode {
+    BuddyFreeNode* prev; ///< Previous free block of the same size
+    BuddyFreeNode* next; ///< Next free block of the same size
+};
+
+/**
+ * @brief Buddy allocator for power-of-two blocks
+ *
+ * The region (a power of two in size) is a binary tree of blocks: level 0 is the
+ * whole region, every level below halves the block size down to min_block_size.
+ * Allocations are rounded up to a power of two and served by splitting larger
+ * blocks; on free a block is merged with its buddy for as long as the buddy is free.
+ *
+ * Block state is kept in two bitmaps outside the region instead of per-block
+ * headers: one "split" bit per inner node and one "free" bit per node.
+ *
+ * @note Allocation and free are O(log n) in the number of levels.
+ */
+struct BuddyAllocator {
+    unsigned char* base;      ///< Start of the power-of-two region
+    size_t region_size;       ///< Size of the region (power of two)
+    size_t min_block_size;    ///< Size of the smallest block (power of two)
+    size_t level_count;       ///< Number of levels (level 0 is the whole region)
+    size_t used;              ///< Bytes currently handed out, in whole blocks
+    uint64_t* split_bits;     ///< One bit per inner node: block has been split
+    uint64_t* free_bits;      ///< One bit per node: block is in a free list
+
+    /**
+     * @brief Maximum number of levels (region_size / min_block_size <= 2^63)
+     */
+    static constexpr size_t MAX_LEVELS = 64;
+
+    BuddyFreeNode* free_lists[MAX_LEVELS]; ///< Free blocks per level
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default size of the smallest block
+     */
+    static constexpr size_t DEFAULT_MIN_BLOCK_SIZE = 256;
+
+    /**
+     * @brief Initialize a buddy allocator over a provided backing buffer
+     *
+     * The largest power-of-two region that fits together with the bitmaps is used;
+     * the bitmaps are placed in the buffer behind the region.
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @param min_block_size Size of the smallest block (power of two, at least sizeof(BuddyFreeNode))
+     * @return std::expected<BuddyAllocator, AllocatorError> Initialized BuddyAllocator or error
+     */
+    static std::expected<BuddyAllocator, AllocatorError> create(void* backing_buffer, size_t backing_buffer_length,
+                                                                size_t min_block_size = DEFAULT_MIN_BLOCK_SIZE);
+
+    /**
+     * @brief Initialize a buddy allocator over a region carved out of a linear allocator
+     *
+     * @param arena Arena to take the region and the bitmaps from
+     * @param region_size Size of the region (power of two)
+     * @param min_block_size Size of the smallest block (power of two, at least sizeof(BuddyFreeNode))
+     * @return std::expected<BuddyAllocator, AllocatorError> Initialized BuddyAllocator or error
+     */
+    static std::expected<BuddyAllocator, AllocatorError> create(LinearAllocator* arena, size_t region_size,
+                                                                size_t min_block_size = DEFAULT_MIN_BLOCK_SIZE);
+
+    /**
+     * @brief Number of bitmap bytes needed for a region
+     *
+     * @param region_size Size of the region (power of two)
+     * @param min_block_size Size of the smallest block (power of two)
+     * @return Bytes needed for the split and free bitmaps
+     */
+    static size_t metadata_size(size_t region_size, size_t min_block_size);
+
+    /**
+     * @brief Allocate a block with alignment
+     *
+     * @param size Size in bytes to allocate (rounded up to a power-of-two block)
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate a block with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate (rounded up to a power-of-two block)
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate a block with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate a block with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note Stays in place while new_size fits the block; otherwise the data is
+     *       moved to a new block and the old one freed.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an existing allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if new_size still fits the block, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free a block, merging it with its buddies
+     *
+     * @param ptr Pointer to a block previously allocated by this allocator
+     * @return std::expected<void, AllocatorError> Success or error code
+     *
+     * @note Freeing a block that is already free is ignored.
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Free all allocations, leaving the region as a single free block
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use mirrors used (whole blocks); padding_bytes is what requests left
+     * unused of their power-of-two block.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the size of the block backing an allocation
+     *
+     * @param ptr Pointer to a block previously allocated by this allocator
+     * @return std::expected<size_t, AllocatorError> Block size or error
+     */
+    std::expected<size_t, AllocatorError> block_size(const void* ptr) const;
+
+private:
+    /**
+     * @brief Find the level and in-level index of the allocated block containing ptr
+     *
+     * @param offset Offset of the pointer from base
+     * @param level Receives the level of the block
+     * @param index Receives the index of the block within its level
+     */
+    void find_block(size_t offset, size_t& level, size_t& index) const;
+
+    /**
+     * @brief Push a block onto the free list of its level
+     *
+     * @param level Level of the block
+     * @param index Index of the block within its level
+     */
+    void push_free(size_t level, size_t index);
+
+    /**
+     * @brief Remove a block from the free list of its level
+     *
+     * @param level Level of the block
+     * @param index Index of the block within its level
+     */
+    void remove_free(size_t level, size_t index);
+};
+
+} // namespace memory
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional> // For std::reference_wrapper
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "memory/Allocator.hpp"
+#include "memory/DynArray.hpp"
+#include "memory/HeapAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Segmented array that many threads can append to without a lock
+ *
+ * Storage is a list of segments of doubling size (BaseSize, 2 * BaseSize,
+ * 4 * BaseSize, ...), each one block from the allocator. Growing adds a segment
+ * and never moves what is already stored, so references to elements stay valid
+ * for the lifetime of the array, even while other threads keep appending.
+ *
+ * push_back and emplace_back claim an index with a single fetch_add and construct
+ * the element in place: no retry loop, no lock. The thread that first needs a new
+ * segment allocates it and publishes it with a compare-and-swap; should another
+ * thread win that race, the loser hands its block back to the allocator. The
+ * allocator is therefore called concurrently and has to be thread-safe:
+ * HeapAllocator (the default) or a ConcurrentLinearAllocator* arena, for example.
+ * A LinearAllocator* works if reserve() allocates every segment up front.
+ *
+ * Consumers read segment by segment (segment(), for_each()), each a contiguous
+ * span, or by index. An element appended by another thread may only be read after
+ * synchronizing with that thread (joining it, or a release/acquire handoff of your
+ * own); get_size() also counts indices whose elements are still being constructed.
+ *
+ * If a segment cannot be allocated, the array stops accepting elements from that
+ * segment on: every later append fails with OutOfMemory. Segments are installed
+ * in order and each one is either installed or marked failed exactly once, so no
+ * append ever constructs an element past that point that get_size() and clear()
+ * would not see.
+ *
+ * @code
+ * ConcurrentDynArray<Sample, ConcurrentLinearAllocator*> samples(&arena);
+ * // on any number of threads:
+ * Sample& s = samples.emplace_back(reading, now).value(); // s never moves
+ * // after joining the producers:
+ * samples.for_each([](std::span<Sample> run) { process(run); });
+ * @endcode
+ *
+ * @tparam T The type of elements stored in the array
+ * @tparam Alloc Allocator type or pointer to a thread-safe allocator (see BasicAllocatorHandle)
+ * @tparam BaseSize Number of elements in the first segment (power of two)
+ */
+template <typename T, BasicAllocatorHandle Alloc = HeapAllocator, size_t BaseSize = 32>
+struct ConcurrentDynArray {
+    static_assert(std::has_single_bit(BaseSize), "BaseSize has to be a power of two");
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "Segments are freed in whatever order threads lose races and clear() runs, not LIFO");
+
+    /**
+     * @brief log2 of BaseSize
+     */
+    static constexpr unsigned BASE_SHIFT = std::countr_zero(BaseSize);
+
+    /**
+     * @brief Number of segment slots, enough to index the whole size_t range
+     */
+    static constexpr size_t MAX_SEGMENTS = std::numeric_limits<size_t>::digits - BASE_SHIFT;
+
+    /**
+     * @brief Number of elements all segments together can hold
+     */
+    static constexpr size_t MAX_CAPACITY = SIZE_MAX - BaseSize + 1;
+
+    // Data members first (following data-oriented approach)
+    std::atomic<T*> segments[MAX_SEGMENTS]; ///< Segment k holds BaseSize << k elements, nullptr until allocated, failed_segment() if that failed
+    std::atomic<size_t> reserved;           ///< Number of indices handed out so far
+    std::atomic<size_t> limit;              ///< First index that can no longer be stored (lowered on allocation failure)
+    [[no_unique_address]] Alloc allocator;  ///< Allocator (or pointer to it) the segments come from
+
+    /**
+     * @brief Default constructor, nothing is allocated until the first append
+     */
+    ConcurrentDynArray();
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Thread-safe allocator to use (or pointer to it)
+     */
+    explicit ConcurrentDynArray(Alloc alloc);
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys all elements and hands the segments back to the allocator.
+     */
+    ~ConcurrentDynArray();
+
+    ConcurrentDynArray(const ConcurrentDynArray&) = delete;
+    ConcurrentDynArray& operator=(const ConcurrentDynArray&) = delete;
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other Array to take the segments from (must not be in use by other threads)
+     */
+    ConcurrentDynArray(ConcurrentDynArray&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator
+     *
+     * @param other Array to take the segments from (must not be in use by other threads)
+     * @return Reference to this array
+     */
+    ConcurrentDynArray& operator=(ConcurrentDynArray&& other) noexcept;
+
+    /**
+     * @brief Append a copy of value, from any thread
+     *
+     * @param value Element to copy
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Stable reference to the new element or OutOfMemory
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> push_back(const T& value);
+
+    /**
+     * @brief Append value by moving it, from any thread
+     *
+     * @param value Element to move
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Stable reference to the new element or OutOfMemory
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> push_back(T&& value);
+
+    /**
+     * @brief Construct an element in place at the end, from any thread
+     *
+     * @param args Constructor arguments
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Stable reference to the new element or OutOfMemory
+     */
+    template <typename... Args>
+    std::expected<std::reference_wrapper<T>, DynArrayError> emplace_back(Args&&... args);
+
+    /**
+     * @brief Allocate the segments needed to hold capacity elements
+     *
+     * Appends below capacity then never call the allocator. Safe to call
+     * concurrently with appends if the allocator is thread-safe.
+     *
+     * @param capacity Number of elements to make room for
+     * @return std::expected<void, DynArrayError> Success or OutOfMemory
+     */
+    std::expected<void, DynArrayError> reserve(size_t capacity);
+
+    /**
+     * @brief Access an element
+     *
+     * @param index Index of the element
+     * @return Reference to the element
+     * @throws std::out_of_range if index >= get_size()
+     */
+    T& operator[](size_t index);
+
+    /**
+     * @brief Access an element
+     *
+     * @param index Index of the element
+     * @return Const reference to the element
+     * @throws std::out_of_range if index >= get_size()
+     */
+    const T& operator[](size_t index) const;
+
+    /**
+     * @brief Access an element with bounds checking
+     *
+     * @param index Index of the element
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Element or OutOfRange
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> at(size_t index);
+
+    /**
+     * @brief Get the number of elements appended so far
+     *
+     * @return Number of elements, including ones other threads are still constructing
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Check if nothing was appended yet
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the number of segments holding elements
+     *
+     * @return Number of segments get_size() elements span
+     */
+    size_t segment_count() const;
+
+    /**
+     * @brief View the elements of one segment
+     *
+     * @param segment Segment number (less than segment_count())
+     * @return std::span<T> Contiguous elements of the segment, the last one possibly partial
+     */
+    std::span<T> segment(size_t segment);
+
+    /**
+     * @brief View the elements of one segment
+     *
+     * @param segment Segment number (less than segment_count())
+     * @return std::span<const T> Contiguous elements of the segment, the last one possibly partial
+     */
+    std::span<const T> segment(size_t segment) const;
+
+    /**
+     * @brief Call f with each segment's elements in order
+     *
+     * @param f Callable taking a std::span<T>
+     */
+    template <typename F>
+    void for_each(F&& f);
+
+    /**
+     * @brief Destroy all elements, keeping the segments for reuse
+     *
+     * Segments that failed to allocate are forgotten, so later appends try again.
+     *
+     * @note Not thread-safe, no appends may run concurrently.
+     */
+    void clear();
+
+    /**
+     * @brief Segment holding an index
+     *
+     * @param index Element index
+     * @return Segment number
+     */
+    static constexpr size_t segment_of(size_t index) {
+        return static_cast<size_t>(std::bit_width((index >> BASE_SHIFT) + 1)) - 1;
+    }
+
+    /**
+     * @brief Index of the first element of a segment
+     *
+     * @param segment Segment number
+     * @return Index of its first element
+     */
+    static constexpr size_t segment_start(size_t segment) {
+        return BaseSize * ((size_t{1} << segment) - 1);
+    }
+
+    /**
+     * @brief Number of elements in a segment
+     *
+     * @param segment Segment number
+     * @return Capacity of the segment
+     */
+    static constexpr size_t segment_size(size_t segment) {
+        return BaseSize << segment;
+    }
+
+private:
+    /**
+     * @brief Marker stored in a segment slot whose allocation failed
+     */
+    alignas(T) static inline unsigned char failed_marker = 0;
+
+    /**
+     * @brief Get the marker for a failed segment, never a real segment address
+     *
+     * @return Pointer to failed_marker
+     */
+    static T* failed_segment() { return reinterpret_cast<T*>(&failed_marker); }
+
+    /**
+     * @brief Find the slot of a claimed index, allocating its segment if needed
+     *
+     * @param index Index returned by the fetch_add on reserved
+     * @return Pointer to uninitialized storage, nullptr if it cannot be stored
+     */
+    T* slot_for(size_t index);
+
+    /**
+     * @brief Get a segment, allocating and publishing it if nobody has yet
+     *
+     * The segments before it are acquired first, so an installed segment only ever
+     * follows installed ones. If the allocation fails, the slot is marked failed with
+     * the same compare-and-swap that would have published it, and limit is lowered
+     * to the start of the segment; a block allocated by a racing thread is then
+     * handed back instead of used.
+     *
+     * @param segment Segment number
+     * @return The segment, nullptr if it (or one before it) could not be allocated
+     */
+    T* acquire_segment(size_t segment);
+
+    /**
+     * @brief Destroy every element and give the segments back
+     */
+    void release();
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/ConcurrentDynArray.tpp"
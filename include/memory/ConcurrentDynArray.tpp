@@ -0,0 +1,294 @@
+#pragma once
+
+#include "memory/ConcurrentDynArray.hpp"
+
+#include <new>
+
+namespace memory {
+
+// Default constructor
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+ConcurrentDynArray<T, Alloc, BaseSize>::ConcurrentDynArray()
+    : reserved(0), limit(MAX_CAPACITY), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    for (auto& slot : segments) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+// Constructor with custom allocator
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+ConcurrentDynArray<T, Alloc, BaseSize>::ConcurrentDynArray(Alloc alloc)
+    : reserved(0), limit(MAX_CAPACITY), allocator(alloc) {
+    for (auto& slot : segments) {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+// Destructor
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+ConcurrentDynArray<T, Alloc, BaseSize>::~ConcurrentDynArray() {
+    release();
+}
+
+// Move constructor
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+ConcurrentDynArray<T, Alloc, BaseSize>::ConcurrentDynArray(ConcurrentDynArray&& other) noexcept
+    : reserved(other.reserved.load(std::memory_order_relaxed)),
+      limit(other.limit.load(std::memory_order_relaxed)),
+      allocator(other.allocator) {
+    for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+        segments[k].store(other.segments[k].exchange(nullptr, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    other.reserved.store(0, std::memory_order_relaxed);
+    other.limit.store(MAX_CAPACITY, std::memory_order_relaxed);
+}
+
+// Move assignment operator
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+ConcurrentDynArray<T, Alloc, BaseSize>& ConcurrentDynArray<T, Alloc, BaseSize>::operator=(
+    ConcurrentDynArray&& other) noexcept {
+    if (this != &other) {
+        release();
+        allocator = other.allocator;
+        reserved.store(other.reserved.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+        limit.store(other.limit.exchange(MAX_CAPACITY, std::memory_order_relaxed), std::memory_order_relaxed);
+        for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+            segments[k].store(other.segments[k].exchange(nullptr, std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+        }
+    }
+    return *this;
+}
+
+// Append a copy
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::expected<std::reference_wrapper<T>, DynArrayError> ConcurrentDynArray<T, Alloc, BaseSize>::push_back(
+    const T& value) {
+    return emplace_back(value);
+}
+
+// Append by moving
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::expected<std::reference_wrapper<T>, DynArrayError> ConcurrentDynArray<T, Alloc, BaseSize>::push_back(T&& value) {
+    return emplace_back(std::move(value));
+}
+
+// Construct an element in place at the end
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+template <typename... Args>
+std::expected<std::reference_wrapper<T>, DynArrayError> ConcurrentDynArray<T, Alloc, BaseSize>::emplace_back(
+    Args&&... args) {
+    // The only shared write on the common path; the index is ours from here on
+    size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+    T* slot = slot_for(index);
+    if (slot == nullptr) {
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+    T* element = ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+    return std::ref(*element);
+}
+
+// Allocate the segments for capacity elements
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::expected<void, DynArrayError> ConcurrentDynArray<T, Alloc, BaseSize>::reserve(size_t capacity) {
+    if (capacity == 0) {
+        return {};
+    }
+    if (capacity > MAX_CAPACITY) {
+        return std::unexpected(DynArrayError::InvalidCapacity);
+    }
+    size_t last = segment_of(capacity - 1);
+    for (size_t k = 0; k <= last; ++k) {
+        if (acquire_segment(k) == nullptr) {
+            return std::unexpected(DynArrayError::OutOfMemory);
+        }
+    }
+    return {};
+}
+
+// Subscript operator
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+T& ConcurrentDynArray<T, Alloc, BaseSize>::operator[](size_t index) {
+    if (index >= get_size()) {
+        throw std::out_of_range("ConcurrentDynArray index out of range");
+    }
+    size_t k = segment_of(index);
+    return segments[k].load(std::memory_order_acquire)[index - segment_start(k)];
+}
+
+// Const subscript operator
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+const T& ConcurrentDynArray<T, Alloc, BaseSize>::operator[](size_t index) const {
+    if (index >= get_size()) {
+        throw std::out_of_range("ConcurrentDynArray index out of range");
+    }
+    size_t k = segment_of(index);
+    return segments[k].load(std::memory_order_acquire)[index - segment_start(k)];
+}
+
+// Safe element access with error handling
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::expected<std::reference_wrapper<T>, DynArrayError> ConcurrentDynArray<T, Alloc, BaseSize>::at(size_t index) {
+    if (index >= get_size()) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    size_t k = segment_of(index);
+    return std::ref(segments[k].load(std::memory_order_acquire)[index - segment_start(k)]);
+}
+
+// Number of elements appended so far
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+size_t ConcurrentDynArray<T, Alloc, BaseSize>::get_size() const {
+    // Indices past the limit were claimed by appends that failed
+    size_t claimed = reserved.load(std::memory_order_acquire);
+    size_t stored = limit.load(std::memory_order_acquire);
+    return claimed < stored ? claimed : stored;
+}
+
+// Check if nothing was appended yet
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+bool ConcurrentDynArray<T, Alloc, BaseSize>::empty() const {
+    return get_size() == 0;
+}
+
+// Number of segments holding elements
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+size_t ConcurrentDynArray<T, Alloc, BaseSize>::segment_count() const {
+    size_t size = get_size();
+    return size == 0 ? 0 : segment_of(size - 1) + 1;
+}
+
+// Elements of one segment
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::span<T> ConcurrentDynArray<T, Alloc, BaseSize>::segment(size_t segment) {
+    if (segment >= MAX_SEGMENTS) {
+        return {};
+    }
+    size_t size = get_size();
+    size_t start = segment_start(segment);
+    if (start >= size) {
+        return {};
+    }
+    size_t count = size - start < segment_size(segment) ? size - start : segment_size(segment);
+    return {segments[segment].load(std::memory_order_acquire), count};
+}
+
+// Elements of one segment
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+std::span<const T> ConcurrentDynArray<T, Alloc, BaseSize>::segment(size_t segment) const {
+    if (segment >= MAX_SEGMENTS) {
+        return {};
+    }
+    size_t size = get_size();
+    size_t start = segment_start(segment);
+    if (start >= size) {
+        return {};
+    }
+    size_t count = size - start < segment_size(segment) ? size - start : segment_size(segment);
+    return {segments[segment].load(std::memory_order_acquire), count};
+}
+
+// Call f with each segment's elements
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+template <typename F>
+void ConcurrentDynArray<T, Alloc, BaseSize>::for_each(F&& f) {
+    size_t count = segment_count();
+    for (size_t k = 0; k < count; ++k) {
+        f(segment(k));
+    }
+}
+
+// Destroy all elements, keeping the segments
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+void ConcurrentDynArray<T, Alloc, BaseSize>::clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        for_each([](std::span<T> run) { std::destroy(run.begin(), run.end()); });
+    }
+    for (auto& slot : segments) {
+        // Let later appends retry segments that failed
+        T* expected = failed_segment();
+        slot.compare_exchange_strong(expected, nullptr, std::memory_order_relaxed);
+    }
+    reserved.store(0, std::memory_order_relaxed);
+    limit.store(MAX_CAPACITY, std::memory_order_relaxed);
+}
+
+// Slot of a claimed index
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+T* ConcurrentDynArray<T, Alloc, BaseSize>::slot_for(size_t index) {
+    if (index >= limit.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    size_t k = segment_of(index);
+    T* segment = segments[k].load(std::memory_order_acquire);
+    if (segment == nullptr || segment == failed_segment()) [[unlikely]] {
+        segment = acquire_segment(k);
+        if (segment == nullptr) {
+            return nullptr;
+        }
+    }
+    return segment + (index - segment_start(k));
+}
+
+// Get a segment, allocating and publishing it if needed
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+T* ConcurrentDynArray<T, Alloc, BaseSize>::acquire_segment(size_t segment) {
+    T* current = segments[segment].load(std::memory_order_acquire);
+    if (current == failed_segment()) {
+        return nullptr;
+    }
+    if (current != nullptr) {
+        return current;
+    }
+
+    // Segments are installed in order, so a failure below can never strand elements above it
+    if (segment > 0 && acquire_segment(segment - 1) == nullptr) {
+        return nullptr;
+    }
+
+    size_t count = segment_size(segment);
+    auto& alloc = detail::allocator_of(allocator);
+    T* fresh = nullptr;
+    if (count <= SIZE_MAX / sizeof(T)) {
+        auto memory = detail::allocate_from(alloc, count * sizeof(T), alignof(T));
+        if (memory) {
+            fresh = static_cast<T*>(memory.value());
+        }
+    }
+
+    // Publish the block, or mark the segment failed; either way its fate is decided once
+    T* desired = fresh != nullptr ? fresh : failed_segment();
+    if (segments[segment].compare_exchange_strong(current, desired, std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+        current = desired;
+    } else if (fresh != nullptr) {
+        // Lost the race: use the winner's outcome and give ours back
+        detail::deallocate_to(alloc, fresh, count * sizeof(T), alignof(T));
+    }
+
+    if (current == failed_segment()) {
+        // Nothing from this segment on can be stored; get_size() stops here
+        size_t start = segment_start(segment);
+        size_t stored = limit.load(std::memory_order_relaxed);
+        while (start < stored &&
+               !limit.compare_exchange_weak(stored, start, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        return nullptr;
+    }
+    return current;
+}
+
+// Destroy every element and give the segments back
+template <typename T, BasicAllocatorHandle Alloc, size_t BaseSize>
+void ConcurrentDynArray<T, Alloc, BaseSize>::release() {
+    clear();
+    auto& alloc = detail::allocator_of(allocator);
+    for (size_t k = 0; k < MAX_SEGMENTS; ++k) {
+        if (T* segment = segments[k].exchange(nullptr, std::memory_order_relaxed)) {
+            detail::deallocate_to(alloc, segment, segment_size(k) * sizeof(T), alignof(T));
+        }
+    }
+}
+
+} // namespace memory
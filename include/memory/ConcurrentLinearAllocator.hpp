@@ -0,0 +1,227 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Linear allocator that many threads can bump at the same time
+ *
+ * The offset and a reset epoch are packed into one atomic word and advanced with a
+ * compare-and-swap loop, so allocation takes no lock. Compared to LinearAllocator:
+ *
+ * - There is no prev_offset. "Last allocation" means the allocation that ends at the
+ *   current offset, and it is only extended in place if no other thread allocated
+ *   in between (see try_resize_in_place).
+ * - free_all is an epoch reset: it atomically rewinds the offset and bumps the epoch.
+ *   Memory handed out before the reset must no longer be used. A thread that may
+ *   still resize across a reset reads epoch() before allocating and passes it to
+ *   try_resize_in_place, which then fails once the epoch has moved on instead of
+ *   extending over a new epoch's allocation that happens to end at the same offset.
+ *
+ * @note Offsets are limited to MAX_CAPACITY bytes; larger buffers are clamped.
+ */
+struct ConcurrentLinearAllocator {
+    unsigned char* buf;           ///< Pointer to backing buffer
+    size_t buf_len;               ///< Length of backing buffer
+    std::atomic<uint64_t> state;  ///< Reset epoch (high bits) and current offset (low bits)
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Number of low bits of state holding the offset
+     */
+    static constexpr unsigned OFFSET_BITS = 40;
+
+    /**
+     * @brief Largest usable buffer length (1 TiB)
+     */
+    static constexpr size_t MAX_CAPACITY = (static_cast<size_t>(1) << OFFSET_BITS) - 1;
+
+    /**
+     * @brief Default alignment for allocations
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = LinearAllocator::DEFAULT_ALIGNMENT;
+
+    /**
+     * @brief Initialize a concurrent linear allocator with provided backing buffer
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @return ConcurrentLinearAllocator Initialized allocator
+     */
+    static ConcurrentLinearAllocator create(void* backing_buffer, size_t backing_buffer_length);
+
+    /**
+     * @brief Initialize a concurrent linear allocator over a region carved out of a linear allocator
+     *
+     * @param arena Arena to take the region from
+     * @param region_size Size of the region in bytes
+     * @return std::expected<ConcurrentLinearAllocator, AllocatorError> Initialized allocator or error
+     */
+    static std::expected<ConcurrentLinearAllocator, AllocatorError> create(LinearAllocator* arena, size_t region_size);
+
+    /**
+     * @brief Construct over a buffer, see create
+     *
+     * @param buffer Pointer to the backing buffer
+     * @param length Size of the backing buffer in bytes
+     */
+    ConcurrentLinearAllocator(unsigned char* buffer, size_t length);
+
+    /**
+     * @brief Move constructor (not thread-safe, the source must not be in use)
+     *
+     * @param other Allocator to move from
+     */
+    ConcurrentLinearAllocator(ConcurrentLinearAllocator&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator (not thread-safe, neither side may be in use)
+     *
+     * @param other Allocator to move from
+     * @return Reference to this allocator
+     */
+    ConcurrentLinearAllocator& operator=(ConcurrentLinearAllocator&& other) noexcept;
+
+    /**
+     * @brief Allocate memory with alignment, from any thread
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it, from any thread
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment, from any thread
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate memory with default alignment without zeroing it, from any thread
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Resize an existing allocation with alignment, from any thread
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note Resizes in place when the allocation still ends at the current offset,
+     *       otherwise allocates a new block and copies the data.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment, from any thread
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an allocation without moving it
+     *
+     * Succeeds only if old_memory + old_size is still the current offset, i.e. no
+     * other thread allocated since, and the new end fits.
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     *
+     * @note Only the offset is checked: after a racing free_all, a new allocation
+     *       ending at the same offset is indistinguishable. Use the overload taking
+     *       the allocation's epoch when resets can race with the resize.
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an allocation without moving it, unless the arena was reset since
+     *
+     * Compares the whole state word, so the resize also fails if free_all started a
+     * new epoch after the allocation, even when the offset matches again.
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param alloc_epoch Value of epoch() read before old_memory was allocated
+     * @return true if the allocation was resized in place, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size, uint64_t alloc_epoch);
+
+    /**
+     * @brief Free all allocations by starting a new epoch
+     *
+     * Safe to call while other threads allocate: each allocation lands either
+     * before the reset (and is released by it) or after it.
+     */
+    void free_all();
+
+    /**
+     * @brief Get the current reset epoch
+     *
+     * @return Number of free_all calls so far (wraps around)
+     */
+    uint64_t epoch() const;
+
+    /**
+     * @brief Get the number of bytes used in the current epoch
+     *
+     * @return Current offset into the buffer
+     */
+    size_t used() const;
+
+    /**
+     * @brief Get a snapshot of the usage statistics, from any thread
+     *
+     * The peak is exact; bytes_in_use may lag behind used() while threads race.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+};
+
+} // namespace memory
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <cassert>
@@ -11,8 +12,18 @@
 #include <stdexcept>
 #include <iterator>
 #include <functional> // For std::reference_wrapper
-
+#include <type_traits>
+#include <cstring>
+#include <ranges>
+#include <span>
+
+#include "memory/AlignmentPolicy.hpp"
+#include "memory/Allocator.hpp"
+#include "memory/ArrayOps.hpp"
+#include "memory/GrowthPolicy.hpp"
+#include "memory/HeapAllocator.hpp"
 #include "memory/LinearAllocator.hpp"
+#include "memory/SimdKernels.hpp"
 
 namespace memory {
 
@@ -27,37 +38,68 @@ enum class DynArrayError {
     EmptyArray         ///< Operation cannot be performed on empty array
 };
 
+/**
+ * @brief Padding an element does not change how it relocates
+ *
+ * @tparam T The padded type
+ */
+template <typename T>
+struct is_trivially_relocatable<CacheLinePadded<T>> : is_trivially_relocatable<T> {};
+
 /**
  * @brief Dynamic array implementation with custom allocator support
  *
  * A dynamic array that can grow as needed and supports custom allocators.
  * Provides standard container operations with error handling via std::expected.
  *
+ * The allocator is a template parameter, so there is no runtime dispatch between
+ * backends. It is either a stateless allocator held by value (HeapAllocator, the
+ * default, which takes no space) or a pointer to an allocator object, e.g.
+ * DynArray<int, LinearAllocator*>. LIFO-only allocators (StackAllocator) are
+ * rejected, since growing frees the old block after the new one is allocated.
+ *
+ * How much the array grows is a policy as well: GeometricGrowth<> (1.5x) by default,
+ * GeometricGrowth<2, 1> for arena-backed arrays, PageGrowth for huge ones.
+ *
+ * So is the alignment of the storage: alignof(T) by default, CacheLineAlignment for
+ * arrays scanned with wide vector loads or shared between threads, PageAlignment
+ * for buffers handed to the OS. Every backend honours it through alloc_align.
+ *
  * @tparam T The type of elements stored in the array
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle, not is_lifo_allocator)
+ * @tparam Growth Growth policy deciding the capacity on reallocation (see GrowthPolicy)
+ * @tparam Align Alignment policy for the storage (see AlignmentPolicy)
  */
-template <typename T>
+template <typename T, AllocatorHandle Alloc = HeapAllocator, GrowthPolicy Growth = GeometricGrowth<>,
+          AlignmentPolicy Align = NaturalAlignment>
 struct DynArray {
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "DynArray frees the old block after allocating the new one, which a LIFO allocator "
+                  "would treat as freeing everything above it");
     // Data members first (following data-oriented approach)
     T*              data;        ///< Pointer to the array data
     size_t          size;        ///< Current number of elements
     size_t          capacity;    ///< Current capacity of the array
-    LinearAllocator* allocator;  ///< Optional custom allocator
-    bool            owns_allocator; ///< Whether we own the allocator (should delete it)
+    [[no_unique_address]] Alloc allocator; ///< Allocator (or pointer to it) the data comes from
+    [[no_unique_address]] StatsRecorder recorder; ///< Growth statistics (empty unless MEMORY_ENABLE_STATS)
 
     /**
-     * @brief Default growth factor when resizing
+     * @brief Capacity allocated by the first insert into an empty array
      */
-    static constexpr float GROWTH_FACTOR = 1.5f;
+    static constexpr size_t DEFAULT_CAPACITY = 8;
 
     /**
-     * @brief Default initial capacity if none specified
+     * @brief Alignment of the storage, as chosen by the alignment policy
      */
-    static constexpr size_t DEFAULT_CAPACITY = 8;
+    static constexpr size_t ALIGNMENT = Align::alignment(alignof(T));
+    static_assert(std::has_single_bit(ALIGNMENT) && ALIGNMENT >= alignof(T),
+                  "Alignment policy has to return a power of two no smaller than alignof(T)");
 
     /**
      * @brief Default constructor
      *
-     * Creates an empty dynamic array with default capacity.
+     * Creates an empty dynamic array without allocating; the first insert
+     * allocates DEFAULT_CAPACITY elements.
      */
     DynArray();
 
@@ -78,19 +120,19 @@ struct DynArray {
     /**
      * @brief Constructor with custom allocator
      *
-     * @param alloc Pointer to a LinearAllocator to use
-     * @param take_ownership Whether to take ownership of the allocator
+     * Like the default constructor, nothing is allocated until the first insert.
+     *
+     * @param alloc Allocator to use (or pointer to it)
      */
-    explicit DynArray(LinearAllocator* alloc, bool take_ownership = false);
+    explicit DynArray(Alloc alloc);
 
     /**
      * @brief Constructor with initial capacity and custom allocator
      *
      * @param initial_capacity Initial capacity to allocate
-     * @param alloc Pointer to a LinearAllocator to use
-     * @param take_ownership Whether to take ownership of the allocator
+     * @param alloc Allocator to use (or pointer to it)
      */
-    DynArray(size_t initial_capacity, LinearAllocator* alloc, bool take_ownership = false);
+    DynArray(size_t initial_capacity, Alloc alloc);
 
     /**
      * @brief Destructor
@@ -102,6 +144,8 @@ struct DynArray {
     /**
      * @brief Copy constructor
      *
+     * The copy uses the same allocator as other.
+     *
      * @param other DynArray to copy from
      */
     DynArray(const DynArray& other);
@@ -116,6 +160,8 @@ struct DynArray {
     /**
      * @brief Copy assignment operator
      *
+     * Elements are copied into memory from this array's own allocator.
+     *
      * @param other DynArray to copy from
      * @return Reference to this DynArray
      */
@@ -124,6 +170,8 @@ struct DynArray {
     /**
      * @brief Move assignment operator
      *
+     * Takes over other's block together with its allocator.
+     *
      * @param other DynArray to move from
      * @return Reference to this DynArray
      */
@@ -226,11 +274,34 @@ struct DynArray {
      */
     size_t get_capacity() const;
 
+    /**
+     * @brief Get a snapshot of the growth statistics
+     *
+     * allocations counts the first block, resizes_in_place and resizes_moved the
+     * growths after it, and bytes_in_use the capacity in bytes.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the allocator the array allocates from
+     *
+     * @return Reference to the allocator (the pointee if Alloc is a pointer)
+     */
+    std::remove_pointer_t<Alloc>& get_allocator();
+
     /**
      * @brief Reserve memory for at least the specified number of elements
      *
      * @param new_capacity New capacity to reserve
      * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note Trivially relocatable elements are grown with the allocator's resize_align,
+     *       which extends the block in place where it can (realloc, the arena's most
+     *       recent allocation, a free neighbour). Other types are only extended with
+     *       try_resize_in_place; otherwise they are moved to a new block and the old
+     *       one is freed.
      */
     std::expected<void, DynArrayError> reserve(size_t new_capacity);
 
@@ -243,6 +314,20 @@ struct DynArray {
      */
     std::expected<void, DynArrayError> resize(size_t count, const T& value = T());
 
+    /**
+     * @brief Resize the array to contain count elements without initializing new ones
+     *
+     * For filling the array directly from read(), decoders and the like. Growth is
+     * amortized like push_back, so repeated calls stay linear overall.
+     *
+     * @param count New size of the array
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note Only available for trivially copyable types; new elements hold
+     *       indeterminate values until written.
+     */
+    std::expected<void, DynArrayError> resize_uninitialized(size_t count);
+
     /**
      * @brief Shrink capacity to fit the current size
      *
@@ -273,6 +358,43 @@ struct DynArray {
      */
     std::expected<void, DynArrayError> push_back(T&& value);
 
+    /**
+     * @brief Construct an element in place at the end of the array
+     *
+     * @tparam Args Types of the constructor arguments
+     * @param args Arguments forwarded to the constructor of T
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to the new element or error
+     */
+    template <typename... Args>
+    std::expected<std::reference_wrapper<T>, DynArrayError> emplace_back(Args&&... args);
+
+    /**
+     * @brief Append the elements [first, last) to the end of the array
+     *
+     * Capacity is reserved once for forward iterators; trivially copyable elements
+     * from contiguous iterators are copied with a single memcpy.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param first Iterator to the first element to append
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> append_range(It first, Sent last);
+
+    /**
+     * @brief Append the elements of a range to the end of the array
+     *
+     * @tparam R Input range type
+     * @param range Range of elements to append (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> append_range(R&& range);
+
     /**
      * @brief Remove the last element from the array
      *
@@ -289,6 +411,36 @@ struct DynArray {
      */
     std::expected<void, DynArrayError> insert(size_t position, const T& value);
 
+    /**
+     * @brief Insert the elements [first, last) at the specified position
+     *
+     * For forward iterators, capacity is reserved once and the tail is shifted once;
+     * trivially copyable elements from contiguous iterators are copied with a single
+     * memcpy. Input iterators are appended and then rotated into place.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param position Position to insert at (as index)
+     * @param first Iterator to the first element to insert
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> insert_range(size_t position, It first, Sent last);
+
+    /**
+     * @brief Insert the elements of a range at the specified position
+     *
+     * @tparam R Input range type
+     * @param position Position to insert at (as index)
+     * @param range Range of elements to insert (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> insert_range(size_t position, R&& range);
+
     /**
      * @brief Erase an element at the specified position
      *
@@ -306,6 +458,70 @@ struct DynArray {
      */
     std::expected<void, DynArrayError> erase_range(size_t first, size_t last);
 
+    // Bulk operations for arithmetic element types, run by the vector kernels of
+    // SimdKernels.hpp at the best instruction set the CPU supports
+
+    /**
+     * @brief Set every element to value
+     *
+     * @param value Value to store
+     */
+    void fill(const T& value) requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Find the first element equal to value
+     *
+     * @param value Value to look for
+     * @return size_t Index of the first match, get_size() if there is none
+     */
+    size_t find(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Check if any element equals value
+     *
+     * @param value Value to look for
+     * @return true if found, false otherwise
+     */
+    bool contains(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Count the elements equal to value
+     *
+     * @param value Value to count
+     * @return size_t Number of matches
+     */
+    size_t count(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Get the smallest element
+     *
+     * @return std::expected<T, DynArrayError> Smallest element or EmptyArray
+     */
+    std::expected<T, DynArrayError> min() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Get the largest element
+     *
+     * @return std::expected<T, DynArrayError> Largest element or EmptyArray
+     */
+    std::expected<T, DynArrayError> max() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Add up the elements
+     *
+     * @return simd::sum_t<T> Sum in 64 bits for integers, in T for floating point
+     */
+    simd::sum_t<T> sum() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Replace every element with f(element)
+     *
+     * @param f Callable taking and returning T, compiled for the active instruction set
+     */
+    template <typename F>
+        requires (simd::Arithmetic<T> && std::is_invocable_r_v<T, F&, T>)
+    void transform(F f);
+
     // Iterator support
     using iterator = T*;
     using const_iterator = const T*;
@@ -360,6 +576,19 @@ private:
      * @return std::expected<void, DynArrayError> Success or error
      */
     std::expected<void, DynArrayError> grow(size_t min_capacity);
+
+    /**
+     * @brief Move the elements to a block of new_capacity elements
+     *
+     * @param new_capacity Capacity of the new block (at least size)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> reallocate(size_t new_capacity);
+
+    /**
+     * @brief Hand the current block back to the allocator
+     */
+    void release();
 };
 
 } // namespace memory
@@ -5,28 +5,28 @@
 namespace memory {
 
 
-template <typename T>
-DynArray<T>::DynArray()
-    : data(nullptr), size(0), capacity(0), allocator(nullptr), owns_allocator(false) {
-    // Default constructor
-    auto result = reserve(DEFAULT_CAPACITY);
-    // In a default constructor, we can't really report errors, so we assert
-    assert(result.has_value() && "Failed to allocate initial capacity");
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray()
+    : data(nullptr), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Default constructor, nothing is allocated until the first insert
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(size_t initial_capacity)
-    : data(nullptr), size(0), capacity(0), allocator(nullptr), owns_allocator(false) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(size_t initial_capacity)
+    : data(nullptr), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
     // Constructor with initial capacity
     auto result = reserve(initial_capacity);
     assert(result.has_value() && "Failed to allocate initial capacity");
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(std::initializer_list<T> elements)
-    : data(nullptr), size(0), capacity(0), allocator(nullptr), owns_allocator(false) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(std::initializer_list<T> elements)
+    : data(nullptr), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
     // Constructor with initializer list
     auto result = reserve(elements.size());
     if (result.has_value()) {
@@ -40,51 +40,43 @@ DynArray<T>::DynArray(std::initializer_list<T> elements)
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(LinearAllocator* alloc, bool take_ownership)
-    : data(nullptr), size(0), capacity(0), allocator(alloc), owns_allocator(take_ownership) {
-    // Constructor with custom allocator
-    auto result = reserve(DEFAULT_CAPACITY);
-    assert(result.has_value() && "Failed to allocate initial capacity with custom allocator");
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(Alloc alloc)
+    : data(nullptr), size(0), capacity(0), allocator(alloc) {
+    // Constructor with custom allocator, nothing is allocated until the first insert
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(size_t initial_capacity, LinearAllocator* alloc, bool take_ownership)
-    : data(nullptr), size(0), capacity(0), allocator(alloc), owns_allocator(take_ownership) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(size_t initial_capacity, Alloc alloc)
+    : data(nullptr), size(0), capacity(0), allocator(alloc) {
     // Constructor with initial capacity and custom allocator
     auto result = reserve(initial_capacity);
     assert(result.has_value() && "Failed to allocate initial capacity with custom allocator");
 }
 
 
-template <typename T>
-DynArray<T>::~DynArray() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::~DynArray() {
     // Destructor - Rule of 5 #1
     // Destroy all elements
     for (size_t i = 0; i < size; ++i) {
         data[i].~T();
     }
 
-    // Free memory if we're not using a custom allocator
-    if (!allocator) {
-        free(data);
-    } else if (owns_allocator) {
-        delete allocator;
-    }
+    // Give the block back to the allocator
+    release();
 
     // Reset all members for safety
     data = nullptr;
     size = 0;
     capacity = 0;
-    allocator = nullptr;
-    owns_allocator = false;
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(const DynArray& other)
-    : data(nullptr), size(0), capacity(0), allocator(nullptr), owns_allocator(false) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(const DynArray& other)
+    : data(nullptr), size(0), capacity(0), allocator(other.allocator) {
     // Copy constructor - Rule of 5 #2
     // Reserve capacity for the elements
     auto result = reserve(other.capacity);
@@ -100,22 +92,19 @@ DynArray<T>::DynArray(const DynArray& other)
 }
 
 
-template <typename T>
-DynArray<T>::DynArray(DynArray&& other) noexcept
-    : data(other.data), size(other.size), capacity(other.capacity),
-      allocator(other.allocator), owns_allocator(other.owns_allocator) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>::DynArray(DynArray&& other) noexcept
+    : data(other.data), size(other.size), capacity(other.capacity), allocator(other.allocator) {
     // Move constructor - Rule of 5 #3
-    // Reset the source object
+    // Reset the source object; it keeps its allocator so it stays usable
     other.data = nullptr;
     other.size = 0;
     other.capacity = 0;
-    other.allocator = nullptr;
-    other.owns_allocator = false;
 }
 
 
-template <typename T>
-DynArray<T>& DynArray<T>::operator=(const DynArray& other) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>& DynArray<T, Alloc, Growth, Align>::operator=(const DynArray& other) {
     // Copy assignment operator - Rule of 5 #4
     if (this != &other) {
         // Clear existing data
@@ -137,38 +126,31 @@ DynArray<T>& DynArray<T>::operator=(const DynArray& other) {
 }
 
 
-template <typename T>
-DynArray<T>& DynArray<T>::operator=(DynArray&& other) noexcept {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+DynArray<T, Alloc, Growth, Align>& DynArray<T, Alloc, Growth, Align>::operator=(DynArray&& other) noexcept {
     // Move assignment operator - Rule of 5 #5
     if (this != &other) {
         // Clean up existing resources
         clear();
-        if (!allocator) {
-            free(data);
-        } else if (owns_allocator) {
-            delete allocator;
-        }
+        release();
 
         // Move resources from other
         data = other.data;
         size = other.size;
         capacity = other.capacity;
         allocator = other.allocator;
-        owns_allocator = other.owns_allocator;
 
         // Reset the source object
         other.data = nullptr;
         other.size = 0;
         other.capacity = 0;
-        other.allocator = nullptr;
-        other.owns_allocator = false;
     }
     return *this;
 }
 
 
-template <typename T>
-T& DynArray<T>::operator[](size_t index) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+T& DynArray<T, Alloc, Growth, Align>::operator[](size_t index) {
     // Subscript operator
     if (index >= size) {
         throw std::out_of_range("DynArray index out of range");
@@ -177,8 +159,8 @@ T& DynArray<T>::operator[](size_t index) {
 }
 
 // Const subscript operator
-template <typename T>
-const T& DynArray<T>::operator[](size_t index) const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+const T& DynArray<T, Alloc, Growth, Align>::operator[](size_t index) const {
     if (index >= size) {
         throw std::out_of_range("DynArray index out of range");
     }
@@ -186,8 +168,8 @@ const T& DynArray<T>::operator[](size_t index) const {
 }
 
 // Safe element access with error handling
-template <typename T>
-std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::at(size_t index) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::at(size_t index) {
     if (index >= size) {
         return std::unexpected(DynArrayError::OutOfRange);
     }
@@ -195,8 +177,8 @@ std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::at(size_t i
 }
 
 // Safe const element access with error handling
-template <typename T>
-std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::at(size_t index) const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::at(size_t index) const {
     if (index >= size) {
         return std::unexpected(DynArrayError::OutOfRange);
     }
@@ -204,8 +186,8 @@ std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::at(si
 }
 
 // Get the first element
-template <typename T>
-std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::front() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::front() {
     if (empty()) {
         return std::unexpected(DynArrayError::EmptyArray);
     }
@@ -213,8 +195,8 @@ std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::front() {
 }
 
 // Get the const first element
-template <typename T>
-std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::front() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::front() const {
     if (empty()) {
         return std::unexpected(DynArrayError::EmptyArray);
     }
@@ -222,8 +204,8 @@ std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::front
 }
 
 // Get the last element
-template <typename T>
-std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::back() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::back() {
     if (empty()) {
         return std::unexpected(DynArrayError::EmptyArray);
     }
@@ -231,8 +213,8 @@ std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T>::back() {
 }
 
 // Get the const last element
-template <typename T>
-std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::back() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::back() const {
     if (empty()) {
         return std::unexpected(DynArrayError::EmptyArray);
     }
@@ -240,83 +222,54 @@ std::expected<std::reference_wrapper<const T>, DynArrayError> DynArray<T>::back(
 }
 
 // Get direct pointer to data
-template <typename T>
-T* DynArray<T>::get_data() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+T* DynArray<T, Alloc, Growth, Align>::get_data() {
     return data;
 }
 
 // Get const direct pointer to data
-template <typename T>
-const T* DynArray<T>::get_data() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+const T* DynArray<T, Alloc, Growth, Align>::get_data() const {
     return data;
 }
 
 // Check if array is empty
-template <typename T>
-bool DynArray<T>::empty() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+bool DynArray<T, Alloc, Growth, Align>::empty() const {
     return size == 0;
 }
 
 // Get size
-template <typename T>
-size_t DynArray<T>::get_size() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+size_t DynArray<T, Alloc, Growth, Align>::get_size() const {
     return size;
 }
 
 // Get capacity
-template <typename T>
-size_t DynArray<T>::get_capacity() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+size_t DynArray<T, Alloc, Growth, Align>::get_capacity() const {
     return capacity;
 }
 
+// Get the allocator
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::remove_pointer_t<Alloc>& DynArray<T, Alloc, Growth, Align>::get_allocator() {
+    return detail::allocator_of(allocator);
+}
+
 // Reserve memory
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::reserve(size_t new_capacity) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::reserve(size_t new_capacity) {
     if (new_capacity <= capacity) {
         return {}; // Nothing to do
     }
 
-    // Allocate new memory
-    T* new_data = nullptr;
-
-    if (allocator) {
-        // Use custom allocator
-        auto alloc_result = allocator->alloc_align(sizeof(T) * new_capacity, alignof(T));
-        if (!alloc_result) {
-            return std::unexpected(DynArrayError::OutOfMemory);
-        }
-        new_data = static_cast<T*>(alloc_result.value());
-    } else {
-        // Use standard allocator
-        new_data = static_cast<T*>(malloc(sizeof(T) * new_capacity));
-        if (!new_data) {
-            return std::unexpected(DynArrayError::OutOfMemory);
-        }
-    }
-
-    // Move existing elements to new memory
-    for (size_t i = 0; i < size; ++i) {
-        new (new_data + i) T(std::move(data[i])); // Placement new with move
-        data[i].~T(); // Destroy old object
-    }
-
-    // Free old memory if it existed
-    if (data) {
-        if (!allocator) {
-            free(data);
-        }
-    }
-
-    // Update pointers and capacity
-    data = new_data;
-    capacity = new_capacity;
-
-    return {};
+    return reallocate(new_capacity);
 }
 
 // Resize array
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::resize(size_t count, const T& value) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::resize(size_t count, const T& value) {
     if (count > capacity) {
         // Need to allocate more memory
         auto result = reserve(count);
@@ -327,8 +280,12 @@ std::expected<void, DynArrayError> DynArray<T>::resize(size_t count, const T& va
 
     if (count > size) {
         // Initialize new elements
-        for (size_t i = size; i < count; ++i) {
-            new (data + i) T(value); // Placement new to copy construct
+        if constexpr (simd::Arithmetic<T>) {
+            simd::fill(std::span<T>(data + size, count - size), value);
+        } else {
+            for (size_t i = size; i < count; ++i) {
+                new (data + i) T(value); // Placement new to copy construct
+            }
         }
     } else if (count < size) {
         // Destroy excess elements
@@ -341,62 +298,52 @@ std::expected<void, DynArrayError> DynArray<T>::resize(size_t count, const T& va
     return {};
 }
 
+// Resize without initializing new elements
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::resize_uninitialized(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "resize_uninitialized needs a trivially copyable type");
+
+    if (count > capacity) {
+        // Amortized growth, callers typically extend the array chunk by chunk
+        auto result = grow(count);
+        if (!result) {
+            return result;
+        }
+    }
+
+    size = count;
+    return {};
+}
+
+// Get growth statistics
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+AllocatorStats DynArray<T, Alloc, Growth, Align>::stats() const {
+    return recorder.snapshot();
+}
+
 // Shrink to fit
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::shrink_to_fit() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::shrink_to_fit() {
     if (size == capacity) {
         return {}; // Already fit
     }
 
     if (size == 0) {
         // Special case: completely empty
-        if (!allocator) {
-            free(data);
-        }
+        release();
         data = nullptr;
         capacity = 0;
+        recorder.record_free();
+        recorder.record_in_use(0);
         return {};
     }
 
-    // Allocate new memory of exact size
-    T* new_data = nullptr;
-
-    if (allocator) {
-        // Use custom allocator
-        auto alloc_result = allocator->alloc_align(sizeof(T) * size, alignof(T));
-        if (!alloc_result) {
-            return std::unexpected(DynArrayError::OutOfMemory);
-        }
-        new_data = static_cast<T*>(alloc_result.value());
-    } else {
-        // Use standard allocator
-        new_data = static_cast<T*>(malloc(sizeof(T) * size));
-        if (!new_data) {
-            return std::unexpected(DynArrayError::OutOfMemory);
-        }
-    }
-
-    // Move existing elements to new memory
-    for (size_t i = 0; i < size; ++i) {
-        new (new_data + i) T(std::move(data[i])); // Placement new with move
-        data[i].~T(); // Destroy old object
-    }
-
-    // Free old memory
-    if (!allocator) {
-        free(data);
-    }
-
-    // Update pointers and capacity
-    data = new_data;
-    capacity = size;
-
-    return {};
+    return reallocate(size);
 }
 
 // Clear array
-template <typename T>
-void DynArray<T>::clear() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+void DynArray<T, Alloc, Growth, Align>::clear() {
     // Destroy all elements
     for (size_t i = 0; i < size; ++i) {
         data[i].~T();
@@ -405,9 +352,9 @@ void DynArray<T>::clear() {
 }
 
 // Push back (copy)
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::push_back(const T& value) {
-    if (size >= capacity) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::push_back(const T& value) {
+    if (size >= capacity) [[unlikely]] {
         // Need to grow the array
         auto result = grow(size + 1);
         if (!result) {
@@ -423,9 +370,9 @@ std::expected<void, DynArrayError> DynArray<T>::push_back(const T& value) {
 }
 
 // Push back (move)
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::push_back(T&& value) {
-    if (size >= capacity) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::push_back(T&& value) {
+    if (size >= capacity) [[unlikely]] {
         // Need to grow the array
         auto result = grow(size + 1);
         if (!result) {
@@ -440,9 +387,42 @@ std::expected<void, DynArrayError> DynArray<T>::push_back(T&& value) {
     return {};
 }
 
+// Emplace back
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <typename... Args>
+std::expected<std::reference_wrapper<T>, DynArrayError> DynArray<T, Alloc, Growth, Align>::emplace_back(Args&&... args) {
+    if (size >= capacity) [[unlikely]] {
+        // Need to grow the array
+        auto result = grow(size + 1);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+    }
+
+    // Construct the element directly in its slot, no temporary
+    T* slot = new (data + size) T(std::forward<Args>(args)...);
+    ++size;
+
+    return std::ref(*slot);
+}
+
+// Append a range of elements
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::append_range(It first, Sent last) {
+    return insert_range(size, std::move(first), std::move(last));
+}
+
+// Append the elements of a range
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::append_range(R&& range) {
+    return insert_range(size, std::ranges::begin(range), std::ranges::end(range));
+}
+
 // Pop back
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::pop_back() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::pop_back() {
     if (empty()) {
         return std::unexpected(DynArrayError::EmptyArray);
     }
@@ -454,13 +434,13 @@ std::expected<void, DynArrayError> DynArray<T>::pop_back() {
 }
 
 // Insert element
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::insert(size_t position, const T& value) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::insert(size_t position, const T& value) {
     if (position > size) {
         return std::unexpected(DynArrayError::OutOfRange);
     }
 
-    if (size >= capacity) {
+    if (size >= capacity) [[unlikely]] {
         // Need to grow the array
         auto result = grow(size + 1);
         if (!result) {
@@ -470,10 +450,7 @@ std::expected<void, DynArrayError> DynArray<T>::insert(size_t position, const T&
 
     if (position < size) {
         // Shift elements to make room
-        for (size_t i = size; i > position; --i) {
-            new (data + i) T(std::move(data[i - 1])); // Move construct at new position
-            data[i - 1].~T(); // Destroy original
-        }
+        detail::shift_elements_right(data, size, position, 1);
     }
 
     // Construct new element at position
@@ -483,15 +460,62 @@ std::expected<void, DynArrayError> DynArray<T>::insert(size_t position, const T&
     return {};
 }
 
+// Insert a range of elements
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::insert_range(size_t position, It first, Sent last) {
+    if (position > size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if constexpr (std::forward_iterator<It>) {
+        size_t count = static_cast<size_t>(std::ranges::distance(first, last));
+        if (count == 0) {
+            return {};
+        }
+
+        // Reserve once for the whole range
+        if (size + count > capacity) {
+            auto result = grow(size + count);
+            if (!result) {
+                return result;
+            }
+        }
+
+        // Shift the tail once and copy the range into the gap
+        detail::insert_elements(data, size, position, std::move(first), count);
+        size += count;
+        return {};
+    } else {
+        // Single pass only: append at the end, then rotate the new elements into place
+        size_t old_size = size;
+        for (; first != last; ++first) {
+            auto result = emplace_back(*first);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+        std::rotate(data + position, data + old_size, data + size);
+        return {};
+    }
+}
+
+// Insert the elements of a range
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::insert_range(size_t position, R&& range) {
+    return insert_range(position, std::ranges::begin(range), std::ranges::end(range));
+}
+
 // Erase element
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::erase(size_t position) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::erase(size_t position) {
     return erase_range(position, position + 1);
 }
 
 // Erase range
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::erase_range(size_t first, size_t last) {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::erase_range(size_t first, size_t last) {
     if (first >= size || last > size || first > last) {
         return std::unexpected(DynArrayError::OutOfRange);
     }
@@ -504,15 +528,10 @@ std::expected<void, DynArrayError> DynArray<T>::erase_range(size_t first, size_t
     size_t count = last - first;
 
     // Destroy elements in the range
-    for (size_t i = first; i < last; ++i) {
-        data[i].~T();
-    }
+    std::destroy(data + first, data + last);
 
     // Shift remaining elements
-    for (size_t i = first; i < size - count; ++i) {
-        new (data + i) T(std::move(data[i + count])); // Move construct at new position
-        data[i + count].~T(); // Destroy original
-    }
+    detail::shift_elements_left(data, size, first, count);
 
     // Update size
     size -= count;
@@ -520,56 +539,188 @@ std::expected<void, DynArrayError> DynArray<T>::erase_range(size_t first, size_t
     return {};
 }
 
+// Fill with a value
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+void DynArray<T, Alloc, Growth, Align>::fill(const T& value) requires simd::Arithmetic<T> {
+    simd::fill(std::span<T>(data, size), value);
+}
+
+// Find a value
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+size_t DynArray<T, Alloc, Growth, Align>::find(const T& value) const requires simd::Arithmetic<T> {
+    return simd::find(std::span<const T>(data, size), value);
+}
+
+// Check for a value
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+bool DynArray<T, Alloc, Growth, Align>::contains(const T& value) const requires simd::Arithmetic<T> {
+    return simd::contains(std::span<const T>(data, size), value);
+}
+
+// Count a value
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+size_t DynArray<T, Alloc, Growth, Align>::count(const T& value) const requires simd::Arithmetic<T> {
+    return simd::count(std::span<const T>(data, size), value);
+}
+
+// Smallest element
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<T, DynArrayError> DynArray<T, Alloc, Growth, Align>::min() const requires simd::Arithmetic<T> {
+    if (size == 0) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return simd::min(std::span<const T>(data, size));
+}
+
+// Largest element
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<T, DynArrayError> DynArray<T, Alloc, Growth, Align>::max() const requires simd::Arithmetic<T> {
+    if (size == 0) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return simd::max(std::span<const T>(data, size));
+}
+
+// Sum of the elements
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+simd::sum_t<T> DynArray<T, Alloc, Growth, Align>::sum() const requires simd::Arithmetic<T> {
+    return simd::sum(std::span<const T>(data, size));
+}
+
+// Transform in place
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+template <typename F>
+    requires (simd::Arithmetic<T> && std::is_invocable_r_v<T, F&, T>)
+void DynArray<T, Alloc, Growth, Align>::transform(F f) {
+    simd::transform(std::span<const T>(data, size), std::span<T>(data, size), std::move(f));
+}
+
 // Begin iterator
-template <typename T>
-typename DynArray<T>::iterator DynArray<T>::begin() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::iterator DynArray<T, Alloc, Growth, Align>::begin() {
     return data;
 }
 
 // End iterator
-template <typename T>
-typename DynArray<T>::iterator DynArray<T>::end() {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::iterator DynArray<T, Alloc, Growth, Align>::end() {
     return data + size;
 }
 
 // Const begin iterator
-template <typename T>
-typename DynArray<T>::const_iterator DynArray<T>::begin() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::const_iterator DynArray<T, Alloc, Growth, Align>::begin() const {
     return data;
 }
 
 // Const end iterator
-template <typename T>
-typename DynArray<T>::const_iterator DynArray<T>::end() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::const_iterator DynArray<T, Alloc, Growth, Align>::end() const {
     return data + size;
 }
 
 // Explicit const begin iterator
-template <typename T>
-typename DynArray<T>::const_iterator DynArray<T>::cbegin() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::const_iterator DynArray<T, Alloc, Growth, Align>::cbegin() const {
     return data;
 }
 
 // Explicit const end iterator
-template <typename T>
-typename DynArray<T>::const_iterator DynArray<T>::cend() const {
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+typename DynArray<T, Alloc, Growth, Align>::const_iterator DynArray<T, Alloc, Growth, Align>::cend() const {
     return data + size;
 }
 
 // Internal function to grow the array capacity
-template <typename T>
-std::expected<void, DynArrayError> DynArray<T>::grow(size_t min_capacity) {
-    // Calculate new capacity using growth factor
-    size_t new_capacity = capacity == 0 ? DEFAULT_CAPACITY :
-                           static_cast<size_t>(capacity * GROWTH_FACTOR) + 1;
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::grow(size_t min_capacity) {
+    // The first allocation takes at least DEFAULT_CAPACITY elements
+    if (capacity == 0 && min_capacity < DEFAULT_CAPACITY) {
+        min_capacity = DEFAULT_CAPACITY;
+    }
+
+    // Let the growth policy pick the new capacity
+    auto result = reserve(Growth::next_capacity(capacity, min_capacity, sizeof(T)));
+    if (!result) {
+        return result;
+    }
 
-    // Ensure it's at least as large as requested
-    if (new_capacity < min_capacity) {
-        new_capacity = min_capacity;
+    if constexpr (uses_usable_size_v<Growth>) {
+        // Use the slack the allocator rounded the block up to
+        size_t usable = detail::usable_size_in(detail::allocator_of(allocator), data,
+                                               sizeof(T) * capacity, ALIGNMENT);
+        capacity = usable / sizeof(T);
     }
+    return {};
+}
 
-    // Reserve new capacity
-    return reserve(new_capacity);
+// Move the elements into a block of a new capacity
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<void, DynArrayError> DynArray<T, Alloc, Growth, Align>::reallocate(size_t new_capacity) {
+    auto& backend = detail::allocator_of(allocator);
+
+    if (data == nullptr) {
+        // No zeroing since elements are constructed in place
+        auto alloc_result = detail::allocate_from(backend, sizeof(T) * new_capacity, ALIGNMENT);
+        if (!alloc_result) {
+            recorder.record_failure();
+            return std::unexpected(DynArrayError::OutOfMemory);
+        }
+        data = static_cast<T*>(alloc_result.value());
+        capacity = new_capacity;
+        recorder.record_alloc(sizeof(T) * new_capacity);
+        recorder.record_in_use(sizeof(T) * capacity);
+        return {};
+    }
+
+    if constexpr (is_trivially_relocatable_v<T>) {
+        // The allocator may extend the block in place (realloc, arena top, free neighbour)
+        // and otherwise moves the bytes itself
+        auto resize_result = detail::resize_in(backend, data, sizeof(T) * capacity,
+                                               sizeof(T) * new_capacity, ALIGNMENT);
+        if (!resize_result) {
+            recorder.record_failure();
+            return std::unexpected(DynArrayError::OutOfMemory);
+        }
+        recorder.record_resize(resize_result.value() == data);
+        data = static_cast<T*>(resize_result.value());
+        capacity = new_capacity;
+        recorder.record_in_use(sizeof(T) * capacity);
+        return {};
+    } else {
+        // Elements stay put if the block can be resized where it is
+        if (detail::try_resize_in_place_in(backend, data, sizeof(T) * capacity, sizeof(T) * new_capacity)) {
+            capacity = new_capacity;
+            recorder.record_resize(true);
+            recorder.record_in_use(sizeof(T) * capacity);
+            return {};
+        }
+
+        auto alloc_result = detail::allocate_from(backend, sizeof(T) * new_capacity, ALIGNMENT);
+        if (!alloc_result) {
+            recorder.record_failure();
+            return std::unexpected(DynArrayError::OutOfMemory);
+        }
+        T* new_data = static_cast<T*>(alloc_result.value());
+
+        // Move existing elements to new memory, then free the old block
+        detail::relocate_elements(new_data, data, size);
+        release();
+
+        data = new_data;
+        capacity = new_capacity;
+        recorder.record_resize(false);
+        recorder.record_in_use(sizeof(T) * capacity);
+        return {};
+    }
+}
+
+// Hand the block back to the allocator
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+void DynArray<T, Alloc, Growth, Align>::release() {
+    if (data != nullptr) {
+        detail::deallocate_to(detail::allocator_of(allocator), data, sizeof(T) * capacity, ALIGNMENT);
+    }
 }
 
 } // namespace memory
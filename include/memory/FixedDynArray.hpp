@@ -0,0 +1,560 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <expected>
+#include <memory>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+#include <functional> // For std::reference_wrapper
+#include <type_traits>
+#include <cstring>
+#include <ranges>
+#include <span>
+
+#include "memory/ArrayOps.hpp"
+#include "memory/DynArray.hpp"
+
+namespace memory {
+
+/**
+ * @brief Dynamic array with a fixed capacity of N elements stored inline
+ *
+ * Same interface as DynArray, but without an allocator: all N slots live inside
+ * the object, so it never allocates and is as cheap to place on the stack as a
+ * plain array. Anything that would need more than N elements fails with
+ * DynArrayError::OutOfMemory instead of growing.
+ *
+ * Where the caller knows the array has room, push_back_unchecked and
+ * emplace_back_unchecked skip the std::expected result and only assert, which
+ * brings an append down to a placement new and an increment. Construction from
+ * a built-in array checks its length with a static_assert.
+ *
+ * @tparam T The type of elements stored in the array
+ * @tparam N Capacity in elements (must be at least 1)
+ *
+ * @note Moving the array moves its elements one by one, so moves are O(size).
+ */
+template <typename T, size_t N>
+struct FixedDynArray {
+    static_assert(N > 0, "FixedDynArray needs room for at least one element");
+    static_assert(N <= SIZE_MAX / sizeof(T), "FixedDynArray capacity overflows size_t");
+
+    // Data members first (following data-oriented approach)
+    size_t          size;        ///< Current number of elements
+    alignas(T) unsigned char storage[sizeof(T) * N]; ///< Storage for the N elements
+    [[no_unique_address]] StatsRecorder recorder; ///< Rejected appends (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Capacity in elements
+     */
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * @brief Default constructor
+     */
+    FixedDynArray();
+
+    /**
+     * @brief Constructor with initial elements
+     *
+     * @param elements Initializer list of elements (at most N)
+     *
+     * @note A longer list aborts the program in every build mode, since a constructor
+     *       cannot return the error. Use the built-in array constructor to have the
+     *       length checked at compile time instead.
+     */
+    FixedDynArray(std::initializer_list<T> elements);
+
+    /**
+     * @brief Constructor from a built-in array, its length checked at compile time
+     *
+     * @tparam M Number of elements (at most N)
+     * @param elements Elements to copy
+     */
+    template <size_t M>
+    explicit FixedDynArray(const T (&elements)[M]);
+
+    /**
+     * @brief Destructor
+     */
+    ~FixedDynArray();
+
+    /**
+     * @brief Copy constructor
+     *
+     * @param other FixedDynArray to copy from
+     */
+    FixedDynArray(const FixedDynArray& other);
+
+    /**
+     * @brief Move constructor
+     *
+     * Elements are moved one by one; other is left empty.
+     *
+     * @param other FixedDynArray to move from
+     */
+    FixedDynArray(FixedDynArray&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator
+     *
+     * @param other FixedDynArray to copy from
+     * @return Reference to this FixedDynArray
+     */
+    FixedDynArray& operator=(const FixedDynArray& other);
+
+    /**
+     * @brief Move assignment operator
+     *
+     * Elements are moved one by one; other is left empty.
+     *
+     * @param other FixedDynArray to move from
+     * @return Reference to this FixedDynArray
+     */
+    FixedDynArray& operator=(FixedDynArray&& other) noexcept;
+
+    /**
+     * @brief Subscript operator for element access
+     *
+     * @param index Index of element to access
+     * @return Reference to the element
+     * @throws std::out_of_range if index is out of bounds
+     */
+    T& operator[](size_t index);
+
+    /**
+     * @brief Const subscript operator for element access
+     *
+     * @param index Index of element to access
+     * @return Const reference to the element
+     * @throws std::out_of_range if index is out of bounds
+     */
+    const T& operator[](size_t index) const;
+
+    /**
+     * @brief Safe element access with error handling
+     *
+     * @param index Index of element to access
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> at(size_t index);
+
+    /**
+     * @brief Safe const element access with error handling
+     *
+     * @param index Index of element to access
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> at(size_t index) const;
+
+    /**
+     * @brief Get the first element in the array
+     *
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to first element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> front();
+
+    /**
+     * @brief Get the const first element in the array
+     *
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to first element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> front() const;
+
+    /**
+     * @brief Get the last element in the array
+     *
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to last element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> back();
+
+    /**
+     * @brief Get the const last element in the array
+     *
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to last element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> back() const;
+
+    /**
+     * @brief Get direct pointer to the array data
+     *
+     * @return Pointer to the first element
+     */
+    T* get_data();
+
+    /**
+     * @brief Get const direct pointer to the array data
+     *
+     * @return Const pointer to the first element
+     */
+    const T* get_data() const;
+
+    /**
+     * @brief Check if the array is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Check if the array is at capacity
+     *
+     * @return true if another append would fail, false otherwise
+     */
+    bool full() const;
+
+    /**
+     * @brief Get the current size of the array
+     *
+     * @return Current number of elements
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the capacity of the array
+     *
+     * @return N
+     */
+    static constexpr size_t get_capacity() { return N; }
+
+    /**
+     * @brief Get a snapshot of the statistics
+     *
+     * Nothing is ever allocated, so only failed_allocations moves: it counts the
+     * appends, inserts and resizes rejected for lack of room.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Check that the array can hold the specified number of elements
+     *
+     * @param new_capacity Capacity needed
+     * @return std::expected<void, DynArrayError> Success, or InvalidCapacity beyond N
+     */
+    std::expected<void, DynArrayError> reserve(size_t new_capacity);
+
+    /**
+     * @brief Resize the array to contain count elements
+     *
+     * @param count New size of the array (at most N)
+     * @param value Value to initialize new elements with
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> resize(size_t count, const T& value = T());
+
+    /**
+     * @brief Resize the array to contain count elements without initializing new ones
+     *
+     * @param count New size of the array (at most N)
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note Only available for trivially copyable types; new elements hold
+     *       indeterminate values until written.
+     */
+    std::expected<void, DynArrayError> resize_uninitialized(size_t count);
+
+    /**
+     * @brief Shrink capacity to fit the current size
+     *
+     * The storage is inline, so this does nothing; kept for DynArray compatibility.
+     *
+     * @return std::expected<void, DynArrayError> Always success
+     */
+    std::expected<void, DynArrayError> shrink_to_fit();
+
+    /**
+     * @brief Clear all elements from the array
+     */
+    void clear();
+
+    /**
+     * @brief Add an element to the end of the array
+     *
+     * @param value Element to add
+     * @return std::expected<void, DynArrayError> Success, or OutOfMemory when full
+     */
+    std::expected<void, DynArrayError> push_back(const T& value);
+
+    /**
+     * @brief Add an element to the end of the array (move version)
+     *
+     * @param value Element to add
+     * @return std::expected<void, DynArrayError> Success, or OutOfMemory when full
+     */
+    std::expected<void, DynArrayError> push_back(T&& value);
+
+    /**
+     * @brief Construct an element in place at the end of the array
+     *
+     * @tparam Args Types of the constructor arguments
+     * @param args Arguments forwarded to the constructor of T
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to the new element or error
+     */
+    template <typename... Args>
+    std::expected<std::reference_wrapper<T>, DynArrayError> emplace_back(Args&&... args);
+
+    /**
+     * @brief Add an element to the end of an array known not to be full
+     *
+     * @param value Element to add
+     * @return Reference to the new element
+     *
+     * @note Only asserts that there is room; appending to a full array is undefined.
+     */
+    T& push_back_unchecked(const T& value);
+
+    /**
+     * @brief Add an element to the end of an array known not to be full (move version)
+     *
+     * @param value Element to add
+     * @return Reference to the new element
+     *
+     * @note Only asserts that there is room; appending to a full array is undefined.
+     */
+    T& push_back_unchecked(T&& value);
+
+    /**
+     * @brief Construct an element in place at the end of an array known not to be full
+     *
+     * @tparam Args Types of the constructor arguments
+     * @param args Arguments forwarded to the constructor of T
+     * @return Reference to the new element
+     *
+     * @note Only asserts that there is room; appending to a full array is undefined.
+     */
+    template <typename... Args>
+    T& emplace_back_unchecked(Args&&... args);
+
+    /**
+     * @brief Append the elements [first, last) to the end of the array
+     *
+     * With forward iterators nothing is appended unless all elements fit;
+     * trivially copyable elements from contiguous iterators are copied with a
+     * single memcpy.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param first Iterator to the first element to append
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> append_range(It first, Sent last);
+
+    /**
+     * @brief Append the elements of a range to the end of the array
+     *
+     * @tparam R Input range type
+     * @param range Range of elements to append (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> append_range(R&& range);
+
+    /**
+     * @brief Remove the last element from the array
+     *
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> pop_back();
+
+    /**
+     * @brief Insert an element at the specified position
+     *
+     * @param position Position to insert at (as index)
+     * @param value Element to insert
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> insert(size_t position, const T& value);
+
+    /**
+     * @brief Insert the elements [first, last) at the specified position
+     *
+     * For forward iterators the tail is shifted once; input iterators are appended
+     * and then rotated into place.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param position Position to insert at (as index)
+     * @param first Iterator to the first element to insert
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> insert_range(size_t position, It first, Sent last);
+
+    /**
+     * @brief Insert the elements of a range at the specified position
+     *
+     * @tparam R Input range type
+     * @param position Position to insert at (as index)
+     * @param range Range of elements to insert (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> insert_range(size_t position, R&& range);
+
+    /**
+     * @brief Erase an element at the specified position
+     *
+     * @param position Position to erase (as index)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> erase(size_t position);
+
+    /**
+     * @brief Erase a range of elements
+     *
+     * @param first First position to erase (inclusive)
+     * @param last Last position to erase (exclusive)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> erase_range(size_t first, size_t last);
+
+    // Bulk operations for arithmetic element types, the same vector kernels as
+    // DynArray runs over the inline slots
+
+    /**
+     * @brief Set every element to value
+     *
+     * @param value Value to store
+     */
+    void fill(const T& value) requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Find the first element equal to value
+     *
+     * @param value Value to look for
+     * @return size_t Index of the first match, get_size() if there is none
+     */
+    size_t find(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Check if any element equals value
+     *
+     * @param value Value to look for
+     * @return true if found, false otherwise
+     */
+    bool contains(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Count the elements equal to value
+     *
+     * @param value Value to count
+     * @return size_t Number of matches
+     */
+    size_t count(const T& value) const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Get the smallest element
+     *
+     * @return std::expected<T, DynArrayError> Smallest element or EmptyArray
+     */
+    std::expected<T, DynArrayError> min() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Get the largest element
+     *
+     * @return std::expected<T, DynArrayError> Largest element or EmptyArray
+     */
+    std::expected<T, DynArrayError> max() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Add up the elements
+     *
+     * @return simd::sum_t<T> Sum in 64 bits for integers, in T for floating point
+     */
+    simd::sum_t<T> sum() const requires simd::Arithmetic<T>;
+
+    /**
+     * @brief Replace every element with f(element)
+     *
+     * @param f Callable taking and returning T, compiled for the active instruction set
+     */
+    template <typename F>
+        requires (simd::Arithmetic<T> && std::is_invocable_r_v<T, F&, T>)
+    void transform(F f);
+
+    // Iterator support
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Get iterator to the beginning
+     *
+     * @return Iterator to the first element
+     */
+    iterator begin();
+
+    /**
+     * @brief Get iterator to the end
+     *
+     * @return Iterator to the element following the last element
+     */
+    iterator end();
+
+    /**
+     * @brief Get const iterator to the beginning
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Get const iterator to the end
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Get const iterator to the beginning (explicit const version)
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator cbegin() const;
+
+    /**
+     * @brief Get const iterator to the end (explicit const version)
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator cend() const;
+
+private:
+    /**
+     * @brief Get the storage as an element pointer
+     *
+     * @return Pointer to the first slot
+     */
+    T* data();
+
+    /**
+     * @brief Get the storage as a const element pointer
+     *
+     * @return Const pointer to the first slot
+     */
+    const T* data() const;
+
+    /**
+     * @brief Move the elements of other into this empty array, leaving other empty
+     *
+     * @param other Array to move from
+     */
+    void steal(FixedDynArray& other);
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/FixedDynArray.tpp"
@@ -0,0 +1,544 @@
+#pragma once
+
+#include "memory/FixedDynArray.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace memory {
+
+// Default constructor
+template <typename T, size_t N>
+FixedDynArray<T, N>::FixedDynArray() : size(0) {}
+
+// Constructor with initializer list
+template <typename T, size_t N>
+FixedDynArray<T, N>::FixedDynArray(std::initializer_list<T> elements) : size(0) {
+    if (elements.size() > N) {
+        // A constructor cannot report the error, and dropping elements would go unnoticed
+        std::fprintf(stderr, "memory: initializer list of %zu elements exceeds FixedDynArray capacity %zu\n",
+                     elements.size(), N);
+        std::abort();
+    }
+    std::uninitialized_copy_n(elements.begin(), elements.size(), data());
+    size = elements.size();
+}
+
+// Constructor from a built-in array
+template <typename T, size_t N>
+template <size_t M>
+FixedDynArray<T, N>::FixedDynArray(const T (&elements)[M]) : size(0) {
+    static_assert(M <= N, "Array does not fit in the FixedDynArray");
+    std::uninitialized_copy_n(elements, M, data());
+    size = M;
+}
+
+// Destructor
+template <typename T, size_t N>
+FixedDynArray<T, N>::~FixedDynArray() {
+    clear();
+}
+
+// Copy constructor
+template <typename T, size_t N>
+FixedDynArray<T, N>::FixedDynArray(const FixedDynArray& other) : size(0) {
+    std::uninitialized_copy(other.data(), other.data() + other.size, data());
+    size = other.size;
+}
+
+// Move constructor
+template <typename T, size_t N>
+FixedDynArray<T, N>::FixedDynArray(FixedDynArray&& other) noexcept : size(0) {
+    steal(other);
+}
+
+// Copy assignment operator
+template <typename T, size_t N>
+FixedDynArray<T, N>& FixedDynArray<T, N>::operator=(const FixedDynArray& other) {
+    if (this != &other) {
+        clear();
+        std::uninitialized_copy(other.data(), other.data() + other.size, data());
+        size = other.size;
+    }
+    return *this;
+}
+
+// Move assignment operator
+template <typename T, size_t N>
+FixedDynArray<T, N>& FixedDynArray<T, N>::operator=(FixedDynArray&& other) noexcept {
+    if (this != &other) {
+        clear();
+        steal(other);
+    }
+    return *this;
+}
+
+// Subscript operator
+template <typename T, size_t N>
+T& FixedDynArray<T, N>::operator[](size_t index) {
+    if (index >= size) {
+        throw std::out_of_range("FixedDynArray index out of range");
+    }
+    return data()[index];
+}
+
+// Const subscript operator
+template <typename T, size_t N>
+const T& FixedDynArray<T, N>::operator[](size_t index) const {
+    if (index >= size) {
+        throw std::out_of_range("FixedDynArray index out of range");
+    }
+    return data()[index];
+}
+
+// Safe element access with error handling
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<T>, DynArrayError> FixedDynArray<T, N>::at(size_t index) {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return std::ref(data()[index]);
+}
+
+// Safe const element access with error handling
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<const T>, DynArrayError> FixedDynArray<T, N>::at(size_t index) const {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return std::cref(data()[index]);
+}
+
+// Get the first element
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<T>, DynArrayError> FixedDynArray<T, N>::front() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::ref(data()[0]);
+}
+
+// Get the const first element
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<const T>, DynArrayError> FixedDynArray<T, N>::front() const {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::cref(data()[0]);
+}
+
+// Get the last element
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<T>, DynArrayError> FixedDynArray<T, N>::back() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::ref(data()[size - 1]);
+}
+
+// Get the const last element
+template <typename T, size_t N>
+std::expected<std::reference_wrapper<const T>, DynArrayError> FixedDynArray<T, N>::back() const {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::cref(data()[size - 1]);
+}
+
+// Get direct pointer to data
+template <typename T, size_t N>
+T* FixedDynArray<T, N>::get_data() {
+    return data();
+}
+
+// Get const direct pointer to data
+template <typename T, size_t N>
+const T* FixedDynArray<T, N>::get_data() const {
+    return data();
+}
+
+// Check if array is empty
+template <typename T, size_t N>
+bool FixedDynArray<T, N>::empty() const {
+    return size == 0;
+}
+
+// Check if array is at capacity
+template <typename T, size_t N>
+bool FixedDynArray<T, N>::full() const {
+    return size == N;
+}
+
+// Get size
+template <typename T, size_t N>
+size_t FixedDynArray<T, N>::get_size() const {
+    return size;
+}
+
+// Get statistics
+template <typename T, size_t N>
+AllocatorStats FixedDynArray<T, N>::stats() const {
+    return recorder.snapshot();
+}
+
+// Check the capacity
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::reserve(size_t new_capacity) {
+    if (new_capacity > N) {
+        return std::unexpected(DynArrayError::InvalidCapacity);
+    }
+    return {};
+}
+
+// Resize array
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::resize(size_t count, const T& value) {
+    if (count > N) {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    if (count > size) {
+        // Initialize new elements
+        std::uninitialized_fill(data() + size, data() + count, value);
+    } else if (count < size) {
+        // Destroy excess elements
+        std::destroy(data() + count, data() + size);
+    }
+
+    size = count;
+    return {};
+}
+
+// Resize without initializing new elements
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::resize_uninitialized(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "resize_uninitialized needs a trivially copyable type");
+
+    if (count > N) {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    size = count;
+    return {};
+}
+
+// Shrink to fit
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::shrink_to_fit() {
+    return {}; // Inline storage can't shrink
+}
+
+// Clear array
+template <typename T, size_t N>
+void FixedDynArray<T, N>::clear() {
+    // Destroy all elements
+    std::destroy(data(), data() + size);
+    size = 0;
+}
+
+// Push back (copy)
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::push_back(const T& value) {
+    if (size >= N) [[unlikely]] {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    // Construct new element at the end
+    new (data() + size) T(value); // Placement new to copy construct
+    ++size;
+
+    return {};
+}
+
+// Push back (move)
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::push_back(T&& value) {
+    if (size >= N) [[unlikely]] {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    // Construct new element at the end
+    new (data() + size) T(std::move(value)); // Placement new to move construct
+    ++size;
+
+    return {};
+}
+
+// Emplace back
+template <typename T, size_t N>
+template <typename... Args>
+std::expected<std::reference_wrapper<T>, DynArrayError> FixedDynArray<T, N>::emplace_back(Args&&... args) {
+    if (size >= N) [[unlikely]] {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    // Construct the element directly in its slot, no temporary
+    T* slot = new (data() + size) T(std::forward<Args>(args)...);
+    ++size;
+
+    return std::ref(*slot);
+}
+
+// Push back without a capacity check (copy)
+template <typename T, size_t N>
+T& FixedDynArray<T, N>::push_back_unchecked(const T& value) {
+    return emplace_back_unchecked(value);
+}
+
+// Push back without a capacity check (move)
+template <typename T, size_t N>
+T& FixedDynArray<T, N>::push_back_unchecked(T&& value) {
+    return emplace_back_unchecked(std::move(value));
+}
+
+// Emplace back without a capacity check
+template <typename T, size_t N>
+template <typename... Args>
+T& FixedDynArray<T, N>::emplace_back_unchecked(Args&&... args) {
+    assert(size < N && "FixedDynArray is full");
+    T* slot = new (data() + size) T(std::forward<Args>(args)...);
+    ++size;
+    return *slot;
+}
+
+// Append a range of elements
+template <typename T, size_t N>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::append_range(It first, Sent last) {
+    return insert_range(size, std::move(first), std::move(last));
+}
+
+// Append the elements of a range
+template <typename T, size_t N>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::append_range(R&& range) {
+    return insert_range(size, std::ranges::begin(range), std::ranges::end(range));
+}
+
+// Pop back
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::pop_back() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+
+    // Destroy the last element
+    data()[--size].~T();
+
+    return {};
+}
+
+// Insert element
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::insert(size_t position, const T& value) {
+    if (position > size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if (size >= N) [[unlikely]] {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+
+    if (position < size) {
+        // Shift elements to make room
+        detail::shift_elements_right(data(), size, position, 1);
+    }
+
+    // Construct new element at position
+    new (data() + position) T(value);
+    ++size;
+
+    return {};
+}
+
+// Insert a range of elements
+template <typename T, size_t N>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::insert_range(size_t position, It first, Sent last) {
+    if (position > size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if constexpr (std::forward_iterator<It>) {
+        size_t count = static_cast<size_t>(std::ranges::distance(first, last));
+        if (count == 0) {
+            return {};
+        }
+
+        // Check once for the whole range, nothing is inserted unless it all fits
+        if (count > N - size) {
+            recorder.record_failure();
+            return std::unexpected(DynArrayError::OutOfMemory);
+        }
+
+        // Shift the tail once and copy the range into the gap
+        detail::insert_elements(data(), size, position, std::move(first), count);
+        size += count;
+        return {};
+    } else {
+        // Single pass only: append at the end, then rotate the new elements into place
+        size_t old_size = size;
+        for (; first != last; ++first) {
+            auto result = emplace_back(*first);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+        std::rotate(data() + position, data() + old_size, data() + size);
+        return {};
+    }
+}
+
+// Insert the elements of a range
+template <typename T, size_t N>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::insert_range(size_t position, R&& range) {
+    return insert_range(position, std::ranges::begin(range), std::ranges::end(range));
+}
+
+// Erase element
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::erase(size_t position) {
+    return erase_range(position, position + 1);
+}
+
+// Erase range
+template <typename T, size_t N>
+std::expected<void, DynArrayError> FixedDynArray<T, N>::erase_range(size_t first, size_t last) {
+    if (first >= size || last > size || first > last) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if (first == last) {
+        return {}; // Nothing to erase
+    }
+
+    // Destroy elements in the range, then close the gap
+    size_t count = last - first;
+    std::destroy(data() + first, data() + last);
+    detail::shift_elements_left(data(), size, first, count);
+    size -= count;
+
+    return {};
+}
+
+// Fill with a value
+template <typename T, size_t N>
+void FixedDynArray<T, N>::fill(const T& value) requires simd::Arithmetic<T> {
+    simd::fill(std::span<T>(data(), size), value);
+}
+
+// Find a value
+template <typename T, size_t N>
+size_t FixedDynArray<T, N>::find(const T& value) const requires simd::Arithmetic<T> {
+    return simd::find(std::span<const T>(data(), size), value);
+}
+
+// Check for a value
+template <typename T, size_t N>
+bool FixedDynArray<T, N>::contains(const T& value) const requires simd::Arithmetic<T> {
+    return simd::contains(std::span<const T>(data(), size), value);
+}
+
+// Count a value
+template <typename T, size_t N>
+size_t FixedDynArray<T, N>::count(const T& value) const requires simd::Arithmetic<T> {
+    return simd::count(std::span<const T>(data(), size), value);
+}
+
+// Smallest element
+template <typename T, size_t N>
+std::expected<T, DynArrayError> FixedDynArray<T, N>::min() const requires simd::Arithmetic<T> {
+    if (size == 0) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return simd::min(std::span<const T>(data(), size));
+}
+
+// Largest element
+template <typename T, size_t N>
+std::expected<T, DynArrayError> FixedDynArray<T, N>::max() const requires simd::Arithmetic<T> {
+    if (size == 0) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return simd::max(std::span<const T>(data(), size));
+}
+
+// Sum of the elements
+template <typename T, size_t N>
+simd::sum_t<T> FixedDynArray<T, N>::sum() const requires simd::Arithmetic<T> {
+    return simd::sum(std::span<const T>(data(), size));
+}
+
+// Transform in place
+template <typename T, size_t N>
+template <typename F>
+    requires (simd::Arithmetic<T> && std::is_invocable_r_v<T, F&, T>)
+void FixedDynArray<T, N>::transform(F f) {
+    simd::transform(std::span<const T>(data(), size), std::span<T>(data(), size), std::move(f));
+}
+
+// Begin iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::iterator FixedDynArray<T, N>::begin() {
+    return data();
+}
+
+// End iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::iterator FixedDynArray<T, N>::end() {
+    return data() + size;
+}
+
+// Const begin iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::const_iterator FixedDynArray<T, N>::begin() const {
+    return data();
+}
+
+// Const end iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::const_iterator FixedDynArray<T, N>::end() const {
+    return data() + size;
+}
+
+// Explicit const begin iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::const_iterator FixedDynArray<T, N>::cbegin() const {
+    return data();
+}
+
+// Explicit const end iterator
+template <typename T, size_t N>
+typename FixedDynArray<T, N>::const_iterator FixedDynArray<T, N>::cend() const {
+    return data() + size;
+}
+
+// Storage as elements
+template <typename T, size_t N>
+T* FixedDynArray<T, N>::data() {
+    return reinterpret_cast<T*>(storage);
+}
+
+// Storage as const elements
+template <typename T, size_t N>
+const T* FixedDynArray<T, N>::data() const {
+    return reinterpret_cast<const T*>(storage);
+}
+
+// Move the elements of another array over
+template <typename T, size_t N>
+void FixedDynArray<T, N>::steal(FixedDynArray& other) {
+    detail::relocate_elements(data(), other.data(), other.size);
+    size = other.size;
+    other.size = 0;
+}
+
+} // namespace memory
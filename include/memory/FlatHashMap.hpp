@@ -0,0 +1,610 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <cstring>
+#include <expected>
+#include <functional> // For std::hash, std::equal_to and std::reference_wrapper
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MEMORY_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define MEMORY_FLAT_HASH_NEON 1
+#include <arm_neon.h>
+#endif
+
+#include "memory/Allocator.hpp"
+#include "memory/AllocatorStats.hpp"
+#include "memory/DynArray.hpp"
+#include "memory/HeapAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Error codes for FlatHashMap operations
+ */
+enum class FlatHashMapError {
+    OutOfMemory,       ///< Failed to allocate the table
+    KeyNotFound,       ///< The key is not in the map
+    InvalidCapacity    ///< Requested capacity does not fit in a table
+};
+
+/**
+ * @brief One key/value entry of a FlatHashMap
+ *
+ * The key must not be modified through an iterator, the entry would no longer be
+ * found under it.
+ *
+ * @tparam K Key type
+ * @tparam V Value type
+ */
+template <typename K, typename V>
+struct FlatHashMapEntry {
+    K key;   ///< Key of the entry
+    V value; ///< Value stored under the key
+};
+
+namespace detail {
+
+/**
+ * @brief Control byte of a slot that was never used since the last rehash
+ */
+inline constexpr int8_t CTRL_EMPTY = -128;
+
+/**
+ * @brief Control byte of a slot whose entry was erased (a tombstone)
+ */
+inline constexpr int8_t CTRL_DELETED = -2;
+
+/**
+ * @brief Number of control bytes probed at once
+ */
+inline constexpr size_t GROUP_WIDTH = 16;
+
+/**
+ * @brief Set of slots within a group matching a probe
+ *
+ * SSE2 and the scalar fallback produce one bit per slot; NEON produces one bit per
+ * nibble, hence SHIFT.
+ */
+struct GroupMask {
+#if MEMORY_FLAT_HASH_NEON
+    static constexpr int SHIFT = 2;
+#else
+    static constexpr int SHIFT = 0;
+#endif
+
+    uint64_t bits; ///< Match bits, one per slot (shifted by SHIFT)
+
+    explicit operator bool() const { return bits != 0; }
+
+    /**
+     * @brief Get the index of the first matching slot in the group
+     *
+     * @return Slot index within the group (the mask must not be empty)
+     */
+    size_t lowest() const { return static_cast<size_t>(std::countr_zero(bits)) >> SHIFT; }
+
+    /**
+     * @brief Drop the first matching slot from the mask
+     */
+    void clear_lowest() { bits &= bits - 1; }
+};
+
+/**
+ * @brief GROUP_WIDTH control bytes loaded for parallel matching
+ */
+struct Group {
+#if MEMORY_FLAT_HASH_SSE2
+    __m128i ctrl; ///< Control bytes of the group
+
+    explicit Group(const int8_t* pos) : ctrl(_mm_load_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    GroupMask match(int8_t h2) const {
+        return {static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)))};
+    }
+
+    GroupMask match_empty() const {
+        return {static_cast<uint64_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(CTRL_EMPTY), ctrl)))};
+    }
+
+    GroupMask match_empty_or_deleted() const {
+        // Full slots hold a 7-bit hash, only the special values have the sign bit set
+        return {static_cast<uint64_t>(_mm_movemask_epi8(ctrl))};
+    }
+#elif MEMORY_FLAT_HASH_NEON
+    int8x16_t ctrl; ///< Control bytes of the group
+
+    explicit Group(const int8_t* pos) : ctrl(vld1q_s8(pos)) {}
+
+    static GroupMask to_mask(uint8x16_t matches) {
+        // Narrow every byte to a nibble, keep one bit per nibble
+        uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+        return {vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL};
+    }
+
+    GroupMask match(int8_t h2) const { return to_mask(vceqq_s8(vdupq_n_s8(h2), ctrl)); }
+
+    GroupMask match_empty() const { return to_mask(vceqq_s8(vdupq_n_s8(CTRL_EMPTY), ctrl)); }
+
+    GroupMask match_empty_or_deleted() const { return to_mask(vcltq_s8(ctrl, vdupq_n_s8(0))); }
+#else
+    int8_t ctrl[GROUP_WIDTH]; ///< Control bytes of the group
+
+    explicit Group(const int8_t* pos) { std::memcpy(ctrl, pos, GROUP_WIDTH); }
+
+    GroupMask match(int8_t h2) const {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            bits |= static_cast<uint64_t>(ctrl[i] == h2) << i;
+        }
+        return {bits};
+    }
+
+    GroupMask match_empty() const { return match(CTRL_EMPTY); }
+
+    GroupMask match_empty_or_deleted() const {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i) {
+            bits |= static_cast<uint64_t>(ctrl[i] < 0) << i;
+        }
+        return {bits};
+    }
+#endif
+};
+
+/**
+ * @brief Spread the entropy of a hash over all bits
+ *
+ * std::hash is the identity for integers on the common standard libraries, which
+ * would put consecutive keys in the same group; the multiply-fold fixes that.
+ *
+ * @param hash Hash from the user's hasher
+ * @return Mixed hash
+ */
+inline size_t mix_hash(size_t hash) {
+    uint64_t h = static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+}
+
+} // namespace detail
+
+/**
+ * @brief Open-addressing hash map with custom allocator support
+ *
+ * Entries live inline in one block from the allocator, next to one control byte per
+ * slot (SwissTable layout): the control byte holds 7 bits of the entry's hash, or
+ * marks the slot empty or erased. A lookup compares the control bytes of 16 slots
+ * at once (SSE2 or NEON, scalar elsewhere) and only touches the entries whose hash
+ * bits match, so most lookups read one cache line of control bytes and one entry.
+ *
+ * Like DynArray, the allocator is a template parameter held by value or by pointer,
+ * e.g. FlatHashMap<uint32_t, float, LinearAllocator*>. Growing rehashes into a new
+ * block and hands the old one back, which is free for an arena. For a throwaway map
+ * per request, put it on a LinearAllocator and reset() it before free_all: nothing
+ * is freed per entry.
+ *
+ * The table holds a power of two slots (at least 16) and rehashes past a load
+ * factor of 7/8. Erased slots become tombstones unless their group never filled up,
+ * and are reclaimed by the next rehash.
+ *
+ * @tparam K Key type
+ * @tparam V Value type
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle)
+ * @tparam Hash Hash function object for K
+ * @tparam KeyEqual Equality function object for K
+ */
+template <typename K, typename V, AllocatorHandle Alloc = HeapAllocator, typename Hash = std::hash<K>,
+          typename KeyEqual = std::equal_to<K>>
+struct FlatHashMap {
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "FlatHashMap frees the old table after rehashing into the new one, out of LIFO order");
+    using Entry = FlatHashMapEntry<K, V>; ///< Stored entry type
+
+    // Data members first (following data-oriented approach)
+    int8_t*         ctrl;        ///< Control bytes, one per slot (start of the block)
+    Entry*          slots;       ///< Entries, in the same block after the control bytes
+    size_t          size;        ///< Number of entries
+    size_t          capacity;    ///< Number of slots (0 or a power of two)
+    size_t          growth_left; ///< Inserts into empty slots left before the next rehash
+    [[no_unique_address]] Alloc allocator;       ///< Allocator (or pointer to it) the table comes from
+    [[no_unique_address]] Hash hasher;           ///< Hash function
+    [[no_unique_address]] KeyEqual key_equal;    ///< Key comparison
+    [[no_unique_address]] StatsRecorder recorder; ///< Growth statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Number of slots allocated by the first insert into an empty map
+     */
+    static constexpr size_t MIN_CAPACITY = detail::GROUP_WIDTH;
+
+    /**
+     * @brief Alignment of the block, enough for aligned group loads and the entries
+     */
+    static constexpr size_t BLOCK_ALIGNMENT =
+        alignof(Entry) > detail::GROUP_WIDTH ? alignof(Entry) : detail::GROUP_WIDTH;
+
+    /**
+     * @brief Forward iterator over the entries, in table order
+     *
+     * @tparam Const Whether the iterator gives read-only access
+     */
+    template <bool Const>
+    struct Iterator {
+        using Owner = std::conditional_t<Const, const FlatHashMap, FlatHashMap>;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Entry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+        using reference = std::conditional_t<Const, const Entry&, Entry&>;
+
+        Owner* map;   ///< Map iterated over
+        size_t index; ///< Slot the iterator points at, capacity at the end
+
+        Iterator() : map(nullptr), index(0) {}
+        Iterator(Owner* map, size_t index) : map(map), index(index) {}
+
+        /**
+         * @brief Read-only iterators can be made from mutable ones
+         */
+        template <bool OtherConst>
+            requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) : map(other.map), index(other.index) {}
+
+        reference operator*() const { return map->slots[index]; }
+        pointer operator->() const { return map->slots + index; }
+
+        Iterator& operator++() { index = map->next_full(index + 1); return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++*this; return old; }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /**
+     * @brief Default constructor
+     *
+     * Creates an empty map without allocating; the first insert allocates
+     * MIN_CAPACITY slots.
+     */
+    FlatHashMap();
+
+    /**
+     * @brief Constructor reserving room for a number of entries
+     *
+     * @param initial_capacity Number of entries to make room for
+     */
+    explicit FlatHashMap(size_t initial_capacity);
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Allocator to use, or pointer to it
+     */
+    explicit FlatHashMap(Alloc alloc);
+
+    /**
+     * @brief Constructor reserving room for a number of entries with custom allocator
+     *
+     * @param initial_capacity Number of entries to make room for
+     * @param alloc Allocator to use, or pointer to it
+     */
+    FlatHashMap(size_t initial_capacity, Alloc alloc);
+
+    /**
+     * @brief Destructor, destroys the entries and hands the table back
+     */
+    ~FlatHashMap();
+
+    /**
+     * @brief Copy constructor, allocates from the same allocator
+     *
+     * @param other Map to copy from
+     */
+    FlatHashMap(const FlatHashMap& other);
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other Map to move from, left empty
+     */
+    FlatHashMap(FlatHashMap&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator
+     *
+     * @param other Map to copy from
+     * @return Reference to this map
+     */
+    FlatHashMap& operator=(const FlatHashMap& other);
+
+    /**
+     * @brief Move assignment operator
+     *
+     * @param other Map to move from, left empty
+     * @return Reference to this map
+     */
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept;
+
+    /**
+     * @brief Insert an entry unless the key is present
+     *
+     * @param key Key of the entry
+     * @param args Arguments to construct the value from (untouched if the key exists)
+     * @return std::expected<std::pair<iterator, bool>, FlatHashMapError> The entry under
+     *         key and whether it was inserted, or OutOfMemory
+     */
+    template <typename... Args>
+    std::expected<std::pair<iterator, bool>, FlatHashMapError> try_emplace(const K& key, Args&&... args);
+
+    /**
+     * @brief Insert an entry unless the key is present, moving the key
+     *
+     * @param key Key of the entry
+     * @param args Arguments to construct the value from (untouched if the key exists)
+     * @return std::expected<std::pair<iterator, bool>, FlatHashMapError> The entry under
+     *         key and whether it was inserted, or OutOfMemory
+     */
+    template <typename... Args>
+    std::expected<std::pair<iterator, bool>, FlatHashMapError> try_emplace(K&& key, Args&&... args);
+
+    /**
+     * @brief Insert an entry, or assign the value if the key is present
+     *
+     * @param key Key of the entry
+     * @param value Value to store under key
+     * @return std::expected<bool, FlatHashMapError> Whether a new entry was inserted, or OutOfMemory
+     */
+    template <typename M>
+    std::expected<bool, FlatHashMapError> insert_or_assign(const K& key, M&& value);
+
+    /**
+     * @brief Find the entry under a key
+     *
+     * @param key Key to look up
+     * @return iterator The entry, or end() if the key is not present
+     */
+    iterator find(const K& key);
+
+    /**
+     * @brief Find the entry under a key, read-only
+     *
+     * @param key Key to look up
+     * @return const_iterator The entry, or end() if the key is not present
+     */
+    const_iterator find(const K& key) const;
+
+    /**
+     * @brief Check if a key is present
+     *
+     * @param key Key to look up
+     * @return true if the map has an entry under key
+     */
+    bool contains(const K& key) const;
+
+    /**
+     * @brief Safe value access with error handling
+     *
+     * @param key Key to look up
+     * @return std::expected<std::reference_wrapper<V>, FlatHashMapError> Value or KeyNotFound
+     */
+    std::expected<std::reference_wrapper<V>, FlatHashMapError> at(const K& key);
+
+    /**
+     * @brief Safe read-only value access with error handling
+     *
+     * @param key Key to look up
+     * @return std::expected<std::reference_wrapper<const V>, FlatHashMapError> Value or KeyNotFound
+     */
+    std::expected<std::reference_wrapper<const V>, FlatHashMapError> at(const K& key) const;
+
+    /**
+     * @brief Erase the entry under a key
+     *
+     * @param key Key to erase
+     * @return true if an entry was erased, false if the key was not present
+     */
+    bool erase(const K& key);
+
+    /**
+     * @brief Make room for a number of entries without rehashing
+     *
+     * @param count Number of entries the map must hold
+     * @return std::expected<void, FlatHashMapError> Success or error
+     */
+    std::expected<void, FlatHashMapError> reserve(size_t count);
+
+    /**
+     * @brief Destroy all entries, keeping the table
+     */
+    void clear();
+
+    /**
+     * @brief Destroy all entries and hand the table back, leaving the map unallocated
+     *
+     * For trivially destructible entries this is O(1), which makes it the way to drop a
+     * map before the arena under it is reset with free_all.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of entries
+     *
+     * @return Current number of entries
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the number of slots in the table
+     *
+     * @return Current capacity in slots (entries fit up to 7/8 of it)
+     */
+    size_t get_capacity() const;
+
+    /**
+     * @brief Check if the map is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get a snapshot of the growth statistics
+     *
+     * allocations counts the first table, resizes_moved the rehashes after it, and
+     * bytes_in_use the size of the table.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the allocator the map allocates from
+     *
+     * @return Reference to the allocator (the pointee if Alloc is a pointer)
+     */
+    std::remove_pointer_t<Alloc>& get_allocator();
+
+    /**
+     * @brief Get iterator to the first entry
+     *
+     * @return Iterator to the first entry
+     */
+    iterator begin();
+
+    /**
+     * @brief Get iterator past the last entry
+     *
+     * @return End iterator
+     */
+    iterator end();
+
+    /**
+     * @brief Get const iterator to the first entry
+     *
+     * @return Const iterator to the first entry
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Get const iterator past the last entry
+     *
+     * @return Const end iterator
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Get const iterator to the first entry (explicit const version)
+     *
+     * @return Const iterator to the first entry
+     */
+    const_iterator cbegin() const;
+
+    /**
+     * @brief Get const iterator past the last entry (explicit const version)
+     *
+     * @return Const end iterator
+     */
+    const_iterator cend() const;
+
+    /**
+     * @brief Compute the size of a table with capacity slots
+     *
+     * @param capacity Number of slots (a power of two)
+     * @return Size in bytes of the control bytes and entries
+     */
+    static constexpr size_t table_size(size_t capacity);
+
+private:
+    /**
+     * @brief Compute where the entries start in a table with capacity slots
+     *
+     * @param capacity Number of slots
+     * @return Offset in bytes from the start of the control bytes
+     */
+    static constexpr size_t slots_offset(size_t capacity);
+
+    /**
+     * @brief Number of entries a table of capacity slots holds before rehashing
+     *
+     * @param capacity Number of slots
+     * @return Maximum number of entries (7/8 of the slots)
+     */
+    static constexpr size_t max_load(size_t capacity);
+
+    /**
+     * @brief Hash a key, mixed for the control bytes
+     *
+     * @param key Key to hash
+     * @return Hash whose low 7 bits go to the control byte and the rest pick the group
+     */
+    size_t hash_of(const K& key) const;
+
+    /**
+     * @brief Find the slot holding a key
+     *
+     * @param key Key to look up
+     * @param hash Hash of key from hash_of
+     * @return Slot index, or capacity if the key is not present
+     */
+    size_t find_index(const K& key, size_t hash) const;
+
+    /**
+     * @brief Find the first empty or erased slot on the probe sequence of a hash
+     *
+     * @param hash Hash of the key to insert
+     * @return Slot index (the table must have a free slot)
+     */
+    size_t find_insert_slot(size_t hash) const;
+
+    /**
+     * @brief Find the first full slot at or after index
+     *
+     * @param index Slot to start from
+     * @return Slot index, or capacity if there is none
+     */
+    size_t next_full(size_t index) const;
+
+    /**
+     * @brief Insert a key known to be absent
+     *
+     * @param key Key, forwarded to the entry
+     * @param hash Hash of key from hash_of
+     * @param args Arguments to construct the value from
+     * @return std::expected<size_t, FlatHashMapError> Slot of the new entry or OutOfMemory
+     */
+    template <typename KeyArg, typename... Args>
+    std::expected<size_t, FlatHashMapError> insert_new(KeyArg&& key, size_t hash, Args&&... args);
+
+    /**
+     * @brief Move every entry into a new table of new_capacity slots
+     *
+     * @param new_capacity Number of slots of the new table (a power of two)
+     * @return std::expected<void, FlatHashMapError> Success or error
+     */
+    std::expected<void, FlatHashMapError> rehash(size_t new_capacity);
+
+    /**
+     * @brief Destroy the entries of every full slot
+     */
+    void destroy_entries();
+
+    /**
+     * @brief Hand the current table back to the allocator
+     */
+    void release();
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/FlatHashMap.tpp"
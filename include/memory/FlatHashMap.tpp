@@ -0,0 +1,520 @@
+#pragma once
+
+#include "memory/FlatHashMap.hpp"
+
+namespace memory {
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap()
+    : ctrl(nullptr), slots(nullptr), size(0), capacity(0), growth_left(0), allocator(), hasher(), key_equal() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Default constructor, nothing is allocated until the first insert
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap(size_t initial_capacity)
+    : ctrl(nullptr), slots(nullptr), size(0), capacity(0), growth_left(0), allocator(), hasher(), key_equal() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity");
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap(Alloc alloc)
+    : ctrl(nullptr), slots(nullptr), size(0), capacity(0), growth_left(0), allocator(alloc), hasher(), key_equal() {
+    // Constructor with custom allocator, nothing is allocated until the first insert
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap(size_t initial_capacity, Alloc alloc)
+    : ctrl(nullptr), slots(nullptr), size(0), capacity(0), growth_left(0), allocator(alloc), hasher(), key_equal() {
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity with custom allocator");
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::~FlatHashMap() {
+    reset();
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap(const FlatHashMap& other)
+    : ctrl(nullptr), slots(nullptr), size(0), capacity(0), growth_left(0), allocator(other.allocator),
+      hasher(other.hasher), key_equal(other.key_equal) {
+    auto result = reserve(other.size);
+    if (result.has_value()) {
+        // Keys are unique already, so skip the lookups
+        for (const Entry& entry : other) {
+            insert_new(entry.key, hash_of(entry.key), entry.value);
+        }
+    } else {
+        assert(false && "Failed to allocate memory in copy constructor");
+    }
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::FlatHashMap(FlatHashMap&& other) noexcept
+    : ctrl(other.ctrl), slots(other.slots), size(other.size), capacity(other.capacity),
+      growth_left(other.growth_left), allocator(other.allocator), hasher(std::move(other.hasher)),
+      key_equal(std::move(other.key_equal)) {
+    // Reset the source object; it keeps its allocator so it stays usable
+    other.ctrl = nullptr;
+    other.slots = nullptr;
+    other.size = 0;
+    other.capacity = 0;
+    other.growth_left = 0;
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>& FlatHashMap<K, V, Alloc, Hash, KeyEqual>::operator=(const FlatHashMap& other) {
+    if (this != &other) {
+        clear();
+        auto result = reserve(other.size);
+        if (result.has_value()) {
+            for (const Entry& entry : other) {
+                insert_new(entry.key, hash_of(entry.key), entry.value);
+            }
+        } else {
+            assert(false && "Failed to allocate memory in copy assignment");
+        }
+    }
+    return *this;
+}
+
+
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>& FlatHashMap<K, V, Alloc, Hash, KeyEqual>::operator=(FlatHashMap&& other) noexcept {
+    if (this != &other) {
+        // Clean up existing resources
+        reset();
+
+        // Move resources from other
+        ctrl = other.ctrl;
+        slots = other.slots;
+        size = other.size;
+        capacity = other.capacity;
+        growth_left = other.growth_left;
+        allocator = other.allocator;
+        hasher = std::move(other.hasher);
+        key_equal = std::move(other.key_equal);
+
+        // Reset the source object
+        other.ctrl = nullptr;
+        other.slots = nullptr;
+        other.size = 0;
+        other.capacity = 0;
+        other.growth_left = 0;
+    }
+    return *this;
+}
+
+// Insert unless present (copied key)
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::expected<std::pair<typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::iterator, bool>, FlatHashMapError>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::try_emplace(const K& key, Args&&... args) {
+    size_t hash = hash_of(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity) {
+        return std::pair{iterator(this, index), false};
+    }
+
+    auto inserted = insert_new(key, hash, std::forward<Args>(args)...);
+    if (!inserted) {
+        return std::unexpected(inserted.error());
+    }
+    return std::pair{iterator(this, inserted.value()), true};
+}
+
+// Insert unless present (moved key)
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+template <typename... Args>
+std::expected<std::pair<typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::iterator, bool>, FlatHashMapError>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::try_emplace(K&& key, Args&&... args) {
+    size_t hash = hash_of(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity) {
+        return std::pair{iterator(this, index), false};
+    }
+
+    auto inserted = insert_new(std::move(key), hash, std::forward<Args>(args)...);
+    if (!inserted) {
+        return std::unexpected(inserted.error());
+    }
+    return std::pair{iterator(this, inserted.value()), true};
+}
+
+// Insert or assign
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+template <typename M>
+std::expected<bool, FlatHashMapError> FlatHashMap<K, V, Alloc, Hash, KeyEqual>::insert_or_assign(const K& key, M&& value) {
+    size_t hash = hash_of(key);
+    size_t index = find_index(key, hash);
+    if (index != capacity) {
+        slots[index].value = std::forward<M>(value);
+        return false;
+    }
+
+    auto inserted = insert_new(key, hash, std::forward<M>(value));
+    if (!inserted) {
+        return std::unexpected(inserted.error());
+    }
+    return true;
+}
+
+// Find an entry
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::find(const K& key) {
+    return iterator(this, find_index(key, hash_of(key)));
+}
+
+// Find an entry (const)
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::find(const K& key) const {
+    return const_iterator(this, find_index(key, hash_of(key)));
+}
+
+// Check for a key
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Alloc, Hash, KeyEqual>::contains(const K& key) const {
+    return find_index(key, hash_of(key)) != capacity;
+}
+
+// Safe value access with error handling
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+std::expected<std::reference_wrapper<V>, FlatHashMapError> FlatHashMap<K, V, Alloc, Hash, KeyEqual>::at(const K& key) {
+    size_t index = find_index(key, hash_of(key));
+    if (index == capacity) {
+        return std::unexpected(FlatHashMapError::KeyNotFound);
+    }
+    return std::ref(slots[index].value);
+}
+
+// Safe const value access with error handling
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+std::expected<std::reference_wrapper<const V>, FlatHashMapError>
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::at(const K& key) const {
+    size_t index = find_index(key, hash_of(key));
+    if (index == capacity) {
+        return std::unexpected(FlatHashMapError::KeyNotFound);
+    }
+    return std::cref(slots[index].value);
+}
+
+// Erase an entry
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Alloc, Hash, KeyEqual>::erase(const K& key) {
+    size_t index = find_index(key, hash_of(key));
+    if (index == capacity) {
+        return false;
+    }
+
+    std::destroy_at(slots + index);
+    --size;
+
+    // A group that still has an empty slot never stopped a probe from ending in it,
+    // so nothing can have been placed past it and the slot can go back to empty
+    size_t group_start = index & ~(detail::GROUP_WIDTH - 1);
+    if (detail::Group(ctrl + group_start).match_empty()) {
+        ctrl[index] = detail::CTRL_EMPTY;
+        ++growth_left;
+    } else {
+        ctrl[index] = detail::CTRL_DELETED;
+    }
+    return true;
+}
+
+// Reserve room for entries
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+std::expected<void, FlatHashMapError> FlatHashMap<K, V, Alloc, Hash, KeyEqual>::reserve(size_t count) {
+    if (count <= max_load(capacity)) {
+        return {}; // Nothing to do
+    }
+    if (count > (std::numeric_limits<size_t>::max() / 2) / (sizeof(Entry) + 1)) {
+        return std::unexpected(FlatHashMapError::InvalidCapacity);
+    }
+
+    size_t new_capacity = capacity != 0 ? capacity : MIN_CAPACITY;
+    while (max_load(new_capacity) < count) {
+        new_capacity *= 2;
+    }
+    return rehash(new_capacity);
+}
+
+// Clear map
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Alloc, Hash, KeyEqual>::clear() {
+    destroy_entries();
+    if (capacity != 0) {
+        std::memset(ctrl, detail::CTRL_EMPTY, capacity);
+    }
+    size = 0;
+    growth_left = max_load(capacity);
+}
+
+// Drop the table
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Alloc, Hash, KeyEqual>::reset() {
+    destroy_entries();
+    release();
+
+    ctrl = nullptr;
+    slots = nullptr;
+    size = 0;
+    capacity = 0;
+    growth_left = 0;
+}
+
+// Get size
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::get_size() const {
+    return size;
+}
+
+// Get capacity
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::get_capacity() const {
+    return capacity;
+}
+
+// Check if empty
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+bool FlatHashMap<K, V, Alloc, Hash, KeyEqual>::empty() const {
+    return size == 0;
+}
+
+// Get growth statistics
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+AllocatorStats FlatHashMap<K, V, Alloc, Hash, KeyEqual>::stats() const {
+    return recorder.snapshot();
+}
+
+// Get the allocator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+std::remove_pointer_t<Alloc>& FlatHashMap<K, V, Alloc, Hash, KeyEqual>::get_allocator() {
+    return detail::allocator_of(allocator);
+}
+
+// Begin iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::iterator FlatHashMap<K, V, Alloc, Hash, KeyEqual>::begin() {
+    return iterator(this, next_full(0));
+}
+
+// End iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::iterator FlatHashMap<K, V, Alloc, Hash, KeyEqual>::end() {
+    return iterator(this, capacity);
+}
+
+// Const begin iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::begin() const {
+    return const_iterator(this, next_full(0));
+}
+
+// Const end iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::end() const {
+    return const_iterator(this, capacity);
+}
+
+// Explicit const begin iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::cbegin() const {
+    return begin();
+}
+
+// Explicit const end iterator
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+typename FlatHashMap<K, V, Alloc, Hash, KeyEqual>::const_iterator
+FlatHashMap<K, V, Alloc, Hash, KeyEqual>::cend() const {
+    return end();
+}
+
+// Size of a table
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+constexpr size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::table_size(size_t capacity) {
+    return slots_offset(capacity) + sizeof(Entry) * capacity;
+}
+
+// Offset of the entries within a table
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+constexpr size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::slots_offset(size_t capacity) {
+    // Control bytes first, then the entries aligned after them
+    return (capacity + alignof(Entry) - 1) & ~(alignof(Entry) - 1);
+}
+
+// Maximum load of a table
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+constexpr size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+// Hash a key
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::hash_of(const K& key) const {
+    return detail::mix_hash(hasher(key));
+}
+
+// Probe for a key
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::find_index(const K& key, size_t hash) const {
+    if (capacity == 0) {
+        return capacity;
+    }
+
+    // Triangular probing over whole groups visits every group once
+    const size_t group_mask = capacity / detail::GROUP_WIDTH - 1;
+    const int8_t h2 = static_cast<int8_t>(hash & 0x7F);
+    size_t group = (hash >> 7) & group_mask;
+    for (size_t step = 1;; ++step) {
+        const size_t base = group * detail::GROUP_WIDTH;
+        detail::Group probe(ctrl + base);
+        for (detail::GroupMask match = probe.match(h2); match; match.clear_lowest()) {
+            size_t index = base + match.lowest();
+            if (key_equal(slots[index].key, key)) [[likely]] {
+                return index;
+            }
+        }
+        if (probe.match_empty()) [[likely]] {
+            return capacity; // The key would have been placed in this group
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+// Probe for a free slot
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::find_insert_slot(size_t hash) const {
+    const size_t group_mask = capacity / detail::GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & group_mask;
+    for (size_t step = 1;; ++step) {
+        const size_t base = group * detail::GROUP_WIDTH;
+        detail::GroupMask free_slots = detail::Group(ctrl + base).match_empty_or_deleted();
+        if (free_slots) [[likely]] {
+            return base + free_slots.lowest();
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+// Next full slot
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+size_t FlatHashMap<K, V, Alloc, Hash, KeyEqual>::next_full(size_t index) const {
+    while (index < capacity && ctrl[index] < 0) {
+        ++index;
+    }
+    return index;
+}
+
+// Insert an absent key
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+template <typename KeyArg, typename... Args>
+std::expected<size_t, FlatHashMapError> FlatHashMap<K, V, Alloc, Hash, KeyEqual>::insert_new(KeyArg&& key, size_t hash,
+                                                                                             Args&&... args) {
+    // Reusing a tombstone does not use up growth, only filling an empty slot does
+    if (capacity == 0 || (growth_left == 0 && ctrl[find_insert_slot(hash)] == detail::CTRL_EMPTY)) {
+        // Mostly tombstones: rehash at the same size to drop them, otherwise double
+        size_t new_capacity = MIN_CAPACITY;
+        if (capacity != 0) {
+            new_capacity = size < max_load(capacity) / 2 ? capacity : capacity * 2;
+        }
+        auto result = rehash(new_capacity);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+    }
+
+    size_t index = find_insert_slot(hash);
+    if (ctrl[index] == detail::CTRL_EMPTY) {
+        --growth_left;
+    }
+    ::new (static_cast<void*>(slots + index)) Entry{std::forward<KeyArg>(key), V(std::forward<Args>(args)...)};
+    ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+    ++size;
+    return index;
+}
+
+// Move the entries to a new table
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+std::expected<void, FlatHashMapError> FlatHashMap<K, V, Alloc, Hash, KeyEqual>::rehash(size_t new_capacity) {
+    auto& backend = detail::allocator_of(allocator);
+    const size_t new_bytes = table_size(new_capacity);
+
+    // No zeroing, every control byte is written below and entries are constructed in place
+    auto alloc_result = detail::allocate_from(backend, new_bytes, BLOCK_ALIGNMENT);
+    if (!alloc_result) {
+        recorder.record_failure();
+        return std::unexpected(FlatHashMapError::OutOfMemory);
+    }
+
+    int8_t* old_ctrl = ctrl;
+    Entry* old_slots = slots;
+    size_t old_capacity = capacity;
+
+    ctrl = static_cast<int8_t*>(alloc_result.value());
+    slots = reinterpret_cast<Entry*>(reinterpret_cast<unsigned char*>(ctrl) + slots_offset(new_capacity));
+    capacity = new_capacity;
+    growth_left = max_load(new_capacity) - size;
+    std::memset(ctrl, detail::CTRL_EMPTY, new_capacity);
+
+    for (size_t i = 0; i < old_capacity; ++i) {
+        if (old_ctrl[i] < 0) {
+            continue;
+        }
+        size_t hash = hash_of(old_slots[i].key);
+        size_t index = find_insert_slot(hash);
+        if constexpr (is_trivially_relocatable_v<K> && is_trivially_relocatable_v<V>) {
+            std::memcpy(static_cast<void*>(slots + index), static_cast<const void*>(old_slots + i), sizeof(Entry));
+        } else {
+            ::new (static_cast<void*>(slots + index)) Entry(std::move(old_slots[i]));
+            std::destroy_at(old_slots + i);
+        }
+        ctrl[index] = static_cast<int8_t>(hash & 0x7F);
+    }
+
+    if (old_ctrl == nullptr) {
+        recorder.record_alloc(new_bytes);
+    } else {
+        detail::deallocate_to(backend, old_ctrl, table_size(old_capacity), BLOCK_ALIGNMENT);
+        recorder.record_resize(false);
+    }
+    recorder.record_in_use(new_bytes);
+    return {};
+}
+
+// Destroy every entry
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Alloc, Hash, KeyEqual>::destroy_entries() {
+    if constexpr (!std::is_trivially_destructible_v<Entry>) {
+        for (size_t i = 0; i < capacity; ++i) {
+            if (ctrl[i] >= 0) {
+                std::destroy_at(slots + i);
+            }
+        }
+    }
+}
+
+// Hand the table back
+template <typename K, typename V, AllocatorHandle Alloc, typename Hash, typename KeyEqual>
+void FlatHashMap<K, V, Alloc, Hash, KeyEqual>::release() {
+    if (ctrl != nullptr) {
+        detail::deallocate_to(detail::allocator_of(allocator), ctrl, table_size(capacity), BLOCK_ALIGNMENT);
+    }
+}
+
+} // namespace memory
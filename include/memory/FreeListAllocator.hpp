@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Strategy used to pick a free block for an allocation
+ */
+enum class PlacementPolicy {
+    FirstFit, ///< Take the first free block that is large enough (fastest)
+    BestFit   ///< Take the smallest free block that is large enough (least fragmentation)
+};
+
+/**
+ * @brief Node of the address-ordered free list, stored inside every free block
+ */
+struct FreeListNode {
+    FreeListNode* next; ///< Next free block (higher address)
+    size_t block_size;  ///< Size of this free block in bytes
+};
+
+/**
+ * @brief Header stored directly in front of every allocation
+ */
+struct FreeListAllocationHeader {
+    size_t block_size; ///< Size of the whole block, from block start to block end
+    size_t padding;    ///< Bytes between the block start and the user pointer
+};
+
+/**
+ * @brief General-purpose free list allocator over a fixed buffer
+ *
+ * Variable-sized allocations are carved out of free blocks chosen by a placement
+ * policy. Free blocks are kept in a singly linked list sorted by address so that
+ * adjacent free blocks are coalesced on free.
+ *
+ * @note Allocation and free are O(n) in the number of free blocks, with no global
+ *       heap lock and no system calls.
+ */
+struct FreeListAllocator {
+    unsigned char* buf;       ///< Pointer to backing buffer (aligned for free list nodes)
+    size_t buf_len;           ///< Length of backing buffer
+    size_t used;              ///< Bytes currently handed out, including headers and padding
+    FreeListNode* head;       ///< Lowest-addressed free block
+    PlacementPolicy policy;   ///< Placement policy used by alloc_align
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default alignment for allocations
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = LinearAllocator::DEFAULT_ALIGNMENT;
+
+    /**
+     * @brief Initialize a free list allocator with provided backing buffer
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @param policy Placement policy for allocations
+     * @return std::expected<FreeListAllocator, AllocatorError> Initialized FreeListAllocator or error
+     */
+    static std::expected<FreeListAllocator, AllocatorError> create(void* backing_buffer, size_t backing_buffer_length,
+                                                                   PlacementPolicy policy = PlacementPolicy::FirstFit);
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate memory with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note Grows in place when the block directly after the allocation is free and
+     *       large enough; shrinking returns the tail to the free list. Otherwise the
+     *       data is moved to a new block and the old one freed.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an existing allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     *
+     * @note The grown tail is not zeroed.
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free a specific memory allocation, coalescing it with free neighbours
+     *
+     * @param ptr Pointer to memory previously allocated by this allocator
+     * @return std::expected<void, AllocatorError> Success or error code
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Free all allocations, leaving a single free block
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use mirrors used, headers and padding included.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+private:
+    /**
+     * @brief Insert a free block into the address-ordered list and merge it with its neighbours
+     *
+     * @param block Start of the free block
+     * @param block_size Size of the free block
+     */
+    void insert_free_block(unsigned char* block, size_t block_size);
+};
+
+} // namespace memory
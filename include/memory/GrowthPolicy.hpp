@@ -0,0 +1,160 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+
+namespace memory {
+
+/**
+ * @brief Compile-time rule for how far a container grows when it runs out of room
+ *
+ * next_capacity gets the current capacity (0 for an array that never allocated),
+ * the capacity the container needs and the element size, and returns the capacity
+ * to allocate. The result must be at least required.
+ *
+ * A policy may also set USE_USABLE_SIZE to true, asking the container to widen its
+ * capacity to whatever the allocator really handed out (see UsableSizeGrowth).
+ *
+ * @tparam P Policy type
+ */
+template <typename P>
+concept GrowthPolicy = requires(size_t capacity, size_t required, size_t element_size) {
+    { P::next_capacity(capacity, required, element_size) } -> std::same_as<size_t>;
+};
+
+/**
+ * @brief Geometric growth by Num / Den, in integer arithmetic
+ *
+ * The default 3 / 2 is the classic 1.5x factor, which lets a free list reuse
+ * earlier blocks. 2 / 1 halves the number of reallocations and suits arenas,
+ * where the last block is extended in place anyway.
+ *
+ * @tparam Num Numerator of the growth factor
+ * @tparam Den Denominator of the growth factor
+ */
+template <size_t Num = 3, size_t Den = 2>
+struct GeometricGrowth {
+    static_assert(Den > 0 && Num > Den, "Growth factor has to be larger than one");
+
+    /**
+     * @brief Compute the next capacity
+     *
+     * @param capacity Current capacity in elements
+     * @param required Minimum capacity needed in elements
+     * @param element_size Size of one element in bytes (unused)
+     * @return Capacity to allocate in elements
+     */
+    static constexpr size_t next_capacity(size_t capacity, size_t required, size_t /*element_size*/) {
+        // capacity * Num / Den without overflowing the intermediate product
+        size_t grown = capacity / Den * Num + capacity % Den * Num / Den + 1;
+        if (grown < capacity) {
+            grown = std::numeric_limits<size_t>::max();
+        }
+        return grown > required ? grown : required;
+    }
+};
+
+/**
+ * @brief Double the capacity and keep it a power of two
+ *
+ * Power-of-two capacities map cleanly onto buddy and size-class allocators.
+ */
+struct PowerOfTwoGrowth {
+    /**
+     * @brief Compute the next capacity
+     *
+     * @param capacity Current capacity in elements
+     * @param required Minimum capacity needed in elements
+     * @param element_size Size of one element in bytes (unused)
+     * @return Capacity to allocate in elements
+     */
+    static constexpr size_t next_capacity(size_t capacity, size_t required, size_t /*element_size*/) {
+        size_t target = capacity < required ? required : capacity + 1;
+        if (target > (std::numeric_limits<size_t>::max() >> 1) + 1) {
+            return target;
+        }
+        return std::bit_ceil(target);
+    }
+};
+
+/**
+ * @brief Grow by Base, capped at MaxStep bytes per step, rounded up to whole pages
+ *
+ * For very large arrays: with PageSize set to the (huge)page size the allocation
+ * always fills its last page, and MaxStep turns geometric growth into linear growth
+ * once a step would exceed it, so a multi-gigabyte array does not overshoot by
+ * gigabytes.
+ *
+ * @tparam PageSize Granularity in bytes (must be a power of two)
+ * @tparam MaxStep Largest growth step in bytes, 0 for no cap
+ * @tparam Base Policy computing the step before capping and rounding
+ */
+template <size_t PageSize = 4096, size_t MaxStep = 0, GrowthPolicy Base = GeometricGrowth<>>
+struct PageGrowth {
+    static_assert(std::has_single_bit(PageSize), "Page size has to be a power of two");
+
+    /**
+     * @brief Compute the next capacity
+     *
+     * @param capacity Current capacity in elements
+     * @param required Minimum capacity needed in elements
+     * @param element_size Size of one element in bytes
+     * @return Capacity to allocate in elements
+     */
+    static constexpr size_t next_capacity(size_t capacity, size_t required, size_t element_size) {
+        size_t target = Base::next_capacity(capacity, required, element_size);
+        if constexpr (MaxStep != 0) {
+            size_t max_step = MaxStep / element_size > 0 ? MaxStep / element_size : 1;
+            if (target - capacity > max_step) {
+                target = capacity + max_step > required ? capacity + max_step : required;
+            }
+        }
+
+        if (target > (std::numeric_limits<size_t>::max() - PageSize) / element_size) {
+            return target;
+        }
+        size_t bytes = (target * element_size + PageSize - 1) & ~(PageSize - 1);
+        return bytes / element_size;
+    }
+};
+
+/**
+ * @brief Grow by Base, then use whatever slack the allocator really handed out
+ *
+ * With HeapAllocator the capacity is widened to malloc_usable_size (or the
+ * platform's equivalent) after every growth, so the bytes malloc rounds up to are
+ * not wasted. Allocators without a usable_size member leave the capacity as is.
+ *
+ * @tparam Base Policy computing the requested capacity
+ */
+template <GrowthPolicy Base = GeometricGrowth<>>
+struct UsableSizeGrowth {
+    /**
+     * @brief Ask the container to widen its capacity to the usable size
+     */
+    static constexpr bool USE_USABLE_SIZE = true;
+
+    /**
+     * @brief Compute the next capacity
+     *
+     * @param capacity Current capacity in elements
+     * @param required Minimum capacity needed in elements
+     * @param element_size Size of one element in bytes
+     * @return Capacity to allocate in elements
+     */
+    static constexpr size_t next_capacity(size_t capacity, size_t required, size_t element_size) {
+        return Base::next_capacity(capacity, required, element_size);
+    }
+};
+
+/**
+ * @brief Check whether a growth policy wants the usable size of an allocation
+ *
+ * @tparam P Policy type
+ */
+template <typename P>
+inline constexpr bool uses_usable_size_v = requires { requires P::USE_USABLE_SIZE; };
+
+} // namespace memory
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Stateless allocator on top of the C heap
+ *
+ * The default allocator of DynArray. It has no data members, so containers that
+ * hold it with [[no_unique_address]] pay nothing for it. Alignments up to
+ * alignof(std::max_align_t) use malloc/realloc; larger ones use the aligned heap.
+ */
+struct HeapAllocator {
+    /**
+     * @brief Default alignment for allocations
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = alignof(std::max_align_t);
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate memory with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note Uses realloc for regular alignments, so the heap may grow the block in place.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Get the number of bytes actually usable in an allocation
+     *
+     * malloc rounds requests up to its size classes; the slack can be used without
+     * reallocating. Asks malloc_usable_size, malloc_size or _aligned_msize depending
+     * on the platform, and returns size where none is available.
+     *
+     * @param ptr Pointer to memory previously allocated by a HeapAllocator
+     * @param size Size the allocation was requested with
+     * @param align Alignment the allocation was requested with
+     * @return Usable size in bytes (at least size)
+     */
+    size_t usable_size(void* ptr, size_t size, size_t align) const;
+
+    /**
+     * @brief Free an allocation
+     *
+     * @param ptr Pointer to memory previously allocated by a HeapAllocator
+     * @return std::expected<void, AllocatorError> Success or error code
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Get a snapshot of the usage statistics of all heap allocations
+     *
+     * The allocator is stateless, so the counters are process-wide and shared by
+     * every HeapAllocator. bytes_in_use counts usable sizes; on Windows, free has to
+     * guess the alignment, so over-aligned blocks are sized approximately there.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+};
+
+} // namespace memory
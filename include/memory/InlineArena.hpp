@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <tuple>
+#include <type_traits>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+namespace detail {
+
+/**
+ * @brief Offsets of one object of each type laid out back to back from offset 0
+ *
+ * Arrays of known bound (int[64]) take sizeof of the whole array. The last entry is
+ * the end of the layout.
+ *
+ * @return Offset of every type, then the total size
+ */
+template <typename... Ts>
+constexpr std::array<size_t, sizeof...(Ts) + 1> inline_layout() {
+    std::array<size_t, sizeof...(Ts) + 1> offsets{};
+    constexpr size_t sizes[] = {sizeof(Ts)..., 0};
+    constexpr size_t alignments[] = {alignof(Ts)..., 1};
+    size_t offset = 0;
+    for (size_t i = 0; i < sizeof...(Ts); ++i) {
+        offset = static_cast<size_t>(LinearAllocator::align_forward(offset, alignments[i]).value());
+        offsets[i] = offset;
+        offset += sizes[i];
+    }
+    offsets[sizeof...(Ts)] = offset;
+    return offsets;
+}
+
+} // namespace detail
+
+/**
+ * @brief Linear allocator with its N-byte buffer stored inline
+ *
+ * Lives on the stack or as a member and never touches the heap. It offers the
+ * LinearAllocator interface on its own buffer, and an InlineArena<N>* plugs into
+ * DynArray, FlatHashMap and the other containers like a LinearAllocator*. The
+ * buffer is part of the object, so an InlineArena cannot be copied or moved.
+ *
+ * For hot paths whose allocations are known up front, carve<Ts...>() resets the
+ * arena and places one object of each type at offsets computed at compile time.
+ * A static_assert proves the layout fits, so there is no overflow check and no
+ * std::expected at runtime: the result is the buffer address plus constants.
+ *
+ * @code
+ * InlineArena<4096> scratch;
+ * auto [header, indices, weights] = scratch.carve<Header, uint32_t[256], float[256]>();
+ * DynArray<Edge, LinearAllocator*> extra(scratch.get_allocator()); // rest of the buffer, checked as usual
+ * @endcode
+ *
+ * @tparam N Buffer size in bytes
+ * @tparam Align Alignment of the buffer, and the largest alignment carve accepts
+ */
+template <size_t N, size_t Align = LinearAllocator::DEFAULT_ALIGNMENT>
+struct InlineArena {
+    static_assert(N > 0, "InlineArena needs a non-empty buffer");
+    static_assert(LinearAllocator::is_power_of_two(Align), "Alignment has to be a power of two");
+
+    LinearAllocator arena;                 ///< Allocator over buffer
+    alignas(Align) unsigned char buffer[N]; ///< Inline backing memory
+
+    /**
+     * @brief Buffer size in bytes
+     */
+    static constexpr size_t CAPACITY = N;
+
+    /**
+     * @brief Alignment of the buffer
+     */
+    static constexpr size_t ALIGNMENT = Align;
+
+    /**
+     * @brief Bytes carve<Ts...>() takes from the start of the buffer
+     */
+    template <typename... Ts>
+    static constexpr size_t layout_size = detail::inline_layout<Ts...>()[sizeof...(Ts)];
+
+    /**
+     * @brief Whether carve<Ts...>() fits in the buffer
+     */
+    template <typename... Ts>
+    static constexpr bool fits = layout_size<Ts...> <= N && ((alignof(Ts) <= Align) && ...);
+
+    /**
+     * @brief Constructor, the whole buffer is free
+     */
+    InlineArena();
+
+    /**
+     * @brief Destructor, unpoisons the buffer with MEMORY_ARENA_DEBUG
+     */
+    ~InlineArena();
+
+    InlineArena(const InlineArena&) = delete;
+    InlineArena& operator=(const InlineArena&) = delete;
+
+    /**
+     * @brief Reset the arena and lay out one zeroed object of each type
+     *
+     * Objects are value-initialized; array types give a pointer to their first
+     * element. Later allocations continue after the layout.
+     *
+     * @return std::tuple of pointers, one per type
+     */
+    template <typename... Ts>
+    std::tuple<std::remove_extent_t<Ts>*...> carve();
+
+    /**
+     * @brief Reset the arena and lay out one object of each type, left uninitialized
+     *
+     * @return std::tuple of pointers, one per type
+     */
+    template <typename... Ts>
+    std::tuple<std::remove_extent_t<Ts>*...> carve_uninit();
+
+    /**
+     * @brief Get the allocator over the buffer
+     *
+     * @return Pointer to the LinearAllocator, valid as long as this arena
+     */
+    LinearAllocator* get_allocator();
+
+    /**
+     * @brief Allocate memory with specified alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment requirement (must be power of 2)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with specified alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment requirement (must be power of 2)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Resize an allocation, in place if it is the most recent one
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment requirement (must be power of 2)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an allocation without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment requirement (must be power of 2)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Try to resize an allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if resized in place, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free an allocation (only reclaims space for the most recent one)
+     *
+     * @param ptr Pointer to free
+     * @return std::expected<void, AllocatorError> Success or error code
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Free everything allocated from the arena
+     */
+    void free_all();
+
+    /**
+     * @brief Get the number of bytes allocated so far
+     *
+     * @return Bytes in use, including alignment padding
+     */
+    size_t get_used() const;
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/InlineArena.tpp"
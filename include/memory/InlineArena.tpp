@@ -0,0 +1,126 @@
+#pragma once
+
+#include "memory/InlineArena.hpp"
+
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace memory {
+
+// Constructor
+template <size_t N, size_t Align>
+InlineArena<N, Align>::InlineArena() : arena(LinearAllocator::create(buffer, N)) {}
+
+// Destructor
+template <size_t N, size_t Align>
+InlineArena<N, Align>::~InlineArena() {
+    // Stack memory is reused after return, so it must not stay poisoned
+    arena.destroy();
+}
+
+// Reset and lay out zeroed objects
+template <size_t N, size_t Align>
+template <typename... Ts>
+std::tuple<std::remove_extent_t<Ts>*...> InlineArena<N, Align>::carve() {
+    auto pointers = carve_uninit<Ts...>();
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (std::uninitialized_value_construct_n(std::get<I>(pointers),
+                                              std::is_array_v<Ts> ? std::extent_v<Ts> : 1),
+         ...);
+    }(std::index_sequence_for<Ts...>{});
+    return pointers;
+}
+
+// Reset and lay out uninitialized objects
+template <size_t N, size_t Align>
+template <typename... Ts>
+std::tuple<std::remove_extent_t<Ts>*...> InlineArena<N, Align>::carve_uninit() {
+    static_assert(sizeof...(Ts) > 0, "carve needs at least one type");
+    static_assert(((alignof(Ts) <= Align) && ...), "carve cannot align beyond the buffer's alignment");
+    static_assert(layout_size<Ts...> <= N, "carve layout does not fit in the InlineArena");
+
+    constexpr auto offsets = detail::inline_layout<Ts...>();
+    constexpr size_t end = offsets[sizeof...(Ts)];
+
+#if MEMORY_ARENA_DEBUG
+    // Validate and poison whatever the previous layout left behind
+    arena.free_all();
+    detail::arena_unpoison(buffer, end);
+#else
+    arena.recorder.record_reset();
+#endif
+    arena.prev_offset = offsets[sizeof...(Ts) - 1];
+    arena.curr_offset = end;
+    arena.recorder.record_alloc(end);
+    arena.recorder.record_in_use(end);
+
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return std::tuple<std::remove_extent_t<Ts>*...>(
+            reinterpret_cast<std::remove_extent_t<Ts>*>(buffer + offsets[I])...);
+    }(std::index_sequence_for<Ts...>{});
+}
+
+// Get the allocator over the buffer
+template <size_t N, size_t Align>
+LinearAllocator* InlineArena<N, Align>::get_allocator() {
+    return &arena;
+}
+
+// Allocate memory with specified alignment
+template <size_t N, size_t Align>
+std::expected<void*, AllocatorError> InlineArena<N, Align>::alloc_align(size_t size, size_t align) {
+    return arena.alloc_align(size, align);
+}
+
+// Allocate memory with specified alignment without zeroing it
+template <size_t N, size_t Align>
+std::expected<void*, AllocatorError> InlineArena<N, Align>::alloc_align_uninit(size_t size, size_t align) {
+    return arena.alloc_align_uninit(size, align);
+}
+
+// Allocate memory with default alignment
+template <size_t N, size_t Align>
+std::expected<void*, AllocatorError> InlineArena<N, Align>::alloc(size_t size) {
+    return arena.alloc(size);
+}
+
+// Resize an allocation
+template <size_t N, size_t Align>
+std::expected<void*, AllocatorError> InlineArena<N, Align>::resize_align(void* old_memory, size_t old_size,
+                                                                      size_t new_size, size_t align) {
+    return arena.resize_align(old_memory, old_size, new_size, align);
+}
+
+// Resize an allocation without zeroing the grown tail
+template <size_t N, size_t Align>
+std::expected<void*, AllocatorError> InlineArena<N, Align>::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                             size_t new_size, size_t align) {
+    return arena.resize_align_uninit(old_memory, old_size, new_size, align);
+}
+
+// Try to resize an allocation without moving it
+template <size_t N, size_t Align>
+bool InlineArena<N, Align>::try_resize_in_place(void* old_memory, size_t old_size, size_t new_size) {
+    return arena.try_resize_in_place(old_memory, old_size, new_size);
+}
+
+// Free an allocation
+template <size_t N, size_t Align>
+std::expected<void, AllocatorError> InlineArena<N, Align>::free(void* ptr) {
+    return arena.free(ptr);
+}
+
+// Free everything
+template <size_t N, size_t Align>
+void InlineArena<N, Align>::free_all() {
+    arena.free_all();
+}
+
+// Bytes allocated so far
+template <size_t N, size_t Align>
+size_t InlineArena<N, Align>::get_used() const {
+    return arena.curr_offset;
+}
+
+} // namespace memory
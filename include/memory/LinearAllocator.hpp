@@ -7,6 +7,9 @@
 #include <string_view>
 #include <memory>
 
+#include "memory/AllocatorStats.hpp"
+#include "memory/ArenaDebug.hpp"
+
 namespace memory {
 
 /**
@@ -16,7 +19,48 @@ enum class AllocatorError {
     OutOfMemory,      ///< Not enough memory available for allocation
     InvalidAlignment, ///< Alignment value is not a power of two
     NullPointer,      ///< Provided pointer is null
-    OutOfBounds       ///< Memory operation outside allocator's buffer
+    OutOfBounds,      ///< Memory operation outside allocator's buffer
+    OutOfOrderFree    ///< Freed allocation is not the most recent one (stack allocators, debug builds)
+};
+
+struct VirtualArena;
+struct ArenaBlock;
+
+/**
+ * @brief Huge page policy for reserved address ranges
+ */
+enum class HugePageMode {
+    Off,         ///< Regular pages only
+    Transparent, ///< Align the range and hint the kernel to use transparent huge pages
+    Explicit     ///< Map explicit huge pages (MAP_HUGETLB), falling back to Transparent
+};
+
+/**
+ * @brief NUMA memory policy for reserved address ranges
+ */
+enum class NumaPolicy {
+    Default,    ///< Pages land on the node of the thread that first touches them
+    Bind,       ///< Pages only come from the given node
+    Preferred,  ///< Pages come from the given node while it has free memory
+    Interleave  ///< Pages are spread round-robin over all nodes
+};
+
+/**
+ * @brief Where the pages of a reserved address range are placed
+ */
+struct NumaPlacement {
+    NumaPolicy policy = NumaPolicy::Default; ///< Placement policy
+    size_t node = 0;                         ///< Node for Bind and Preferred
+};
+
+/**
+ * @brief Options for a LinearAllocator backed by a virtual memory reservation
+ */
+struct ReserveOptions {
+    size_t commit_step = 2 * 1024 * 1024;  ///< Granularity in which pages are committed (rounded up to whole pages)
+    size_t retain_committed = SIZE_MAX;    ///< Bytes kept committed across free_all/TempArenaMemory::end, the rest is decommitted
+    HugePageMode huge_pages = HugePageMode::Off; ///< Huge page policy for the reservation
+    NumaPlacement numa = {};               ///< NUMA placement of the reservation (a hint, ignored where unsupported)
 };
 
 /**
@@ -33,6 +77,11 @@ struct LinearAllocator {
     size_t buf_len;           ///< Length of backing buffer
     size_t prev_offset;       ///< Previous allocation offset
     size_t curr_offset;       ///< Current allocation offset
+    size_t committed;         ///< Bytes at the front of buf that are committed (buf_len for plain buffers)
+    size_t commit_step;       ///< Commit granularity, 0 if the buffer is not a reservation we own
+    size_t retain_committed;  ///< Committed bytes kept across resets, the rest is decommitted
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+    [[no_unique_address]] ArenaDebugState debug;  ///< Red zone bookkeeping (empty unless MEMORY_ARENA_DEBUG)
 
     /**
      * @brief Default alignment for allocations
@@ -48,13 +97,41 @@ struct LinearAllocator {
      */
     static LinearAllocator create(void* backing_buffer, size_t backing_buffer_length);
 
+    /**
+     * @brief Initialize a linear allocator over a fresh virtual memory reservation
+     *
+     * The whole address range is reserved up front but pages are only committed in
+     * steps of options.commit_step as the allocator moves forward. The memory stays
+     * contiguous, so the most recent allocation can always be resized in place and
+     * pointers are never invalidated.
+     *
+     * @param reserve_size Size of the address range to reserve (e.g. 64 GiB)
+     * @param options Commit, decommit, huge page and NUMA placement options
+     * @return std::expected<LinearAllocator, AllocatorError> Initialized LinearAllocator,
+     *         OutOfBounds if options.numa names a node without memory, or error
+     *
+     * @note Call destroy() to release the reservation.
+     * @note A NUMA placement the system cannot apply leaves the pages unbound and is
+     *       counted in stats().failed_allocations.
+     */
+    static std::expected<LinearAllocator, AllocatorError> create_reserved(size_t reserve_size,
+                                                                         const ReserveOptions& options = {});
+
+    /**
+     * @brief Release the virtual memory reservation, if this allocator owns one
+     *
+     * Does nothing for allocators created over a caller-provided buffer, except
+     * unpoisoning it with MEMORY_ARENA_DEBUG so the caller can reuse it.
+     */
+    void destroy();
+
     /**
      * @brief Check if a value is a power of two
      *
      * @param x Value to check
      * @return true if x is a power of two, false otherwise
      */
-    static bool is_power_of_two(uintptr_t x);
+    static constexpr bool is_power_of_two(uintptr_t x);
 
     /**
      * @brief Align a memory address forward to the specified alignment
@@ -62,8 +139,10 @@ struct LinearAllocator {
      * @param ptr Address to align
      * @param align Alignment (must be a power of two)
      * @return std::expected<uintptr_t, AllocatorError> Aligned address or error
+     *
+     * @note constexpr, so offsets can be laid out at compile time as well
      */
-    static std::expected<uintptr_t, AllocatorError> align_forward(uintptr_t ptr, size_t align);
+    static constexpr std::expected<uintptr_t, AllocatorError> align_forward(uintptr_t ptr, size_t align);
 
     /**
      * @brief Allocate memory with alignment
@@ -76,6 +155,17 @@ struct LinearAllocator {
      */
     std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
 
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note For callers that overwrite the memory anyway (e.g. placement construction)
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
     /**
      * @brief Allocate memory with default alignment
      *
@@ -84,6 +174,14 @@ struct LinearAllocator {
      */
     std::expected<void*, AllocatorError> alloc(size_t size);
 
+    /**
+     * @brief Allocate memory with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
     /**
      * @brief Allocate memory for a specific type with default alignment
      *
@@ -111,6 +209,18 @@ struct LinearAllocator {
     std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
                                                    size_t new_size, size_t align);
 
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
     /**
      * @brief Resize an existing allocation with default alignment
      *
@@ -121,6 +231,20 @@ struct LinearAllocator {
      */
     std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
 
+    /**
+     * @brief Try to resize an existing allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     *
+     * @note Only the most recent allocation can be resized in place. On failure the
+     *       allocator state is left untouched so the caller can fall back to a copy.
+     *       The grown tail is not zeroed.
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
     /**
      * @brief Free a specific memory allocation
      *
@@ -133,8 +257,58 @@ struct LinearAllocator {
 
     /**
      * @brief Free all allocations from this allocator
+     *
+     * @note Reserved allocators decommit pages above retain_committed. With
+     *       MEMORY_ARENA_DEBUG the red zones are validated and all memory is poisoned.
      */
     void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use is the current offset; the peak is the high-water mark to size
+     * the arena by.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Roll the offsets back to a saved position
+     *
+     * With MEMORY_ARENA_DEBUG, the red zones of everything allocated since are
+     * validated and the rolled-back memory is poisoned. Used by free_all and
+     * TempArenaMemory::end.
+     *
+     * @param saved_prev_offset Saved previous offset
+     * @param saved_curr_offset Saved current offset
+     * @param saved_debug Saved red zone bookkeeping
+     */
+    void rollback(size_t saved_prev_offset, size_t saved_curr_offset, const ArenaDebugState& saved_debug);
+
+    /**
+     * @brief Validate the red zones of every live allocation
+     *
+     * Aborts with a message on stderr if one was overwritten. Does nothing unless
+     * MEMORY_ARENA_DEBUG.
+     */
+    void check_guards() const;
+
+    /**
+     * @brief Decommit pages above max(curr_offset, retain_committed)
+     *
+     * Does nothing for allocators created over a caller-provided buffer.
+     */
+    void trim_committed();
+
+private:
+    /**
+     * @brief Make sure the first end bytes of the buffer are committed
+     *
+     * @param end Offset one past the last byte that has to be usable
+     * @return true if the range is committed, false if committing failed
+     */
+    bool ensure_committed(size_t end);
 };
 
 /**
@@ -145,8 +319,11 @@ struct LinearAllocator {
  */
 struct TempArenaMemory {
     LinearAllocator* arena;  ///< The arena to save/restore
+    VirtualArena* chain;     ///< Chained arena the scope was taken from, nullptr for a plain arena
+    ArenaBlock* block;       ///< Block of the chained arena that was current at begin
     size_t prev_offset;      ///< Saved previous offset
     size_t curr_offset;      ///< Saved current offset
+    [[no_unique_address]] ArenaDebugState debug; ///< Saved red zone bookkeeping (empty unless MEMORY_ARENA_DEBUG)
 
     /**
      * @brief Begin a temporary memory scope from the given arena
@@ -156,10 +333,66 @@ struct TempArenaMemory {
      */
     static TempArenaMemory begin(LinearAllocator* a);
 
+    /**
+     * @brief Begin a temporary memory scope from a chained arena
+     *
+     * Blocks chained in after begin are released again by end.
+     *
+     * @param a Pointer to the chained arena to create a temporary scope from
+     * @return TempArenaMemory Temporary memory scope object
+     */
+    static TempArenaMemory begin(VirtualArena* a);
+
+    /**
+     * @brief Allocate scratch memory inside this scope
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Scratch memory is not zeroed; it is thrown away by end() anyway
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate scratch memory with default alignment inside this scope
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
     /**
      * @brief End the temporary memory scope, restoring the arena to its previous state
+     *
+     * With MEMORY_ARENA_DEBUG the red zones of the scope's allocations are validated
+     * and the scope's memory is poisoned.
      */
     void end();
 };
 
+// Check if a value is a power of two
+constexpr bool LinearAllocator::is_power_of_two(uintptr_t x) {
+    return (x & (x-1)) == 0 && x != 0;
+}
+
+// Align an address forward to a power of two
+constexpr std::expected<uintptr_t, AllocatorError> LinearAllocator::align_forward(uintptr_t ptr, size_t align) {
+    if (!is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    uintptr_t p = ptr;
+    uintptr_t a = static_cast<uintptr_t>(align);
+    // Same as (p % a) but faster as 'a' is a power of two
+    uintptr_t modulo = p & (a-1);
+
+    if (modulo != 0) {
+        // If 'p' address is not aligned, push the address to the
+        // next value which is aligned
+        p += a - modulo;
+    }
+    return p;
+}
+
 } // namespace memory
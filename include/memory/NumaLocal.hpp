@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+#include <type_traits>
+
+#include "memory/DynArray.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/VirtualMemory.hpp"
+
+namespace memory {
+
+/**
+ * @brief NUMA node of the calling thread
+ *
+ * Looked up once per thread and cached, since workers are expected to be pinned.
+ * A thread that moves to another node calls refresh_thread_numa_node afterwards.
+ *
+ * @return Node number (0 without NUMA support)
+ */
+size_t thread_numa_node();
+
+/**
+ * @brief Look up the calling thread's NUMA node again, e.g. after pinning it
+ *
+ * @return The new node number
+ */
+size_t refresh_thread_numa_node();
+
+/**
+ * @brief One allocator instance per NUMA node, each over memory bound to its node
+ *
+ * For every node a virtual memory reservation is made with a Bind (or Preferred)
+ * policy for that node, and the factory builds the node's instance on top of it
+ * through the usual create(LinearAllocator*, ...) overloads. local() returns the
+ * instance of the calling thread's node, so workers on each socket allocate from
+ * local memory instead of all sharing pages first touched by one thread.
+ *
+ * Every thread on a node shares that node's instance, so Alloc has to be
+ * thread-safe (ThreadCachedPool, ConcurrentLinearAllocator) unless each node runs
+ * a single thread. Memory may be freed from any node through free(), which finds
+ * the owning instance by address.
+ *
+ * @code
+ * auto pools = NumaLocal<ThreadCachedPool>::create(1 << 30, [](LinearAllocator* arena, size_t) {
+ *     return ThreadCachedPool::create(arena, arena->buf_len, sizeof(Message));
+ * });
+ * void* message = pools->local().alloc().value(); // from the calling thread's node
+ * pools->free(message);                           // from any thread
+ * @endcode
+ *
+ * @tparam Alloc Allocator type built on each node (movable)
+ */
+template <typename Alloc>
+struct NumaLocal {
+    DynArray<LinearAllocator> arenas; ///< Node-bound reservation per node, indexed by node
+    DynArray<Alloc> instances;        ///< Allocator per node, indexed by node
+
+    /**
+     * @brief Reserve memory on every node and build an instance on each
+     *
+     * options.numa picks between NumaPolicy::Bind (the default) and
+     * NumaPolicy::Preferred; the node is always the instance's own. Nodes without
+     * memory of their own get an unbound reservation instead. Placement is a hint,
+     * so without NUMA support every instance ends up in ordinary memory.
+     *
+     * @param bytes_per_node Size of each node's reservation
+     * @param make Factory called as make(LinearAllocator* node_arena, size_t node),
+     *             returning std::expected<Alloc, AllocatorError>
+     * @param options Commit and huge page options for the reservations
+     * @return std::expected<NumaLocal, AllocatorError> One instance per node or error
+     */
+    template <typename Make>
+    static std::expected<NumaLocal, AllocatorError> create(size_t bytes_per_node, Make&& make,
+                                                           const ReserveOptions& options = {});
+
+    /**
+     * @brief Get the instance of the calling thread's node
+     *
+     * @return Reference to the node-local instance
+     */
+    Alloc& local();
+
+    /**
+     * @brief Get the instance of a node
+     *
+     * @param node Node number (less than node_count())
+     * @return Reference to the node's instance
+     */
+    Alloc& on_node(size_t node);
+
+    /**
+     * @brief Get the number of instances
+     *
+     * @return Number of NUMA nodes covered
+     */
+    size_t node_count() const;
+
+    /**
+     * @brief Find the node whose memory holds ptr
+     *
+     * @param ptr Pointer allocated from one of the instances
+     * @return Node number, or node_count() if ptr belongs to none of them
+     */
+    size_t node_of(const void* ptr) const;
+
+    /**
+     * @brief Return memory to the instance it came from, from any node
+     *
+     * @param ptr Pointer allocated from one of the instances
+     * @return std::expected<void, AllocatorError> Success, OutOfBounds if no instance owns ptr, or the instance's error
+     */
+    std::expected<void, AllocatorError> free(void* ptr)
+        requires requires(Alloc& a, void* p) { a.free(p); };
+
+    /**
+     * @brief Destroy the instances, then release every node's reservation
+     *
+     * @note Memory allocated from the instances must not be used afterwards.
+     */
+    void destroy();
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/NumaLocal.tpp"
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "memory/NumaLocal.hpp"
+
+namespace memory {
+
+// Reserve memory on every node and build an instance on each
+template <typename Alloc>
+template <typename Make>
+std::expected<NumaLocal<Alloc>, AllocatorError> NumaLocal<Alloc>::create(size_t bytes_per_node, Make&& make,
+                                                                         const ReserveOptions& options) {
+    const size_t nodes = VirtualMemory::numa_node_count();
+    NumaLocal result;
+    // The instances keep pointers to their arena, so it must never move
+    if (!result.arenas.reserve(nodes) || !result.instances.reserve(nodes)) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    for (size_t node = 0; node < nodes; ++node) {
+        ReserveOptions node_options = options;
+        node_options.numa.policy =
+            options.numa.policy == NumaPolicy::Preferred ? NumaPolicy::Preferred : NumaPolicy::Bind;
+        node_options.numa.node = node;
+        if (!VirtualMemory::numa_node_has_memory(node)) {
+            // A CPU-only node cannot be bound to; first touch from its threads
+            // places the pages on the nearest node that has memory
+            node_options.numa.policy = NumaPolicy::Default;
+        }
+
+        auto arena = LinearAllocator::create_reserved(bytes_per_node, node_options);
+        if (!arena) {
+            result.destroy();
+            return std::unexpected(arena.error());
+        }
+        if (!result.arenas.push_back(std::move(arena.value()))) {
+            arena.value().destroy();
+            result.destroy();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+
+        std::expected<Alloc, AllocatorError> instance = make(&result.arenas[node], node);
+        if (!instance) {
+            result.destroy();
+            return std::unexpected(instance.error());
+        }
+        if (!result.instances.push_back(std::move(instance.value()))) {
+            instance = std::unexpected(AllocatorError::OutOfMemory); // Destroy it before its arena goes
+            result.destroy();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+    }
+    return result;
+}
+
+// Get the instance of the calling thread's node
+template <typename Alloc>
+Alloc& NumaLocal<Alloc>::local() {
+    size_t node = thread_numa_node();
+    // Nodes that came online after create share the first instance
+    return instances[node < instances.get_size() ? node : 0];
+}
+
+// Get the instance of a node
+template <typename Alloc>
+Alloc& NumaLocal<Alloc>::on_node(size_t node) {
+    return instances[node];
+}
+
+// Get the number of instances
+template <typename Alloc>
+size_t NumaLocal<Alloc>::node_count() const {
+    return instances.get_size();
+}
+
+// Find the node whose reservation holds ptr
+template <typename Alloc>
+size_t NumaLocal<Alloc>::node_of(const void* ptr) const {
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    for (size_t node = 0; node < arenas.get_size(); ++node) {
+        const LinearAllocator& arena = arenas[node];
+        if (arena.buf <= p && p < arena.buf + arena.buf_len) {
+            return node;
+        }
+    }
+    return arenas.get_size();
+}
+
+// Return memory to the instance it came from
+template <typename Alloc>
+std::expected<void, AllocatorError> NumaLocal<Alloc>::free(void* ptr)
+    requires requires(Alloc& a, void* p) { a.free(p); }
+{
+    size_t node = node_of(ptr);
+    if (node >= instances.get_size()) {
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+    return instances[node].free(ptr);
+}
+
+// Destroy the instances, then release every node's reservation
+template <typename Alloc>
+void NumaLocal<Alloc>::destroy() {
+    // Destroy the instances while the memory they point into is still mapped
+    instances.clear();
+    for (size_t node = 0; node < arenas.get_size(); ++node) {
+        arenas[node].destroy();
+    }
+    arenas.clear();
+}
+
+} // namespace memory
@@ -0,0 +1,475 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <functional> // For std::reference_wrapper
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "memory/DynArray.hpp"
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Error codes for opening and syncing a PersistentArena
+ */
+enum class PersistentArenaError {
+    IoError,       ///< Opening, sizing, mapping or syncing the file failed
+    InvalidFormat, ///< The file is not a persistent arena or was written by an incompatible build
+    ReadOnly       ///< The operation needs an arena opened for writing
+};
+
+/**
+ * @brief How an existing arena file is mapped
+ */
+enum class PersistentMode {
+    ReadOnly, ///< Shared read-only mapping, the arena cannot allocate
+    ReadWrite ///< Shared writable mapping, allocation resumes where it stopped
+};
+
+/**
+ * @brief Pointer that stays valid wherever the memory holding it is mapped
+ *
+ * Stores the distance from itself to the target instead of an address, so a
+ * structure linked with OffsetPtrs inside one mapping reads back correctly at any
+ * base address. Both ends have to live in the same mapping. Copying recomputes the
+ * distance for the new location, so an OffsetPtr is not trivially copyable and has
+ * to be copied by assignment, never by memcpy.
+ *
+ * @tparam T Pointee type
+ */
+template <typename T>
+struct OffsetPtr {
+    /**
+     * @brief Offset stored for nullptr; one byte into itself is never a real target
+     */
+    static constexpr intptr_t NULL_OFFSET = 1;
+
+    intptr_t offset; ///< Distance in bytes from this object to the target, NULL_OFFSET for nullptr
+
+    /**
+     * @brief Construct a null pointer
+     */
+    OffsetPtr() : offset(NULL_OFFSET) {}
+
+    /**
+     * @brief Construct a pointer to target
+     *
+     * @param target Object to point to, or nullptr
+     */
+    OffsetPtr(T* target) { set(target); }
+
+    /**
+     * @brief Copy constructor, points to the same target from the new location
+     *
+     * @param other Pointer to copy
+     */
+    OffsetPtr(const OffsetPtr& other) { set(other.get()); }
+
+    /**
+     * @brief Copy assignment, points to the same target from this location
+     *
+     * @param other Pointer to copy
+     * @return Reference to this pointer
+     */
+    OffsetPtr& operator=(const OffsetPtr& other) {
+        set(other.get());
+        return *this;
+    }
+
+    /**
+     * @brief Point to another target
+     *
+     * @param target Object to point to, or nullptr
+     * @return Reference to this pointer
+     */
+    OffsetPtr& operator=(T* target) {
+        set(target);
+        return *this;
+    }
+
+    /**
+     * @brief Get the target
+     *
+     * @return T* Pointer to the target, nullptr if null
+     */
+    T* get() const {
+        if (offset == NULL_OFFSET) {
+            return nullptr;
+        }
+        return reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + static_cast<uintptr_t>(offset));
+    }
+
+    /**
+     * @brief Dereference the pointer
+     *
+     * @return Reference to the target
+     */
+    T& operator*() const { return *get(); }
+
+    /**
+     * @brief Access a member of the target
+     *
+     * @return Pointer to the target
+     */
+    T* operator->() const { return get(); }
+
+    /**
+     * @brief Index from the target
+     *
+     * @param index Element index
+     * @return Reference to the element
+     */
+    T& operator[](size_t index) const { return get()[index]; }
+
+    /**
+     * @brief Check if the pointer is non-null
+     *
+     * @return true if it points somewhere, false otherwise
+     */
+    explicit operator bool() const { return offset != NULL_OFFSET; }
+
+private:
+    void set(T* target) {
+        offset = target == nullptr ? NULL_OFFSET
+                                   : static_cast<intptr_t>(reinterpret_cast<uintptr_t>(target) -
+                                                           reinterpret_cast<uintptr_t>(this));
+    }
+};
+
+/**
+ * @brief Position-independent array stored inside a PersistentArena
+ *
+ * Element storage and this header both live in the mapping, so the array reads back
+ * as is after the file is mapped again, anywhere. Offers the read side of the
+ * DynArray interface (operator[], at, get_data, get_size, iterators) and is created
+ * by PersistentArena::store_array from a span or a DynArray. Elements are copied
+ * with their copy constructor: plain data and OffsetPtr members survive a reload,
+ * raw pointers do not.
+ *
+ * @tparam T Element type
+ */
+template <typename T>
+struct PersistentArray {
+    OffsetPtr<T> data; ///< First element
+    size_t size;       ///< Number of elements
+
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Access an element
+     *
+     * @param index Element index
+     * @return Reference to the element
+     * @throws std::out_of_range if index >= get_size()
+     */
+    T& operator[](size_t index) const {
+        if (index >= size) {
+            throw std::out_of_range("PersistentArray index out of range");
+        }
+        return data.get()[index];
+    }
+
+    /**
+     * @brief Access an element with bounds checking
+     *
+     * @param index Element index
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Element or OutOfRange
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> at(size_t index) const {
+        if (index >= size) {
+            return std::unexpected(DynArrayError::OutOfRange);
+        }
+        return std::ref(data.get()[index]);
+    }
+
+    /**
+     * @brief Get the elements
+     *
+     * @return T* Pointer to the first element
+     */
+    T* get_data() const { return data.get(); }
+
+    /**
+     * @brief Get the number of elements
+     *
+     * @return Number of elements
+     */
+    size_t get_size() const { return size; }
+
+    /**
+     * @brief Check if the array is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const { return size == 0; }
+
+    /**
+     * @brief View the elements as a span
+     *
+     * @return std::span<T> The elements
+     */
+    std::span<T> span() const { return {data.get(), size}; }
+
+    iterator begin() const { return data.get(); }
+    iterator end() const { return data.get() + size; }
+};
+
+/**
+ * @brief Trait for types that PersistentArena may store
+ *
+ * Plain data that is trivially copyable qualifies on its own; raw pointers do not,
+ * since they are meaningless once the file is mapped again. Types that own heap
+ * memory (std::string, DynArray, ...) are rejected because they are not trivially
+ * copyable. OffsetPtr is not trivially copyable either, so a struct that links
+ * through OffsetPtr or PersistentArray members opts in by specializing this trait
+ * to std::true_type, declaring that every pointer it holds is an OffsetPtr.
+ *
+ * @tparam T The type to query
+ */
+template <typename T>
+struct is_persistable
+    : std::bool_constant<std::is_trivially_copyable_v<T> && !std::is_pointer_v<T> && !std::is_member_pointer_v<T>> {};
+
+/**
+ * @brief Convenience variable template for is_persistable
+ *
+ * @tparam T The type to query
+ */
+template <typename T>
+inline constexpr bool is_persistable_v = is_persistable<std::remove_cv_t<T>>::value;
+
+/**
+ * @brief Offset pointers are what makes data persistable
+ *
+ * @tparam T Pointee type
+ */
+template <typename T>
+struct is_persistable<OffsetPtr<T>> : std::true_type {};
+
+/**
+ * @brief Persistent arrays link to their elements through an OffsetPtr
+ *
+ * @tparam T Element type
+ */
+template <typename T>
+struct is_persistable<PersistentArray<T>> : is_persistable<std::remove_cv_t<T>> {};
+
+/**
+ * @brief Header at the start of a persistent arena file
+ *
+ * Takes the first DATA_OFFSET bytes of the file; the arena's memory follows.
+ */
+struct PersistentArenaHeader {
+    char magic[8];          ///< "MEMARENA"
+    uint32_t version;       ///< Layout version, PersistentArena::VERSION
+    uint32_t layout_tag;    ///< Pointer size and byte order of the writer
+    uint64_t data_offset;   ///< Bytes before the data region
+    uint64_t capacity;      ///< Size of the data region in bytes
+    uint64_t curr_offset;   ///< Bytes allocated in the data region
+    uint64_t prev_offset;   ///< Start of the most recent allocation
+    uint64_t root;          ///< Offset of the root object in the data region, NO_ROOT if none
+};
+
+/**
+ * @brief LinearAllocator over a memory-mapped file that outlives the process
+ *
+ * The file holds a header page and the arena's memory. Data built into the arena
+ * is there again after PersistentArena::open, with no parsing: pages are faulted
+ * in from the page cache as they are touched, and read-only openers in several
+ * processes share a single copy of them.
+ *
+ * Anything meant to survive a reload may only link to other data in the arena
+ * through OffsetPtr (or PersistentArray), since the mapping lands at a different
+ * address every time. make, store_array and root only accept types for which
+ * is_persistable holds, so std::string, raw pointers and the like are compile
+ * errors. Alignments up to the page size are preserved, because the
+ * data region starts on a page boundary. The file is only valid for builds with
+ * the same pointer size and byte order.
+ *
+ * @code
+ * auto file = PersistentArena::create("table.arena", 1 << 30);
+ * auto* table = file->store_array(std::span<const Entry>(entries)).value();
+ * file->set_root(table);
+ * file->close();
+ *
+ * auto reader = PersistentArena::open("table.arena", PersistentMode::ReadOnly);
+ * auto* same = reader->root<PersistentArray<Entry>>();
+ * @endcode
+ */
+struct PersistentArena {
+    LinearAllocator arena;         ///< Allocator over the data region (usable as LinearAllocator*)
+    PersistentArenaHeader* header; ///< Header at the start of the mapping
+    unsigned char* base;           ///< Start of the mapping
+    size_t mapping_size;           ///< Size of the mapping (header and data region)
+    intptr_t file;                 ///< File descriptor (file handle on Windows), -1 once closed
+    intptr_t mapping;              ///< File mapping handle on Windows, unused elsewhere
+    PersistentMode mode;           ///< How the file is mapped
+
+    /**
+     * @brief Bytes reserved for the header, keeping the data region page aligned
+     */
+    static constexpr size_t DATA_OFFSET = 4096;
+
+    /**
+     * @brief File layout version
+     */
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Root offset of an arena without a root object
+     */
+    static constexpr uint64_t NO_ROOT = UINT64_MAX;
+
+    /**
+     * @brief Create (or truncate) an arena file and map it for writing
+     *
+     * The file is sized to DATA_OFFSET + capacity up front; on file systems with
+     * sparse files only the pages that are written take disk space.
+     *
+     * @param path File to create
+     * @param capacity Size of the data region in bytes (rounded up to whole pages)
+     * @return std::expected<PersistentArena, PersistentArenaError> Mapped arena or error
+     */
+    static std::expected<PersistentArena, PersistentArenaError> create(const char* path, size_t capacity);
+
+    /**
+     * @brief Map an existing arena file
+     *
+     * ReadWrite resumes allocation after the data written so far. ReadOnly maps the
+     * file without write access; the arena then has no room to allocate from.
+     *
+     * @param path File to open
+     * @param mode Mapping mode
+     * @return std::expected<PersistentArena, PersistentArenaError> Mapped arena or error
+     */
+    static std::expected<PersistentArena, PersistentArenaError> open(const char* path, PersistentMode mode);
+
+    /**
+     * @brief Record the arena's offsets in the header and flush the mapping to disk
+     *
+     * Returns once the data is durable. Not needed for other processes to see the
+     * data, which they do through the shared page cache right away.
+     *
+     * @return std::expected<void, PersistentArenaError> Success or error
+     */
+    std::expected<void, PersistentArenaError> sync();
+
+    /**
+     * @brief Record the offsets (when writable), unmap the file and close it
+     *
+     * Does not wait for the data to reach the disk; call sync() first for that.
+     */
+    void close();
+
+    /**
+     * @brief Construct an object in the arena
+     *
+     * @tparam T Object type (see is_persistable)
+     * @param args Constructor arguments
+     * @return std::expected<T*, AllocatorError> The object or error (OutOfMemory when read-only)
+     */
+    template <typename T, typename... Args>
+    std::expected<T*, AllocatorError> make(Args&&... args);
+
+    /**
+     * @brief Copy elements into a PersistentArray in the arena
+     *
+     * @tparam T Element type (see is_persistable)
+     * @param elements Elements to copy
+     * @return std::expected<PersistentArray<T>*, AllocatorError> The array or error
+     */
+    template <typename T>
+    std::expected<PersistentArray<T>*, AllocatorError> store_array(std::span<const T> elements);
+
+    /**
+     * @brief Copy the elements of a DynArray into a PersistentArray in the arena
+     *
+     * @param array Array to copy
+     * @return std::expected<PersistentArray<T>*, AllocatorError> The array or error
+     */
+    template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+    std::expected<PersistentArray<T>*, AllocatorError> store_array(const DynArray<T, Alloc, Growth, Align>& array);
+
+    /**
+     * @brief Record the object readers start from
+     *
+     * @param object Object in the data region, nullptr to clear the root
+     * @return std::expected<void, PersistentArenaError> Success or ReadOnly
+     */
+    std::expected<void, PersistentArenaError> set_root(const void* object);
+
+    /**
+     * @brief Get the object recorded with set_root
+     *
+     * @return T* The root object, nullptr if none was set
+     */
+    template <typename T>
+    T* root() const;
+
+    /**
+     * @brief Check if the arena was opened read-only
+     *
+     * @return true if read-only, false otherwise
+     */
+    bool is_read_only() const;
+};
+
+// Construct an object in the arena
+template <typename T, typename... Args>
+std::expected<T*, AllocatorError> PersistentArena::make(Args&&... args) {
+    static_assert(is_persistable_v<T>, "Only plain data and OffsetPtr links survive a reload, see is_persistable");
+    auto memory = arena.alloc_align_uninit(sizeof(T), alignof(T));
+    if (!memory) {
+        return std::unexpected(memory.error());
+    }
+    return ::new (memory.value()) T(std::forward<Args>(args)...);
+}
+
+// Copy a span into the arena
+template <typename T>
+std::expected<PersistentArray<T>*, AllocatorError> PersistentArena::store_array(std::span<const T> elements) {
+    static_assert(is_persistable_v<T>, "Only plain data and OffsetPtr links survive a reload, see is_persistable");
+    if (elements.size() > SIZE_MAX / sizeof(T)) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    auto storage = arena.alloc_align_uninit(sizeof(T) * elements.size(), alignof(T));
+    if (!storage) {
+        return std::unexpected(storage.error());
+    }
+    T* first = static_cast<T*>(storage.value());
+    std::uninitialized_copy(elements.begin(), elements.end(), first);
+
+    auto array = make<PersistentArray<T>>();
+    if (!array) {
+        return std::unexpected(array.error());
+    }
+    array.value()->data = first;
+    array.value()->size = elements.size();
+    return array;
+}
+
+// Copy a DynArray into the arena
+template <typename T, AllocatorHandle Alloc, GrowthPolicy Growth, AlignmentPolicy Align>
+std::expected<PersistentArray<T>*, AllocatorError> PersistentArena::store_array(
+    const DynArray<T, Alloc, Growth, Align>& array) {
+    return store_array(std::span<const T>(array.get_data(), array.get_size()));
+}
+
+// Get the root object
+template <typename T>
+T* PersistentArena::root() const {
+    static_assert(is_persistable_v<T>, "Only plain data and OffsetPtr links survive a reload, see is_persistable");
+    if (header == nullptr || header->root == NO_ROOT) {
+        return nullptr;
+    }
+    return reinterpret_cast<T*>(arena.buf + header->root);
+}
+
+} // namespace memory
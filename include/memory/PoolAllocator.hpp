@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Intrusive free list node stored inside every free chunk
+ */
+struct PoolFreeNode {
+    PoolFreeNode* next; ///< Next free chunk
+};
+
+/**
+ * @brief Fixed-size pool allocator implementation
+ *
+ * A pool allocator splits its backing buffer into equally sized, aligned chunks and
+ * keeps the free ones in an intrusive singly linked list. Chunks can be allocated and
+ * freed individually in any order.
+ *
+ * @note Allocation and deallocation are O(1). free_all is a single linear pass.
+ */
+struct PoolAllocator {
+    unsigned char* buf;       ///< Pointer to the first chunk (aligned start of the backing buffer)
+    size_t buf_len;           ///< Length of the chunked part of the buffer
+    size_t chunk_size;        ///< Size of each chunk (multiple of chunk_alignment)
+    size_t chunk_alignment;   ///< Alignment of each chunk
+    PoolFreeNode* head;       ///< Head of the free list
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default chunk alignment
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = LinearAllocator::DEFAULT_ALIGNMENT;
+
+    /**
+     * @brief Initialize a pool allocator over a provided backing buffer
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @param chunk_size Size of each chunk (rounded up to the alignment and to hold a free list node)
+     * @param chunk_alignment Alignment of each chunk (must be a power of two)
+     * @return std::expected<PoolAllocator, AllocatorError> Initialized PoolAllocator or error
+     */
+    static std::expected<PoolAllocator, AllocatorError> create(void* backing_buffer, size_t backing_buffer_length,
+                                                               size_t chunk_size,
+                                                               size_t chunk_alignment = DEFAULT_ALIGNMENT);
+
+    /**
+     * @brief Initialize a pool allocator over a region carved out of a linear allocator
+     *
+     * @param arena Arena to take the region from
+     * @param chunk_count Number of chunks in the pool
+     * @param chunk_size Size of each chunk (rounded up to the alignment and to hold a free list node)
+     * @param chunk_alignment Alignment of each chunk (must be a power of two)
+     * @return std::expected<PoolAllocator, AllocatorError> Initialized PoolAllocator or error
+     */
+    static std::expected<PoolAllocator, AllocatorError> create(LinearAllocator* arena, size_t chunk_count,
+                                                               size_t chunk_size,
+                                                               size_t chunk_alignment = DEFAULT_ALIGNMENT);
+
+    /**
+     * @brief Allocate one chunk
+     *
+     * @return std::expected<void*, AllocatorError> Pointer to the chunk or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc();
+
+    /**
+     * @brief Allocate one chunk without zeroing it
+     *
+     * @return std::expected<void*, AllocatorError> Pointer to the chunk or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit();
+
+    /**
+     * @brief Allocate a chunk for a request of the given size and alignment
+     *
+     * @param size Size in bytes to allocate (must not exceed chunk_size)
+     * @param align Alignment of the allocation (must not exceed chunk_alignment)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate a chunk for a request of the given size and alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate (must not exceed chunk_size)
+     * @param align Alignment of the allocation (must not exceed chunk_alignment)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Resize an allocation within its chunk
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must not exceed chunk_alignment)
+     * @return std::expected<void*, AllocatorError> old_memory, or a fresh chunk if old_memory was null
+     *
+     * @note Chunks never move; growing beyond chunk_size fails with OutOfMemory.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Try to resize an allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if new_size still fits in the chunk, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Return a chunk to the pool
+     *
+     * @param ptr Pointer to a chunk previously allocated by this pool
+     * @return std::expected<void, AllocatorError> Success or error code
+     *
+     * @note Returns NullPointer for nullptr and OutOfBounds for pointers that are not
+     *       the start of one of this pool's chunks.
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Return every chunk to the pool by rebuilding the free list
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use counts whole chunks; padding_bytes is what requests left unused
+     * of their chunk.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the number of chunks in the pool
+     *
+     * @return Total chunk count
+     */
+    size_t chunk_count() const;
+};
+
+} // namespace memory
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+#include "memory/VirtualArena.hpp"
+
+namespace memory {
+
+/**
+ * @brief Number of scratch arenas every thread gets, see get_scratch
+ *
+ * Two are enough for the usual pattern: a function allocates its result in the
+ * arena it was handed and its temporaries in the scratch arena that is not that one.
+ */
+inline constexpr size_t SCRATCH_ARENA_COUNT = 2;
+
+/**
+ * @brief Address space reserved for each scratch arena
+ *
+ * Only reserved; pages are committed as the arena is used and stay committed for
+ * the lifetime of the thread, so steady-state scratch use never enters the kernel.
+ */
+inline constexpr size_t SCRATCH_ARENA_RESERVE_SIZE = static_cast<size_t>(1) << 30;
+
+/**
+ * @brief RAII temporary memory scope
+ *
+ * A TempArenaMemory that ends itself when it goes out of scope, so early returns and
+ * exceptions cannot leak arena space. Scopes over the same arena must be destroyed
+ * in reverse order of creation, which block scoping gives for free.
+ *
+ * Also usable as an allocator (DynArray<T, ScopedArena*>, ArenaAllocator, ...):
+ * everything is bump-allocated from the arena and rolled back with the scope.
+ */
+struct ScopedArena {
+    TempArenaMemory scope; ///< Saved position of the arena
+    bool active;           ///< Whether the scope still has to be ended
+
+    /**
+     * @brief Begin a scope on a linear allocator
+     *
+     * @param a Arena to take the scope from
+     */
+    explicit ScopedArena(LinearAllocator* a);
+
+    /**
+     * @brief Begin a scope on a chained arena
+     *
+     * @param a Chained arena to take the scope from
+     */
+    explicit ScopedArena(VirtualArena* a);
+
+    /**
+     * @brief Move constructor, the source no longer ends the scope
+     *
+     * @param other Scope to move from
+     */
+    ScopedArena(ScopedArena&& other) noexcept;
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+    ScopedArena& operator=(ScopedArena&&) = delete;
+
+    /**
+     * @brief End the scope unless it was ended already
+     */
+    ~ScopedArena();
+
+    /**
+     * @brief Allocate memory with alignment inside this scope
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it inside this scope
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment inside this scope
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Resize an allocation made inside this scope
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note Grows in place when old_memory is the most recent allocation
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an allocation made inside this scope without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Try to resize an allocation made inside this scope without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free an allocation (a no-op, memory comes back when the scope ends)
+     *
+     * @param ptr Pointer to the allocation
+     * @return std::expected<void, AllocatorError> Always success
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief End the scope early, rolling the arena back
+     *
+     * Does nothing if the scope was ended already.
+     */
+    void end();
+
+    /**
+     * @brief Get the arena the scope bump-allocates from
+     *
+     * Pass this down as the arena of a callee, and as a conflict to get_scratch in
+     * functions that both read from it and need scratch memory.
+     *
+     * @return LinearAllocator* The arena (the current block's allocator for chained arenas)
+     */
+    LinearAllocator* arena() const;
+};
+
+namespace detail {
+
+/**
+ * @brief Identity of a conflict passed to get_scratch
+ *
+ * @param conflict Any allocator pointer
+ * @return Address to compare the scratch arenas against
+ */
+inline const void* scratch_conflict(const void* conflict) {
+    return conflict;
+}
+
+/**
+ * @brief Identity of a scope passed to get_scratch as a conflict
+ *
+ * @param conflict Scope whose arena must not be used
+ * @return Address of the scope's arena
+ */
+inline const void* scratch_conflict(const ScopedArena* conflict) {
+    return conflict != nullptr ? conflict->arena() : nullptr;
+}
+
+/**
+ * @brief Begin a scope on the first scratch arena of this thread not in conflicts
+ *
+ * @param conflicts Arenas that must not be used
+ * @param conflict_count Number of entries in conflicts
+ * @return std::expected<ScopedArena, AllocatorError> Scope or error
+ */
+std::expected<ScopedArena, AllocatorError> get_scratch(const void* const* conflicts, size_t conflict_count);
+
+} // namespace detail
+
+/**
+ * @brief Get a scope on one of this thread's scratch arenas
+ *
+ * Each thread has SCRATCH_ARENA_COUNT scratch arenas over lazily committed address
+ * space, created on first use and released when the thread exits. Pass the arenas
+ * the caller is still reading from (plain allocator pointers or ScopedArenas) as
+ * conflicts, so the scratch memory cannot clobber them:
+ *
+ * @code
+ * Result build(LinearAllocator* out) {
+ *     auto scratch = get_scratch(out).value(); // never the arena behind out
+ *     ...                                      // temporaries in scratch, result in out
+ * }                                            // scratch rolls back here
+ * @endcode
+ *
+ * @param conflicts Arenas that must not be used
+ * @return std::expected<ScopedArena, AllocatorError> Scope, or OutOfMemory if the
+ *         address space cannot be reserved or every scratch arena conflicts
+ */
+template <typename... Conflicts>
+std::expected<ScopedArena, AllocatorError> get_scratch(const Conflicts*... conflicts) {
+    const void* list[] = {detail::scratch_conflict(conflicts)..., nullptr};
+    return detail::get_scratch(list, sizeof...(Conflicts));
+}
+
+} // namespace memory
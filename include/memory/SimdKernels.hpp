@@ -0,0 +1,339 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// GCC and Clang build the vector kernels; other compilers only get the scalar loops
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MEMORY_SIMD_X86 1
+#elif defined(__GNUC__) && (defined(__ARM_NEON) || defined(__aarch64__))
+#define MEMORY_SIMD_NEON 1
+#endif
+
+namespace memory::simd {
+
+/**
+ * @brief Instruction set the bulk kernels run with
+ *
+ * Ordered from weakest to strongest within an architecture. SSE42 stands for the
+ * x86-64 baseline plus SSE4.1/4.2, which add the 32-bit min/max and the 64-bit
+ * compares the kernels need; AVX512 needs the F, BW, DQ and VL subsets.
+ */
+enum class SimdLevel : uint8_t {
+    Scalar, ///< Plain loops, whatever the compiler makes of them
+    SSE42,  ///< 128-bit x86 vectors
+    AVX2,   ///< 256-bit x86 vectors
+    AVX512, ///< 512-bit x86 vectors
+    NEON    ///< 128-bit ARM vectors
+};
+
+/**
+ * @brief Element types with vector kernels
+ *
+ * Other arithmetic types are accepted by every kernel and handled with scalar loops.
+ */
+template <typename T>
+concept SimdElement = std::same_as<T, int32_t> || std::same_as<T, uint32_t> ||
+                      std::same_as<T, int64_t> || std::same_as<T, uint64_t> ||
+                      std::same_as<T, float> || std::same_as<T, double>;
+
+/**
+ * @brief Element types the kernels accept
+ */
+template <typename T>
+concept Arithmetic = std::is_arithmetic_v<T> && !std::same_as<T, bool>;
+
+/**
+ * @brief Result type of sum()
+ *
+ * Integers are summed in 64 bits (wrapping on overflow), floating point values in
+ * their own type.
+ */
+template <typename T>
+using sum_t = std::conditional_t<std::is_floating_point_v<T>, T,
+                                 std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+
+/**
+ * @brief Instruction set the CPU supports best
+ *
+ * @return SimdLevel Detected level (Scalar on compilers without vector kernels)
+ */
+SimdLevel detect_level();
+
+/**
+ * @brief Instruction set the kernels currently dispatch to
+ *
+ * @return SimdLevel detect_level() unless set_level() changed it
+ */
+SimdLevel active_level();
+
+/**
+ * @brief Make the kernels dispatch to another instruction set
+ *
+ * Meant for benchmarks and for comparing results across levels. Applies to every
+ * thread.
+ *
+ * @param level Level to use
+ * @return true if the CPU supports level, false if the active level is unchanged
+ */
+bool set_level(SimdLevel level);
+
+/**
+ * @brief Check if the CPU can run the kernels at a level
+ *
+ * @param level Level to check
+ * @return true if supported, false otherwise
+ */
+bool is_supported(SimdLevel level);
+
+/**
+ * @brief Get the name of a level
+ *
+ * @param level Level to name
+ * @return const char* "scalar", "sse4.2", "avx2", "avx512" or "neon"
+ */
+const char* level_name(SimdLevel level);
+
+namespace detail {
+
+// Dispatching entry points, instantiated for every SimdElement in SimdKernels.cpp
+template <SimdElement T> void fill(T* data, size_t count, T value);
+template <SimdElement T> size_t find(const T* data, size_t count, T value);
+template <SimdElement T> size_t count(const T* data, size_t count, T value);
+template <SimdElement T> T min(const T* data, size_t count);
+template <SimdElement T> T max(const T* data, size_t count);
+template <SimdElement T> sum_t<T> sum(const T* data, size_t count);
+
+#if defined(MEMORY_SIMD_X86) || defined(MEMORY_SIMD_NEON)
+/**
+ * @brief Replace the elements with f(element) one vector width at a time
+ *
+ * With a single pointer there is nothing to alias, so the fixed-size inner loop
+ * becomes straight vector code (even at -O2) instead of hiding behind an overlap
+ * check that in-place calls would always fail.
+ *
+ * @tparam LANES Elements per block, two vector registers
+ */
+template <size_t LANES, typename T, typename F>
+[[gnu::always_inline]] inline void transform_blocks_in_place(T* data, size_t count, F& f) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (size_t j = 0; j < LANES; ++j) {
+            data[i + j] = f(data[i + j]);
+        }
+    }
+    for (; i < count; ++i) {
+        data[i] = f(data[i]);
+    }
+}
+
+/**
+ * @brief Store f(in[i]) into out[i] one vector width at a time, for ranges that do not overlap
+ *
+ * @tparam LANES Elements per block, two vector registers
+ */
+template <size_t LANES, typename T, typename F>
+[[gnu::always_inline]] inline void transform_blocks_apart(const T* __restrict in, T* __restrict out, size_t count,
+                                                          F& f) {
+    size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        for (size_t j = 0; j < LANES; ++j) {
+            out[i + j] = f(in[i + j]);
+        }
+    }
+    for (; i < count; ++i) {
+        out[i] = f(in[i]);
+    }
+}
+
+/**
+ * @brief Apply f to the elements, inlined into the target-specific callers below
+ *
+ * f is compiled for the caller's instruction set.
+ *
+ * @tparam LANES Elements per block
+ */
+template <size_t LANES, typename T, typename F>
+[[gnu::always_inline]] inline void transform_blocks(const T* in, T* out, size_t count, F& f) {
+    if (in == out) {
+        transform_blocks_in_place<LANES>(out, count, f);
+    } else {
+        transform_blocks_apart<LANES>(in, out, count, f);
+    }
+}
+#endif
+
+#if defined(MEMORY_SIMD_X86)
+template <typename T, typename F>
+[[gnu::target("sse4.2")]] void transform_sse42(const T* in, T* out, size_t count, F& f) {
+    transform_blocks<32 / sizeof(T)>(in, out, count, f);
+}
+
+template <typename T, typename F>
+[[gnu::target("avx2")]] void transform_avx2(const T* in, T* out, size_t count, F& f) {
+    transform_blocks<64 / sizeof(T)>(in, out, count, f);
+}
+
+template <typename T, typename F>
+[[gnu::target("avx512f,avx512bw,avx512dq,avx512vl")]]
+void transform_avx512(const T* in, T* out, size_t count, F& f) {
+    transform_blocks<128 / sizeof(T)>(in, out, count, f);
+}
+#endif
+
+} // namespace detail
+
+/**
+ * @brief Set every element to value
+ *
+ * @param data Elements to overwrite
+ * @param value Value to store
+ */
+template <Arithmetic T>
+void fill(std::span<T> data, std::type_identity_t<T> value) {
+    if constexpr (SimdElement<T>) {
+        detail::fill(data.data(), data.size(), value);
+    } else {
+        std::fill(data.begin(), data.end(), value);
+    }
+}
+
+/**
+ * @brief Find the first element equal to value
+ *
+ * @param data Elements to search
+ * @param value Value to look for
+ * @return size_t Index of the first match, data.size() if there is none
+ */
+template <Arithmetic T>
+size_t find(std::span<const T> data, std::type_identity_t<T> value) {
+    if constexpr (SimdElement<T>) {
+        return detail::find(data.data(), data.size(), value);
+    } else {
+        return static_cast<size_t>(std::find(data.begin(), data.end(), value) - data.begin());
+    }
+}
+
+/**
+ * @brief Check if any element equals value
+ *
+ * @param data Elements to search
+ * @param value Value to look for
+ * @return true if found, false otherwise
+ */
+template <Arithmetic T>
+bool contains(std::span<const T> data, std::type_identity_t<T> value) {
+    return simd::find(data, value) != data.size();
+}
+
+/**
+ * @brief Count the elements equal to value
+ *
+ * @param data Elements to search
+ * @param value Value to count
+ * @return size_t Number of matches
+ */
+template <Arithmetic T>
+size_t count(std::span<const T> data, std::type_identity_t<T> value) {
+    if constexpr (SimdElement<T>) {
+        return detail::count(data.data(), data.size(), value);
+    } else {
+        return static_cast<size_t>(std::count(data.begin(), data.end(), value));
+    }
+}
+
+/**
+ * @brief Get the smallest element
+ *
+ * @param data Elements to scan, must not be empty
+ * @return T Smallest element (unspecified if data contains a NaN)
+ */
+template <Arithmetic T>
+T min(std::span<const T> data) {
+    assert(!data.empty() && "simd::min of an empty range");
+    if constexpr (SimdElement<T>) {
+        return detail::min(data.data(), data.size());
+    } else {
+        return *std::min_element(data.begin(), data.end());
+    }
+}
+
+/**
+ * @brief Get the largest element
+ *
+ * @param data Elements to scan, must not be empty
+ * @return T Largest element (unspecified if data contains a NaN)
+ */
+template <Arithmetic T>
+T max(std::span<const T> data) {
+    assert(!data.empty() && "simd::max of an empty range");
+    if constexpr (SimdElement<T>) {
+        return detail::max(data.data(), data.size());
+    } else {
+        return *std::max_element(data.begin(), data.end());
+    }
+}
+
+/**
+ * @brief Add up the elements
+ *
+ * Floating point values are summed in several vector lanes, so the result may
+ * differ from a left-to-right loop in the last bits (it is usually closer to the
+ * exact sum).
+ *
+ * @param data Elements to add
+ * @return sum_t<T> Sum, 0 for an empty range
+ */
+template <Arithmetic T>
+sum_t<T> sum(std::span<const T> data) {
+    if constexpr (SimdElement<T>) {
+        return detail::sum(data.data(), data.size());
+    } else {
+        sum_t<T> total = 0;
+        for (T value : data) {
+            total += value;
+        }
+        return total;
+    }
+}
+
+/**
+ * @brief Store f(in[i]) into out[i] for every element
+ *
+ * f is compiled for the active instruction set, so plain arithmetic in it becomes
+ * vector code. in and out may be the same range (in-place transform) but must not
+ * overlap otherwise.
+ *
+ * @param in Elements to read
+ * @param out Destination, at least in.size() elements
+ * @param f Callable taking and returning T
+ */
+template <Arithmetic T, typename F>
+    requires std::is_invocable_r_v<T, F&, T>
+void transform(std::span<const T> in, std::span<T> out, F f) {
+    assert(out.size() >= in.size() && "simd::transform destination too small");
+#if defined(MEMORY_SIMD_X86)
+    switch (active_level()) {
+    case SimdLevel::AVX512:
+        return detail::transform_avx512(in.data(), out.data(), in.size(), f);
+    case SimdLevel::AVX2:
+        return detail::transform_avx2(in.data(), out.data(), in.size(), f);
+    case SimdLevel::SSE42:
+        return detail::transform_sse42(in.data(), out.data(), in.size(), f);
+    default:
+        break;
+    }
+#elif defined(MEMORY_SIMD_NEON)
+    if (active_level() == SimdLevel::NEON) {
+        return detail::transform_blocks<32 / sizeof(T)>(in.data(), out.data(), in.size(), f);
+    }
+#endif
+    std::transform(in.begin(), in.end(), out.begin(), f);
+}
+
+} // namespace memory::simd
@@ -0,0 +1,511 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <expected>
+#include <memory>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+#include <functional> // For std::reference_wrapper
+#include <type_traits>
+#include <cstring>
+#include <ranges>
+
+#include "memory/Allocator.hpp"
+#include "memory/GrowthPolicy.hpp"
+#include "memory/DynArray.hpp"
+#include "memory/HeapAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Dynamic array with inline storage for the first N elements
+ *
+ * Same interface as DynArray, but the first N elements live inside the object
+ * itself. Arrays that never grow past N never touch the allocator; beyond N the
+ * elements spill to a block from the allocator, and shrink_to_fit brings them back
+ * inline once they fit again.
+ *
+ * @tparam T The type of elements stored in the array
+ * @tparam N Number of elements stored inline (must be at least 1)
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle)
+ * @tparam Growth Growth policy deciding the capacity on reallocation (see GrowthPolicy)
+ *
+ * @note Moving an inline array moves its elements one by one, so moves are O(N)
+ *       rather than a pointer swap.
+ */
+template <typename T, size_t N, AllocatorHandle Alloc = HeapAllocator, GrowthPolicy Growth = GeometricGrowth<>>
+struct SmallDynArray {
+    static_assert(N > 0, "SmallDynArray needs room for at least one inline element");
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "SmallDynArray frees a spilled block after moving to a bigger one, out of LIFO order");
+
+    // Data members first (following data-oriented approach)
+    T*              data;        ///< Pointer to the array data (inline_storage while inline)
+    size_t          size;        ///< Current number of elements
+    size_t          capacity;    ///< Current capacity of the array (N while inline)
+    [[no_unique_address]] Alloc allocator; ///< Allocator (or pointer to it) spilled data comes from
+    [[no_unique_address]] StatsRecorder recorder; ///< Growth statistics (empty unless MEMORY_ENABLE_STATS)
+    alignas(T) unsigned char inline_storage[sizeof(T) * N]; ///< Storage for the first N elements
+
+    /**
+     * @brief Number of elements stored inline
+     */
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    /**
+     * @brief Default constructor
+     *
+     * Creates an empty array using the inline storage; nothing is allocated.
+     */
+    SmallDynArray();
+
+    /**
+     * @brief Constructor with initial capacity
+     *
+     * @param initial_capacity Initial capacity (allocates only if larger than N)
+     */
+    explicit SmallDynArray(size_t initial_capacity);
+
+    /**
+     * @brief Constructor with initial elements
+     *
+     * @param elements Initializer list of elements
+     */
+    SmallDynArray(std::initializer_list<T> elements);
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Allocator to use once the array spills (or pointer to it)
+     */
+    explicit SmallDynArray(Alloc alloc);
+
+    /**
+     * @brief Constructor with initial capacity and custom allocator
+     *
+     * @param initial_capacity Initial capacity (allocates only if larger than N)
+     * @param alloc Allocator to use once the array spills (or pointer to it)
+     */
+    SmallDynArray(size_t initial_capacity, Alloc alloc);
+
+    /**
+     * @brief Destructor
+     *
+     * Destroys all elements and frees the spilled block, if any.
+     */
+    ~SmallDynArray();
+
+    /**
+     * @brief Copy constructor
+     *
+     * The copy uses the same allocator as other.
+     *
+     * @param other SmallDynArray to copy from
+     */
+    SmallDynArray(const SmallDynArray& other);
+
+    /**
+     * @brief Move constructor
+     *
+     * Steals a spilled block; inline elements are moved one by one.
+     *
+     * @param other SmallDynArray to move from
+     */
+    SmallDynArray(SmallDynArray&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator
+     *
+     * Elements are copied into this array's own storage.
+     *
+     * @param other SmallDynArray to copy from
+     * @return Reference to this SmallDynArray
+     */
+    SmallDynArray& operator=(const SmallDynArray& other);
+
+    /**
+     * @brief Move assignment operator
+     *
+     * Takes over other's spilled block together with its allocator; inline
+     * elements are moved one by one.
+     *
+     * @param other SmallDynArray to move from
+     * @return Reference to this SmallDynArray
+     */
+    SmallDynArray& operator=(SmallDynArray&& other) noexcept;
+
+    /**
+     * @brief Subscript operator for element access
+     *
+     * @param index Index of element to access
+     * @return Reference to the element
+     * @throws std::out_of_range if index is out of bounds
+     */
+    T& operator[](size_t index);
+
+    /**
+     * @brief Const subscript operator for element access
+     *
+     * @param index Index of element to access
+     * @return Const reference to the element
+     * @throws std::out_of_range if index is out of bounds
+     */
+    const T& operator[](size_t index) const;
+
+    /**
+     * @brief Safe element access with error handling
+     *
+     * @param index Index of element to access
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> at(size_t index);
+
+    /**
+     * @brief Safe const element access with error handling
+     *
+     * @param index Index of element to access
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> at(size_t index) const;
+
+    /**
+     * @brief Get the first element in the array
+     *
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to first element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> front();
+
+    /**
+     * @brief Get the const first element in the array
+     *
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to first element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> front() const;
+
+    /**
+     * @brief Get the last element in the array
+     *
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to last element or error
+     */
+    std::expected<std::reference_wrapper<T>, DynArrayError> back();
+
+    /**
+     * @brief Get the const last element in the array
+     *
+     * @return std::expected<std::reference_wrapper<const T>, DynArrayError> Const reference to last element or error
+     */
+    std::expected<std::reference_wrapper<const T>, DynArrayError> back() const;
+
+    /**
+     * @brief Get direct pointer to the array data
+     *
+     * @return Pointer to the first element
+     */
+    T* get_data();
+
+    /**
+     * @brief Get const direct pointer to the array data
+     *
+     * @return Const pointer to the first element
+     */
+    const T* get_data() const;
+
+    /**
+     * @brief Check if the array is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get the current size of the array
+     *
+     * @return Current number of elements
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the current capacity of the array
+     *
+     * @return Current capacity
+     */
+    size_t get_capacity() const;
+
+    /**
+     * @brief Get a snapshot of the growth statistics
+     *
+     * allocations counts the first block, resizes_in_place and resizes_moved the
+     * growths after it, and bytes_in_use the capacity in bytes.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the allocator the array spills to
+     *
+     * @return Reference to the allocator (the pointee if Alloc is a pointer)
+     */
+    std::remove_pointer_t<Alloc>& get_allocator();
+
+    /**
+     * @brief Check whether the elements are stored inline
+     *
+     * @return true if no block has been taken from the allocator
+     */
+    bool is_inline() const;
+
+    /**
+     * @brief Reserve memory for at least the specified number of elements
+     *
+     * @param new_capacity New capacity to reserve
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> reserve(size_t new_capacity);
+
+    /**
+     * @brief Resize the array to contain count elements
+     *
+     * @param count New size of the array
+     * @param value Value to initialize new elements with
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> resize(size_t count, const T& value = T());
+
+    /**
+     * @brief Resize the array to contain count elements without initializing new ones
+     *
+     * For filling the array directly from read(), decoders and the like. Growth is
+     * amortized like push_back, so repeated calls stay linear overall.
+     *
+     * @param count New size of the array
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note Only available for trivially copyable types; new elements hold
+     *       indeterminate values until written.
+     */
+    std::expected<void, DynArrayError> resize_uninitialized(size_t count);
+
+    /**
+     * @brief Shrink capacity to fit the current size
+     *
+     * Moves the elements back inline if they fit.
+     *
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> shrink_to_fit();
+
+    /**
+     * @brief Clear all elements from the array
+     *
+     * Reduces size to 0 but keeps capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Add an element to the end of the array
+     *
+     * @param value Element to add
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> push_back(const T& value);
+
+    /**
+     * @brief Add an element to the end of the array (move version)
+     *
+     * @param value Element to add
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> push_back(T&& value);
+
+    /**
+     * @brief Construct an element in place at the end of the array
+     *
+     * @tparam Args Types of the constructor arguments
+     * @param args Arguments forwarded to the constructor of T
+     * @return std::expected<std::reference_wrapper<T>, DynArrayError> Reference to the new element or error
+     */
+    template <typename... Args>
+    std::expected<std::reference_wrapper<T>, DynArrayError> emplace_back(Args&&... args);
+
+    /**
+     * @brief Append the elements [first, last) to the end of the array
+     *
+     * Capacity is reserved once for forward iterators; trivially copyable elements
+     * from contiguous iterators are copied with a single memcpy.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param first Iterator to the first element to append
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> append_range(It first, Sent last);
+
+    /**
+     * @brief Append the elements of a range to the end of the array
+     *
+     * @tparam R Input range type
+     * @param range Range of elements to append (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> append_range(R&& range);
+
+    /**
+     * @brief Remove the last element from the array
+     *
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> pop_back();
+
+    /**
+     * @brief Insert an element at the specified position
+     *
+     * @param position Position to insert at (as index)
+     * @param value Element to insert
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> insert(size_t position, const T& value);
+
+    /**
+     * @brief Insert the elements [first, last) at the specified position
+     *
+     * For forward iterators, capacity is reserved once and the tail is shifted once;
+     * trivially copyable elements from contiguous iterators are copied with a single
+     * memcpy. Input iterators are appended and then rotated into place.
+     *
+     * @tparam It Input iterator type
+     * @tparam Sent Sentinel type
+     * @param position Position to insert at (as index)
+     * @param first Iterator to the first element to insert
+     * @param last Sentinel for the end of the elements
+     * @return std::expected<void, DynArrayError> Success or error
+     *
+     * @note The elements must not come from this array.
+     */
+    template <std::input_iterator It, std::sentinel_for<It> Sent>
+    std::expected<void, DynArrayError> insert_range(size_t position, It first, Sent last);
+
+    /**
+     * @brief Insert the elements of a range at the specified position
+     *
+     * @tparam R Input range type
+     * @param position Position to insert at (as index)
+     * @param range Range of elements to insert (must not be this array)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <std::ranges::input_range R>
+    std::expected<void, DynArrayError> insert_range(size_t position, R&& range);
+
+    /**
+     * @brief Erase an element at the specified position
+     *
+     * @param position Position to erase (as index)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> erase(size_t position);
+
+    /**
+     * @brief Erase a range of elements
+     *
+     * @param first First position to erase (inclusive)
+     * @param last Last position to erase (exclusive)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> erase_range(size_t first, size_t last);
+
+    // Iterator support
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    /**
+     * @brief Get iterator to the beginning
+     *
+     * @return Iterator to the first element
+     */
+    iterator begin();
+
+    /**
+     * @brief Get iterator to the end
+     *
+     * @return Iterator to the element following the last element
+     */
+    iterator end();
+
+    /**
+     * @brief Get const iterator to the beginning
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Get const iterator to the end
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Get const iterator to the beginning (explicit const version)
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator cbegin() const;
+
+    /**
+     * @brief Get const iterator to the end (explicit const version)
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator cend() const;
+
+private:
+    /**
+     * @brief Get the inline storage as an element pointer
+     *
+     * @return Pointer to the first inline slot
+     */
+    T* inline_data();
+
+    /**
+     * @brief Internal function to grow the array capacity
+     *
+     * @param min_capacity Minimum capacity needed
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> grow(size_t min_capacity);
+
+    /**
+     * @brief Move the elements to an allocator block of new_capacity elements
+     *
+     * @param new_capacity Capacity of the new block (larger than N, at least size)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> reallocate(size_t new_capacity);
+
+    /**
+     * @brief Take over the elements of other, leaving it empty and inline
+     *
+     * @param other Array to move from (this array must be empty and inline)
+     */
+    void steal(SmallDynArray& other);
+
+    /**
+     * @brief Hand a spilled block back to the allocator
+     */
+    void release();
+};
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/SmallDynArray.tpp"
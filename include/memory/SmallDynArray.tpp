@@ -0,0 +1,650 @@
+#pragma once
+
+#include "memory/SmallDynArray.hpp"
+
+namespace memory {
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray()
+    : data(inline_data()), size(0), capacity(N), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Default constructor, starts out inline
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(size_t initial_capacity)
+    : data(inline_data()), size(0), capacity(N), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Constructor with initial capacity
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity");
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(std::initializer_list<T> elements)
+    : data(inline_data()), size(0), capacity(N), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Constructor with initializer list
+    auto result = reserve(elements.size());
+    if (result.has_value()) {
+        for (const auto& element : elements) {
+            // We already reserved space, so this won't fail unless something catastrophic happens
+            push_back(element);
+        }
+    } else {
+        assert(false && "Failed to allocate capacity for initializer list");
+    }
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(Alloc alloc)
+    : data(inline_data()), size(0), capacity(N), allocator(alloc) {
+    // Constructor with custom allocator, starts out inline
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(size_t initial_capacity, Alloc alloc)
+    : data(inline_data()), size(0), capacity(N), allocator(alloc) {
+    // Constructor with initial capacity and custom allocator
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity with custom allocator");
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::~SmallDynArray() {
+    // Destructor - Rule of 5 #1
+    clear();
+    release();
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(const SmallDynArray& other)
+    : data(inline_data()), size(0), capacity(N), allocator(other.allocator) {
+    // Copy constructor - Rule of 5 #2
+    auto result = reserve(other.size);
+    if (result.has_value()) {
+        // Copy elements
+        std::uninitialized_copy(other.data, other.data + other.size, data);
+        size = other.size;
+    } else {
+        assert(false && "Failed to allocate memory in copy constructor");
+    }
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>::SmallDynArray(SmallDynArray&& other) noexcept
+    : data(inline_data()), size(0), capacity(N), allocator(other.allocator) {
+    // Move constructor - Rule of 5 #3
+    steal(other);
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>& SmallDynArray<T, N, Alloc, Growth>::operator=(const SmallDynArray& other) {
+    // Copy assignment operator - Rule of 5 #4
+    if (this != &other) {
+        // Clear existing data
+        clear();
+
+        // Ensure we have enough capacity
+        auto result = reserve(other.size);
+        if (result.has_value()) {
+            // Copy elements
+            std::uninitialized_copy(other.data, other.data + other.size, data);
+            size = other.size;
+        } else {
+            assert(false && "Failed to allocate memory in copy assignment");
+        }
+    }
+    return *this;
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+SmallDynArray<T, N, Alloc, Growth>& SmallDynArray<T, N, Alloc, Growth>::operator=(SmallDynArray&& other) noexcept {
+    // Move assignment operator - Rule of 5 #5
+    if (this != &other) {
+        // Clean up existing resources and go back inline
+        clear();
+        release();
+        data = inline_data();
+        capacity = N;
+
+        allocator = other.allocator;
+        steal(other);
+    }
+    return *this;
+}
+
+
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+T& SmallDynArray<T, N, Alloc, Growth>::operator[](size_t index) {
+    // Subscript operator
+    if (index >= size) {
+        throw std::out_of_range("SmallDynArray index out of range");
+    }
+    return data[index];
+}
+
+// Const subscript operator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+const T& SmallDynArray<T, N, Alloc, Growth>::operator[](size_t index) const {
+    if (index >= size) {
+        throw std::out_of_range("SmallDynArray index out of range");
+    }
+    return data[index];
+}
+
+// Safe element access with error handling
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::at(size_t index) {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return std::ref(data[index]);
+}
+
+// Safe const element access with error handling
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<const T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::at(size_t index) const {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return std::cref(data[index]);
+}
+
+// Get the first element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::front() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::ref(data[0]);
+}
+
+// Get the const first element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<const T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::front() const {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::cref(data[0]);
+}
+
+// Get the last element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::back() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::ref(data[size - 1]);
+}
+
+// Get the const last element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<std::reference_wrapper<const T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::back() const {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+    return std::cref(data[size - 1]);
+}
+
+// Get direct pointer to data
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+T* SmallDynArray<T, N, Alloc, Growth>::get_data() {
+    return data;
+}
+
+// Get const direct pointer to data
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+const T* SmallDynArray<T, N, Alloc, Growth>::get_data() const {
+    return data;
+}
+
+// Check if array is empty
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+bool SmallDynArray<T, N, Alloc, Growth>::empty() const {
+    return size == 0;
+}
+
+// Get size
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+size_t SmallDynArray<T, N, Alloc, Growth>::get_size() const {
+    return size;
+}
+
+// Get capacity
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+size_t SmallDynArray<T, N, Alloc, Growth>::get_capacity() const {
+    return capacity;
+}
+
+// Get the allocator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::remove_pointer_t<Alloc>& SmallDynArray<T, N, Alloc, Growth>::get_allocator() {
+    return detail::allocator_of(allocator);
+}
+
+// Check whether the elements are inline
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+bool SmallDynArray<T, N, Alloc, Growth>::is_inline() const {
+    return data == reinterpret_cast<const T*>(inline_storage);
+}
+
+// Reserve memory
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::reserve(size_t new_capacity) {
+    if (new_capacity <= capacity) {
+        return {}; // Nothing to do, always true while new_capacity <= N
+    }
+
+    return reallocate(new_capacity);
+}
+
+// Resize array
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::resize(size_t count, const T& value) {
+    if (count > capacity) {
+        // Need to allocate more memory
+        auto result = reserve(count);
+        if (!result) {
+            return result;
+        }
+    }
+
+    if (count > size) {
+        // Initialize new elements
+        std::uninitialized_fill(data + size, data + count, value);
+    } else if (count < size) {
+        // Destroy excess elements
+        std::destroy(data + count, data + size);
+    }
+
+    size = count;
+    return {};
+}
+
+// Resize without initializing new elements
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::resize_uninitialized(size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "resize_uninitialized needs a trivially copyable type");
+
+    if (count > capacity) {
+        // Amortized growth, callers typically extend the array chunk by chunk
+        auto result = grow(count);
+        if (!result) {
+            return result;
+        }
+    }
+
+    size = count;
+    return {};
+}
+
+// Get growth statistics
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+AllocatorStats SmallDynArray<T, N, Alloc, Growth>::stats() const {
+    return recorder.snapshot();
+}
+
+// Shrink to fit
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::shrink_to_fit() {
+    if (is_inline() || size == capacity) {
+        return {}; // Inline storage can't shrink, or already fit
+    }
+
+    if (size <= N) {
+        // Move back into the inline storage and free the block
+        T* heap_data = data;
+        detail::relocate_elements(inline_data(), heap_data, size);
+        release();
+        data = inline_data();
+        capacity = N;
+        recorder.record_free();
+        recorder.record_in_use(0);
+        return {};
+    }
+
+    return reallocate(size);
+}
+
+// Clear array
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+void SmallDynArray<T, N, Alloc, Growth>::clear() {
+    // Destroy all elements
+    std::destroy(data, data + size);
+    size = 0;
+}
+
+// Push back (copy)
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::push_back(const T& value) {
+    if (size >= capacity) [[unlikely]] {
+        // Need to grow the array
+        auto result = grow(size + 1);
+        if (!result) {
+            return result;
+        }
+    }
+
+    // Construct new element at the end
+    new (data + size) T(value); // Placement new to copy construct
+    ++size;
+
+    return {};
+}
+
+// Push back (move)
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::push_back(T&& value) {
+    if (size >= capacity) [[unlikely]] {
+        // Need to grow the array
+        auto result = grow(size + 1);
+        if (!result) {
+            return result;
+        }
+    }
+
+    // Construct new element at the end
+    new (data + size) T(std::move(value)); // Placement new to move construct
+    ++size;
+
+    return {};
+}
+
+// Emplace back
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+template <typename... Args>
+std::expected<std::reference_wrapper<T>, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::emplace_back(Args&&... args) {
+    if (size >= capacity) [[unlikely]] {
+        // Need to grow the array
+        auto result = grow(size + 1);
+        if (!result) {
+            return std::unexpected(result.error());
+        }
+    }
+
+    // Construct the element directly in its slot, no temporary
+    T* slot = new (data + size) T(std::forward<Args>(args)...);
+    ++size;
+
+    return std::ref(*slot);
+}
+
+// Append a range of elements
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::append_range(It first, Sent last) {
+    return insert_range(size, std::move(first), std::move(last));
+}
+
+// Append the elements of a range
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::append_range(R&& range) {
+    return insert_range(size, std::ranges::begin(range), std::ranges::end(range));
+}
+
+// Pop back
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::pop_back() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+
+    // Destroy the last element
+    data[--size].~T();
+
+    return {};
+}
+
+// Insert element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::insert(size_t position, const T& value) {
+    if (position > size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if (size >= capacity) [[unlikely]] {
+        // Need to grow the array
+        auto result = grow(size + 1);
+        if (!result) {
+            return result;
+        }
+    }
+
+    if (position < size) {
+        // Shift elements to make room
+        detail::shift_elements_right(data, size, position, 1);
+    }
+
+    // Construct new element at position
+    new (data + position) T(value);
+    ++size;
+
+    return {};
+}
+
+// Insert a range of elements
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+template <std::input_iterator It, std::sentinel_for<It> Sent>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::insert_range(size_t position, It first, Sent last) {
+    if (position > size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if constexpr (std::forward_iterator<It>) {
+        size_t count = static_cast<size_t>(std::ranges::distance(first, last));
+        if (count == 0) {
+            return {};
+        }
+
+        // Reserve once for the whole range
+        if (size + count > capacity) {
+            auto result = grow(size + count);
+            if (!result) {
+                return result;
+            }
+        }
+
+        // Shift the tail once and copy the range into the gap
+        detail::insert_elements(data, size, position, std::move(first), count);
+        size += count;
+        return {};
+    } else {
+        // Single pass only: append at the end, then rotate the new elements into place
+        size_t old_size = size;
+        for (; first != last; ++first) {
+            auto result = emplace_back(*first);
+            if (!result) {
+                return std::unexpected(result.error());
+            }
+        }
+        std::rotate(data + position, data + old_size, data + size);
+        return {};
+    }
+}
+
+// Insert the elements of a range
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+template <std::ranges::input_range R>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::insert_range(size_t position, R&& range) {
+    return insert_range(position, std::ranges::begin(range), std::ranges::end(range));
+}
+
+// Erase element
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::erase(size_t position) {
+    return erase_range(position, position + 1);
+}
+
+// Erase range
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::erase_range(size_t first, size_t last) {
+    if (first >= size || last > size || first > last) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+
+    if (first == last) {
+        return {}; // Nothing to erase
+    }
+
+    // Destroy elements in the range, then close the gap
+    size_t count = last - first;
+    std::destroy(data + first, data + last);
+    detail::shift_elements_left(data, size, first, count);
+    size -= count;
+
+    return {};
+}
+
+// Begin iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::iterator SmallDynArray<T, N, Alloc, Growth>::begin() {
+    return data;
+}
+
+// End iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::iterator SmallDynArray<T, N, Alloc, Growth>::end() {
+    return data + size;
+}
+
+// Const begin iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::const_iterator SmallDynArray<T, N, Alloc, Growth>::begin() const {
+    return data;
+}
+
+// Const end iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::const_iterator SmallDynArray<T, N, Alloc, Growth>::end() const {
+    return data + size;
+}
+
+// Explicit const begin iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::const_iterator SmallDynArray<T, N, Alloc, Growth>::cbegin() const {
+    return data;
+}
+
+// Explicit const end iterator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+typename SmallDynArray<T, N, Alloc, Growth>::const_iterator SmallDynArray<T, N, Alloc, Growth>::cend() const {
+    return data + size;
+}
+
+// Inline storage as elements
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+T* SmallDynArray<T, N, Alloc, Growth>::inline_data() {
+    return reinterpret_cast<T*>(inline_storage);
+}
+
+// Internal function to grow the array capacity
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::grow(size_t min_capacity) {
+    // Let the growth policy pick the new capacity
+    auto result = reserve(Growth::next_capacity(capacity, min_capacity, sizeof(T)));
+    if (!result) {
+        return result;
+    }
+
+    if constexpr (uses_usable_size_v<Growth>) {
+        // Use the slack the allocator rounded the block up to (grown arrays are never inline)
+        size_t usable = detail::usable_size_in(detail::allocator_of(allocator), data,
+                                               sizeof(T) * capacity, alignof(T));
+        capacity = usable / sizeof(T);
+    }
+    return {};
+}
+
+// Move the elements into an allocator block of a new capacity
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+std::expected<void, DynArrayError> SmallDynArray<T, N, Alloc, Growth>::reallocate(size_t new_capacity) {
+    auto& backend = detail::allocator_of(allocator);
+
+    if (!is_inline()) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // The allocator may extend the block in place and otherwise moves the bytes itself
+            auto resize_result = detail::resize_in(backend, data, sizeof(T) * capacity,
+                                                   sizeof(T) * new_capacity, alignof(T));
+            if (!resize_result) {
+                recorder.record_failure();
+                return std::unexpected(DynArrayError::OutOfMemory);
+            }
+            recorder.record_resize(resize_result.value() == data);
+            data = static_cast<T*>(resize_result.value());
+            capacity = new_capacity;
+            recorder.record_in_use(sizeof(T) * capacity);
+            return {};
+        } else {
+            if (detail::try_resize_in_place_in(backend, data, sizeof(T) * capacity, sizeof(T) * new_capacity)) {
+                capacity = new_capacity;
+                recorder.record_resize(true);
+                recorder.record_in_use(sizeof(T) * capacity);
+                return {};
+            }
+        }
+    }
+
+    // Spill (or move on) to a fresh block, no zeroing since elements are constructed in place
+    auto alloc_result = detail::allocate_from(backend, sizeof(T) * new_capacity, alignof(T));
+    if (!alloc_result) {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+    T* new_data = static_cast<T*>(alloc_result.value());
+
+    // Spilling out of the inline storage counts as an allocation, moving on as a resize
+    if (is_inline()) {
+        recorder.record_alloc(sizeof(T) * new_capacity);
+    } else {
+        recorder.record_resize(false);
+    }
+
+    detail::relocate_elements(new_data, data, size);
+    release();
+
+    data = new_data;
+    capacity = new_capacity;
+    recorder.record_in_use(sizeof(T) * capacity);
+    return {};
+}
+
+// Take over the elements of another array
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+void SmallDynArray<T, N, Alloc, Growth>::steal(SmallDynArray& other) {
+    if (other.is_inline()) {
+        // Inline elements can't change hands, move them over one by one
+        detail::relocate_elements(data, other.data, other.size);
+        size = other.size;
+    } else {
+        data = other.data;
+        size = other.size;
+        capacity = other.capacity;
+    }
+
+    // Reset the source object; it keeps its allocator so it stays usable
+    other.data = other.inline_data();
+    other.size = 0;
+    other.capacity = N;
+}
+
+// Hand a spilled block back to the allocator
+template <typename T, size_t N, AllocatorHandle Alloc, GrowthPolicy Growth>
+void SmallDynArray<T, N, Alloc, Growth>::release() {
+    if (!is_inline()) {
+        detail::deallocate_to(detail::allocator_of(allocator), data, sizeof(T) * capacity, alignof(T));
+    }
+}
+
+} // namespace memory
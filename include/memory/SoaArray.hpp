@@ -0,0 +1,515 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cassert>
+#include <expected>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <limits>
+
+#include "memory/Allocator.hpp"
+#include "memory/AllocatorStats.hpp"
+#include "memory/DynArray.hpp"
+#include "memory/GrowthPolicy.hpp"
+#include "memory/HeapAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Minimum alignment of every SoaArray column
+ *
+ * A cache line, so each column starts on its own line and full-width SIMD loads
+ * over a column never straddle into its neighbour.
+ */
+inline constexpr size_t SOA_COLUMN_ALIGNMENT = 64;
+
+namespace detail {
+
+/**
+ * @brief Call f with std::integral_constant<size_t, I> for I = 0, ..., N - 1
+ *
+ * @param f Callable taking the index as a compile-time constant
+ */
+template <size_t N, typename F>
+constexpr void for_each_index(F&& f) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<size_t, I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+/**
+ * @brief Call f with std::integral_constant<size_t, I> for I = N - 1, ..., 0
+ *
+ * @param f Callable taking the index as a compile-time constant
+ */
+template <size_t N, typename F>
+constexpr void for_each_index_reverse(F&& f) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (f(std::integral_constant<size_t, N - 1 - I>{}), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+} // namespace detail
+
+/**
+ * @brief Structure-of-arrays container with custom allocator support
+ *
+ * Stores element i as one entry in each of sizeof...(Fields) columns instead of one
+ * struct, so a loop that touches a single field reads nothing but that field. All
+ * columns live in one block from the allocator, each aligned to at least
+ * SOA_COLUMN_ALIGNMENT, and they grow together:
+ *
+ * @code
+ * BasicSoaArray<LinearAllocator*, float, float, uint32_t> particles(&arena);
+ * particles.push_back({1.0f, 2.0f, 7u});
+ * for (float& x : particles.column<0>()) { x += 1.0f; }  // dense scan of one field
+ * for (auto [x, y, id] : particles) { ... }              // or walk whole elements
+ * @endcode
+ *
+ * Elements are accessed through a proxy reference, a std::tuple of references into
+ * the columns. Growth is geometric (GeometricGrowth<>) like DynArray; when all fields
+ * are trivially relocatable and the allocator can extend the block in place (the top
+ * of an arena), the columns are slid up within it instead of being copied out.
+ *
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle)
+ * @tparam Fields Types of the columns, one per member of the element
+ */
+template <AllocatorHandle Alloc, typename... Fields>
+struct BasicSoaArray {
+    static_assert(sizeof...(Fields) > 0, "SoaArray needs at least one column");
+    static_assert((std::is_object_v<Fields> && ...), "SoaArray columns have to be object types");
+    static_assert(!is_lifo_allocator_v<std::remove_pointer_t<Alloc>>,
+                  "SoaArray releases its old block only once the grown one exists, out of LIFO order");
+
+    // Data members first (following data-oriented approach)
+    unsigned char*          block;       ///< Start of the block holding every column
+    std::tuple<Fields*...>  columns;     ///< Start of each column inside block
+    size_t                  size;        ///< Current number of elements
+    size_t                  capacity;    ///< Current capacity of every column
+    [[no_unique_address]] Alloc allocator; ///< Allocator (or pointer to it) the block comes from
+    [[no_unique_address]] StatsRecorder recorder; ///< Growth statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Number of columns
+     */
+    static constexpr size_t COLUMN_COUNT = sizeof...(Fields);
+
+    /**
+     * @brief Capacity allocated by the first insert into an empty array
+     */
+    static constexpr size_t DEFAULT_CAPACITY = 8;
+
+    /**
+     * @brief Alignment of the block, the strictest column alignment
+     */
+    static constexpr size_t BLOCK_ALIGNMENT = std::max({alignof(Fields)..., SOA_COLUMN_ALIGNMENT});
+
+    /**
+     * @brief Type of column I
+     *
+     * @tparam I Index of the column
+     */
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    using value_type = std::tuple<Fields...>;              ///< Element by value
+    using reference = std::tuple<Fields&...>;              ///< Proxy reference into the columns
+    using const_reference = std::tuple<const Fields&...>;  ///< Read-only proxy reference
+
+    /**
+     * @brief Random access iterator yielding proxy references
+     *
+     * @tparam Const Whether the iterator gives read-only access
+     */
+    template <bool Const>
+    struct Iterator {
+        using Owner = std::conditional_t<Const, const BasicSoaArray, BasicSoaArray>;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = BasicSoaArray::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const_reference, BasicSoaArray::reference>;
+        using pointer = void;
+
+        Owner* array; ///< Array iterated over
+        size_t index; ///< Index of the element the iterator points at
+
+        Iterator() : array(nullptr), index(0) {}
+        Iterator(Owner* array, size_t index) : array(array), index(index) {}
+
+        /**
+         * @brief Read-only iterators can be made from mutable ones
+         */
+        template <bool OtherConst>
+            requires (Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) : array(other.array), index(other.index) {}
+
+        reference operator*() const { return array->element(index); }
+        reference operator[](difference_type n) const { return array->element(index + n); }
+
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++index; return old; }
+        Iterator& operator--() { --index; return *this; }
+        Iterator operator--(int) { Iterator old = *this; --index; return old; }
+        Iterator& operator+=(difference_type n) { index += n; return *this; }
+        Iterator& operator-=(difference_type n) { index -= n; return *this; }
+
+        friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+        friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+        friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const Iterator& a, const Iterator& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+        friend bool operator==(const Iterator& a, const Iterator& b) { return a.index == b.index; }
+        friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.index <=> b.index; }
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    /**
+     * @brief Default constructor
+     *
+     * Creates an empty array without allocating; the first insert allocates
+     * DEFAULT_CAPACITY elements.
+     */
+    BasicSoaArray();
+
+    /**
+     * @brief Constructor with initial capacity
+     *
+     * @param initial_capacity Initial capacity to allocate
+     */
+    explicit BasicSoaArray(size_t initial_capacity);
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Allocator to use, or pointer to it
+     */
+    explicit BasicSoaArray(Alloc alloc);
+
+    /**
+     * @brief Constructor with initial capacity and custom allocator
+     *
+     * @param initial_capacity Initial capacity to allocate
+     * @param alloc Allocator to use, or pointer to it
+     */
+    BasicSoaArray(size_t initial_capacity, Alloc alloc);
+
+    /**
+     * @brief Destructor, destroys the elements and hands the block back
+     */
+    ~BasicSoaArray();
+
+    /**
+     * @brief Copy constructor, allocates from the same allocator
+     *
+     * @param other Array to copy from
+     */
+    BasicSoaArray(const BasicSoaArray& other);
+
+    /**
+     * @brief Move constructor
+     *
+     * @param other Array to move from, left empty
+     */
+    BasicSoaArray(BasicSoaArray&& other) noexcept;
+
+    /**
+     * @brief Copy assignment operator
+     *
+     * @param other Array to copy from
+     * @return Reference to this array
+     */
+    BasicSoaArray& operator=(const BasicSoaArray& other);
+
+    /**
+     * @brief Move assignment operator
+     *
+     * @param other Array to move from, left empty
+     * @return Reference to this array
+     */
+    BasicSoaArray& operator=(BasicSoaArray&& other) noexcept;
+
+    /**
+     * @brief Access an element through a proxy reference
+     *
+     * @param index Index of the element
+     * @return reference Tuple of references to the element's fields
+     * @throws std::out_of_range if index is out of bounds
+     */
+    reference operator[](size_t index);
+
+    /**
+     * @brief Access an element through a read-only proxy reference
+     *
+     * @param index Index of the element
+     * @return const_reference Tuple of const references to the element's fields
+     * @throws std::out_of_range if index is out of bounds
+     */
+    const_reference operator[](size_t index) const;
+
+    /**
+     * @brief Safe element access with error handling
+     *
+     * @param index Index of the element
+     * @return std::expected<reference, DynArrayError> Proxy reference or OutOfRange
+     */
+    std::expected<reference, DynArrayError> at(size_t index);
+
+    /**
+     * @brief Safe read-only element access with error handling
+     *
+     * @param index Index of the element
+     * @return std::expected<const_reference, DynArrayError> Proxy reference or OutOfRange
+     */
+    std::expected<const_reference, DynArrayError> at(size_t index) const;
+
+    /**
+     * @brief Get one column as a span over the current elements
+     *
+     * @tparam I Index of the column
+     * @return std::span<field_type<I>> The column, aligned to at least SOA_COLUMN_ALIGNMENT
+     */
+    template <size_t I>
+    std::span<field_type<I>> column();
+
+    /**
+     * @brief Get one column as a read-only span over the current elements
+     *
+     * @tparam I Index of the column
+     * @return std::span<const field_type<I>> The column
+     */
+    template <size_t I>
+    std::span<const field_type<I>> column() const;
+
+    /**
+     * @brief Get the number of elements
+     *
+     * @return Current number of elements
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the number of elements every column has room for
+     *
+     * @return Current capacity
+     */
+    size_t get_capacity() const;
+
+    /**
+     * @brief Check if the array is empty
+     *
+     * @return true if empty, false otherwise
+     */
+    bool empty() const;
+
+    /**
+     * @brief Get a snapshot of the growth statistics
+     *
+     * allocations counts the first block, resizes_in_place and resizes_moved the
+     * growths after it, and bytes_in_use the size of the block.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Get the allocator the array allocates from
+     *
+     * @return Reference to the allocator (the pointee if Alloc is a pointer)
+     */
+    std::remove_pointer_t<Alloc>& get_allocator();
+
+    /**
+     * @brief Reserve room for at least new_capacity elements in every column
+     *
+     * @param new_capacity Minimum capacity
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> reserve(size_t new_capacity);
+
+    /**
+     * @brief Resize the array, value-initializing new elements
+     *
+     * @param count New number of elements
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> resize(size_t count);
+
+    /**
+     * @brief Destroy all elements, keeping the capacity
+     */
+    void clear();
+
+    /**
+     * @brief Append an element given as a tuple of its fields
+     *
+     * @param value Fields of the new element
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> push_back(const value_type& value);
+
+    /**
+     * @brief Append an element given as a tuple of its fields, moving them
+     *
+     * @param value Fields of the new element
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> push_back(value_type&& value);
+
+    /**
+     * @brief Append an element, constructing each field from one argument
+     *
+     * @param args One constructor argument per column
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    template <typename... Args>
+        requires (sizeof...(Args) == sizeof...(Fields))
+    std::expected<void, DynArrayError> emplace_back(Args&&... args);
+
+    /**
+     * @brief Remove the last element
+     *
+     * @return std::expected<void, DynArrayError> Success or EmptyArray
+     */
+    std::expected<void, DynArrayError> pop_back();
+
+    /**
+     * @brief Get iterator to the beginning
+     *
+     * @return Iterator to the first element
+     */
+    iterator begin();
+
+    /**
+     * @brief Get iterator to the end
+     *
+     * @return Iterator to the element following the last element
+     */
+    iterator end();
+
+    /**
+     * @brief Get const iterator to the beginning
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator begin() const;
+
+    /**
+     * @brief Get const iterator to the end
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator end() const;
+
+    /**
+     * @brief Get const iterator to the beginning (explicit const version)
+     *
+     * @return Const iterator to the first element
+     */
+    const_iterator cbegin() const;
+
+    /**
+     * @brief Get const iterator to the end (explicit const version)
+     *
+     * @return Const iterator to the element following the last element
+     */
+    const_iterator cend() const;
+
+    /**
+     * @brief Compute the size of a block holding every column for capacity elements
+     *
+     * @param capacity Number of elements per column
+     * @return Size in bytes, SIZE_MAX if it does not fit in size_t
+     */
+    static constexpr size_t block_size(size_t capacity);
+
+private:
+    /**
+     * @brief Access an element without bounds checking
+     *
+     * @param index Index of the element
+     * @return reference Tuple of references to the element's fields
+     */
+    reference element(size_t index);
+
+    /**
+     * @brief Access an element read-only without bounds checking
+     *
+     * @param index Index of the element
+     * @return const_reference Tuple of const references to the element's fields
+     */
+    const_reference element(size_t index) const;
+
+    /**
+     * @brief Compute where column index starts in a block of capacity elements
+     *
+     * @param capacity Number of elements per column
+     * @param index Index of the column (COLUMN_COUNT gives the end of the last column)
+     * @return Offset in bytes from the start of the block
+     */
+    static constexpr size_t column_offset(size_t capacity, size_t index);
+
+    /**
+     * @brief Point the columns into a block of capacity elements
+     *
+     * @param base Start of the block
+     * @param capacity Number of elements per column
+     * @return Start of each column
+     */
+    static std::tuple<Fields*...> layout(unsigned char* base, size_t capacity);
+
+    /**
+     * @brief Internal function to grow the array capacity
+     *
+     * @param min_capacity Minimum capacity needed
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> grow(size_t min_capacity);
+
+    /**
+     * @brief Move the elements to a block of new_capacity elements
+     *
+     * @param new_capacity Capacity of the new block (larger than capacity)
+     * @return std::expected<void, DynArrayError> Success or error
+     */
+    std::expected<void, DynArrayError> reallocate(size_t new_capacity);
+
+    /**
+     * @brief Destroy the elements [first, size) of every column
+     *
+     * @param first Index of the first element to destroy
+     */
+    void destroy_from(size_t first);
+
+    /**
+     * @brief Hand the current block back to the allocator
+     */
+    void release();
+
+    friend struct Iterator<false>;
+    friend struct Iterator<true>;
+};
+
+/**
+ * @brief Structure-of-arrays container on the default heap allocator
+ *
+ * @tparam Fields Types of the columns, one per member of the element
+ */
+template <typename... Fields>
+using SoaArray = BasicSoaArray<HeapAllocator, Fields...>;
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/SoaArray.tpp"
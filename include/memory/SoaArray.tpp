@@ -0,0 +1,471 @@
+#pragma once
+
+#include "memory/SoaArray.hpp"
+
+namespace memory {
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray()
+    : block(nullptr), columns(), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    // Default constructor, nothing is allocated until the first insert
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray(size_t initial_capacity)
+    : block(nullptr), columns(), size(0), capacity(0), allocator() {
+    static_assert(!std::is_pointer_v<Alloc>, "Pass the allocator when Alloc is a pointer");
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity");
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray(Alloc alloc)
+    : block(nullptr), columns(), size(0), capacity(0), allocator(alloc) {
+    // Constructor with custom allocator, nothing is allocated until the first insert
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray(size_t initial_capacity, Alloc alloc)
+    : block(nullptr), columns(), size(0), capacity(0), allocator(alloc) {
+    auto result = reserve(initial_capacity);
+    assert(result.has_value() && "Failed to allocate initial capacity with custom allocator");
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::~BasicSoaArray() {
+    destroy_from(0);
+    release();
+
+    // Reset all members for safety
+    block = nullptr;
+    size = 0;
+    capacity = 0;
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray(const BasicSoaArray& other)
+    : block(nullptr), columns(), size(0), capacity(0), allocator(other.allocator) {
+    auto result = reserve(other.size);
+    if (result.has_value()) {
+        // Copy column by column
+        detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+            std::uninitialized_copy_n(std::get<I>(other.columns), other.size, std::get<I>(columns));
+        });
+        size = other.size;
+    } else {
+        assert(false && "Failed to allocate memory in copy constructor");
+    }
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>::BasicSoaArray(BasicSoaArray&& other) noexcept
+    : block(other.block), columns(other.columns), size(other.size), capacity(other.capacity),
+      allocator(other.allocator) {
+    // Reset the source object; it keeps its allocator so it stays usable
+    other.block = nullptr;
+    other.columns = {};
+    other.size = 0;
+    other.capacity = 0;
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>& BasicSoaArray<Alloc, Fields...>::operator=(const BasicSoaArray& other) {
+    if (this != &other) {
+        clear();
+        auto result = reserve(other.size);
+        if (result.has_value()) {
+            detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+                std::uninitialized_copy_n(std::get<I>(other.columns), other.size, std::get<I>(columns));
+            });
+            size = other.size;
+        } else {
+            assert(false && "Failed to allocate memory in copy assignment");
+        }
+    }
+    return *this;
+}
+
+
+template <AllocatorHandle Alloc, typename... Fields>
+BasicSoaArray<Alloc, Fields...>& BasicSoaArray<Alloc, Fields...>::operator=(BasicSoaArray&& other) noexcept {
+    if (this != &other) {
+        // Clean up existing resources
+        clear();
+        release();
+
+        // Move resources from other
+        block = other.block;
+        columns = other.columns;
+        size = other.size;
+        capacity = other.capacity;
+        allocator = other.allocator;
+
+        // Reset the source object
+        other.block = nullptr;
+        other.columns = {};
+        other.size = 0;
+        other.capacity = 0;
+    }
+    return *this;
+}
+
+// Subscript operator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::reference BasicSoaArray<Alloc, Fields...>::operator[](size_t index) {
+    if (index >= size) {
+        throw std::out_of_range("SoaArray index out of range");
+    }
+    return element(index);
+}
+
+// Const subscript operator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_reference
+BasicSoaArray<Alloc, Fields...>::operator[](size_t index) const {
+    if (index >= size) {
+        throw std::out_of_range("SoaArray index out of range");
+    }
+    return element(index);
+}
+
+// Safe element access with error handling
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<typename BasicSoaArray<Alloc, Fields...>::reference, DynArrayError>
+BasicSoaArray<Alloc, Fields...>::at(size_t index) {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return element(index);
+}
+
+// Safe const element access with error handling
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<typename BasicSoaArray<Alloc, Fields...>::const_reference, DynArrayError>
+BasicSoaArray<Alloc, Fields...>::at(size_t index) const {
+    if (index >= size) {
+        return std::unexpected(DynArrayError::OutOfRange);
+    }
+    return element(index);
+}
+
+// Column access
+template <AllocatorHandle Alloc, typename... Fields>
+template <size_t I>
+std::span<typename BasicSoaArray<Alloc, Fields...>::template field_type<I>> BasicSoaArray<Alloc, Fields...>::column() {
+    static_assert(I < COLUMN_COUNT, "Column index out of range");
+    return {std::get<I>(columns), size};
+}
+
+// Const column access
+template <AllocatorHandle Alloc, typename... Fields>
+template <size_t I>
+std::span<const typename BasicSoaArray<Alloc, Fields...>::template field_type<I>>
+BasicSoaArray<Alloc, Fields...>::column() const {
+    static_assert(I < COLUMN_COUNT, "Column index out of range");
+    return {std::get<I>(columns), size};
+}
+
+// Get size
+template <AllocatorHandle Alloc, typename... Fields>
+size_t BasicSoaArray<Alloc, Fields...>::get_size() const {
+    return size;
+}
+
+// Get capacity
+template <AllocatorHandle Alloc, typename... Fields>
+size_t BasicSoaArray<Alloc, Fields...>::get_capacity() const {
+    return capacity;
+}
+
+// Check if empty
+template <AllocatorHandle Alloc, typename... Fields>
+bool BasicSoaArray<Alloc, Fields...>::empty() const {
+    return size == 0;
+}
+
+// Get growth statistics
+template <AllocatorHandle Alloc, typename... Fields>
+AllocatorStats BasicSoaArray<Alloc, Fields...>::stats() const {
+    return recorder.snapshot();
+}
+
+// Get the allocator
+template <AllocatorHandle Alloc, typename... Fields>
+std::remove_pointer_t<Alloc>& BasicSoaArray<Alloc, Fields...>::get_allocator() {
+    return detail::allocator_of(allocator);
+}
+
+// Reserve memory
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::reserve(size_t new_capacity) {
+    if (new_capacity <= capacity) {
+        return {}; // Nothing to do
+    }
+    if (block_size(new_capacity) == std::numeric_limits<size_t>::max()) {
+        return std::unexpected(DynArrayError::InvalidCapacity);
+    }
+
+    return reallocate(new_capacity);
+}
+
+// Resize array
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::resize(size_t count) {
+    if (count > capacity) {
+        auto result = reserve(count);
+        if (!result) {
+            return result;
+        }
+    }
+
+    if (count > size) {
+        // Value-initialize the new elements of every column
+        detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+            std::uninitialized_value_construct_n(std::get<I>(columns) + size, count - size);
+        });
+    } else {
+        destroy_from(count);
+    }
+
+    size = count;
+    return {};
+}
+
+// Clear array
+template <AllocatorHandle Alloc, typename... Fields>
+void BasicSoaArray<Alloc, Fields...>::clear() {
+    destroy_from(0);
+    size = 0;
+}
+
+// Push back (copy)
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::push_back(const value_type& value) {
+    return std::apply([this](const Fields&... fields) { return emplace_back(fields...); }, value);
+}
+
+// Push back (move)
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::push_back(value_type&& value) {
+    return std::apply([this](Fields&... fields) { return emplace_back(std::move(fields)...); }, value);
+}
+
+// Emplace back, one argument per column
+template <AllocatorHandle Alloc, typename... Fields>
+template <typename... Args>
+    requires (sizeof...(Args) == sizeof...(Fields))
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::emplace_back(Args&&... args) {
+    if (size >= capacity) [[unlikely]] {
+        auto result = grow(size + 1);
+        if (!result) {
+            return result;
+        }
+    }
+
+    // Construct each field at the end of its column
+    std::apply([&](Fields*... column_data) {
+        (std::construct_at(column_data + size, std::forward<Args>(args)), ...);
+    }, columns);
+    ++size;
+    return {};
+}
+
+// Pop back
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::pop_back() {
+    if (empty()) {
+        return std::unexpected(DynArrayError::EmptyArray);
+    }
+
+    destroy_from(size - 1);
+    --size;
+    return {};
+}
+
+// Begin iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::iterator BasicSoaArray<Alloc, Fields...>::begin() {
+    return iterator(this, 0);
+}
+
+// End iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::iterator BasicSoaArray<Alloc, Fields...>::end() {
+    return iterator(this, size);
+}
+
+// Const begin iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_iterator BasicSoaArray<Alloc, Fields...>::begin() const {
+    return const_iterator(this, 0);
+}
+
+// Const end iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_iterator BasicSoaArray<Alloc, Fields...>::end() const {
+    return const_iterator(this, size);
+}
+
+// Explicit const begin iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_iterator BasicSoaArray<Alloc, Fields...>::cbegin() const {
+    return begin();
+}
+
+// Explicit const end iterator
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_iterator BasicSoaArray<Alloc, Fields...>::cend() const {
+    return end();
+}
+
+// Size of a block for capacity elements
+template <AllocatorHandle Alloc, typename... Fields>
+constexpr size_t BasicSoaArray<Alloc, Fields...>::block_size(size_t capacity) {
+    return column_offset(capacity, COLUMN_COUNT);
+}
+
+// Unchecked element access
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::reference BasicSoaArray<Alloc, Fields...>::element(size_t index) {
+    return std::apply([index](Fields*... column_data) { return reference(column_data[index]...); }, columns);
+}
+
+// Unchecked const element access
+template <AllocatorHandle Alloc, typename... Fields>
+typename BasicSoaArray<Alloc, Fields...>::const_reference
+BasicSoaArray<Alloc, Fields...>::element(size_t index) const {
+    return std::apply([index](Fields*... column_data) { return const_reference(column_data[index]...); }, columns);
+}
+
+// Offset of a column within the block
+template <AllocatorHandle Alloc, typename... Fields>
+constexpr size_t BasicSoaArray<Alloc, Fields...>::column_offset(size_t capacity, size_t index) {
+    constexpr std::array<size_t, COLUMN_COUNT> sizes = {sizeof(Fields)...};
+    constexpr std::array<size_t, COLUMN_COUNT> aligns = {std::max(alignof(Fields), SOA_COLUMN_ALIGNMENT)...};
+    constexpr size_t overflow = std::numeric_limits<size_t>::max();
+
+    size_t offset = 0;
+    for (size_t i = 0; i < index; ++i) {
+        // Each column starts aligned right after the previous one
+        offset = (offset + aligns[i] - 1) & ~(aligns[i] - 1);
+        if (capacity > (overflow - offset - BLOCK_ALIGNMENT) / sizes[i]) {
+            return overflow;
+        }
+        offset += sizes[i] * capacity;
+    }
+    if (index < COLUMN_COUNT) {
+        offset = (offset + aligns[index] - 1) & ~(aligns[index] - 1);
+    }
+    return offset;
+}
+
+// Column starts for a block
+template <AllocatorHandle Alloc, typename... Fields>
+std::tuple<Fields*...> BasicSoaArray<Alloc, Fields...>::layout(unsigned char* base, size_t capacity) {
+    std::tuple<Fields*...> result;
+    detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+        std::get<I>(result) = reinterpret_cast<field_type<I>*>(base + column_offset(capacity, I));
+    });
+    return result;
+}
+
+// Grow array capacity
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::grow(size_t min_capacity) {
+    // The first allocation takes at least DEFAULT_CAPACITY elements
+    if (capacity == 0 && min_capacity < DEFAULT_CAPACITY) {
+        min_capacity = DEFAULT_CAPACITY;
+    }
+
+    constexpr size_t element_size = (sizeof(Fields) + ...);
+    return reserve(GeometricGrowth<>::next_capacity(capacity, min_capacity, element_size));
+}
+
+// Move the columns to a larger block
+template <AllocatorHandle Alloc, typename... Fields>
+std::expected<void, DynArrayError> BasicSoaArray<Alloc, Fields...>::reallocate(size_t new_capacity) {
+    auto& backend = detail::allocator_of(allocator);
+    size_t old_bytes = block_size(capacity);
+    size_t new_bytes = block_size(new_capacity);
+
+    if constexpr ((is_trivially_relocatable_v<Fields> && ...)) {
+        // Extend the block where it is, then slide the columns up to their new offsets.
+        // Columns only move up, so going from the last one down never overwrites one
+        // that has not moved yet.
+        if (block != nullptr && detail::try_resize_in_place_in(backend, block, old_bytes, new_bytes)) {
+            std::tuple<Fields*...> moved = layout(block, new_capacity);
+            detail::for_each_index_reverse<COLUMN_COUNT>([&](auto I) {
+                std::memmove(static_cast<void*>(std::get<I>(moved)), static_cast<const void*>(std::get<I>(columns)),
+                             sizeof(field_type<I>) * size);
+            });
+            columns = moved;
+            capacity = new_capacity;
+            recorder.record_resize(true);
+            recorder.record_in_use(new_bytes);
+            return {};
+        }
+    }
+
+    // No zeroing since elements are constructed in place
+    auto alloc_result = detail::allocate_from(backend, new_bytes, BLOCK_ALIGNMENT);
+    if (!alloc_result) {
+        recorder.record_failure();
+        return std::unexpected(DynArrayError::OutOfMemory);
+    }
+    auto* new_block = static_cast<unsigned char*>(alloc_result.value());
+    std::tuple<Fields*...> new_columns = layout(new_block, new_capacity);
+
+    if (block == nullptr) {
+        recorder.record_alloc(new_bytes);
+    } else {
+        // Relocate column by column into the new block, then free the old one
+        detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+            using Field = field_type<I>;
+            Field* src = std::get<I>(columns);
+            Field* dst = std::get<I>(new_columns);
+            if constexpr (is_trivially_relocatable_v<Field>) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(Field) * size);
+            } else {
+                std::uninitialized_move(src, src + size, dst);
+                std::destroy_n(src, size);
+            }
+        });
+        release();
+        recorder.record_resize(false);
+    }
+
+    block = new_block;
+    columns = new_columns;
+    capacity = new_capacity;
+    recorder.record_in_use(new_bytes);
+    return {};
+}
+
+// Destroy a tail of every column
+template <AllocatorHandle Alloc, typename... Fields>
+void BasicSoaArray<Alloc, Fields...>::destroy_from(size_t first) {
+    detail::for_each_index<COLUMN_COUNT>([&](auto I) {
+        if constexpr (!std::is_trivially_destructible_v<field_type<I>>) {
+            std::destroy(std::get<I>(columns) + first, std::get<I>(columns) + size);
+        }
+    });
+}
+
+// Hand the block back
+template <AllocatorHandle Alloc, typename... Fields>
+void BasicSoaArray<Alloc, Fields...>::release() {
+    if (block != nullptr) {
+        detail::deallocate_to(detail::allocator_of(allocator), block, block_size(capacity), BLOCK_ALIGNMENT);
+    }
+}
+
+} // namespace memory
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/Allocator.hpp"
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Header stored directly in front of every stack allocation
+ */
+struct StackAllocationHeader {
+    size_t prev_offset; ///< Start offset of the allocation that was on top before this one
+    size_t padding;     ///< Bytes between the previous end offset and the start of this allocation
+};
+
+/**
+ * @brief Stack allocator implementation
+ *
+ * A linear allocator that additionally supports freeing the most recent allocation.
+ * A small header in front of every allocation remembers how to roll back the offsets,
+ * so allocations are released in LIFO order.
+ *
+ * @note Allocation, free and in-place resize of the top allocation are O(1).
+ *       Debug builds (without NDEBUG) reject out-of-order frees with
+ *       AllocatorError::OutOfOrderFree; release builds free everything above the
+ *       pointer instead.
+ */
+struct StackAllocator {
+    unsigned char* buf;       ///< Pointer to backing buffer
+    size_t buf_len;           ///< Length of backing buffer
+    size_t prev_offset;       ///< Start offset of the top allocation
+    size_t curr_offset;       ///< Current allocation offset (end of the top allocation)
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default alignment for allocations
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = LinearAllocator::DEFAULT_ALIGNMENT;
+
+    /**
+     * @brief Initialize a stack allocator with provided backing buffer
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @return Initialized StackAllocator
+     */
+    static StackAllocator create(void* backing_buffer, size_t backing_buffer_length);
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate memory with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Allocate memory for a specific type with default alignment
+     *
+     * @tparam T Type to allocate memory for
+     * @param count Number of elements to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    template<typename T>
+    std::expected<void*, AllocatorError> alloc(size_t count = 1) {
+        return alloc(sizeof(T) * count);
+    }
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note The top allocation is resized in place. Otherwise a new allocation is
+     *       pushed and the data copied; the old block is released once everything
+     *       above it has been freed.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an existing allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     *
+     * @note Only the top allocation can be resized in place. The grown tail is not zeroed.
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free the most recent allocation
+     *
+     * @param ptr Pointer to the top allocation of this allocator
+     * @return std::expected<void, AllocatorError> Success or error code
+     *
+     * @note Freeing a pointer above the current top (a double free) is ignored.
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Free all allocations from this allocator
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use is the current offset, headers included.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+};
+
+/**
+ * @brief Frees roll the stack back, so they have to come in LIFO order
+ */
+template <>
+struct is_lifo_allocator<StackAllocator> : std::true_type {};
+
+} // namespace memory
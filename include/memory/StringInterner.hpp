@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <string_view>
+#include <type_traits>
+
+#include "memory/Allocator.hpp"
+#include "memory/FlatHashMap.hpp"
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+namespace detail {
+
+/**
+ * @brief Value type of a hash map used as a set
+ */
+struct InternedTag {};
+
+} // namespace detail
+
+/**
+ * @brief Deduplicating string table over an allocator
+ *
+ * intern() copies a string into the allocator the first time it is seen and returns
+ * the same view for every later copy of it, so interned strings compare equal by
+ * pointer and live exactly as long as the allocator's memory. The views are
+ * NUL-terminated and stay valid across later interns; clearing the arena with
+ * free_all invalidates all of them at once.
+ *
+ * The characters and the lookup table (a FlatHashMap) both come from the allocator.
+ * Interned strings are never freed one by one, so the allocator should be an arena
+ * (the default LinearAllocator*, a ScopedArena, a VirtualArena) that is reset as a whole.
+ *
+ * @tparam Alloc Allocator type or pointer to an allocator (see AllocatorHandle)
+ */
+template <AllocatorHandle Alloc = LinearAllocator*>
+struct BasicStringInterner {
+    FlatHashMap<std::string_view, detail::InternedTag, Alloc> table; ///< Interned strings, viewing allocator memory
+    size_t bytes;                                                      ///< Bytes of characters interned, terminators included
+
+    /**
+     * @brief Default constructor, for allocators held by value
+     */
+    BasicStringInterner();
+
+    /**
+     * @brief Constructor with custom allocator
+     *
+     * @param alloc Allocator to use, or pointer to it
+     */
+    explicit BasicStringInterner(Alloc alloc);
+
+    /**
+     * @brief Get the interned copy of a string, interning it if it is new
+     *
+     * @param text String to intern
+     * @return std::expected<std::string_view, AllocatorError> Stable view of the
+     *         interned copy or error
+     */
+    std::expected<std::string_view, AllocatorError> intern(std::string_view text);
+
+    /**
+     * @brief Check if a string has been interned
+     *
+     * @param text String to look up
+     * @return true if intern(text) would not allocate
+     */
+    bool contains(std::string_view text) const;
+
+    /**
+     * @brief Get the number of distinct strings interned
+     *
+     * @return Number of interned strings
+     */
+    size_t get_size() const;
+
+    /**
+     * @brief Get the number of bytes the interned characters use
+     *
+     * @return Bytes of characters, terminators included
+     */
+    size_t get_bytes() const;
+
+    /**
+     * @brief Drop the table so the arena under it can be reset
+     *
+     * Every view returned so far must be considered invalid once the allocator
+     * reclaims its memory; the interner starts out empty again.
+     */
+    void reset();
+};
+
+/**
+ * @brief String interner on a LinearAllocator
+ */
+using StringInterner = BasicStringInterner<LinearAllocator*>;
+
+} // namespace memory
+
+// Include the implementation
+#include "memory/StringInterner.tpp"
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "memory/StringInterner.hpp"
+
+namespace memory {
+
+
+template <AllocatorHandle Alloc>
+BasicStringInterner<Alloc>::BasicStringInterner() : table(), bytes(0) {}
+
+
+template <AllocatorHandle Alloc>
+BasicStringInterner<Alloc>::BasicStringInterner(Alloc alloc) : table(alloc), bytes(0) {}
+
+// Intern a string
+template <AllocatorHandle Alloc>
+std::expected<std::string_view, AllocatorError> BasicStringInterner<Alloc>::intern(std::string_view text) {
+    // One probe: insert the caller's view, then point the new entry at the copy
+    auto inserted = table.try_emplace(text);
+    if (!inserted) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    auto [entry, is_new] = inserted.value();
+    if (!is_new) {
+        return entry->key;
+    }
+
+    auto memory = detail::allocate_from(table.get_allocator(), text.size() + 1, alignof(char));
+    if (!memory) {
+        table.erase(text);
+        return std::unexpected(memory.error());
+    }
+    char* copy = static_cast<char*>(memory.value());
+    std::memcpy(copy, text.data(), text.size());
+    copy[text.size()] = '\0';
+
+    // Same characters, so the entry keeps its hash and place
+    entry->key = std::string_view(copy, text.size());
+    bytes += text.size() + 1;
+    return entry->key;
+}
+
+// Check for a string
+template <AllocatorHandle Alloc>
+bool BasicStringInterner<Alloc>::contains(std::string_view text) const {
+    return table.contains(text);
+}
+
+// Get size
+template <AllocatorHandle Alloc>
+size_t BasicStringInterner<Alloc>::get_size() const {
+    return table.get_size();
+}
+
+// Get interned bytes
+template <AllocatorHandle Alloc>
+size_t BasicStringInterner<Alloc>::get_bytes() const {
+    return bytes;
+}
+
+// Drop the table
+template <AllocatorHandle Alloc>
+void BasicStringInterner<Alloc>::reset() {
+    table.reset();
+    bytes = 0;
+}
+
+} // namespace memory
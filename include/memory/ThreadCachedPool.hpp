@@ -0,0 +1,255 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <thread>
+
+#include "memory/AlignmentPolicy.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/PoolAllocator.hpp"
+
+namespace memory {
+
+struct ThreadCache;
+
+/**
+ * @brief Header at the start of every span of a thread-cached pool
+ *
+ * A span is a fixed-size run of chunks owned by a single thread cache. The owner
+ * allocates from it and frees into it without synchronization; every other thread
+ * pushes the chunks it frees onto the lock-free remote free stack, which the owner
+ * drains in one go when the local list runs dry.
+ */
+struct alignas(CACHE_LINE_SIZE) PoolSpan {
+    ThreadCache* owner;          ///< Thread cache this span belongs to
+    PoolSpan* next;              ///< Next span owned by the same thread cache
+    PoolFreeNode* local_free;    ///< Chunks freed by the owner (owner only)
+    size_t carved;               ///< Number of chunks handed out from the span so far (owner only)
+
+    /// Chunks freed by other threads (multi-producer, drained by the owner)
+    alignas(CACHE_LINE_SIZE) std::atomic<PoolFreeNode*> remote_free;
+};
+
+/**
+ * @brief Per-thread slot of a thread-cached pool
+ */
+struct alignas(CACHE_LINE_SIZE) ThreadCache {
+    std::atomic<std::thread::id> owner_thread; ///< Thread using this slot (default id when free)
+    PoolSpan* active;                          ///< Span allocations are served from
+    PoolSpan* spans;                           ///< All spans owned by this slot
+};
+
+/**
+ * @brief State of a thread-cached pool shared by all threads
+ */
+struct alignas(CACHE_LINE_SIZE) ThreadCachedPoolShared {
+    std::atomic<size_t> next_span; ///< Index of the next span to carve out of the region
+    uint64_t id;                   ///< Unique id so stale thread-local lookups are never reused
+};
+
+/**
+ * @brief Tuning options for a thread-cached pool
+ */
+struct ThreadCacheOptions {
+    size_t max_threads = 64;       ///< Number of thread slots
+    size_t span_size = 64 * 1024;  ///< Bytes taken from the shared region per refill (power of two)
+};
+
+/**
+ * @brief Fixed-size pool allocator with a per-thread cache for multi-threaded use
+ *
+ * The backing buffer is a shared region split into spans. Each thread claims a slot
+ * on first use and refills it one span at a time with a single atomic increment, so
+ * allocation and free by the owning thread never touch shared state. Chunks freed
+ * by another thread go onto a lock-free stack in their span and are picked up by
+ * the owner on its next refill.
+ *
+ * All mutable state lives in the backing buffer, so copies of a ThreadCachedPool
+ * refer to the same pool.
+ *
+ * @note alloc and free are thread-safe; free_all is not and must not race with them.
+ *       A thread keeps its slot (and the spans in it) until release_thread_cache is
+ *       called; a slot released by one thread is inherited by the next one to claim it.
+ */
+struct ThreadCachedPool {
+    unsigned char* buf;               ///< Start of the span region
+    size_t span_count;                ///< Number of spans in the region
+    size_t span_size;                 ///< Size of each span (power of two)
+    size_t chunk_size;                ///< Size of each chunk (multiple of chunk_alignment)
+    size_t chunk_alignment;           ///< Alignment of each chunk
+    size_t first_chunk;               ///< Offset of the first chunk within a span
+    size_t chunks_per_span;           ///< Number of chunks in each span
+    ThreadCache* caches;              ///< Thread slots
+    size_t max_threads;               ///< Number of thread slots
+    ThreadCachedPoolShared* shared;   ///< Shared state
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics, shared by all threads (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default chunk alignment
+     */
+    static constexpr size_t DEFAULT_ALIGNMENT = LinearAllocator::DEFAULT_ALIGNMENT;
+
+    /**
+     * @brief Initialize a thread-cached pool over a provided backing buffer
+     *
+     * The shared state and the thread slots are placed at the start of the buffer,
+     * the rest is split into spans.
+     *
+     * @param backing_buffer Pointer to pre-allocated memory buffer
+     * @param backing_buffer_length Size of the backing buffer in bytes
+     * @param chunk_size Size of each chunk (rounded up to the alignment and to hold a free list node)
+     * @param chunk_alignment Alignment of each chunk (must be a power of two, at most the span size)
+     * @param options Number of thread slots and span size
+     * @return std::expected<ThreadCachedPool, AllocatorError> Initialized ThreadCachedPool or error
+     */
+    static std::expected<ThreadCachedPool, AllocatorError> create(void* backing_buffer, size_t backing_buffer_length,
+                                                                  size_t chunk_size,
+                                                                  size_t chunk_alignment = DEFAULT_ALIGNMENT,
+                                                                  const ThreadCacheOptions& options = {});
+
+    /**
+     * @brief Initialize a thread-cached pool over a region carved out of a linear allocator
+     *
+     * @param arena Arena to take the region from
+     * @param region_size Size of the region in bytes
+     * @param chunk_size Size of each chunk (rounded up to the alignment and to hold a free list node)
+     * @param chunk_alignment Alignment of each chunk (must be a power of two, at most the span size)
+     * @param options Number of thread slots and span size
+     * @return std::expected<ThreadCachedPool, AllocatorError> Initialized ThreadCachedPool or error
+     */
+    static std::expected<ThreadCachedPool, AllocatorError> create(LinearAllocator* arena, size_t region_size,
+                                                                  size_t chunk_size,
+                                                                  size_t chunk_alignment = DEFAULT_ALIGNMENT,
+                                                                  const ThreadCacheOptions& options = {});
+
+    /**
+     * @brief Allocate a chunk from the calling thread's cache
+     *
+     * @return std::expected<void*, AllocatorError> Pointer to the chunk or error
+     *
+     * @note Allocated memory is zeroed by default. Fails with OutOfMemory when the
+     *       region is exhausted or every thread slot is taken.
+     */
+    std::expected<void*, AllocatorError> alloc();
+
+    /**
+     * @brief Allocate a chunk from the calling thread's cache without zeroing it
+     *
+     * @return std::expected<void*, AllocatorError> Pointer to the chunk or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit();
+
+    /**
+     * @brief Allocate a chunk for an object of the given size and alignment
+     *
+     * @param size Size in bytes (must fit in a chunk)
+     * @param align Alignment (must be a power of two, at most chunk_alignment)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed by default
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate a chunk for an object of the given size and alignment without zeroing it
+     *
+     * @param size Size in bytes (must fit in a chunk)
+     * @param align Alignment (must be a power of two, at most chunk_alignment)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Resize an allocation within its chunk
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size (must fit in a chunk)
+     * @param align Alignment (must be a power of two, at most chunk_alignment)
+     * @return std::expected<void*, AllocatorError> old_memory, or a fresh chunk if old_memory was null
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Try to resize an allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if new_size fits in a chunk, false otherwise
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Return a chunk to its span, from any thread
+     *
+     * @param ptr Pointer to a chunk previously allocated from this pool
+     * @return std::expected<void, AllocatorError> Success or error code
+     *
+     * @note Frees by the owning thread are a plain list push; frees by any other
+     *       thread are a lock-free push onto the span's remote free stack.
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Return every span to the shared region
+     *
+     * @note Not thread-safe. Threads keep their slots.
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics, from any thread
+     *
+     * bytes_in_use counts whole chunks; padding_bytes is what requests left unused
+     * of their chunk.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Give the calling thread's slot back so another thread can claim it
+     *
+     * The spans cached in the slot stay with it and are inherited by the next thread
+     * that claims the slot. Call this before a worker thread exits.
+     */
+    void release_thread_cache();
+
+    /**
+     * @brief Get the number of spans carved out of the shared region so far
+     *
+     * @return Number of spans in use
+     */
+    size_t spans_in_use() const;
+
+private:
+    /**
+     * @brief Find the calling thread's slot, optionally claiming a free one
+     *
+     * @param claim Whether to claim a slot if the thread has none
+     * @return The thread's slot, or nullptr if it has none (or none was free)
+     */
+    ThreadCache* thread_cache(bool claim) const;
+
+    /**
+     * @brief Take a chunk from a span owned by the calling thread
+     *
+     * @param span Span to take the chunk from
+     * @return Pointer to the chunk, or nullptr if the span is exhausted
+     */
+    void* take_chunk(PoolSpan* span);
+
+    /**
+     * @brief Find or carve a span with free chunks for a slot
+     *
+     * @param cache Slot to refill
+     * @return Span with at least one free chunk, or nullptr if the region is exhausted
+     */
+    PoolSpan* refill(ThreadCache* cache);
+};
+
+} // namespace memory
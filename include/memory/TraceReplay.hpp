@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "memory/AllocationTrace.hpp"
+#include "memory/Allocator.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/VirtualArena.hpp"
+
+namespace memory {
+
+/**
+ * @brief Kind of a replay operation
+ */
+enum class ReplayOpKind : uint8_t {
+    Alloc,        ///< Allocate the handle
+    Resize,       ///< Resize the handle
+    Free,         ///< Free the handle
+    ImplicitFree, ///< Free a handle that a scope end released (skipped by arenas, which rewind instead)
+    FreeAll,      ///< Free every handle with free_all
+    ScopeBegin,   ///< Begin a scratch scope
+    ScopeEnd      ///< End the innermost scratch scope
+};
+
+/**
+ * @brief One operation of a compiled trace
+ *
+ * Addresses are replaced by dense handles, so the replay loop indexes an array
+ * instead of hashing addresses.
+ */
+struct ReplayOp {
+    size_t size;       ///< Size to allocate or resize to
+    size_t old_size;   ///< Size of the handle before a resize or free
+    uint32_t handle;   ///< Handle the operation applies to
+    uint32_t align;    ///< Alignment of the handle
+    ReplayOpKind kind; ///< Operation
+};
+
+/**
+ * @brief The operations of one traced allocator, ready to replay
+ */
+struct ReplayProgram {
+    std::vector<ReplayOp> ops; ///< Operations in recording order
+    size_t handles = 0;        ///< Number of handles the operations use
+    size_t max_size = 0;       ///< Largest allocation or resize
+    size_t max_align = 1;      ///< Largest alignment
+    size_t peak_live_bytes = 0; ///< Largest sum of live allocation sizes
+    uint64_t duration_ns = 0;  ///< Time between the first and the last event
+    size_t skipped = 0;        ///< Events that referred to unknown allocations (dropped or cut off), left out
+    bool lifo = true;          ///< Every free releases the newest live allocation, so LIFO allocators can replay it
+
+    /**
+     * @brief Compile the events of one traced allocator
+     *
+     * Scope ends are expanded into ImplicitFree operations for everything allocated
+     * inside the scope, so allocators without scopes can replay them too. Frees are
+     * also checked against the order a LIFO allocator (is_lifo_allocator) could
+     * serve, see lifo.
+     *
+     * @param events Trace in recording order
+     * @param allocator Id of the allocator whose events to take
+     * @return ReplayProgram Compiled operations
+     */
+    static ReplayProgram compile(std::span<const TraceEvent> events, uint16_t allocator);
+};
+
+/**
+ * @brief Get the ids of the allocators that appear in a trace
+ *
+ * @param events Trace
+ * @return Ids in ascending order
+ */
+std::vector<uint16_t> trace_allocators(std::span<const TraceEvent> events);
+
+/**
+ * @brief Outcome of replaying a program against an allocator
+ */
+struct ReplayReport {
+    size_t operations = 0;      ///< Operations replayed
+    bool applicable = true;     ///< false if the allocator cannot serve the trace's free order, nothing replayed
+    size_t failures = 0;        ///< Allocations, resizes and frees the allocator could not satisfy
+    size_t peak_live_bytes = 0; ///< Largest sum of live allocation sizes
+    size_t peak_footprint = 0;  ///< Largest span of the backing buffer in use (or of usable sizes, without one)
+    double seconds = 0.0;       ///< Wall time of the replay loop
+
+    /**
+     * @brief Share of the footprint that did not hold live data at the peak
+     *
+     * @return 1 - peak_live_bytes / peak_footprint, 0 for an empty replay
+     */
+    double fragmentation() const {
+        return peak_footprint == 0 ? 0.0 : 1.0 - static_cast<double>(peak_live_bytes) /
+                                                     static_cast<double>(peak_footprint);
+    }
+
+    /**
+     * @brief Operations replayed per second
+     *
+     * @return Throughput, 0 if the replay took no measurable time
+     */
+    double ops_per_second() const {
+        return seconds > 0.0 ? static_cast<double>(operations) / seconds : 0.0;
+    }
+};
+
+/**
+ * @brief Replay a compiled trace against an allocator
+ *
+ * With a base, the footprint is how far past base allocations reached, which is the
+ * backing buffer an arena needs. Without one (heap, chained arenas) it is the sum of
+ * the live allocations' usable sizes. LinearAllocator and VirtualArena replay
+ * scopes as TempArenaMemory; other allocators free the scope's allocations instead.
+ * A LIFO allocator is not replayed at all unless program.lifo holds, since freeing
+ * below its top would release live blocks and make the footprint meaningless.
+ *
+ * @tparam A Allocator type
+ * @param program Compiled trace
+ * @param allocator Allocator to replay against, freshly created
+ * @param base Start of the allocator's backing buffer, nullptr if it has none
+ * @return ReplayReport Outcome of the replay
+ */
+template <BasicAllocator A>
+ReplayReport replay(const ReplayProgram& program, A& allocator, const void* base = nullptr) {
+    constexpr bool SCOPED = std::same_as<A, LinearAllocator> || std::same_as<A, VirtualArena>;
+
+    struct Block {
+        void* ptr = nullptr;  ///< Replayed allocation, nullptr if not live
+        size_t size = 0;      ///< Size of the allocation
+        size_t footprint = 0; ///< Usable size counted into the footprint (without base)
+    };
+
+    ReplayReport report;
+    if constexpr (is_lifo_allocator_v<A>) {
+        if (!program.lifo) {
+            report.applicable = false;
+            return report;
+        }
+    }
+
+    std::vector<Block> blocks(program.handles);
+    std::vector<TempArenaMemory> scopes;
+    size_t live_bytes = 0;
+    size_t footprint = 0;
+
+    auto track = [&](Block& block, void* ptr, size_t size, size_t align) {
+        live_bytes = live_bytes - block.size + size;
+        if (base != nullptr) {
+            size_t end = static_cast<size_t>(static_cast<const unsigned char*>(ptr) + size -
+                                             static_cast<const unsigned char*>(base));
+            footprint = std::max(footprint, end);
+        } else {
+            size_t usable = detail::usable_size_in(allocator, ptr, size, align);
+            footprint = footprint - block.footprint + usable;
+            block.footprint = usable;
+        }
+        block.ptr = ptr;
+        block.size = size;
+        report.peak_live_bytes = std::max(report.peak_live_bytes, live_bytes);
+        report.peak_footprint = std::max(report.peak_footprint, footprint);
+    };
+
+    auto forget = [&](Block& block) {
+        live_bytes -= block.size;
+        if (base == nullptr) {
+            footprint -= block.footprint;
+        }
+        block = Block{};
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (const ReplayOp& op : program.ops) {
+        Block& block = blocks[op.handle];
+        switch (op.kind) {
+        case ReplayOpKind::Alloc:
+        case ReplayOpKind::Resize: {
+            std::expected<void*, AllocatorError> result = std::unexpected(AllocatorError::NullPointer);
+            if (block.ptr == nullptr) {
+                result = detail::allocate_from(allocator, op.size, op.align);
+            } else if constexpr (ResizableAllocator<A>) {
+                result = detail::resize_in(allocator, block.ptr, block.size, op.size, op.align);
+            } else {
+                result = detail::allocate_from(allocator, op.size, op.align);
+                if (result) {
+                    std::memcpy(result.value(), block.ptr, std::min(block.size, op.size));
+                }
+            }
+            if (!result) {
+                ++report.failures;
+                break;
+            }
+            track(block, result.value(), op.size, op.align);
+            break;
+        }
+        case ReplayOpKind::ImplicitFree:
+            if constexpr (SCOPED) {
+                // The scope end that follows rewinds the arena
+                forget(block);
+                break;
+            }
+            [[fallthrough]];
+        case ReplayOpKind::Free:
+            if (block.ptr != nullptr) {
+                if (!detail::deallocate_to(allocator, block.ptr, block.size, op.align)) {
+                    ++report.failures;
+                }
+                forget(block);
+            }
+            break;
+        case ReplayOpKind::FreeAll:
+            if constexpr (requires { allocator.free_all(); }) {
+                allocator.free_all();
+            }
+            std::fill(blocks.begin(), blocks.end(), Block{});
+            scopes.clear();
+            live_bytes = 0;
+            footprint = 0;
+            break;
+        case ReplayOpKind::ScopeBegin:
+            if constexpr (SCOPED) {
+                scopes.push_back(TempArenaMemory::begin(&allocator));
+            }
+            break;
+        case ReplayOpKind::ScopeEnd:
+            if constexpr (SCOPED) {
+                if (!scopes.empty()) {
+                    scopes.back().end();
+                    scopes.pop_back();
+                }
+            }
+            break;
+        }
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    report.operations = program.ops.size();
+    report.seconds = std::chrono::duration<double>(stop - start).count();
+    return report;
+}
+
+} // namespace memory
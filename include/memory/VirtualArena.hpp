@@ -0,0 +1,256 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Upstream source of memory blocks for a VirtualArena
+ *
+ * A pair of C-style callbacks so that blocks can come from malloc, a virtual
+ * memory reservation, a bigger arena or anything else.
+ */
+struct BlockSource {
+    void* (*alloc_block)(size_t size, void* user_data);          ///< Allocate a block of at least size bytes
+    void  (*free_block)(void* block, size_t size, void* user_data); ///< Return a block to the source
+    void* user_data;                                              ///< Opaque pointer passed to both callbacks
+
+    /**
+     * @brief Block source backed by malloc/free
+     *
+     * @return BlockSource using the C heap
+     */
+    static BlockSource heap();
+};
+
+/**
+ * @brief Header placed at the start of every block owned by a VirtualArena
+ */
+struct ArenaBlock {
+    ArenaBlock* prev; ///< Previously current block (older in the chain)
+    size_t size;      ///< Total size of the block including this header
+};
+
+/**
+ * @brief Growable chained arena
+ *
+ * A linear allocator that never runs out of room as long as its upstream can hand
+ * out blocks. Allocations bump-allocate from the current block; when it is full a
+ * new block of geometrically increasing size is chained in front of it.
+ *
+ * @note Allocation is O(1) amortized. free_all keeps the largest block for reuse so
+ *       steady-state resets do not go back to the upstream.
+ */
+struct VirtualArena {
+    LinearAllocator current;  ///< Bump allocator over the current block's payload
+    ArenaBlock* block;        ///< Current block (head of the chain), nullptr before the first allocation
+    ArenaBlock* spare;        ///< Retained free block reused by the next block request
+    BlockSource upstream;     ///< Where blocks come from
+    size_t next_block_size;   ///< Size of the next block to request (including header)
+    size_t max_block_size;    ///< Upper bound on geometric block growth
+    [[no_unique_address]] StatsRecorder recorder; ///< Usage statistics (empty unless MEMORY_ENABLE_STATS)
+
+    /**
+     * @brief Default size of the first block
+     */
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * @brief Default cap for geometric block growth
+     */
+    static constexpr size_t DEFAULT_MAX_BLOCK_SIZE = 64 * 1024 * 1024;
+
+    /**
+     * @brief Initialize a chained arena
+     *
+     * No memory is requested until the first allocation.
+     *
+     * @param initial_block_size Size of the first block in bytes
+     * @param source Upstream block source
+     * @param max_block_size Upper bound on geometric block growth
+     * @return Initialized VirtualArena
+     */
+    static VirtualArena create(size_t initial_block_size = DEFAULT_BLOCK_SIZE,
+                               BlockSource source = BlockSource::heap(),
+                               size_t max_block_size = DEFAULT_MAX_BLOCK_SIZE);
+
+    /**
+     * @brief Return every block, including the retained one, to the upstream
+     */
+    void destroy();
+
+    /**
+     * @brief Allocate memory with alignment
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     *
+     * @note Allocated memory is zeroed. OutOfMemory is only returned when the
+     *       upstream fails to provide a block.
+     */
+    std::expected<void*, AllocatorError> alloc_align(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_align_uninit(size_t size, size_t align);
+
+    /**
+     * @brief Allocate memory with default alignment
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc(size_t size);
+
+    /**
+     * @brief Allocate memory with default alignment without zeroing it
+     *
+     * @param size Size in bytes to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    std::expected<void*, AllocatorError> alloc_uninit(size_t size);
+
+    /**
+     * @brief Allocate memory for a specific type with default alignment
+     *
+     * @tparam T Type to allocate memory for
+     * @param count Number of elements to allocate
+     * @return std::expected<void*, AllocatorError> Pointer to allocated memory or error
+     */
+    template<typename T>
+    std::expected<void*, AllocatorError> alloc(size_t count = 1) {
+        return alloc(sizeof(T) * count);
+    }
+
+    /**
+     * @brief Resize an existing allocation with alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     *
+     * @note The most recent allocation is resized in place while it fits in the
+     *       current block. Otherwise the data is copied, possibly into a new block.
+     */
+    std::expected<void*, AllocatorError> resize_align(void* old_memory, size_t old_size,
+                                                   size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with alignment without zeroing the grown tail
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @param align Alignment of the allocation (must be a power of two)
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize_align_uninit(void* old_memory, size_t old_size,
+                                                          size_t new_size, size_t align);
+
+    /**
+     * @brief Resize an existing allocation with default alignment
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return std::expected<void*, AllocatorError> Pointer to resized memory or error
+     */
+    std::expected<void*, AllocatorError> resize(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Try to resize an existing allocation without moving it
+     *
+     * @param old_memory Pointer to previously allocated memory
+     * @param old_size Previous allocation size
+     * @param new_size New allocation size
+     * @return true if the allocation was resized in place, false otherwise
+     *
+     * @note Only the most recent allocation of the current block can be resized in place.
+     */
+    bool try_resize_in_place(void* old_memory, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Free a specific memory allocation
+     *
+     * @param ptr Pointer to memory previously allocated by this allocator
+     * @return std::expected<void, AllocatorError> Success or error code
+     *
+     * @note This function does nothing and exists for interface completeness
+     */
+    std::expected<void, AllocatorError> free(void* ptr);
+
+    /**
+     * @brief Free all allocations, retaining the largest block for reuse
+     */
+    void free_all();
+
+    /**
+     * @brief Get a snapshot of the usage statistics
+     *
+     * bytes_in_use counts the chained blocks (headers included, the spare block
+     * excluded), so the peak is the most memory the chain held from upstream.
+     *
+     * @return AllocatorStats Counters (all zero unless MEMORY_ENABLE_STATS)
+     */
+    AllocatorStats stats() const;
+
+    /**
+     * @brief Check whether a pointer lies inside one of the arena's blocks
+     *
+     * @param ptr Pointer to check
+     * @return true if ptr belongs to this arena, false otherwise
+     */
+    bool owns(const void* ptr) const;
+
+    /**
+     * @brief Roll the arena back to a previously saved position
+     *
+     * Blocks chained after saved_block are released (the largest is kept as spare).
+     * Used by TempArenaMemory.
+     *
+     * @param saved_block Block that was current at the saved position
+     * @param saved_prev_offset Saved previous offset within saved_block
+     * @param saved_curr_offset Saved current offset within saved_block
+     * @param saved_debug Saved red zone bookkeeping within saved_block
+     */
+    void rewind(ArenaBlock* saved_block, size_t saved_prev_offset, size_t saved_curr_offset,
+                const ArenaDebugState& saved_debug = {});
+
+private:
+    /**
+     * @brief Chain a new block large enough for an allocation in front of the current one
+     *
+     * @param size Size of the allocation that did not fit
+     * @param align Alignment of that allocation
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    std::expected<void, AllocatorError> push_block(size_t size, size_t align);
+
+    /**
+     * @brief Release a block, keeping the largest one as spare
+     *
+     * @param b Block to release
+     */
+    void release_block(ArenaBlock* b);
+
+    /**
+     * @brief Point the bump allocator at the payload of a block
+     *
+     * @param b Block to make current (may be nullptr)
+     */
+    void set_current(ArenaBlock* b);
+};
+
+} // namespace memory
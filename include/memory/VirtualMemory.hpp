@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+
+#include "memory/LinearAllocator.hpp"
+
+namespace memory {
+
+/**
+ * @brief Thin platform layer over the OS virtual memory API
+ *
+ * Uses mmap/mprotect/madvise on POSIX systems and VirtualAlloc/VirtualFree on Windows.
+ * Address ranges are reserved without backing, then committed (made readable and
+ * writable) and decommitted (backing returned to the OS) piecewise.
+ */
+struct VirtualMemory {
+    /**
+     * @brief Size of a regular page on this system
+     *
+     * @return Page size in bytes
+     */
+    static size_t page_size();
+
+    /**
+     * @brief Size of a huge page on this system
+     *
+     * @return Huge page size in bytes (2 MiB where it cannot be queried)
+     */
+    static size_t huge_page_size();
+
+    /**
+     * @brief Reserve an address range without committing any memory
+     *
+     * @param size Size of the range in bytes (rounded up to whole pages)
+     * @param huge_pages Huge page policy for the range
+     * @return std::expected<void*, AllocatorError> Base of the range or error
+     *
+     * @note HugePageMode::Explicit falls back to transparent huge pages when the
+     *       system has no huge pages reserved.
+     */
+    static std::expected<void*, AllocatorError> reserve(size_t size, HugePageMode huge_pages);
+
+    /**
+     * @brief Commit part of a reserved range, making it readable and writable
+     *
+     * @param ptr Page aligned start of the range to commit
+     * @param size Size in bytes (multiple of the page size)
+     * @return std::expected<void, AllocatorError> Success or error
+     */
+    static std::expected<void, AllocatorError> commit(void* ptr, size_t size);
+
+    /**
+     * @brief Return the backing of part of a committed range to the OS
+     *
+     * The range stays reserved and has to be committed again before reuse.
+     *
+     * @param ptr Page aligned start of the range to decommit
+     * @param size Size in bytes (multiple of the page size)
+     */
+    static void decommit(void* ptr, size_t size);
+
+    /**
+     * @brief Release a whole reserved range
+     *
+     * @param ptr Base of the range as returned by reserve
+     * @param size Size passed to reserve
+     */
+    static void release(void* ptr, size_t size);
+
+    /**
+     * @brief Number of NUMA nodes on this system
+     *
+     * Counts up to the highest node that has memory, so offline nodes and trailing
+     * CPU-only nodes are left out. Nodes below it may still lack memory, see
+     * numa_node_has_memory.
+     *
+     * @return Highest node number with memory plus one (1 without NUMA support)
+     */
+    static size_t numa_node_count();
+
+    /**
+     * @brief Check whether pages can be placed on a NUMA node
+     *
+     * @param node Node number
+     * @return true if the node is online and has memory of its own
+     */
+    static bool numa_node_has_memory(size_t node);
+
+    /**
+     * @brief NUMA node of the CPU the calling thread is running on
+     *
+     * @return Node number (0 without NUMA support)
+     */
+    static size_t current_numa_node();
+
+    /**
+     * @brief Set the NUMA policy for the pages of a range
+     *
+     * Applies to pages faulted in after the call, so place a range before it is first
+     * touched. Uses mbind on Linux; elsewhere only NumaPolicy::Default is supported.
+     *
+     * @param ptr Page aligned start of the range
+     * @param size Size in bytes (rounded up to whole pages)
+     * @param placement Policy and node
+     * @return true if the policy was applied, false if it is unsupported or the node has no memory
+     */
+    static bool place_on_numa(void* ptr, size_t size, const NumaPlacement& placement);
+};
+
+} // namespace memory
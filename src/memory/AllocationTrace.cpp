@@ -0,0 +1,181 @@
+#include "memory/AllocationTrace.hpp"
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace memory {
+
+namespace {
+
+/**
+ * @brief First bytes of every trace file
+ */
+struct TraceFileHeader {
+    char magic[4];        ///< "MTRC"
+    uint16_t version;     ///< Format version
+    uint16_t event_size;  ///< sizeof(TraceEvent) of the writer
+};
+
+constexpr char TRACE_MAGIC[4] = {'M', 'T', 'R', 'C'};
+constexpr uint16_t TRACE_VERSION = 1;
+
+// Events are drained to the file in chunks of this many
+constexpr size_t FLUSH_CHUNK = 256;
+
+} // namespace
+
+std::expected<TraceBuffer, AllocatorError> TraceBuffer::create(void* backing_buffer, size_t backing_buffer_length) {
+    if (backing_buffer == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    void* aligned = backing_buffer;
+    size_t space = backing_buffer_length;
+    if (std::align(alignof(TraceSlot), sizeof(TraceSlot), aligned, space) == nullptr) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    size_t capacity = std::bit_floor(space / sizeof(TraceSlot));
+    if (capacity < 2) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    return TraceBuffer(static_cast<TraceSlot*>(aligned), capacity);
+}
+
+TraceBuffer::TraceBuffer(TraceSlot* ring, size_t capacity)
+    : slots(ring), mask(capacity - 1), head(0), tail(0), dropped(0), next_id(0), origin(Clock::now()) {
+    // A free slot expects the position that maps onto it next
+    for (size_t i = 0; i < capacity; ++i) {
+        TraceSlot* slot = new (&slots[i]) TraceSlot;
+        slot->sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+TraceBuffer::TraceBuffer(TraceBuffer&& other) noexcept
+    : slots(other.slots), mask(other.mask), head(other.head.load(std::memory_order_relaxed)), tail(other.tail),
+      dropped(other.dropped.load(std::memory_order_relaxed)), next_id(other.next_id.load(std::memory_order_relaxed)),
+      origin(other.origin) {}
+
+TraceBuffer& TraceBuffer::operator=(TraceBuffer&& other) noexcept {
+    slots = other.slots;
+    mask = other.mask;
+    head.store(other.head.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    tail = other.tail;
+    dropped.store(other.dropped.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    next_id.store(other.next_id.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    origin = other.origin;
+    return *this;
+}
+
+uint16_t TraceBuffer::register_allocator() {
+    return static_cast<uint16_t>(next_id.fetch_add(1, std::memory_order_relaxed));
+}
+
+bool TraceBuffer::record(TraceOp op, uint16_t allocator, const void* address, const void* old_address,
+                         size_t size, size_t align) {
+    uint64_t timestamp = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin).count());
+
+    // Claim a position whose slot the consumer has already handed back
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    TraceSlot* slot;
+    for (;;) {
+        slot = &slots[pos & mask];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence - pos);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The slot still holds an event from one lap ago: the ring is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->event = TraceEvent{timestamp,
+                             reinterpret_cast<uintptr_t>(address),
+                             reinterpret_cast<uintptr_t>(old_address),
+                             static_cast<uint64_t>(size),
+                             static_cast<uint32_t>(align),
+                             allocator,
+                             op,
+                             0};
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+size_t TraceBuffer::drain(TraceEvent* out, size_t max_events) {
+    size_t count = 0;
+    while (count < max_events) {
+        TraceSlot* slot = &slots[tail & mask];
+        if (slot->sequence.load(std::memory_order_acquire) != tail + 1) {
+            break;
+        }
+        out[count++] = slot->event;
+        // Hand the slot back for the position one lap ahead
+        slot->sequence.store(tail + mask + 1, std::memory_order_release);
+        ++tail;
+    }
+    return count;
+}
+
+std::expected<size_t, TraceError> TraceBuffer::flush(std::FILE* file) {
+    TraceEvent chunk[FLUSH_CHUNK];
+    size_t total = 0;
+    size_t count;
+    while ((count = drain(chunk, FLUSH_CHUNK)) > 0) {
+        if (std::fwrite(chunk, sizeof(TraceEvent), count, file) != count) {
+            return std::unexpected(TraceError::IoError);
+        }
+        total += count;
+    }
+    return total;
+}
+
+size_t TraceBuffer::capacity() const {
+    return mask + 1;
+}
+
+uint64_t TraceBuffer::dropped_events() const {
+    return dropped.load(std::memory_order_relaxed);
+}
+
+std::expected<void, TraceError> write_trace_header(std::FILE* file) {
+    TraceFileHeader header;
+    std::memcpy(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC));
+    header.version = TRACE_VERSION;
+    header.event_size = sizeof(TraceEvent);
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        return std::unexpected(TraceError::IoError);
+    }
+    return {};
+}
+
+std::expected<std::vector<TraceEvent>, TraceError> read_trace(std::FILE* file) {
+    TraceFileHeader header;
+    if (std::fread(&header, sizeof(header), 1, file) != 1) {
+        return std::unexpected(std::ferror(file) ? TraceError::IoError : TraceError::InvalidFormat);
+    }
+    if (std::memcmp(header.magic, TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0 || header.version != TRACE_VERSION ||
+        header.event_size != sizeof(TraceEvent)) {
+        return std::unexpected(TraceError::InvalidFormat);
+    }
+
+    std::vector<TraceEvent> events;
+    TraceEvent chunk[FLUSH_CHUNK];
+    size_t count;
+    while ((count = std::fread(chunk, sizeof(TraceEvent), FLUSH_CHUNK, file)) > 0) {
+        events.insert(events.end(), chunk, chunk + count);
+    }
+    if (std::ferror(file)) {
+        return std::unexpected(TraceError::IoError);
+    }
+    return events;
+}
+
+} // namespace memory
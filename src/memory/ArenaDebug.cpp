@@ -0,0 +1,109 @@
+#include "memory/ArenaDebug.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if MEMORY_HAS_ASAN
+#include <sanitizer/asan_interface.h>
+#endif
+
+namespace memory::detail {
+
+namespace {
+
+/**
+ * @brief Last bytes of every red zone, linking it to the one before
+ */
+struct GuardTrailer {
+    uint64_t prev_guard; ///< Offset one past the previous red zone, 0 if there is none
+    uint64_t data_end;   ///< Offset one past the allocation the red zone follows
+};
+
+constexpr size_t TRAILER_SIZE = sizeof(GuardTrailer);
+
+void poison(const void* ptr, size_t size) {
+#if MEMORY_HAS_ASAN
+    ASAN_POISON_MEMORY_REGION(ptr, size);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+void unpoison(const void* ptr, size_t size) {
+#if MEMORY_HAS_ASAN
+    ASAN_UNPOISON_MEMORY_REGION(ptr, size);
+#else
+    (void)ptr;
+    (void)size;
+#endif
+}
+
+[[noreturn]] void report_corruption(const char* what, const unsigned char* buf, size_t guard_end) {
+    std::fprintf(stderr, "memory: arena red zone ending at %p (offset %zu) %s\n",
+                 static_cast<const void*>(buf + guard_end), guard_end, what);
+    std::abort();
+}
+
+} // namespace
+
+void arena_poison(void* ptr, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    unpoison(ptr, size);
+    std::memset(ptr, ARENA_FREED_BYTE, size);
+    poison(ptr, size);
+}
+
+void arena_unpoison(void* ptr, size_t size) {
+    unpoison(ptr, size);
+}
+
+void arena_write_guard(unsigned char* buf, size_t data_end, size_t guard_end, size_t prev_guard) {
+    unpoison(buf + data_end, guard_end - data_end);
+    std::memset(buf + data_end, ARENA_GUARD_BYTE, guard_end - TRAILER_SIZE - data_end);
+    GuardTrailer trailer{prev_guard, data_end};
+    std::memcpy(buf + guard_end - TRAILER_SIZE, &trailer, TRAILER_SIZE);
+    poison(buf + data_end, guard_end - data_end);
+}
+
+size_t arena_prev_guard(const unsigned char* buf, size_t guard_end) {
+    GuardTrailer trailer;
+    unpoison(buf + guard_end - TRAILER_SIZE, TRAILER_SIZE);
+    std::memcpy(&trailer, buf + guard_end - TRAILER_SIZE, TRAILER_SIZE);
+    poison(buf + guard_end - TRAILER_SIZE, TRAILER_SIZE);
+    return static_cast<size_t>(trailer.prev_guard);
+}
+
+void arena_check_guards(const unsigned char* buf, size_t last_guard, size_t stop_guard) {
+    size_t guard_end = last_guard;
+    while (guard_end > stop_guard) {
+        if (guard_end < TRAILER_SIZE + ARENA_REDZONE_SIZE) {
+            report_corruption("is out of bounds (corrupted link)", buf, guard_end);
+        }
+
+        unpoison(buf + guard_end - TRAILER_SIZE, TRAILER_SIZE);
+        GuardTrailer trailer;
+        std::memcpy(&trailer, buf + guard_end - TRAILER_SIZE, TRAILER_SIZE);
+
+        // A sane trailer points backwards and leaves room for the guard bytes
+        size_t data_end = static_cast<size_t>(trailer.data_end);
+        if (trailer.prev_guard > data_end || data_end + ARENA_REDZONE_SIZE + TRAILER_SIZE > guard_end ||
+            arena_guard_end(data_end) != guard_end) {
+            report_corruption("has a corrupted trailer (overflow past the guard bytes?)", buf, guard_end);
+        }
+
+        unpoison(buf + data_end, guard_end - TRAILER_SIZE - data_end);
+        for (size_t i = data_end; i < guard_end - TRAILER_SIZE; ++i) {
+            if (buf[i] != ARENA_GUARD_BYTE) {
+                report_corruption("was overwritten (buffer overflow of the allocation before it)", buf, guard_end);
+            }
+        }
+        poison(buf + data_end, guard_end - data_end);
+
+        guard_end = static_cast<size_t>(trailer.prev_guard);
+    }
+}
+
+} // namespace memory::detail
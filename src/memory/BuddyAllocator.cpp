@@ -0,0 +1,372 @@
+#include "memory/BuddyAllocator.hpp"
+#include <bit>
+#include <cstring>
+
+namespace memory {
+
+namespace {
+
+// Nodes are numbered breadth first: level l, index i -> (2^l - 1) + i
+size_t node_id(size_t level, size_t index) {
+    return (static_cast<size_t>(1) << level) - 1 + index;
+}
+
+bool test_bit(const uint64_t* bits, size_t i) {
+    return (bits[i / 64] >> (i % 64)) & 1u;
+}
+
+void set_bit(uint64_t* bits, size_t i) {
+    bits[i / 64] |= static_cast<uint64_t>(1) << (i % 64);
+}
+
+void clear_bit(uint64_t* bits, size_t i) {
+    bits[i / 64] &= ~(static_cast<uint64_t>(1) << (i % 64));
+}
+
+size_t words_for(size_t bit_count) {
+    return (bit_count + 63) / 64;
+}
+
+size_t levels_for(size_t region_size, size_t min_block_size) {
+    return static_cast<size_t>(std::countr_zero(region_size) - std::countr_zero(min_block_size)) + 1;
+}
+
+// Free list nodes live inside the blocks, so the smallest block has to hold one
+size_t effective_min_block_size(size_t min_block_size) {
+    return min_block_size < sizeof(BuddyFreeNode) ? std::bit_ceil(sizeof(BuddyFreeNode)) : min_block_size;
+}
+
+} // namespace
+
+size_t BuddyAllocator::metadata_size(size_t region_size, size_t min_block_size) {
+    size_t levels = levels_for(region_size, min_block_size);
+    size_t inner_nodes = (static_cast<size_t>(1) << (levels - 1)) - 1;
+    size_t all_nodes = (static_cast<size_t>(1) << levels) - 1;
+    return (words_for(inner_nodes) + words_for(all_nodes)) * sizeof(uint64_t);
+}
+
+std::expected<BuddyAllocator, AllocatorError> BuddyAllocator::create(void* backing_buffer, size_t backing_buffer_length,
+                                                                     size_t min_block_size) {
+    if (backing_buffer == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (!LinearAllocator::is_power_of_two(min_block_size)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    min_block_size = effective_min_block_size(min_block_size);
+
+    // Align the region to the smallest block size
+    uintptr_t initial_start = reinterpret_cast<uintptr_t>(backing_buffer);
+    uintptr_t start = LinearAllocator::align_forward(initial_start, min_block_size).value();
+    size_t padding = static_cast<size_t>(start - initial_start);
+    if (backing_buffer_length < padding + min_block_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    size_t available = backing_buffer_length - padding;
+
+    // Largest power-of-two region that still leaves room for the bitmaps behind it
+    size_t region_size = std::bit_floor(available);
+    while (region_size >= min_block_size && region_size + metadata_size(region_size, min_block_size) > available) {
+        region_size >>= 1;
+    }
+    if (region_size < min_block_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    size_t levels = levels_for(region_size, min_block_size);
+    size_t inner_nodes = (static_cast<size_t>(1) << (levels - 1)) - 1;
+
+    BuddyAllocator b;
+    b.base = reinterpret_cast<unsigned char*>(start);
+    b.region_size = region_size;
+    b.min_block_size = min_block_size;
+    b.level_count = levels;
+    b.split_bits = reinterpret_cast<uint64_t*>(b.base + region_size);
+    b.free_bits = b.split_bits + words_for(inner_nodes);
+    b.free_all();
+    b.recorder = StatsRecorder();
+    return b;
+}
+
+std::expected<BuddyAllocator, AllocatorError> BuddyAllocator::create(LinearAllocator* arena, size_t region_size,
+                                                                     size_t min_block_size) {
+    if (arena == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (!LinearAllocator::is_power_of_two(min_block_size) || !LinearAllocator::is_power_of_two(region_size)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    min_block_size = effective_min_block_size(min_block_size);
+    if (region_size < min_block_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    size_t levels = levels_for(region_size, min_block_size);
+    size_t inner_nodes = (static_cast<size_t>(1) << (levels - 1)) - 1;
+
+    auto bitmap = arena->alloc_align_uninit(metadata_size(region_size, min_block_size), alignof(uint64_t));
+    if (!bitmap) {
+        return std::unexpected(bitmap.error());
+    }
+    auto region = arena->alloc_align_uninit(region_size, min_block_size);
+    if (!region) {
+        return std::unexpected(region.error());
+    }
+
+    BuddyAllocator b;
+    b.base = static_cast<unsigned char*>(region.value());
+    b.region_size = region_size;
+    b.min_block_size = min_block_size;
+    b.level_count = levels;
+    b.split_bits = static_cast<uint64_t*>(bitmap.value());
+    b.free_bits = b.split_bits + words_for(inner_nodes);
+    b.free_all();
+    b.recorder = StatsRecorder();
+    return b;
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // Blocks are aligned to their size relative to base, so a block is only as
+    // aligned as the base address allows
+    size_t base_alignment = static_cast<size_t>(1) << std::countr_zero(reinterpret_cast<uintptr_t>(base));
+    if (align > base_alignment) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    size_t needed = size > align ? size : align;
+    if (needed < min_block_size) {
+        needed = min_block_size;
+    }
+    if (needed > region_size) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Level whose blocks are the smallest power of two that fits
+    size_t target_size = std::bit_ceil(needed);
+    size_t target_level = static_cast<size_t>(std::countr_zero(region_size) - std::countr_zero(target_size));
+
+    // Find the nearest level at or above the target with a free block
+    size_t level = target_level + 1;
+    while (level > 0 && free_lists[level - 1] == nullptr) {
+        --level;
+    }
+    if (level == 0) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    --level;
+
+    size_t block = region_size >> level;
+    size_t index = static_cast<size_t>(reinterpret_cast<unsigned char*>(free_lists[level]) - base) / block;
+    remove_free(level, index);
+
+    // Split down to the target level, keeping the right halves free
+    while (level < target_level) {
+        set_bit(split_bits, node_id(level, index));
+        ++level;
+        index *= 2;
+        push_free(level, index + 1);
+    }
+
+    used += target_size;
+    recorder.record_alloc(size, target_size - size);
+    recorder.record_in_use(used);
+    return static_cast<void*>(base + index * target_size);
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::alloc(size_t size) {
+    return alloc_align(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::resize_align(void* old_memory, size_t old_size,
+                                                                size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                       size_t new_size, size_t align) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (old_mem == nullptr) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    if (old_mem < base || old_mem >= base + region_size) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (try_resize_in_place(old_memory, old_size, new_size)) {
+        return old_memory;
+    }
+
+    // Outgrew the block, move to a bigger one
+    auto new_memory_result = alloc_align_uninit(new_size, align);
+    if (!new_memory_result) {
+        return std::unexpected(new_memory_result.error());
+    }
+
+    void* new_memory = new_memory_result.value();
+    size_t copy_size = (old_size < new_size) ? old_size : new_size;
+    std::memcpy(new_memory, old_memory, copy_size);
+    free(old_memory);
+    recorder.record_resize(false);
+    return new_memory;
+}
+
+std::expected<void*, AllocatorError> BuddyAllocator::resize(void* old_memory, size_t old_size, size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+bool BuddyAllocator::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    auto size_result = block_size(old_memory);
+    if (!size_result || new_size > size_result.value()) {
+        return false;
+    }
+    recorder.record_resize(true);
+    return true;
+}
+
+std::expected<void, AllocatorError> BuddyAllocator::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p < base || p >= base + region_size) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    size_t offset = static_cast<size_t>(p - base);
+    size_t level = 0;
+    size_t index = 0;
+    find_block(offset, level, index);
+
+    size_t block = region_size >> level;
+    if (offset != index * block) {
+        // Not the start of a block
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (test_bit(free_bits, node_id(level, index))) {
+        // Allow double frees
+        return {};
+    }
+    used -= block;
+
+    // Merge with the buddy for as long as it is free
+    while (level > 0) {
+        size_t buddy = index ^ 1;
+        if (!test_bit(free_bits, node_id(level, buddy))) {
+            break;
+        }
+        remove_free(level, buddy);
+        --level;
+        index >>= 1;
+        clear_bit(split_bits, node_id(level, index));
+    }
+
+    push_free(level, index);
+    recorder.record_free();
+    recorder.record_in_use(used);
+    return {};
+}
+
+void BuddyAllocator::free_all() {
+    size_t inner_nodes = (static_cast<size_t>(1) << (level_count - 1)) - 1;
+    size_t all_nodes = (static_cast<size_t>(1) << level_count) - 1;
+    std::memset(split_bits, 0, words_for(inner_nodes) * sizeof(uint64_t));
+    std::memset(free_bits, 0, words_for(all_nodes) * sizeof(uint64_t));
+    for (size_t i = 0; i < MAX_LEVELS; ++i) {
+        free_lists[i] = nullptr;
+    }
+
+    used = 0;
+    push_free(0, 0);
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats BuddyAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+std::expected<size_t, AllocatorError> BuddyAllocator::block_size(const void* ptr) const {
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    if (p == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (p < base || p >= base + region_size) {
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    size_t level = 0;
+    size_t index = 0;
+    find_block(static_cast<size_t>(p - base), level, index);
+    return region_size >> level;
+}
+
+void BuddyAllocator::find_block(size_t offset, size_t& level, size_t& index) const {
+    // Walk down through split blocks; the first unsplit block holds the pointer
+    level = 0;
+    index = 0;
+    while (level + 1 < level_count && test_bit(split_bits, node_id(level, index))) {
+        ++level;
+        index = offset / (region_size >> level);
+    }
+}
+
+void BuddyAllocator::push_free(size_t level, size_t index) {
+    BuddyFreeNode* node = reinterpret_cast<BuddyFreeNode*>(base + index * (region_size >> level));
+    node->prev = nullptr;
+    node->next = free_lists[level];
+    if (node->next) {
+        node->next->prev = node;
+    }
+    free_lists[level] = node;
+    set_bit(free_bits, node_id(level, index));
+}
+
+void BuddyAllocator::remove_free(size_t level, size_t index) {
+    BuddyFreeNode* node = reinterpret_cast<BuddyFreeNode*>(base + index * (region_size >> level));
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        free_lists[level] = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    clear_bit(free_bits, node_id(level, index));
+}
+
+} // namespace memory
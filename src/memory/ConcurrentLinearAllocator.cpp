@@ -0,0 +1,198 @@
+#include "memory/ConcurrentLinearAllocator.hpp"
+#include <cstring>
+
+namespace memory {
+
+namespace {
+
+constexpr uint64_t OFFSET_MASK = (static_cast<uint64_t>(1) << ConcurrentLinearAllocator::OFFSET_BITS) - 1;
+
+size_t offset_of(uint64_t state) {
+    return static_cast<size_t>(state & OFFSET_MASK);
+}
+
+uint64_t with_offset(uint64_t state, size_t offset) {
+    return (state & ~OFFSET_MASK) | static_cast<uint64_t>(offset);
+}
+
+} // namespace
+
+ConcurrentLinearAllocator ConcurrentLinearAllocator::create(void* backing_buffer, size_t backing_buffer_length) {
+    return ConcurrentLinearAllocator(static_cast<unsigned char*>(backing_buffer), backing_buffer_length);
+}
+
+std::expected<ConcurrentLinearAllocator, AllocatorError> ConcurrentLinearAllocator::create(LinearAllocator* arena,
+                                                                                           size_t region_size) {
+    if (arena == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    auto region = arena->alloc_align_uninit(region_size, DEFAULT_ALIGNMENT);
+    if (!region) {
+        return std::unexpected(region.error());
+    }
+    return create(region.value(), region_size);
+}
+
+ConcurrentLinearAllocator::ConcurrentLinearAllocator(unsigned char* buffer, size_t length)
+    : buf(buffer), buf_len(length < MAX_CAPACITY ? length : MAX_CAPACITY), state(0) {}
+
+ConcurrentLinearAllocator::ConcurrentLinearAllocator(ConcurrentLinearAllocator&& other) noexcept
+    : buf(other.buf), buf_len(other.buf_len), state(other.state.load(std::memory_order_relaxed)),
+      recorder(other.recorder) {}
+
+ConcurrentLinearAllocator& ConcurrentLinearAllocator::operator=(ConcurrentLinearAllocator&& other) noexcept {
+    buf = other.buf;
+    buf_len = other.buf_len;
+    state.store(other.state.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    recorder = other.recorder;
+    return *this;
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // Padding depends on the offset we start from, so recompute it on every retry
+    uint64_t current = state.load(std::memory_order_relaxed);
+    size_t offset;
+    do {
+        uintptr_t curr_ptr = reinterpret_cast<uintptr_t>(buf) + static_cast<uintptr_t>(offset_of(current));
+        offset = static_cast<size_t>(LinearAllocator::align_forward(curr_ptr, align).value() -
+                                     reinterpret_cast<uintptr_t>(buf));
+        if (offset > buf_len || size > buf_len - offset) {
+            recorder.record_failure();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+    } while (!state.compare_exchange_weak(current, with_offset(current, offset + size),
+                                          std::memory_order_relaxed, std::memory_order_relaxed));
+
+    recorder.record_alloc(size, offset - offset_of(current));
+    recorder.record_in_use(offset + size);
+    return static_cast<void*>(buf + offset);
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::alloc(size_t size) {
+    return alloc_align(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::resize_align(void* old_memory, size_t old_size,
+                                                                          size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                                 size_t new_size, size_t align) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (old_mem == nullptr || old_size == 0) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    if (old_mem < buf || old_mem >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (try_resize_in_place(old_memory, old_size, new_size)) {
+        return old_memory;
+    }
+
+    if (new_size <= old_size) {
+        // Someone allocated after us; the tail can't be given back but the block is big enough
+        recorder.record_resize(true);
+        return old_memory;
+    }
+
+    auto new_memory_result = alloc_align_uninit(new_size, align);
+    if (!new_memory_result) {
+        return std::unexpected(new_memory_result.error());
+    }
+
+    void* new_memory = new_memory_result.value();
+    std::memcpy(new_memory, old_memory, old_size);
+    recorder.record_resize(false);
+    return new_memory;
+}
+
+std::expected<void*, AllocatorError> ConcurrentLinearAllocator::resize(void* old_memory, size_t old_size,
+                                                                    size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, DEFAULT_ALIGNMENT);
+}
+
+bool ConcurrentLinearAllocator::try_resize_in_place(void* old_memory, size_t old_size, size_t new_size) {
+    return try_resize_in_place(old_memory, old_size, new_size, epoch());
+}
+
+bool ConcurrentLinearAllocator::try_resize_in_place(void* old_memory, size_t old_size, size_t new_size,
+                                                    uint64_t alloc_epoch) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+    if (old_mem == nullptr || old_mem < buf || old_mem > buf + buf_len) {
+        return false;
+    }
+
+    size_t start = static_cast<size_t>(old_mem - buf);
+    if (old_size > buf_len - start || new_size > buf_len - start) {
+        return false;
+    }
+
+    // Only the allocation ending at the current offset can move the offset, and only
+    // within its own epoch; the CAS fails if another thread allocated or reset since
+    uint64_t current = (alloc_epoch << OFFSET_BITS) | static_cast<uint64_t>(start + old_size);
+    if (!state.compare_exchange_strong(current, with_offset(current, start + new_size),
+                                       std::memory_order_relaxed, std::memory_order_relaxed)) {
+        return false;
+    }
+    recorder.record_resize(true);
+    recorder.record_in_use(start + new_size);
+    return true;
+}
+
+void ConcurrentLinearAllocator::free_all() {
+    // New epoch, offset back to zero
+    uint64_t current = state.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+        next = ((current >> OFFSET_BITS) + 1) << OFFSET_BITS;
+    } while (!state.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_relaxed));
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats ConcurrentLinearAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+uint64_t ConcurrentLinearAllocator::epoch() const {
+    return state.load(std::memory_order_acquire) >> OFFSET_BITS;
+}
+
+size_t ConcurrentLinearAllocator::used() const {
+    return offset_of(state.load(std::memory_order_relaxed));
+}
+
+} // namespace memory
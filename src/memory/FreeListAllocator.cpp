@@ -0,0 +1,332 @@
+#include "memory/FreeListAllocator.hpp"
+#include <cstring>
+
+namespace memory {
+
+namespace {
+
+// Block starts and sizes are kept aligned so a free list node fits anywhere
+constexpr size_t NODE_ALIGNMENT = alignof(FreeListNode);
+
+size_t round_to_node_alignment(size_t n) {
+    return (n + NODE_ALIGNMENT - 1) & ~(NODE_ALIGNMENT - 1);
+}
+
+// Bytes from ptr to the first address aligned to 'align' that leaves room for a header
+size_t padding_with_header(uintptr_t ptr, size_t align) {
+    uintptr_t aligned = LinearAllocator::align_forward(ptr + sizeof(FreeListAllocationHeader), align).value();
+    return static_cast<size_t>(aligned - ptr);
+}
+
+// Block size needed for an allocation; zero-sized allocations still get a byte so the
+// user pointer always lies inside its block (and inside the buffer)
+size_t block_size_for(size_t padding, size_t size) {
+    return round_to_node_alignment(padding + (size != 0 ? size : 1));
+}
+
+FreeListAllocationHeader* header_of(void* ptr) {
+    return reinterpret_cast<FreeListAllocationHeader*>(static_cast<unsigned char*>(ptr) - sizeof(FreeListAllocationHeader));
+}
+
+} // namespace
+
+std::expected<FreeListAllocator, AllocatorError> FreeListAllocator::create(void* backing_buffer, size_t backing_buffer_length,
+                                                                           PlacementPolicy policy) {
+    if (backing_buffer == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    // Align the start so the first free list node is aligned
+    uintptr_t initial_start = reinterpret_cast<uintptr_t>(backing_buffer);
+    uintptr_t start = LinearAllocator::align_forward(initial_start, NODE_ALIGNMENT).value();
+    size_t padding = static_cast<size_t>(start - initial_start);
+
+    if (backing_buffer_length < padding + sizeof(FreeListNode)) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    FreeListAllocator f;
+    f.buf = reinterpret_cast<unsigned char*>(start);
+    f.buf_len = (backing_buffer_length - padding) & ~(NODE_ALIGNMENT - 1);
+    f.used = 0;
+    f.head = nullptr;
+    f.policy = policy;
+    f.free_all();
+    f.recorder = StatsRecorder();
+    return f;
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (size > buf_len) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // The header in front of the allocation must be aligned as well
+    if (align < alignof(FreeListAllocationHeader)) {
+        align = alignof(FreeListAllocationHeader);
+    }
+
+    // Find a free block according to the placement policy
+    FreeListNode* best = nullptr;
+    FreeListNode* best_prev = nullptr;
+    size_t best_padding = 0;
+    size_t best_required = 0;
+
+    FreeListNode* prev = nullptr;
+    for (FreeListNode* node = head; node != nullptr; prev = node, node = node->next) {
+        size_t padding = padding_with_header(reinterpret_cast<uintptr_t>(node), align);
+        size_t required = block_size_for(padding, size);
+        if (node->block_size < required) {
+            continue;
+        }
+
+        if (best == nullptr || node->block_size < best->block_size) {
+            best = node;
+            best_prev = prev;
+            best_padding = padding;
+            best_required = required;
+        }
+
+        if (policy == PlacementPolicy::FirstFit || node->block_size == required) {
+            break;
+        }
+    }
+
+    if (best == nullptr) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Split off the remainder if it can hold a free block of its own
+    unsigned char* block = reinterpret_cast<unsigned char*>(best);
+    FreeListNode* next = best->next;
+    size_t remaining = best->block_size - best_required;
+    if (remaining >= sizeof(FreeListNode)) {
+        FreeListNode* rest = reinterpret_cast<FreeListNode*>(block + best_required);
+        rest->block_size = remaining;
+        rest->next = next;
+        next = rest;
+    } else {
+        best_required = best->block_size;
+    }
+
+    // Unlink the chosen block
+    if (best_prev) {
+        best_prev->next = next;
+    } else {
+        head = next;
+    }
+
+    void* ptr = block + best_padding;
+    FreeListAllocationHeader* header = header_of(ptr);
+    header->block_size = best_required;
+    header->padding = best_padding;
+    used += best_required;
+    recorder.record_alloc(size, best_required - size);
+    recorder.record_in_use(used);
+    return ptr;
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::alloc(size_t size) {
+    return alloc_align(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::resize_align(void* old_memory, size_t old_size,
+                                                                   size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                          size_t new_size, size_t align) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // Zero-sized allocations still own a block, so only nullptr means "allocate"
+    if (old_mem == nullptr) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    if (old_mem < buf || old_mem >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (try_resize_in_place(old_memory, old_size, new_size)) {
+        return old_memory;
+    }
+
+    // The next block is taken (or too small), move to a new block
+    auto new_memory_result = alloc_align_uninit(new_size, align);
+    if (!new_memory_result) {
+        return std::unexpected(new_memory_result.error());
+    }
+
+    void* new_memory = new_memory_result.value();
+    size_t copy_size = (old_size < new_size) ? old_size : new_size;
+    std::memcpy(new_memory, old_memory, copy_size);
+    free(old_memory);
+    recorder.record_resize(false);
+    return new_memory;
+}
+
+std::expected<void*, AllocatorError> FreeListAllocator::resize(void* old_memory, size_t old_size, size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, DEFAULT_ALIGNMENT);
+}
+
+bool FreeListAllocator::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+    if (old_mem == nullptr || old_mem < buf || old_mem >= buf + buf_len || new_size > buf_len) {
+        return false;
+    }
+
+    FreeListAllocationHeader* header = header_of(old_memory);
+    unsigned char* block = old_mem - header->padding;
+    size_t required = block_size_for(header->padding, new_size);
+
+    if (required <= header->block_size) {
+        // Shrinking: hand the tail back if it can form a free block
+        size_t tail = header->block_size - required;
+        if (tail >= sizeof(FreeListNode)) {
+            header->block_size = required;
+            used -= tail;
+            insert_free_block(block + required, tail);
+        }
+        recorder.record_resize(true);
+        recorder.record_in_use(used);
+        return true;
+    }
+
+    // Growing: the free block directly after this one has to make up the difference
+    unsigned char* block_end = block + header->block_size;
+    FreeListNode* prev = nullptr;
+    FreeListNode* node = head;
+    while (node != nullptr && reinterpret_cast<unsigned char*>(node) < block_end) {
+        prev = node;
+        node = node->next;
+    }
+
+    if (node == nullptr || reinterpret_cast<unsigned char*>(node) != block_end) {
+        return false;
+    }
+
+    size_t total = header->block_size + node->block_size;
+    if (total < required) {
+        return false;
+    }
+
+    // Take what we need from the neighbour and keep the rest free
+    FreeListNode* next = node->next;
+    size_t remaining = total - required;
+    if (remaining >= sizeof(FreeListNode)) {
+        FreeListNode* rest = reinterpret_cast<FreeListNode*>(block + required);
+        rest->block_size = remaining;
+        rest->next = next;
+        next = rest;
+    } else {
+        required = total;
+    }
+
+    if (prev) {
+        prev->next = next;
+    } else {
+        head = next;
+    }
+
+    used += required - header->block_size;
+    header->block_size = required;
+    recorder.record_resize(true);
+    recorder.record_in_use(used);
+    return true;
+}
+
+std::expected<void, AllocatorError> FreeListAllocator::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p < buf || p >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    const FreeListAllocationHeader* header = header_of(ptr);
+    size_t block_size = header->block_size;
+    used -= block_size;
+    insert_free_block(p - header->padding, block_size);
+    recorder.record_free();
+    recorder.record_in_use(used);
+    return {};
+}
+
+void FreeListAllocator::free_all() {
+    used = 0;
+    head = reinterpret_cast<FreeListNode*>(buf);
+    head->block_size = buf_len;
+    head->next = nullptr;
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats FreeListAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+void FreeListAllocator::insert_free_block(unsigned char* block, size_t block_size) {
+    // Find the neighbours in the address-ordered list
+    FreeListNode* prev = nullptr;
+    FreeListNode* node = head;
+    while (node != nullptr && reinterpret_cast<unsigned char*>(node) < block) {
+        prev = node;
+        node = node->next;
+    }
+
+    FreeListNode* free_node = reinterpret_cast<FreeListNode*>(block);
+    free_node->block_size = block_size;
+    free_node->next = node;
+    if (prev) {
+        prev->next = free_node;
+    } else {
+        head = free_node;
+    }
+
+    // Coalesce with the following block
+    if (node != nullptr && block + block_size == reinterpret_cast<unsigned char*>(node)) {
+        free_node->block_size += node->block_size;
+        free_node->next = node->next;
+    }
+
+    // Coalesce with the preceding block
+    if (prev != nullptr && reinterpret_cast<unsigned char*>(prev) + prev->block_size == block) {
+        prev->block_size += free_node->block_size;
+        prev->next = free_node->next;
+    }
+}
+
+} // namespace memory
@@ -0,0 +1,170 @@
+#include "memory/HeapAllocator.hpp"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32) || defined(__GLIBC__)
+#include <malloc.h>
+#elif defined(__APPLE__)
+#include <malloc/malloc.h>
+#endif
+
+namespace memory {
+
+namespace {
+
+// Memory from the aligned heap has to go back through the matching free on Windows,
+// so every allocation takes the same path there
+void* heap_alloc(size_t size, size_t align) {
+#if defined(_WIN32)
+    return _aligned_malloc(size, align);
+#else
+    if (align <= alignof(std::max_align_t)) {
+        return std::malloc(size);
+    }
+    // aligned_alloc wants the size to be a multiple of the alignment
+    return std::aligned_alloc(align, (size + align - 1) & ~(align - 1));
+#endif
+}
+
+void heap_free(void* ptr) {
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+// One set of counters for the whole process, HeapAllocator itself holds no state
+StatsRecorder heap_recorder;
+
+} // namespace
+
+std::expected<void*, AllocatorError> HeapAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // Zero-sized requests still get a unique pointer
+    void* ptr = heap_alloc(size != 0 ? size : 1, align);
+    if (ptr == nullptr) {
+        heap_recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    if constexpr (STATS_ENABLED) {
+        heap_recorder.record_alloc(size);
+        heap_recorder.add_in_use(usable_size(ptr, size, align));
+    }
+    return ptr;
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::alloc(size_t size) {
+    return alloc_align(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::resize_align(void* old_memory, size_t old_size,
+                                                              size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                     size_t new_size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (old_memory == nullptr) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    size_t size = new_size != 0 ? new_size : 1;
+    size_t old_usable = 0;
+    if constexpr (STATS_ENABLED) {
+        old_usable = usable_size(old_memory, old_size, align);
+    }
+#if defined(_WIN32)
+    void* ptr = _aligned_realloc(old_memory, size, align);
+#else
+    void* ptr = nullptr;
+    if (align <= alignof(std::max_align_t)) {
+        ptr = std::realloc(old_memory, size);
+    } else {
+        // realloc only guarantees the fundamental alignment, move by hand
+        ptr = heap_alloc(size, align);
+        if (ptr != nullptr) {
+            std::memcpy(ptr, old_memory, old_size < new_size ? old_size : new_size);
+            heap_free(old_memory);
+        }
+    }
+#endif
+    if (ptr == nullptr) {
+        // The old block is untouched
+        heap_recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    if constexpr (STATS_ENABLED) {
+        heap_recorder.record_resize(ptr == old_memory);
+        heap_recorder.sub_in_use(old_usable);
+        heap_recorder.add_in_use(usable_size(ptr, size, align));
+    }
+    return ptr;
+}
+
+std::expected<void*, AllocatorError> HeapAllocator::resize(void* old_memory, size_t old_size, size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, DEFAULT_ALIGNMENT);
+}
+
+size_t HeapAllocator::usable_size(void* ptr, size_t size, size_t align) const {
+    if (ptr == nullptr) {
+        return 0;
+    }
+#if defined(_WIN32)
+    size_t usable = _aligned_msize(ptr, align, 0);
+#elif defined(__GLIBC__)
+    (void)align;
+    size_t usable = malloc_usable_size(ptr);
+#elif defined(__APPLE__)
+    (void)align;
+    size_t usable = malloc_size(ptr);
+#else
+    (void)align;
+    size_t usable = size;
+#endif
+    return usable > size ? usable : size;
+}
+
+std::expected<void, AllocatorError> HeapAllocator::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if constexpr (STATS_ENABLED) {
+        heap_recorder.record_free();
+        heap_recorder.sub_in_use(usable_size(ptr, 0, DEFAULT_ALIGNMENT));
+    }
+    heap_free(ptr);
+    return {};
+}
+
+AllocatorStats HeapAllocator::stats() const {
+    return heap_recorder.snapshot();
+}
+
+} // namespace memory
@@ -1,40 +1,123 @@
 #include "memory/LinearAllocator.hpp"
+#include "memory/VirtualArena.hpp"
+#include "memory/VirtualMemory.hpp"
 #include <cstring>
 
 namespace memory {
 
+namespace {
+
+// commit_step is a page multiple but not necessarily a power of two, so no mask
+size_t round_up_to_step(size_t value, size_t step) {
+    return (value + step - 1) / step * step;
+}
+
+} // namespace
+
 LinearAllocator LinearAllocator::create(void* backing_buffer, size_t backing_buffer_length) {
     LinearAllocator a;
     a.buf = static_cast<unsigned char*>(backing_buffer);
     a.buf_len = backing_buffer_length;
     a.curr_offset = 0;
     a.prev_offset = 0;
+    a.committed = backing_buffer_length;
+    a.commit_step = 0;
+    a.retain_committed = backing_buffer_length;
     return a;
 }
 
-bool LinearAllocator::is_power_of_two(uintptr_t x) {
-    return (x & (x-1)) == 0 && x != 0;
+std::expected<LinearAllocator, AllocatorError> LinearAllocator::create_reserved(size_t reserve_size,
+                                                                               const ReserveOptions& options) {
+    // Commit in whole (huge) pages
+    size_t granularity = options.huge_pages == HugePageMode::Off ? VirtualMemory::page_size()
+                                                                 : VirtualMemory::huge_page_size();
+    // A node that cannot hold pages is a caller error, not a missing feature
+    if ((options.numa.policy == NumaPolicy::Bind || options.numa.policy == NumaPolicy::Preferred) &&
+        !VirtualMemory::numa_node_has_memory(options.numa.node)) {
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    size_t step = options.commit_step < granularity ? granularity : options.commit_step;
+    step = (step + granularity - 1) & ~(granularity - 1);
+    reserve_size = round_up_to_step(reserve_size, step);
+
+    auto reserved = VirtualMemory::reserve(reserve_size, options.huge_pages);
+    if (!reserved) {
+        return std::unexpected(reserved.error());
+    }
+    // Nothing is committed yet, so the policy covers every page the arena will touch
+    bool placed = VirtualMemory::place_on_numa(reserved.value(), reserve_size, options.numa);
+
+    LinearAllocator a = create(reserved.value(), reserve_size);
+    a.committed = 0;
+    a.commit_step = step;
+    a.retain_committed = options.retain_committed;
+    if (!placed) {
+        // The arena still works from ordinary memory, but the miss shows up in stats()
+        a.recorder.record_failure();
+    }
+    return a;
 }
 
-std::expected<uintptr_t, AllocatorError> LinearAllocator::align_forward(uintptr_t ptr, size_t align) {
-    if (!is_power_of_two(align)) {
-        return std::unexpected(AllocatorError::InvalidAlignment);
+void LinearAllocator::destroy() {
+    if constexpr (ARENA_DEBUG_ENABLED) {
+        if (buf != nullptr) {
+            detail::arena_unpoison(buf, committed);
+        }
     }
+    if (commit_step != 0 && buf != nullptr) {
+        VirtualMemory::release(buf, buf_len);
+        *this = create(nullptr, 0);
+    }
+}
 
-    uintptr_t p = ptr;
-    uintptr_t a = static_cast<uintptr_t>(align);
-    // Same as (p % a) but faster as 'a' is a power of two
-    uintptr_t modulo = p & (a-1);
+bool LinearAllocator::ensure_committed(size_t end) {
+    if (end <= committed) {
+        return true;
+    }
 
-    if (modulo != 0) {
-        // If 'p' address is not aligned, push the address to the
-        // next value which is aligned
-        p += a - modulo;
+    // Commit in large steps so the syscall is amortized over many allocations
+    size_t new_committed = round_up_to_step(end, commit_step);
+    if (new_committed > buf_len) {
+        new_committed = buf_len;
     }
-    return p;
+
+    if (!VirtualMemory::commit(buf + committed, new_committed - committed)) {
+        return false;
+    }
+    committed = new_committed;
+    return true;
+}
+
+void LinearAllocator::trim_committed() {
+    if (commit_step == 0) {
+        return;
+    }
+
+    // Keep everything in use plus the retained high-water mark
+    size_t keep = curr_offset > retain_committed ? curr_offset : retain_committed;
+    if (keep >= committed) {
+        return;
+    }
+    keep = round_up_to_step(keep, commit_step);
+    if (keep >= committed) {
+        return;
+    }
+
+    VirtualMemory::decommit(buf + keep, committed - keep);
+    committed = keep;
 }
 
 std::expected<void*, AllocatorError> LinearAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> LinearAllocator::alloc_align_uninit(size_t size, size_t align) {
     // Align 'curr_offset' forward to the specified alignment
     uintptr_t curr_ptr = reinterpret_cast<uintptr_t>(buf) + static_cast<uintptr_t>(curr_offset);
 
@@ -47,17 +130,38 @@ std::expected<void*, AllocatorError> LinearAllocator::alloc_align(size_t size, s
     offset -= reinterpret_cast<uintptr_t>(buf); // Change to relative offset
 
     // Check to see if the backing memory has space left
-    if (offset + size <= buf_len) {
+    if (offset <= buf_len && size <= buf_len - offset) {
+        // Debug builds follow every allocation with a red zone
+        size_t end = offset + size;
+        if constexpr (ARENA_DEBUG_ENABLED) {
+            end = detail::arena_guard_end(end);
+            if (end > buf_len) {
+                recorder.record_failure();
+                return std::unexpected(AllocatorError::OutOfMemory);
+            }
+        }
+
+        // Reserved buffers commit lazily as the offset moves forward
+        if (!ensure_committed(end)) {
+            recorder.record_failure();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+
         void* ptr = &buf[offset];
+#if MEMORY_ARENA_DEBUG
+        detail::arena_unpoison(ptr, size);
+        detail::arena_write_guard(buf, offset + size, end, debug.last_guard);
+        debug.last_guard = end;
+#endif
+        recorder.record_alloc(size, offset - curr_offset);
         prev_offset = offset;
-        curr_offset = offset + size;
-
-        // Zero new memory by default
-        std::memset(ptr, 0, size);
+        curr_offset = end;
+        recorder.record_in_use(curr_offset);
         return ptr;
     }
 
     // Return error if the arena is out of memory
+    recorder.record_failure();
     return std::unexpected(AllocatorError::OutOfMemory);
 }
 
@@ -65,8 +169,23 @@ std::expected<void*, AllocatorError> LinearAllocator::alloc(size_t size) {
     return alloc_align(size, DEFAULT_ALIGNMENT);
 }
 
+std::expected<void*, AllocatorError> LinearAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, DEFAULT_ALIGNMENT);
+}
+
 std::expected<void*, AllocatorError> LinearAllocator::resize_align(void* old_memory, size_t old_size,
                                                                  size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (old_size is 0 for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> LinearAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                        size_t new_size, size_t align) {
     unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
 
     if (!is_power_of_two(align)) {
@@ -74,30 +193,24 @@ std::expected<void*, AllocatorError> LinearAllocator::resize_align(void* old_mem
     }
 
     if (old_mem == nullptr || old_size == 0) {
-        return alloc_align(new_size, align);
+        return alloc_align_uninit(new_size, align);
     }
     else if (buf <= old_mem && old_mem < buf + buf_len) {
         if (buf + prev_offset == old_mem) {
             // This was the previous allocation, we can resize in place
-            curr_offset = prev_offset + new_size;
-
-            // Check if we're still within buffer bounds
-            if (curr_offset > buf_len) {
+            if (!try_resize_in_place(old_memory, old_size, new_size)) {
+                recorder.record_failure();
                 return std::unexpected(AllocatorError::OutOfMemory);
             }
-
-            if (new_size > old_size) {
-                // Zero the new memory by default
-                std::memset(&buf[prev_offset + old_size], 0, new_size - old_size);
-            }
             return old_memory;
         }
         else {
             // Not the previous allocation, allocate new memory and copy
-            auto new_memory_result = alloc_align(new_size, align);
+            auto new_memory_result = alloc_align_uninit(new_size, align);
             if (!new_memory_result) {
                 return std::unexpected(new_memory_result.error());
             }
+            recorder.record_resize(false);
 
             void* new_memory = new_memory_result.value();
             size_t copy_size = (old_size < new_size) ? old_size : new_size;
@@ -117,29 +230,117 @@ std::expected<void*, AllocatorError> LinearAllocator::resize(void* old_memory, s
     return resize_align(old_memory, old_size, new_size, DEFAULT_ALIGNMENT);
 }
 
-std::expected<void, AllocatorError> LinearAllocator::free(void* ptr) {
+bool LinearAllocator::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    // Only the most recent allocation can grow or shrink in place
+    if (old_mem == nullptr || buf + prev_offset != old_mem) {
+        return false;
+    }
+
+    // Check if we're still within buffer bounds before touching any state
+    if (new_size > buf_len - prev_offset) {
+        return false;
+    }
+    size_t end = prev_offset + new_size;
+    if constexpr (ARENA_DEBUG_ENABLED) {
+        end = detail::arena_guard_end(end);
+    }
+    if (end > buf_len || !ensure_committed(end)) {
+        return false;
+    }
+
+#if MEMORY_ARENA_DEBUG
+    // Move the red zone behind the new end, checking the old one on the way
+    size_t prev_guard = 0;
+    if (debug.last_guard != 0) {
+        prev_guard = detail::arena_prev_guard(buf, debug.last_guard);
+        detail::arena_check_guards(buf, debug.last_guard, prev_guard);
+    }
+    if (end < curr_offset) {
+        detail::arena_poison(buf + end, curr_offset - end);
+    }
+    detail::arena_unpoison(old_mem, new_size);
+    detail::arena_write_guard(buf, prev_offset + new_size, end, prev_guard);
+    debug.last_guard = end;
+#endif
+
+    curr_offset = end;
+    recorder.record_resize(true);
+    recorder.record_in_use(curr_offset);
+    return true;
+}
+
+std::expected<void, AllocatorError> LinearAllocator::free(void* /*ptr*/) {
     // Linear allocators don't support individual deallocation
     // This function exists for interface completeness
     return {};
 }
 
 void LinearAllocator::free_all() {
-    curr_offset = 0;
-    prev_offset = 0;
+    rollback(0, 0, ArenaDebugState{});
+    recorder.record_reset();
+    recorder.record_in_use(0);
+    trim_committed();
+}
+
+AllocatorStats LinearAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+void LinearAllocator::rollback(size_t saved_prev_offset, size_t saved_curr_offset,
+                               [[maybe_unused]] const ArenaDebugState& saved_debug) {
+#if MEMORY_ARENA_DEBUG
+    // Catch overflows before the evidence is rolled back, then poison the stale memory
+    detail::arena_check_guards(buf, debug.last_guard, saved_debug.last_guard);
+    if (curr_offset > saved_curr_offset) {
+        detail::arena_poison(buf + saved_curr_offset, curr_offset - saved_curr_offset);
+    }
+    debug = saved_debug;
+#endif
+    prev_offset = saved_prev_offset;
+    curr_offset = saved_curr_offset;
+}
+
+void LinearAllocator::check_guards() const {
+#if MEMORY_ARENA_DEBUG
+    detail::arena_check_guards(buf, debug.last_guard, 0);
+#endif
 }
 
 // TempArenaMemory implementation
 TempArenaMemory TempArenaMemory::begin(LinearAllocator* a) {
     TempArenaMemory temp;
     temp.arena = a;
+    temp.chain = nullptr;
+    temp.block = nullptr;
     temp.prev_offset = a->prev_offset;
     temp.curr_offset = a->curr_offset;
+    temp.debug = a->debug;
     return temp;
 }
 
+std::expected<void*, AllocatorError> TempArenaMemory::alloc_align(size_t size, size_t align) {
+    if (chain) {
+        return chain->alloc_align_uninit(size, align);
+    }
+    return arena->alloc_align_uninit(size, align);
+}
+
+std::expected<void*, AllocatorError> TempArenaMemory::alloc(size_t size) {
+    return alloc_align(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
 void TempArenaMemory::end() {
-    arena->prev_offset = prev_offset;
-    arena->curr_offset = curr_offset;
+    if (chain) {
+        // Chained arenas may have moved on to newer blocks since begin
+        chain->rewind(block, prev_offset, curr_offset, debug);
+        return;
+    }
+    arena->rollback(prev_offset, curr_offset, debug);
+    arena->recorder.record_reset();
+    arena->recorder.record_in_use(curr_offset);
+    arena->trim_committed();
 }
 
 } // namespace memory
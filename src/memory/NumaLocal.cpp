@@ -0,0 +1,26 @@
+#include "memory/NumaLocal.hpp"
+
+#include <cstdint>
+
+namespace memory {
+
+namespace {
+
+// SIZE_MAX until the thread first asks
+thread_local size_t tls_numa_node = SIZE_MAX;
+
+} // namespace
+
+size_t thread_numa_node() {
+    if (tls_numa_node == SIZE_MAX) {
+        tls_numa_node = VirtualMemory::current_numa_node();
+    }
+    return tls_numa_node;
+}
+
+size_t refresh_thread_numa_node() {
+    tls_numa_node = VirtualMemory::current_numa_node();
+    return tls_numa_node;
+}
+
+} // namespace memory
@@ -0,0 +1,283 @@
+#include "memory/PersistentArena.hpp"
+#include "memory/VirtualMemory.hpp"
+
+#include <bit>
+#include <cstring>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace memory {
+
+namespace {
+
+constexpr char MAGIC[8] = {'M', 'E', 'M', 'A', 'R', 'E', 'N', 'A'};
+
+static_assert(sizeof(PersistentArenaHeader) <= PersistentArena::DATA_OFFSET,
+              "Header has to fit in front of the data region");
+
+size_t round_up(size_t value, size_t granularity) {
+    return (value + granularity - 1) & ~(granularity - 1);
+}
+
+// Pointer size in the low byte and byte order in the next, so a file written by an
+// incompatible build is rejected instead of misread
+uint32_t layout_tag() {
+    uint32_t little = std::endian::native == std::endian::little ? 1 : 0;
+    return static_cast<uint32_t>(sizeof(void*)) | (little << 8);
+}
+
+// Check that a mapped header describes a usable arena of file_size bytes
+bool valid_header(const PersistentArenaHeader& header, uint64_t file_size) {
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != PersistentArena::VERSION ||
+        header.layout_tag != layout_tag() || header.data_offset != PersistentArena::DATA_OFFSET) {
+        return false;
+    }
+    if (header.capacity > file_size - PersistentArena::DATA_OFFSET || header.curr_offset > header.capacity ||
+        header.prev_offset > header.curr_offset) {
+        return false;
+    }
+    return header.root == PersistentArena::NO_ROOT || header.root < header.curr_offset;
+}
+
+// Publish the allocator's offsets in the header
+void write_offsets(PersistentArena& p) {
+    p.header->curr_offset = p.arena.curr_offset;
+    p.header->prev_offset = p.arena.prev_offset;
+}
+
+PersistentArena empty_arena() {
+    PersistentArena p;
+    p.arena = LinearAllocator::create(nullptr, 0);
+    p.header = nullptr;
+    p.base = nullptr;
+    p.mapping_size = 0;
+    p.file = -1;
+    p.mapping = -1;
+    p.mode = PersistentMode::ReadOnly;
+    return p;
+}
+
+#if defined(_WIN32)
+
+// Map size bytes of an open file, creating the mapping object
+unsigned char* map_file(PersistentArena& p, size_t size, bool writable) {
+    HANDLE file = reinterpret_cast<HANDLE>(p.file);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY,
+                                        static_cast<DWORD>(static_cast<uint64_t>(size) >> 32),
+                                        static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    if (mapping == nullptr) {
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, size);
+    if (view == nullptr) {
+        CloseHandle(mapping);
+        return nullptr;
+    }
+    p.mapping = reinterpret_cast<intptr_t>(mapping);
+    return static_cast<unsigned char*>(view);
+}
+
+void close_file(PersistentArena& p) {
+    if (p.base != nullptr) {
+        UnmapViewOfFile(p.base);
+    }
+    if (p.mapping != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(p.mapping));
+    }
+    if (p.file != -1) {
+        CloseHandle(reinterpret_cast<HANDLE>(p.file));
+    }
+}
+
+#else
+
+unsigned char* map_file(PersistentArena& p, size_t size, bool writable) {
+    void* view = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED,
+                      static_cast<int>(p.file), 0);
+    return view == MAP_FAILED ? nullptr : static_cast<unsigned char*>(view);
+}
+
+void close_file(PersistentArena& p) {
+    if (p.base != nullptr) {
+        munmap(p.base, p.mapping_size);
+    }
+    if (p.file != -1) {
+        ::close(static_cast<int>(p.file));
+    }
+}
+
+#endif
+
+} // namespace
+
+std::expected<PersistentArena, PersistentArenaError> PersistentArena::create(const char* path, size_t capacity) {
+    capacity = round_up(capacity, VirtualMemory::page_size());
+    if (capacity == 0 || capacity > SIZE_MAX - DATA_OFFSET) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    size_t size = DATA_OFFSET + capacity;
+
+    PersistentArena p = empty_arena();
+    p.mode = PersistentMode::ReadWrite;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.file = reinterpret_cast<intptr_t>(file);
+    // The mapping extends the file to its size
+#else
+    int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.file = fd;
+    // Leaves a sparse file where the file system supports it
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+#endif
+
+    p.base = map_file(p, size, true);
+    if (p.base == nullptr) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.mapping_size = size;
+
+    p.header = reinterpret_cast<PersistentArenaHeader*>(p.base);
+    std::memcpy(p.header->magic, MAGIC, sizeof(MAGIC));
+    p.header->version = VERSION;
+    p.header->layout_tag = layout_tag();
+    p.header->data_offset = DATA_OFFSET;
+    p.header->capacity = capacity;
+    p.header->curr_offset = 0;
+    p.header->prev_offset = 0;
+    p.header->root = NO_ROOT;
+
+    p.arena = LinearAllocator::create(p.base + DATA_OFFSET, capacity);
+    return p;
+}
+
+std::expected<PersistentArena, PersistentArenaError> PersistentArena::open(const char* path, PersistentMode mode) {
+    const bool writable = mode == PersistentMode::ReadWrite;
+    PersistentArena p = empty_arena();
+    p.mode = mode;
+    uint64_t file_size = 0;
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.file = reinterpret_cast<intptr_t>(file);
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    file_size = static_cast<uint64_t>(length.QuadPart);
+#else
+    int fd = ::open(path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.file = fd;
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    file_size = static_cast<uint64_t>(info.st_size);
+#endif
+
+    if (file_size < DATA_OFFSET || file_size > SIZE_MAX) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::InvalidFormat);
+    }
+
+    p.base = map_file(p, static_cast<size_t>(file_size), writable);
+    if (p.base == nullptr) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+    p.mapping_size = static_cast<size_t>(file_size);
+
+    p.header = reinterpret_cast<PersistentArenaHeader*>(p.base);
+    if (!valid_header(*p.header, file_size)) {
+        close_file(p);
+        return std::unexpected(PersistentArenaError::InvalidFormat);
+    }
+
+    // A read-only arena gets no room at all, so every allocation fails with
+    // OutOfMemory instead of faulting on the read-only pages, even after free_all
+    if (!writable) {
+        p.arena = LinearAllocator::create(p.base + DATA_OFFSET, 0);
+        return p;
+    }
+    p.arena = LinearAllocator::create(p.base + DATA_OFFSET, static_cast<size_t>(p.header->capacity));
+    p.arena.curr_offset = static_cast<size_t>(p.header->curr_offset);
+    p.arena.prev_offset = static_cast<size_t>(p.header->prev_offset);
+    return p;
+}
+
+std::expected<void, PersistentArenaError> PersistentArena::sync() {
+    if (header == nullptr || mode == PersistentMode::ReadOnly) {
+        return std::unexpected(PersistentArenaError::ReadOnly);
+    }
+    write_offsets(*this);
+
+    // Pages past curr_offset were never written, so only the used prefix is flushed
+    size_t used = round_up(DATA_OFFSET + arena.curr_offset, VirtualMemory::page_size());
+    if (used > mapping_size) {
+        used = mapping_size;
+    }
+
+#if defined(_WIN32)
+    if (!FlushViewOfFile(base, used) || !FlushFileBuffers(reinterpret_cast<HANDLE>(file))) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+#else
+    if (msync(base, used, MS_SYNC) != 0) {
+        return std::unexpected(PersistentArenaError::IoError);
+    }
+#endif
+    return {};
+}
+
+void PersistentArena::close() {
+    if (header != nullptr && mode == PersistentMode::ReadWrite) {
+        write_offsets(*this);
+    }
+    arena.destroy();
+    close_file(*this);
+    *this = empty_arena();
+}
+
+std::expected<void, PersistentArenaError> PersistentArena::set_root(const void* object) {
+    if (header == nullptr || mode == PersistentMode::ReadOnly) {
+        return std::unexpected(PersistentArenaError::ReadOnly);
+    }
+    header->root = object == nullptr ? NO_ROOT
+                                     : static_cast<uint64_t>(static_cast<const unsigned char*>(object) - arena.buf);
+    return {};
+}
+
+bool PersistentArena::is_read_only() const {
+    return mode == PersistentMode::ReadOnly;
+}
+
+} // namespace memory
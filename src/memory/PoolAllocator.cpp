@@ -0,0 +1,196 @@
+#include "memory/PoolAllocator.hpp"
+#include <cstring>
+
+namespace memory {
+
+std::expected<PoolAllocator, AllocatorError> PoolAllocator::create(void* backing_buffer, size_t backing_buffer_length,
+                                                                   size_t chunk_size, size_t chunk_alignment) {
+    if (backing_buffer == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (!LinearAllocator::is_power_of_two(chunk_alignment)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (chunk_alignment < alignof(PoolFreeNode)) {
+        // Free list nodes live inside the chunks
+        chunk_alignment = alignof(PoolFreeNode);
+    }
+
+    // Align the start of the backing buffer to the chunk alignment
+    uintptr_t initial_start = reinterpret_cast<uintptr_t>(backing_buffer);
+    auto start_result = LinearAllocator::align_forward(initial_start, chunk_alignment);
+    if (!start_result) {
+        return std::unexpected(start_result.error());
+    }
+    uintptr_t start = start_result.value();
+    size_t padding = static_cast<size_t>(start - initial_start);
+
+    // Every chunk has to be able to hold a free list node and keep the next chunk aligned
+    if (chunk_size < sizeof(PoolFreeNode)) {
+        chunk_size = sizeof(PoolFreeNode);
+    }
+    chunk_size = static_cast<size_t>(LinearAllocator::align_forward(chunk_size, chunk_alignment).value());
+
+    if (backing_buffer_length < padding + chunk_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    PoolAllocator p;
+    p.buf = reinterpret_cast<unsigned char*>(start);
+    p.buf_len = ((backing_buffer_length - padding) / chunk_size) * chunk_size;
+    p.chunk_size = chunk_size;
+    p.chunk_alignment = chunk_alignment;
+    p.head = nullptr;
+
+    // Set up the free list for free chunks, counting from zero afterwards
+    p.free_all();
+    p.recorder = StatsRecorder();
+    return p;
+}
+
+std::expected<PoolAllocator, AllocatorError> PoolAllocator::create(LinearAllocator* arena, size_t chunk_count,
+                                                                   size_t chunk_size, size_t chunk_alignment) {
+    if (arena == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (!LinearAllocator::is_power_of_two(chunk_alignment)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (chunk_alignment < alignof(PoolFreeNode)) {
+        chunk_alignment = alignof(PoolFreeNode);
+    }
+
+    // Same rounding as the buffer overload so the region holds exactly chunk_count chunks
+    size_t rounded = chunk_size < sizeof(PoolFreeNode) ? sizeof(PoolFreeNode) : chunk_size;
+    rounded = static_cast<size_t>(LinearAllocator::align_forward(rounded, chunk_alignment).value());
+
+    auto region = arena->alloc_align_uninit(rounded * chunk_count, chunk_alignment);
+    if (!region) {
+        return std::unexpected(region.error());
+    }
+    return create(region.value(), rounded * chunk_count, rounded, chunk_alignment);
+}
+
+std::expected<void*, AllocatorError> PoolAllocator::alloc() {
+    auto result = alloc_uninit();
+    if (result) {
+        // Zero memory by default
+        std::memset(result.value(), 0, chunk_size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> PoolAllocator::alloc_uninit() {
+    return alloc_align_uninit(chunk_size, chunk_alignment);
+}
+
+std::expected<void*, AllocatorError> PoolAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> PoolAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align) || align > chunk_alignment) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (size > chunk_size) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Get latest free node
+    PoolFreeNode* node = head;
+    if (node == nullptr) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Pop free node
+    head = node->next;
+    recorder.record_alloc(size, chunk_size - size);
+    recorder.add_in_use(chunk_size);
+    return static_cast<void*>(node);
+}
+
+std::expected<void*, AllocatorError> PoolAllocator::resize_align(void* old_memory, size_t old_size,
+                                                               size_t new_size, size_t align) {
+    if (old_memory == nullptr || old_size == 0) {
+        return alloc_align(new_size, align);
+    }
+    if (!LinearAllocator::is_power_of_two(align) || align > chunk_alignment) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+    if (old_mem < buf || old_mem >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (!try_resize_in_place(old_memory, old_size, new_size)) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    if (new_size > old_size) {
+        // Zero the new memory by default
+        std::memset(old_mem + old_size, 0, new_size - old_size);
+    }
+    return old_memory;
+}
+
+bool PoolAllocator::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    // A chunk can hold anything up to chunk_size
+    if (old_memory == nullptr || new_size > chunk_size) {
+        return false;
+    }
+    recorder.record_resize(true);
+    return true;
+}
+
+std::expected<void, AllocatorError> PoolAllocator::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p < buf || p >= buf + buf_len || static_cast<size_t>(p - buf) % chunk_size != 0) {
+        // Not the start of one of our chunks
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    // Push free node
+    PoolFreeNode* node = reinterpret_cast<PoolFreeNode*>(p);
+    node->next = head;
+    head = node;
+    recorder.record_free();
+    recorder.sub_in_use(chunk_size);
+    return {};
+}
+
+void PoolAllocator::free_all() {
+    // Link chunks back to front so the list hands them out in address order
+    PoolFreeNode* next = nullptr;
+    for (size_t i = chunk_count(); i > 0; --i) {
+        PoolFreeNode* node = reinterpret_cast<PoolFreeNode*>(buf + (i - 1) * chunk_size);
+        node->next = next;
+        next = node;
+    }
+    head = next;
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats PoolAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+size_t PoolAllocator::chunk_count() const {
+    return buf_len / chunk_size;
+}
+
+} // namespace memory
@@ -0,0 +1,136 @@
+#include "memory/ScopedArena.hpp"
+#include <cstring>
+
+namespace memory {
+
+namespace {
+
+/**
+ * @brief The scratch arenas of one thread, reserved on first use
+ */
+struct ScratchPool {
+    LinearAllocator arenas[SCRATCH_ARENA_COUNT]; ///< Scratch arenas, buf is nullptr until reserved
+
+    ScratchPool() {
+        for (LinearAllocator& arena : arenas) {
+            arena = LinearAllocator::create(nullptr, 0);
+        }
+    }
+
+    ~ScratchPool() {
+        for (LinearAllocator& arena : arenas) {
+            arena.destroy();
+        }
+    }
+
+    ScratchPool(const ScratchPool&) = delete;
+    ScratchPool& operator=(const ScratchPool&) = delete;
+};
+
+thread_local ScratchPool scratch_pool;
+
+} // namespace
+
+ScopedArena::ScopedArena(LinearAllocator* a) : scope(TempArenaMemory::begin(a)), active(true) {}
+
+ScopedArena::ScopedArena(VirtualArena* a) : scope(TempArenaMemory::begin(a)), active(true) {}
+
+ScopedArena::ScopedArena(ScopedArena&& other) noexcept : scope(other.scope), active(other.active) {
+    other.active = false;
+}
+
+ScopedArena::~ScopedArena() {
+    end();
+}
+
+std::expected<void*, AllocatorError> ScopedArena::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> ScopedArena::alloc_align_uninit(size_t size, size_t align) {
+    return scope.alloc_align(size, align);
+}
+
+std::expected<void*, AllocatorError> ScopedArena::alloc(size_t size) {
+    return alloc_align(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> ScopedArena::resize_align(void* old_memory, size_t old_size,
+                                                               size_t new_size, size_t align) {
+    if (scope.chain) {
+        return scope.chain->resize_align(old_memory, old_size, new_size, align);
+    }
+    return scope.arena->resize_align(old_memory, old_size, new_size, align);
+}
+
+std::expected<void*, AllocatorError> ScopedArena::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                      size_t new_size, size_t align) {
+    if (scope.chain) {
+        return scope.chain->resize_align_uninit(old_memory, old_size, new_size, align);
+    }
+    return scope.arena->resize_align_uninit(old_memory, old_size, new_size, align);
+}
+
+bool ScopedArena::try_resize_in_place(void* old_memory, size_t old_size, size_t new_size) {
+    if (scope.chain) {
+        return scope.chain->try_resize_in_place(old_memory, old_size, new_size);
+    }
+    return scope.arena->try_resize_in_place(old_memory, old_size, new_size);
+}
+
+std::expected<void, AllocatorError> ScopedArena::free(void* /*ptr*/) {
+    // Scoped memory is released all at once by end
+    return {};
+}
+
+void ScopedArena::end() {
+    if (active) {
+        scope.end();
+        active = false;
+    }
+}
+
+LinearAllocator* ScopedArena::arena() const {
+    return scope.arena;
+}
+
+namespace detail {
+
+std::expected<ScopedArena, AllocatorError> get_scratch(const void* const* conflicts, size_t conflict_count) {
+    for (LinearAllocator& arena : scratch_pool.arenas) {
+        bool conflicting = false;
+        for (size_t i = 0; i < conflict_count; ++i) {
+            if (conflicts[i] == &arena) {
+                conflicting = true;
+                break;
+            }
+        }
+        if (conflicting) {
+            continue;
+        }
+
+        if (arena.buf == nullptr) {
+            // Keep everything committed, scratch memory is reused all the time
+            ReserveOptions options;
+            options.retain_committed = SIZE_MAX;
+            auto reserved = LinearAllocator::create_reserved(SCRATCH_ARENA_RESERVE_SIZE, options);
+            if (!reserved) {
+                return std::unexpected(reserved.error());
+            }
+            arena = reserved.value();
+        }
+        return ScopedArena(&arena);
+    }
+
+    // Every scratch arena is in use by the caller
+    return std::unexpected(AllocatorError::OutOfMemory);
+}
+
+} // namespace detail
+
+} // namespace memory
@@ -0,0 +1,545 @@
+#include "memory/SimdKernels.hpp"
+
+#include <atomic>
+#include <utility>
+
+namespace memory::simd {
+
+namespace {
+
+/**
+ * @brief Unsigned counterpart of an integer, the type itself for floating point
+ *
+ * Integer sums accumulate in unsigned lanes, where overflow wraps instead of being
+ * undefined.
+ */
+template <typename T>
+using wrapping_t = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>,
+                                               std::type_identity<T>>::type;
+
+/**
+ * @brief Plain loops, the fallback on every platform
+ */
+struct ScalarKernels {
+    template <typename T>
+    static void fill(T* data, size_t count, T value) {
+        std::fill(data, data + count, value);
+    }
+
+    template <typename T>
+    static size_t find(const T* data, size_t count, T value) {
+        return static_cast<size_t>(std::find(data, data + count, value) - data);
+    }
+
+    template <typename T>
+    static size_t count(const T* data, size_t count, T value) {
+        return static_cast<size_t>(std::count(data, data + count, value));
+    }
+
+    template <typename T>
+    static T min(const T* data, size_t count) {
+        T result = data[0];
+        for (size_t i = 1; i < count; ++i) {
+            result = data[i] < result ? data[i] : result;
+        }
+        return result;
+    }
+
+    template <typename T>
+    static T max(const T* data, size_t count) {
+        T result = data[0];
+        for (size_t i = 1; i < count; ++i) {
+            result = data[i] > result ? data[i] : result;
+        }
+        return result;
+    }
+
+    template <typename T>
+    static sum_t<T> sum(const T* data, size_t count) {
+        wrapping_t<sum_t<T>> total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            total += static_cast<wrapping_t<sum_t<T>>>(data[i]);
+        }
+        return static_cast<sum_t<T>>(total);
+    }
+};
+
+#if defined(MEMORY_SIMD_X86) || defined(MEMORY_SIMD_NEON)
+
+#define MEMORY_SIMD_INLINE [[gnu::always_inline]] inline
+
+/**
+ * @brief GCC/Clang vector of BYTES / sizeof(T) lanes
+ *
+ * Written once against the generic vector extensions; every instruction set below
+ * instantiates the kernels at its own width inside a function compiled for it.
+ */
+template <typename T, size_t BYTES>
+struct Vector {
+    typedef T type __attribute__((vector_size(BYTES)));
+};
+
+template <typename T, size_t BYTES>
+using vector_t = typename Vector<T, BYTES>::type;
+
+// The helpers take vectors by reference: they are compiled for the baseline target,
+// and passing a 256/512-bit vector by value there has a different ABI (GCC warns
+// about it even though the calls are always inlined)
+
+template <typename V, typename T>
+MEMORY_SIMD_INLINE void load(V& result, const T* source) {
+    __builtin_memcpy(&result, source, sizeof(V)); // Unaligned load
+}
+
+template <typename V, typename T>
+MEMORY_SIMD_INLINE void store(T* destination, const V& value) {
+    __builtin_memcpy(destination, &value, sizeof(V)); // Unaligned store
+}
+
+// Pair half of the elements of value with the matching elements of extra, the
+// way unpack instructions do: the first (HIGH: last) two of every 16-byte group
+template <bool HIGH, typename V, size_t... I>
+MEMORY_SIMD_INLINE void unpack_pairs(V& result, const V& value, const V& extra, std::index_sequence<I...>) {
+    constexpr size_t LANES = sizeof...(I);
+    result = __builtin_shufflevector(
+        value, extra, ((I / 4) * 4 + (I % 4) / 2 + (HIGH ? 2 : 0) + (I % 2 == 0 ? 0 : LANES))...);
+}
+
+template <typename M>
+MEMORY_SIMD_INLINE bool any(const M& mask) {
+    uint64_t words[sizeof(M) / sizeof(uint64_t)];
+    __builtin_memcpy(words, &mask, sizeof(M));
+    uint64_t combined = 0;
+    for (uint64_t word : words) {
+        combined |= word;
+    }
+    return combined != 0;
+}
+
+/**
+ * @brief The kernels for BYTES-wide vectors
+ *
+ * Every loop handles UNROLL vectors per iteration so independent operations can
+ * overlap, then finishes with single vectors and a scalar tail. Nothing needs to be
+ * aligned.
+ */
+template <size_t BYTES>
+struct VectorKernels {
+    static constexpr size_t UNROLL = 4;
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static void fill(T* data, size_t count, T value) {
+        using V = vector_t<T, BYTES>;
+        constexpr size_t LANES = BYTES / sizeof(T);
+
+        const V values = V{} + value;
+        size_t i = 0;
+        for (; i + UNROLL * LANES <= count; i += UNROLL * LANES) {
+            for (size_t u = 0; u < UNROLL; ++u) {
+                store(data + i + u * LANES, values);
+            }
+        }
+        for (; i + LANES <= count; i += LANES) {
+            store(data + i, values);
+        }
+        for (; i < count; ++i) {
+            data[i] = value;
+        }
+    }
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static size_t find(const T* data, size_t count, T value) {
+        using V = vector_t<T, BYTES>;
+        constexpr size_t LANES = BYTES / sizeof(T);
+
+        const V values = V{} + value;
+        V a, b, c, d;
+        size_t i = 0;
+        for (; i + UNROLL * LANES <= count; i += UNROLL * LANES) {
+            load(a, data + i);
+            load(b, data + i + LANES);
+            load(c, data + i + 2 * LANES);
+            load(d, data + i + 3 * LANES);
+            // Matches are -1, so the sum is non-zero exactly where one of them matched.
+            // Adding rather than or-ing also keeps GCC from scalarizing the AVX-512 compares
+            auto hits = (a == values) + (b == values) + (c == values) + (d == values);
+            if (any(hits)) {
+                // The block holds a match, pin it down with scalar compares
+                return i + ScalarKernels::find(data + i, UNROLL * LANES, value);
+            }
+        }
+        for (; i + LANES <= count; i += LANES) {
+            load(a, data + i);
+            auto hits = a == values;
+            if (any(hits)) {
+                return i + ScalarKernels::find(data + i, LANES, value);
+            }
+        }
+        return i + ScalarKernels::find(data + i, count - i, value);
+    }
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static size_t count(const T* data, size_t count, T value) {
+        using V = vector_t<T, BYTES>;
+        using M = decltype(V{} == V{});
+        constexpr size_t LANES = BYTES / sizeof(T);
+        // Lane counters have the element's width, drain them before 32-bit ones overflow
+        constexpr size_t CHUNK = LANES * (size_t{1} << 30);
+
+        const V values = V{} + value;
+        V block;
+        size_t result = 0;
+        size_t i = 0;
+        while (i + LANES <= count) {
+            const size_t chunk_end = count - i > CHUNK ? i + CHUNK : count;
+            M counters[UNROLL] = {};
+            for (; i + UNROLL * LANES <= chunk_end; i += UNROLL * LANES) {
+                for (size_t u = 0; u < UNROLL; ++u) {
+                    load(block, data + i + u * LANES);
+                    counters[u] -= block == values; // Matches are -1
+                }
+            }
+            for (; i + LANES <= chunk_end; i += LANES) {
+                load(block, data + i);
+                counters[0] -= block == values;
+            }
+            for (size_t u = 1; u < UNROLL; ++u) {
+                counters[0] += counters[u];
+            }
+            for (size_t lane = 0; lane < LANES; ++lane) {
+                result += static_cast<size_t>(counters[0][lane]);
+            }
+        }
+        return result + ScalarKernels::count(data + i, count - i, value);
+    }
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static T min(const T* data, size_t count) {
+        return reduce<PickMin>(data, count);
+    }
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static T max(const T* data, size_t count) {
+        return reduce<PickMax>(data, count);
+    }
+
+    template <typename T>
+    MEMORY_SIMD_INLINE static sum_t<T> sum(const T* data, size_t count) {
+        using A = wrapping_t<sum_t<T>>;
+        using VA = vector_t<A, BYTES>;
+        using VT = vector_t<T, BYTES>;
+        constexpr size_t LANES = BYTES / sizeof(T);
+
+        VA totals[UNROLL] = {};
+        VT block;
+        size_t i = 0;
+        for (; i + UNROLL * LANES <= count; i += UNROLL * LANES) {
+            for (size_t u = 0; u < UNROLL; ++u) {
+                load(block, data + i + u * LANES);
+                accumulate(totals[u], block);
+            }
+        }
+        for (; i + LANES <= count; i += LANES) {
+            load(block, data + i);
+            accumulate(totals[0], block);
+        }
+        // Combine the accumulators pairwise
+        totals[0] += totals[1];
+        totals[2] += totals[3];
+        totals[0] += totals[2];
+
+        A result = 0;
+        for (size_t lane = 0; lane < BYTES / sizeof(A); ++lane) {
+            result += totals[0][lane];
+        }
+        for (; i < count; ++i) {
+            result += static_cast<A>(data[i]);
+        }
+        return static_cast<sum_t<T>>(result);
+    }
+
+private:
+    // Add a full vector of elements into total. 32-bit integers widen into 64-bit
+    // lanes by pairing each element with its sign word, which keeps every load a
+    // whole vector; the generic conversion from half a vector goes through scalar
+    // registers
+    template <typename VA, typename VT>
+    MEMORY_SIMD_INLINE static void accumulate(VA& total, const VT& block) {
+        constexpr size_t LANES = sizeof(VT) / sizeof(block[0]);
+        if constexpr (sizeof(VA) / sizeof(total[0]) == LANES) {
+            total += __builtin_convertvector(block, VA);
+        } else {
+            using T = std::remove_cvref_t<decltype(block[0])>;
+            VT extension = {};
+            if constexpr (std::is_signed_v<T>) {
+                extension = block < extension; // -1 for negative elements, 0 otherwise
+            }
+            VT low;
+            VT high;
+            unpack_pairs<false>(low, block, extension, std::make_index_sequence<LANES>{});
+            unpack_pairs<true>(high, block, extension, std::make_index_sequence<LANES>{});
+            total += (VA)low; // Same size, so this reinterprets the bits
+            total += (VA)high;
+        }
+    }
+
+    // Element-wise selections for reduce(): keep the smaller (larger) of acc and x in acc
+    struct PickMin {
+        template <typename V>
+        MEMORY_SIMD_INLINE static void apply(V& acc, const V& x) { acc = x < acc ? x : acc; }
+    };
+
+    struct PickMax {
+        template <typename V>
+        MEMORY_SIMD_INLINE static void apply(V& acc, const V& x) { acc = x > acc ? x : acc; }
+    };
+
+    /**
+     * @brief Fold a non-empty range with Pick, an element-wise min or max
+     */
+    template <typename Pick, typename T>
+    MEMORY_SIMD_INLINE static T reduce(const T* data, size_t count) {
+        using V = vector_t<T, BYTES>;
+        constexpr size_t LANES = BYTES / sizeof(T);
+
+        T scalar = data[0];
+        if (count < LANES) {
+            for (size_t i = 1; i < count; ++i) {
+                Pick::apply(scalar, data[i]);
+            }
+            return scalar;
+        }
+
+        V result, a, b, c, d;
+        load(result, data);
+        size_t i = LANES;
+        for (; i + UNROLL * LANES <= count; i += UNROLL * LANES) {
+            load(a, data + i);
+            load(b, data + i + LANES);
+            load(c, data + i + 2 * LANES);
+            load(d, data + i + 3 * LANES);
+            Pick::apply(a, b);
+            Pick::apply(c, d);
+            Pick::apply(a, c);
+            Pick::apply(result, a);
+        }
+        for (; i + LANES <= count; i += LANES) {
+            load(a, data + i);
+            Pick::apply(result, a);
+        }
+        // The last, partial vector overlaps elements already seen, which min/max ignore
+        if (i < count) {
+            load(a, data + count - LANES);
+            Pick::apply(result, a);
+        }
+
+        scalar = result[0];
+        for (size_t lane = 1; lane < LANES; ++lane) {
+            Pick::apply(scalar, static_cast<T>(result[lane]));
+        }
+        return scalar;
+    }
+};
+
+#endif
+
+#if defined(MEMORY_SIMD_X86)
+
+// One wrapper per instruction set: the generic kernels are inlined into functions
+// compiled for that target, and only called after the CPU was checked for it
+#define MEMORY_SIMD_DEFINE_LEVEL(NAME, TARGET, BYTES)                                      \
+    struct NAME {                                                                          \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static void fill(T* data, size_t count, T value) {         \
+            VectorKernels<BYTES>::fill(data, count, value);                                \
+        }                                                                                  \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static size_t find(const T* data, size_t count, T value) { \
+            return VectorKernels<BYTES>::find(data, count, value);                         \
+        }                                                                                  \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static size_t count(const T* data, size_t count, T value) {\
+            return VectorKernels<BYTES>::count(data, count, value);                        \
+        }                                                                                  \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static T min(const T* data, size_t count) {                \
+            return VectorKernels<BYTES>::min(data, count);                                 \
+        }                                                                                  \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static T max(const T* data, size_t count) {                \
+            return VectorKernels<BYTES>::max(data, count);                                 \
+        }                                                                                  \
+        template <typename T>                                                              \
+        [[gnu::target(TARGET)]] static sum_t<T> sum(const T* data, size_t count) {         \
+            return VectorKernels<BYTES>::sum(data, count);                                 \
+        }                                                                                  \
+    };
+
+MEMORY_SIMD_DEFINE_LEVEL(Sse42Kernels, "sse4.2", 16)
+MEMORY_SIMD_DEFINE_LEVEL(Avx2Kernels, "avx2", 32)
+MEMORY_SIMD_DEFINE_LEVEL(Avx512Kernels, "avx512f,avx512bw,avx512dq,avx512vl", 64)
+
+#undef MEMORY_SIMD_DEFINE_LEVEL
+
+#elif defined(MEMORY_SIMD_NEON)
+
+// NEON is part of the AArch64 baseline, no target attribute needed
+using NeonKernels = VectorKernels<16>;
+
+#endif
+
+SimdLevel detect_cpu_level() {
+#if defined(MEMORY_SIMD_X86)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+        return SimdLevel::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+        return SimdLevel::SSE42;
+    }
+    return SimdLevel::Scalar;
+#elif defined(MEMORY_SIMD_NEON)
+    return SimdLevel::NEON;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Detected on first use rather than at static initialization, so kernels called
+// from other static constructors still dispatch correctly
+std::atomic<SimdLevel>& current_level() {
+    static std::atomic<SimdLevel> level{detect_cpu_level()};
+    return level;
+}
+
+/**
+ * @brief Call kernel with the kernel set of the active level
+ *
+ * @param kernel Generic callable taking a kernel set object
+ */
+template <typename Kernel>
+decltype(auto) dispatch(Kernel&& kernel) {
+    switch (current_level().load(std::memory_order_relaxed)) {
+#if defined(MEMORY_SIMD_X86)
+    case SimdLevel::AVX512:
+        return kernel(Avx512Kernels{});
+    case SimdLevel::AVX2:
+        return kernel(Avx2Kernels{});
+    case SimdLevel::SSE42:
+        return kernel(Sse42Kernels{});
+#elif defined(MEMORY_SIMD_NEON)
+    case SimdLevel::NEON:
+        return kernel(NeonKernels{});
+#endif
+    default:
+        return kernel(ScalarKernels{});
+    }
+}
+
+} // namespace
+
+SimdLevel detect_level() {
+    static const SimdLevel level = detect_cpu_level();
+    return level;
+}
+
+SimdLevel active_level() {
+    return current_level().load(std::memory_order_relaxed);
+}
+
+bool set_level(SimdLevel level) {
+    if (!is_supported(level)) {
+        return false;
+    }
+    current_level().store(level, std::memory_order_relaxed);
+    return true;
+}
+
+bool is_supported(SimdLevel level) {
+    const SimdLevel detected = detect_level();
+    switch (level) {
+    case SimdLevel::Scalar:
+        return true;
+    case SimdLevel::SSE42:
+    case SimdLevel::AVX2:
+    case SimdLevel::AVX512:
+        // The x86 levels include each other
+        return detected != SimdLevel::NEON && level <= detected;
+    case SimdLevel::NEON:
+        return detected == SimdLevel::NEON;
+    }
+    return false;
+}
+
+const char* level_name(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Scalar:
+        return "scalar";
+    case SimdLevel::SSE42:
+        return "sse4.2";
+    case SimdLevel::AVX2:
+        return "avx2";
+    case SimdLevel::AVX512:
+        return "avx512";
+    case SimdLevel::NEON:
+        return "neon";
+    }
+    return "unknown";
+}
+
+namespace detail {
+
+template <SimdElement T>
+void fill(T* data, size_t count, T value) {
+    dispatch([&](auto kernels) { decltype(kernels)::fill(data, count, value); });
+}
+
+template <SimdElement T>
+size_t find(const T* data, size_t count, T value) {
+    return dispatch([&](auto kernels) { return decltype(kernels)::find(data, count, value); });
+}
+
+template <SimdElement T>
+size_t count(const T* data, size_t count, T value) {
+    return dispatch([&](auto kernels) { return decltype(kernels)::count(data, count, value); });
+}
+
+template <SimdElement T>
+T min(const T* data, size_t count) {
+    return dispatch([&](auto kernels) { return decltype(kernels)::min(data, count); });
+}
+
+template <SimdElement T>
+T max(const T* data, size_t count) {
+    return dispatch([&](auto kernels) { return decltype(kernels)::max(data, count); });
+}
+
+template <SimdElement T>
+sum_t<T> sum(const T* data, size_t count) {
+    return dispatch([&](auto kernels) { return decltype(kernels)::sum(data, count); });
+}
+
+#define MEMORY_SIMD_INSTANTIATE(T)                             \
+    template void fill<T>(T*, size_t, T);                      \
+    template size_t find<T>(const T*, size_t, T);              \
+    template size_t count<T>(const T*, size_t, T);             \
+    template T min<T>(const T*, size_t);                       \
+    template T max<T>(const T*, size_t);                       \
+    template sum_t<T> sum<T>(const T*, size_t);
+
+MEMORY_SIMD_INSTANTIATE(int32_t)
+MEMORY_SIMD_INSTANTIATE(uint32_t)
+MEMORY_SIMD_INSTANTIATE(int64_t)
+MEMORY_SIMD_INSTANTIATE(uint64_t)
+MEMORY_SIMD_INSTANTIATE(float)
+MEMORY_SIMD_INSTANTIATE(double)
+
+#undef MEMORY_SIMD_INSTANTIATE
+
+} // namespace detail
+
+} // namespace memory::simd
@@ -0,0 +1,178 @@
+#include "memory/StackAllocator.hpp"
+#include <cstring>
+
+namespace memory {
+
+StackAllocator StackAllocator::create(void* backing_buffer, size_t backing_buffer_length) {
+    StackAllocator s;
+    s.buf = static_cast<unsigned char*>(backing_buffer);
+    s.buf_len = backing_buffer_length;
+    s.prev_offset = 0;
+    s.curr_offset = 0;
+    return s;
+}
+
+std::expected<void*, AllocatorError> StackAllocator::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> StackAllocator::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // The header in front of the allocation must be aligned as well
+    if (align < alignof(StackAllocationHeader)) {
+        align = alignof(StackAllocationHeader);
+    }
+
+    // Leave room for the header between the current offset and the aligned address
+    uintptr_t curr_addr = reinterpret_cast<uintptr_t>(buf) + static_cast<uintptr_t>(curr_offset);
+    uintptr_t aligned_addr = LinearAllocator::align_forward(curr_addr + sizeof(StackAllocationHeader), align).value();
+    size_t padding = static_cast<size_t>(aligned_addr - curr_addr);
+
+    // Check to see if the backing memory has space left
+    size_t available = buf_len - curr_offset;
+    if (padding > available || size > available - padding) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    size_t next_offset = curr_offset + padding;
+    StackAllocationHeader* header = reinterpret_cast<StackAllocationHeader*>(buf + next_offset - sizeof(StackAllocationHeader));
+    header->padding = padding;
+    header->prev_offset = prev_offset;
+
+    prev_offset = next_offset;
+    curr_offset = next_offset + size;
+    recorder.record_alloc(size, padding);
+    recorder.record_in_use(curr_offset);
+    return static_cast<void*>(buf + next_offset);
+}
+
+std::expected<void*, AllocatorError> StackAllocator::alloc(size_t size) {
+    return alloc_align(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> StackAllocator::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> StackAllocator::resize_align(void* old_memory, size_t old_size,
+                                                                size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> StackAllocator::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                       size_t new_size, size_t align) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (old_mem == nullptr || old_size == 0) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    if (old_mem < buf || old_mem >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (buf + prev_offset == old_mem) {
+        // This is the top allocation, we can resize in place
+        if (!try_resize_in_place(old_memory, old_size, new_size)) {
+            recorder.record_failure();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+        return old_memory;
+    }
+
+    // Not the top allocation, push a new one and copy
+    auto new_memory_result = alloc_align_uninit(new_size, align);
+    if (!new_memory_result) {
+        return std::unexpected(new_memory_result.error());
+    }
+    recorder.record_resize(false);
+
+    void* new_memory = new_memory_result.value();
+    size_t copy_size = (old_size < new_size) ? old_size : new_size;
+    std::memmove(new_memory, old_memory, copy_size);
+    return new_memory;
+}
+
+std::expected<void*, AllocatorError> StackAllocator::resize(void* old_memory, size_t old_size, size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, DEFAULT_ALIGNMENT);
+}
+
+bool StackAllocator::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+
+    // Only the top allocation can grow or shrink in place
+    if (old_mem == nullptr || buf + prev_offset != old_mem || new_size > buf_len - prev_offset) {
+        return false;
+    }
+
+    curr_offset = prev_offset + new_size;
+    recorder.record_resize(true);
+    recorder.record_in_use(curr_offset);
+    return true;
+}
+
+std::expected<void, AllocatorError> StackAllocator::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p < buf || p >= buf + buf_len) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (p > buf + curr_offset) {
+        // Allow double frees
+        return {};
+    }
+
+#ifndef NDEBUG
+    if (p != buf + prev_offset) {
+        // Freeing anything but the top would silently release everything above it
+        return std::unexpected(AllocatorError::OutOfOrderFree);
+    }
+#endif
+
+    const StackAllocationHeader* header = reinterpret_cast<const StackAllocationHeader*>(p - sizeof(StackAllocationHeader));
+
+    // Roll back to where the previous end offset was
+    curr_offset = static_cast<size_t>(p - buf) - header->padding;
+    prev_offset = header->prev_offset;
+    recorder.record_free();
+    recorder.record_in_use(curr_offset);
+    return {};
+}
+
+void StackAllocator::free_all() {
+    curr_offset = 0;
+    prev_offset = 0;
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats StackAllocator::stats() const {
+    return recorder.snapshot();
+}
+
+} // namespace memory
@@ -0,0 +1,358 @@
+#include "memory/ThreadCachedPool.hpp"
+#include <cstring>
+#include <new>
+
+namespace memory {
+
+namespace {
+
+// Pools a thread has looked up recently, so the common path skips the slot scan
+struct TlsCacheEntry {
+    const ThreadCachedPoolShared* shared;
+    uint64_t id;
+    ThreadCache* cache;
+};
+
+constexpr size_t TLS_CACHE_ENTRIES = 8;
+
+thread_local TlsCacheEntry tls_caches[TLS_CACHE_ENTRIES];
+thread_local size_t tls_next_entry = 0;
+
+std::atomic<uint64_t> next_pool_id{1};
+
+size_t round_chunk_size(size_t chunk_size, size_t chunk_alignment) {
+    if (chunk_size < sizeof(PoolFreeNode)) {
+        chunk_size = sizeof(PoolFreeNode);
+    }
+    return static_cast<size_t>(LinearAllocator::align_forward(chunk_size, chunk_alignment).value());
+}
+
+} // namespace
+
+std::expected<ThreadCachedPool, AllocatorError> ThreadCachedPool::create(void* backing_buffer, size_t backing_buffer_length,
+                                                                         size_t chunk_size, size_t chunk_alignment,
+                                                                         const ThreadCacheOptions& options) {
+    if (backing_buffer == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+    if (!LinearAllocator::is_power_of_two(chunk_alignment) || !LinearAllocator::is_power_of_two(options.span_size)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (chunk_alignment < alignof(PoolFreeNode)) {
+        // Free list nodes live inside the chunks
+        chunk_alignment = alignof(PoolFreeNode);
+    }
+    if (chunk_alignment > options.span_size || alignof(PoolSpan) > options.span_size) {
+        // Spans are laid out back to back, so they can't be aligned beyond their size
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (options.max_threads == 0) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    chunk_size = round_chunk_size(chunk_size, chunk_alignment);
+    size_t first_chunk = static_cast<size_t>(LinearAllocator::align_forward(sizeof(PoolSpan), chunk_alignment).value());
+    if (first_chunk + chunk_size > options.span_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Shared state and thread slots go first, spans after them
+    uintptr_t initial_start = reinterpret_cast<uintptr_t>(backing_buffer);
+    uintptr_t shared_start = LinearAllocator::align_forward(initial_start, alignof(ThreadCachedPoolShared)).value();
+    uintptr_t caches_start = shared_start + sizeof(ThreadCachedPoolShared);
+    uintptr_t caches_end = caches_start + options.max_threads * sizeof(ThreadCache);
+
+    size_t span_alignment = chunk_alignment > alignof(PoolSpan) ? chunk_alignment : alignof(PoolSpan);
+    uintptr_t spans_start = LinearAllocator::align_forward(caches_end, span_alignment).value();
+    size_t header = static_cast<size_t>(spans_start - initial_start);
+    if (backing_buffer_length < header + options.span_size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    ThreadCachedPool p;
+    p.buf = reinterpret_cast<unsigned char*>(spans_start);
+    p.span_count = (backing_buffer_length - header) / options.span_size;
+    p.span_size = options.span_size;
+    p.chunk_size = chunk_size;
+    p.chunk_alignment = chunk_alignment;
+    p.first_chunk = first_chunk;
+    p.chunks_per_span = (options.span_size - first_chunk) / chunk_size;
+    p.max_threads = options.max_threads;
+
+    p.shared = new (reinterpret_cast<void*>(shared_start)) ThreadCachedPoolShared{};
+    p.shared->next_span.store(0, std::memory_order_relaxed);
+    p.shared->id = next_pool_id.fetch_add(1, std::memory_order_relaxed);
+
+    p.caches = reinterpret_cast<ThreadCache*>(caches_start);
+    for (size_t i = 0; i < p.max_threads; ++i) {
+        ThreadCache* cache = new (&p.caches[i]) ThreadCache{};
+        cache->owner_thread.store(std::thread::id{}, std::memory_order_relaxed);
+        cache->active = nullptr;
+        cache->spans = nullptr;
+    }
+    return p;
+}
+
+std::expected<ThreadCachedPool, AllocatorError> ThreadCachedPool::create(LinearAllocator* arena, size_t region_size,
+                                                                         size_t chunk_size, size_t chunk_alignment,
+                                                                         const ThreadCacheOptions& options) {
+    if (arena == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    auto region = arena->alloc_align_uninit(region_size, CACHE_LINE_SIZE);
+    if (!region) {
+        return std::unexpected(region.error());
+    }
+    return create(region.value(), region_size, chunk_size, chunk_alignment, options);
+}
+
+std::expected<void*, AllocatorError> ThreadCachedPool::alloc() {
+    auto result = alloc_uninit();
+    if (result) {
+        // Zero memory by default
+        std::memset(result.value(), 0, chunk_size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> ThreadCachedPool::alloc_uninit() {
+    return alloc_align_uninit(chunk_size, chunk_alignment);
+}
+
+std::expected<void*, AllocatorError> ThreadCachedPool::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> ThreadCachedPool::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align) || align > chunk_alignment) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+    if (size > chunk_size) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    ThreadCache* cache = thread_cache(true);
+    if (cache == nullptr) {
+        // Every thread slot is taken
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    // Fast path: the active span, no shared state involved
+    void* chunk = cache->active != nullptr ? take_chunk(cache->active) : nullptr;
+    if (chunk == nullptr) {
+        PoolSpan* span = refill(cache);
+        if (span == nullptr) {
+            recorder.record_failure();
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+        chunk = take_chunk(span);
+    }
+
+    recorder.record_alloc(size, chunk_size - size);
+    recorder.add_in_use(chunk_size);
+    return chunk;
+}
+
+std::expected<void*, AllocatorError> ThreadCachedPool::resize_align(void* old_memory, size_t old_size,
+                                                                  size_t new_size, size_t align) {
+    if (old_memory == nullptr || old_size == 0) {
+        return alloc_align(new_size, align);
+    }
+    if (!LinearAllocator::is_power_of_two(align) || align > chunk_alignment) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    unsigned char* old_mem = static_cast<unsigned char*>(old_memory);
+    if (old_mem < buf || old_mem >= buf + span_count * span_size) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (!try_resize_in_place(old_memory, old_size, new_size)) {
+        recorder.record_failure();
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    if (new_size > old_size) {
+        // Zero the new memory by default
+        std::memset(old_mem + old_size, 0, new_size - old_size);
+    }
+    return old_memory;
+}
+
+bool ThreadCachedPool::try_resize_in_place(void* old_memory, size_t /*old_size*/, size_t new_size) {
+    // A chunk can hold anything up to chunk_size
+    if (old_memory == nullptr || new_size > chunk_size) {
+        return false;
+    }
+    recorder.record_resize(true);
+    return true;
+}
+
+std::expected<void, AllocatorError> ThreadCachedPool::free(void* ptr) {
+    if (ptr == nullptr) {
+        return std::unexpected(AllocatorError::NullPointer);
+    }
+
+    unsigned char* p = static_cast<unsigned char*>(ptr);
+    if (p < buf || p >= buf + span_count * span_size) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    size_t offset = static_cast<size_t>(p - buf);
+    size_t in_span = offset & (span_size - 1);
+    if (in_span < first_chunk || (in_span - first_chunk) % chunk_size != 0 ||
+        (in_span - first_chunk) / chunk_size >= chunks_per_span) {
+        // Not the start of one of our chunks
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    PoolSpan* span = reinterpret_cast<PoolSpan*>(buf + (offset - in_span));
+    PoolFreeNode* node = reinterpret_cast<PoolFreeNode*>(p);
+    recorder.record_free();
+    recorder.sub_in_use(chunk_size);
+
+    // Threads that never allocated have no slot and can't own the span
+    ThreadCache* cache = thread_cache(false);
+    if (cache != nullptr && span->owner == cache) {
+        node->next = span->local_free;
+        span->local_free = node;
+        return {};
+    }
+
+    // Remote free: lock-free push, the owner takes the whole stack at once so there is no ABA
+    PoolFreeNode* head = span->remote_free.load(std::memory_order_relaxed);
+    do {
+        node->next = head;
+    } while (!span->remote_free.compare_exchange_weak(head, node, std::memory_order_release,
+                                                      std::memory_order_relaxed));
+    return {};
+}
+
+void ThreadCachedPool::free_all() {
+    shared->next_span.store(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < max_threads; ++i) {
+        caches[i].active = nullptr;
+        caches[i].spans = nullptr;
+    }
+    recorder.record_reset();
+    recorder.record_in_use(0);
+}
+
+AllocatorStats ThreadCachedPool::stats() const {
+    return recorder.snapshot();
+}
+
+void ThreadCachedPool::release_thread_cache() {
+    ThreadCache* cache = thread_cache(false);
+    if (cache == nullptr) {
+        return;
+    }
+
+    for (TlsCacheEntry& entry : tls_caches) {
+        if (entry.cache == cache) {
+            entry = TlsCacheEntry{};
+        }
+    }
+
+    // Hand the slot's spans over to whoever claims it next
+    cache->owner_thread.store(std::thread::id{}, std::memory_order_release);
+}
+
+size_t ThreadCachedPool::spans_in_use() const {
+    size_t carved = shared->next_span.load(std::memory_order_relaxed);
+    return carved < span_count ? carved : span_count;
+}
+
+ThreadCache* ThreadCachedPool::thread_cache(bool claim) const {
+    for (const TlsCacheEntry& entry : tls_caches) {
+        if (entry.shared == shared && entry.id == shared->id) {
+            return entry.cache;
+        }
+    }
+
+    // Slow path: look for a slot this thread already holds, then for a free one
+    std::thread::id self = std::this_thread::get_id();
+    ThreadCache* found = nullptr;
+    for (size_t i = 0; i < max_threads && found == nullptr; ++i) {
+        if (caches[i].owner_thread.load(std::memory_order_acquire) == self) {
+            found = &caches[i];
+        }
+    }
+    for (size_t i = 0; i < max_threads && found == nullptr && claim; ++i) {
+        std::thread::id expected{};
+        if (caches[i].owner_thread.compare_exchange_strong(expected, self, std::memory_order_acquire,
+                                                           std::memory_order_relaxed)) {
+            found = &caches[i];
+        }
+    }
+    if (found == nullptr) {
+        return nullptr;
+    }
+
+    tls_caches[tls_next_entry] = TlsCacheEntry{shared, shared->id, found};
+    tls_next_entry = (tls_next_entry + 1) % TLS_CACHE_ENTRIES;
+    return found;
+}
+
+void* ThreadCachedPool::take_chunk(PoolSpan* span) {
+    if (PoolFreeNode* node = span->local_free) {
+        span->local_free = node->next;
+        return node;
+    }
+
+    // Carve chunks the span has never handed out
+    if (span->carved < chunks_per_span) {
+        unsigned char* chunk = reinterpret_cast<unsigned char*>(span) + first_chunk + span->carved * chunk_size;
+        ++span->carved;
+        return chunk;
+    }
+
+    // Take everything other threads have freed into this span
+    PoolFreeNode* remote = span->remote_free.exchange(nullptr, std::memory_order_acquire);
+    if (remote == nullptr) {
+        return nullptr;
+    }
+    span->local_free = remote->next;
+    return remote;
+}
+
+PoolSpan* ThreadCachedPool::refill(ThreadCache* cache) {
+    // Reuse a span of our own that has free chunks again
+    for (PoolSpan* span = cache->spans; span != nullptr; span = span->next) {
+        if (span == cache->active) {
+            continue;
+        }
+        if (span->local_free != nullptr || span->remote_free.load(std::memory_order_relaxed) != nullptr) {
+            cache->active = span;
+            return span;
+        }
+    }
+
+    // Batched refill: one atomic increment buys a whole span of chunks
+    size_t index = shared->next_span.fetch_add(1, std::memory_order_relaxed);
+    if (index >= span_count) {
+        return nullptr;
+    }
+
+    PoolSpan* span = new (buf + index * span_size) PoolSpan{};
+    span->owner = cache;
+    span->next = cache->spans;
+    span->local_free = nullptr;
+    span->carved = 0;
+    span->remote_free.store(nullptr, std::memory_order_relaxed);
+
+    cache->spans = span;
+    cache->active = span;
+    return span;
+}
+
+} // namespace memory
@@ -0,0 +1,179 @@
+#include "memory/TraceReplay.hpp"
+#include <functional>
+#include <unordered_map>
+
+namespace memory {
+
+namespace {
+
+/**
+ * @brief A traced allocation that is live at the current point of the trace
+ */
+struct LiveAllocation {
+    uint32_t handle;   ///< Handle the allocation was given
+    size_t size;       ///< Current size
+    uint32_t align;    ///< Alignment it was allocated with
+    uint64_t sequence; ///< Position in allocation order, to find what a scope released
+    size_t depth;      ///< Slot a LIFO allocator would give it, counted from the bottom
+};
+
+} // namespace
+
+ReplayProgram ReplayProgram::compile(std::span<const TraceEvent> events, uint16_t allocator) {
+    ReplayProgram program;
+    std::unordered_map<uint64_t, LiveAllocation> live;
+    std::vector<uint32_t> free_handles;
+    std::vector<uint64_t> scopes;
+    uint64_t sequence = 0;
+    size_t live_bytes = 0;
+    size_t stack_depth = 0;
+    bool first = true;
+    uint64_t first_timestamp = 0;
+
+    // Recycle handles so the replay's block array stays as small as the live set
+    auto take_handle = [&]() -> uint32_t {
+        if (!free_handles.empty()) {
+            uint32_t handle = free_handles.back();
+            free_handles.pop_back();
+            return handle;
+        }
+        return static_cast<uint32_t>(program.handles++);
+    };
+
+    // A LIFO allocator only frees its top slot; a slot left behind by a moving
+    // resize is never freed again, so nothing below it can be freed either
+    auto release_slot = [&](const LiveAllocation& allocation) {
+        if (allocation.depth + 1 == stack_depth) {
+            --stack_depth;
+        } else {
+            program.lifo = false;
+        }
+    };
+
+    for (const TraceEvent& event : events) {
+        if (event.allocator != allocator) {
+            continue;
+        }
+        if (first) {
+            first_timestamp = event.timestamp_ns;
+            first = false;
+        }
+        program.duration_ns = event.timestamp_ns - first_timestamp;
+
+        switch (event.op) {
+        case TraceOp::Alloc: {
+            if (live.contains(event.address)) {
+                ++program.skipped;
+                break;
+            }
+            size_t size = static_cast<size_t>(event.size);
+            LiveAllocation allocation{take_handle(), size, event.align, sequence++, stack_depth++};
+            live.emplace(event.address, allocation);
+            program.ops.push_back(ReplayOp{size, 0, allocation.handle, allocation.align, ReplayOpKind::Alloc});
+            live_bytes += size;
+            program.max_size = std::max(program.max_size, size);
+            program.max_align = std::max(program.max_align, static_cast<size_t>(event.align));
+            break;
+        }
+        case TraceOp::Resize: {
+            auto it = live.find(event.old_address);
+            if (it == live.end()) {
+                ++program.skipped;
+                break;
+            }
+            LiveAllocation allocation = it->second;
+            size_t size = static_cast<size_t>(event.size);
+            program.ops.push_back(ReplayOp{size, allocation.size, allocation.handle, allocation.align,
+                                           ReplayOpKind::Resize});
+            live_bytes = live_bytes - allocation.size + size;
+            program.max_size = std::max(program.max_size, size);
+            if (allocation.depth + 1 != stack_depth) {
+                // Only the top resizes in place, anything else moves to a new top slot
+                allocation.depth = stack_depth++;
+            }
+            allocation.size = size;
+            live.erase(it);
+            live[event.address] = allocation;
+            break;
+        }
+        case TraceOp::Free: {
+            auto it = live.find(event.address);
+            if (it == live.end()) {
+                ++program.skipped;
+                break;
+            }
+            const LiveAllocation& allocation = it->second;
+            program.ops.push_back(ReplayOp{0, allocation.size, allocation.handle, allocation.align,
+                                           ReplayOpKind::Free});
+            release_slot(allocation);
+            live_bytes -= allocation.size;
+            free_handles.push_back(allocation.handle);
+            live.erase(it);
+            break;
+        }
+        case TraceOp::FreeAll:
+            program.ops.push_back(ReplayOp{0, 0, 0, 0, ReplayOpKind::FreeAll});
+            for (const auto& [address, allocation] : live) {
+                free_handles.push_back(allocation.handle);
+            }
+            live.clear();
+            scopes.clear();
+            live_bytes = 0;
+            stack_depth = 0;
+            break;
+        case TraceOp::ScopeBegin:
+            scopes.push_back(sequence);
+            program.ops.push_back(ReplayOp{0, 0, 0, 0, ReplayOpKind::ScopeBegin});
+            break;
+        case TraceOp::ScopeEnd: {
+            if (scopes.empty()) {
+                ++program.skipped;
+                break;
+            }
+            uint64_t mark = scopes.back();
+            scopes.pop_back();
+
+            // Everything allocated since the scope began goes away, newest first
+            std::vector<std::pair<uint64_t, uint64_t>> released;
+            for (const auto& [address, allocation] : live) {
+                if (allocation.sequence >= mark) {
+                    released.emplace_back(allocation.sequence, address);
+                }
+            }
+            std::sort(released.begin(), released.end(), std::greater<>());
+            for (const auto& [allocation_sequence, address] : released) {
+                auto it = live.find(address);
+                const LiveAllocation& allocation = it->second;
+                program.ops.push_back(ReplayOp{0, allocation.size, allocation.handle, allocation.align,
+                                               ReplayOpKind::ImplicitFree});
+                release_slot(allocation);
+                live_bytes -= allocation.size;
+                free_handles.push_back(allocation.handle);
+                live.erase(it);
+            }
+            program.ops.push_back(ReplayOp{0, 0, 0, 0, ReplayOpKind::ScopeEnd});
+            break;
+        }
+        }
+        program.peak_live_bytes = std::max(program.peak_live_bytes, live_bytes);
+    }
+
+    // Handle 0 is referenced by FreeAll and scope operations even if nothing was allocated
+    if (program.handles == 0) {
+        program.handles = 1;
+    }
+    return program;
+}
+
+std::vector<uint16_t> trace_allocators(std::span<const TraceEvent> events) {
+    std::vector<uint16_t> ids;
+    for (const TraceEvent& event : events) {
+        if (std::find(ids.begin(), ids.end(), event.allocator) == ids.end()) {
+            ids.push_back(event.allocator);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // namespace memory
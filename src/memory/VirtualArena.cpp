@@ -0,0 +1,294 @@
+#include "memory/VirtualArena.hpp"
+#include <cstdlib>
+#include <cstring>
+
+namespace memory {
+
+namespace {
+
+void* heap_alloc_block(size_t size, void* /*user_data*/) {
+    return std::malloc(size);
+}
+
+void heap_free_block(void* block, size_t /*size*/, void* /*user_data*/) {
+    std::free(block);
+}
+
+// Keep block payloads aligned as strictly as the default allocation alignment
+constexpr size_t BLOCK_HEADER_SIZE =
+    (sizeof(ArenaBlock) + LinearAllocator::DEFAULT_ALIGNMENT - 1) & ~(LinearAllocator::DEFAULT_ALIGNMENT - 1);
+
+// Hand a block back to the upstream unpoisoned, it may reuse the memory for anything
+void return_block(const BlockSource& upstream, ArenaBlock* b) {
+    if constexpr (ARENA_DEBUG_ENABLED) {
+        detail::arena_unpoison(b, b->size);
+    }
+    upstream.free_block(b, b->size, upstream.user_data);
+}
+
+} // namespace
+
+BlockSource BlockSource::heap() {
+    return BlockSource{heap_alloc_block, heap_free_block, nullptr};
+}
+
+VirtualArena VirtualArena::create(size_t initial_block_size, BlockSource source, size_t max_block_size) {
+    VirtualArena a;
+    a.current = LinearAllocator::create(nullptr, 0);
+    a.block = nullptr;
+    a.spare = nullptr;
+    a.upstream = source;
+    a.next_block_size = initial_block_size > BLOCK_HEADER_SIZE ? initial_block_size : BLOCK_HEADER_SIZE * 2;
+    a.max_block_size = max_block_size > a.next_block_size ? max_block_size : a.next_block_size;
+    return a;
+}
+
+void VirtualArena::destroy() {
+    while (block) {
+        ArenaBlock* prev = block->prev;
+        return_block(upstream, block);
+        block = prev;
+    }
+    if (spare) {
+        return_block(upstream, spare);
+        spare = nullptr;
+    }
+    set_current(nullptr);
+    recorder.record_in_use(0);
+}
+
+std::expected<void*, AllocatorError> VirtualArena::alloc_align(size_t size, size_t align) {
+    auto result = alloc_align_uninit(size, align);
+    if (result) {
+        // Zero new memory by default
+        std::memset(result.value(), 0, size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> VirtualArena::alloc_align_uninit(size_t size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    // Fast path: bump within the current block
+    if (block) {
+        size_t offset = current.curr_offset;
+        auto result = current.alloc_align_uninit(size, align);
+        if (result) {
+            recorder.record_alloc(size, current.curr_offset - offset - size);
+            return result;
+        }
+    }
+
+    // The current block is full (or there is none yet), chain in a new one
+    auto pushed = push_block(size, align);
+    if (!pushed) {
+        recorder.record_failure();
+        return std::unexpected(pushed.error());
+    }
+    auto result = current.alloc_align_uninit(size, align);
+    if (result) {
+        recorder.record_alloc(size, current.curr_offset - size);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> VirtualArena::alloc(size_t size) {
+    return alloc_align(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> VirtualArena::alloc_uninit(size_t size) {
+    return alloc_align_uninit(size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+std::expected<void*, AllocatorError> VirtualArena::resize_align(void* old_memory, size_t old_size,
+                                                              size_t new_size, size_t align) {
+    auto result = resize_align_uninit(old_memory, old_size, new_size, align);
+    if (result && new_size > old_size) {
+        // Zero the new memory by default (everything for fresh allocations)
+        size_t kept = (old_memory == nullptr) ? 0 : old_size;
+        std::memset(static_cast<unsigned char*>(result.value()) + kept, 0, new_size - kept);
+    }
+    return result;
+}
+
+std::expected<void*, AllocatorError> VirtualArena::resize_align_uninit(void* old_memory, size_t old_size,
+                                                                     size_t new_size, size_t align) {
+    if (!LinearAllocator::is_power_of_two(align)) {
+        return std::unexpected(AllocatorError::InvalidAlignment);
+    }
+
+    if (old_memory == nullptr || old_size == 0) {
+        return alloc_align_uninit(new_size, align);
+    }
+
+    if (!owns(old_memory)) {
+        // Memory is out of bounds of this allocator
+        return std::unexpected(AllocatorError::OutOfBounds);
+    }
+
+    if (try_resize_in_place(old_memory, old_size, new_size)) {
+        return old_memory;
+    }
+
+    // Not resizable in place, allocate new memory (possibly in a new block) and copy
+    auto new_memory_result = alloc_align_uninit(new_size, align);
+    if (!new_memory_result) {
+        return std::unexpected(new_memory_result.error());
+    }
+
+    void* new_memory = new_memory_result.value();
+    size_t copy_size = (old_size < new_size) ? old_size : new_size;
+    std::memmove(new_memory, old_memory, copy_size);
+    recorder.record_resize(false);
+    return new_memory;
+}
+
+std::expected<void*, AllocatorError> VirtualArena::resize(void* old_memory, size_t old_size, size_t new_size) {
+    return resize_align(old_memory, old_size, new_size, LinearAllocator::DEFAULT_ALIGNMENT);
+}
+
+bool VirtualArena::try_resize_in_place(void* old_memory, size_t old_size, size_t new_size) {
+    if (block == nullptr || !current.try_resize_in_place(old_memory, old_size, new_size)) {
+        return false;
+    }
+    recorder.record_resize(true);
+    return true;
+}
+
+std::expected<void, AllocatorError> VirtualArena::free(void* /*ptr*/) {
+    // Arenas don't support individual deallocation
+    // This function exists for interface completeness
+    return {};
+}
+
+void VirtualArena::free_all() {
+    rewind(nullptr, 0, 0);
+}
+
+bool VirtualArena::owns(const void* ptr) const {
+    const unsigned char* p = static_cast<const unsigned char*>(ptr);
+    for (const ArenaBlock* b = block; b != nullptr; b = b->prev) {
+        const unsigned char* begin = reinterpret_cast<const unsigned char*>(b) + BLOCK_HEADER_SIZE;
+        const unsigned char* end = reinterpret_cast<const unsigned char*>(b) + b->size;
+        if (begin <= p && p < end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void VirtualArena::rewind(ArenaBlock* saved_block, size_t saved_prev_offset, size_t saved_curr_offset,
+                          const ArenaDebugState& saved_debug) {
+    // Drop every block chained after the saved one
+    bool dropped = false;
+    while (block && block != saved_block) {
+        ArenaBlock* prev = block->prev;
+        if constexpr (ARENA_DEBUG_ENABLED) {
+            // Older blocks had their red zones checked when the arena moved on from them
+            if (!dropped) {
+                current.check_guards();
+            }
+            detail::arena_poison(reinterpret_cast<unsigned char*>(block) + BLOCK_HEADER_SIZE,
+                                 block->size - BLOCK_HEADER_SIZE);
+        }
+        recorder.sub_in_use(block->size);
+        release_block(block);
+        block = prev;
+        dropped = true;
+    }
+
+    if (dropped) {
+        // Everything behind the saved position of the older block is stale
+        set_current(block);
+        current.curr_offset = current.buf_len;
+    }
+    if (block) {
+        current.rollback(saved_prev_offset, saved_curr_offset, saved_debug);
+    }
+    recorder.record_reset();
+}
+
+AllocatorStats VirtualArena::stats() const {
+    return recorder.snapshot();
+}
+
+std::expected<void, AllocatorError> VirtualArena::push_block(size_t size, size_t align) {
+    // Worst case the payload needs (align - 1) bytes of padding in front of the allocation
+    size_t needed = size + align + BLOCK_HEADER_SIZE;
+    if constexpr (ARENA_DEBUG_ENABLED) {
+        needed += ARENA_MAX_GUARD_OVERHEAD;
+    }
+    if (needed < size) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    ArenaBlock* b = nullptr;
+    if (spare && spare->size >= needed) {
+        // Reuse the retained block, no trip to the upstream
+        b = spare;
+        spare = nullptr;
+    } else {
+        size_t block_size = next_block_size > needed ? next_block_size : needed;
+        void* memory = upstream.alloc_block(block_size, upstream.user_data);
+        if (!memory) {
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+        b = static_cast<ArenaBlock*>(memory);
+        b->size = block_size;
+
+        // Geometric growth, capped
+        if (next_block_size < max_block_size) {
+            next_block_size = (next_block_size > max_block_size / 2) ? max_block_size : next_block_size * 2;
+        }
+    }
+
+    // The current block is done growing, so this is the last chance to check it
+    if (block) {
+        current.check_guards();
+    }
+    b->prev = block;
+    block = b;
+    set_current(b);
+    recorder.add_in_use(b->size);
+    return {};
+}
+
+void VirtualArena::release_block(ArenaBlock* b) {
+    if (spare == nullptr) {
+        spare = b;
+        return;
+    }
+
+    // Keep whichever block is larger, return the other one
+    ArenaBlock* victim = b;
+    if (b->size > spare->size) {
+        victim = spare;
+        spare = b;
+    }
+    return_block(upstream, victim);
+}
+
+void VirtualArena::set_current(ArenaBlock* b) {
+    if (b) {
+        current = LinearAllocator::create(reinterpret_cast<unsigned char*>(b) + BLOCK_HEADER_SIZE,
+                                          b->size - BLOCK_HEADER_SIZE);
+    } else {
+        current = LinearAllocator::create(nullptr, 0);
+    }
+}
+
+// TempArenaMemory over a chained arena
+TempArenaMemory TempArenaMemory::begin(VirtualArena* a) {
+    TempArenaMemory temp;
+    temp.arena = &a->current;
+    temp.chain = a;
+    temp.block = a->block;
+    temp.prev_offset = a->current.prev_offset;
+    temp.curr_offset = a->current.curr_offset;
+    temp.debug = a->current.debug;
+    return temp;
+}
+
+} // namespace memory
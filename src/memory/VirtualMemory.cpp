@@ -0,0 +1,299 @@
+#include "memory/VirtualMemory.hpp"
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__linux__)
+    #include <cstdio>
+    #include <sched.h>
+    #include <sys/syscall.h>
+#endif
+
+namespace memory {
+
+namespace {
+
+constexpr size_t DEFAULT_HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+#if defined(__linux__)
+// Policy modes from <linux/mempolicy.h>, which not every libc ships
+constexpr int MPOL_MODE_DEFAULT = 0;
+constexpr int MPOL_MODE_PREFERRED = 1;
+constexpr int MPOL_MODE_BIND = 2;
+constexpr int MPOL_MODE_INTERLEAVE = 3;
+
+// Node masks passed to mbind cover this many nodes
+constexpr size_t MAX_NUMA_NODES = 1024;
+constexpr size_t MASK_BITS = 8 * sizeof(unsigned long);
+
+constexpr size_t MASK_WORDS = MAX_NUMA_NODES / MASK_BITS;
+
+// Nodes in a sysfs node list such as "0-1" or "0,2-3", false if unreadable
+bool read_node_list(const char* path, unsigned long (&mask)[MASK_WORDS]) {
+    std::FILE* file = std::fopen(path, "r");
+    if (file == nullptr) {
+        return false;
+    }
+    long value = 0;
+    long range_start = -1;
+    char separator = 0;
+    while (std::fscanf(file, "%ld%c", &value, &separator) >= 1) {
+        if (separator == '-') {
+            range_start = value;
+            continue;
+        }
+        for (long node = range_start < 0 ? value : range_start; node <= value; ++node) {
+            if (node >= 0 && static_cast<size_t>(node) < MAX_NUMA_NODES) {
+                mask[node / MASK_BITS] |= 1ul << (node % MASK_BITS);
+            }
+        }
+        range_start = -1;
+        if (separator != ',') {
+            break;
+        }
+        separator = 0;
+    }
+    std::fclose(file);
+    return true;
+}
+
+// Nodes that have memory to place pages on, read once
+struct MemoryNodes {
+    unsigned long mask[MASK_WORDS] = {}; ///< Bit per node with memory
+    size_t count = 1;                    ///< Highest node with memory plus one
+};
+
+const MemoryNodes& memory_nodes() {
+    static const MemoryNodes nodes = [] {
+        MemoryNodes result;
+        // "possible" also lists offline and CPU-only nodes, which mbind rejects;
+        // kernels without has_memory at least exclude the offline ones
+        if (!read_node_list("/sys/devices/system/node/has_memory", result.mask)) {
+            read_node_list("/sys/devices/system/node/online", result.mask);
+        }
+        result.count = 0;
+        for (size_t node = 0; node < MAX_NUMA_NODES; ++node) {
+            if (result.mask[node / MASK_BITS] & (1ul << (node % MASK_BITS))) {
+                result.count = node + 1;
+            }
+        }
+        if (result.count == 0) {
+            // Unreadable or empty, treat the system as a single node
+            result.mask[0] = 1;
+            result.count = 1;
+        }
+        return result;
+    }();
+    return nodes;
+}
+#endif
+
+size_t round_up(size_t value, size_t granularity) {
+    return (value + granularity - 1) & ~(granularity - 1);
+}
+
+} // namespace
+
+size_t VirtualMemory::page_size() {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return size;
+#endif
+}
+
+size_t VirtualMemory::huge_page_size() {
+#if defined(_WIN32)
+    size_t size = GetLargePageMinimum();
+    return size != 0 ? size : DEFAULT_HUGE_PAGE_SIZE;
+#else
+    return DEFAULT_HUGE_PAGE_SIZE;
+#endif
+}
+
+std::expected<void*, AllocatorError> VirtualMemory::reserve(size_t size, HugePageMode huge_pages) {
+    if (size == 0) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+#if defined(_WIN32)
+    // Large pages on Windows must be committed up front, so only regular pages are
+    // supported for lazily committed reservations
+    (void)huge_pages;
+    void* ptr = VirtualAlloc(nullptr, round_up(size, page_size()), MEM_RESERVE, PAGE_NOACCESS);
+    if (!ptr) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+    return ptr;
+#else
+    size = round_up(size, page_size());
+
+#if defined(MAP_HUGETLB)
+    if (huge_pages == HugePageMode::Explicit && size % huge_page_size() == 0) {
+        // No MAP_NORESERVE here: hugetlb pages must be reserved at map time, otherwise
+        // running out of them later raises SIGBUS instead of failing the reservation
+        void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr != MAP_FAILED) {
+            return ptr;
+        }
+        // No huge pages reserved on this system, fall back to transparent huge pages
+    }
+#endif
+
+    if (huge_pages == HugePageMode::Off) {
+        void* ptr = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return std::unexpected(AllocatorError::OutOfMemory);
+        }
+        return ptr;
+    }
+
+    // Over-reserve so the base can be aligned to a huge page boundary, which is
+    // required for the kernel to back the range with huge pages
+    const size_t huge = huge_page_size();
+    const size_t padded = size + huge;
+    void* raw = mmap(nullptr, padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+
+    uintptr_t raw_addr = reinterpret_cast<uintptr_t>(raw);
+    uintptr_t aligned = (raw_addr + huge - 1) & ~(static_cast<uintptr_t>(huge) - 1);
+    size_t head = aligned - raw_addr;
+    size_t tail = padded - head - size;
+    if (head) {
+        munmap(raw, head);
+    }
+    if (tail) {
+        munmap(reinterpret_cast<void*>(aligned + size), tail);
+    }
+
+#if defined(MADV_HUGEPAGE)
+    madvise(reinterpret_cast<void*>(aligned), size, MADV_HUGEPAGE);
+#endif
+    return reinterpret_cast<void*>(aligned);
+#endif
+}
+
+std::expected<void, AllocatorError> VirtualMemory::commit(void* ptr, size_t size) {
+#if defined(_WIN32)
+    if (!VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE)) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+#else
+    if (mprotect(ptr, size, PROT_READ | PROT_WRITE) != 0) {
+        return std::unexpected(AllocatorError::OutOfMemory);
+    }
+#endif
+    return {};
+}
+
+void VirtualMemory::decommit(void* ptr, size_t size) {
+#if defined(_WIN32)
+    VirtualFree(ptr, size, MEM_DECOMMIT);
+#else
+    // Drop the pages first so the RSS is returned, then make the range inaccessible
+    // again so stray accesses fault instead of silently re-committing memory
+    madvise(ptr, size, MADV_DONTNEED);
+    mprotect(ptr, size, PROT_NONE);
+#endif
+}
+
+void VirtualMemory::release(void* ptr, size_t size) {
+#if defined(_WIN32)
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, round_up(size, page_size()));
+#endif
+}
+
+size_t VirtualMemory::numa_node_count() {
+#if defined(_WIN32)
+    ULONG highest = 0;
+    return GetNumaHighestNodeNumber(&highest) ? static_cast<size_t>(highest) + 1 : 1;
+#elif defined(__linux__)
+    return memory_nodes().count;
+#else
+    return 1;
+#endif
+}
+
+bool VirtualMemory::numa_node_has_memory(size_t node) {
+#if defined(__linux__)
+    const MemoryNodes& nodes = memory_nodes();
+    return node < nodes.count && (nodes.mask[node / MASK_BITS] & (1ul << (node % MASK_BITS))) != 0;
+#else
+    return node < numa_node_count();
+#endif
+}
+
+size_t VirtualMemory::current_numa_node() {
+#if defined(_WIN32)
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    return GetNumaProcessorNodeEx(&processor, &node) ? static_cast<size_t>(node) : 0;
+#elif defined(__linux__) && defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+    // glibc answers from the vDSO where the kernel exports getcpu (x86-64 does)
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (getcpu(&cpu, &node) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(node);
+#elif defined(__linux__) && defined(SYS_getcpu)
+    // A real syscall every time, which is why thread_numa_node caches the answer
+    unsigned cpu = 0;
+    unsigned node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+        return 0;
+    }
+    return static_cast<size_t>(node);
+#else
+    return 0;
+#endif
+}
+
+bool VirtualMemory::place_on_numa(void* ptr, size_t size, const NumaPlacement& placement) {
+    if (placement.policy == NumaPolicy::Default) {
+        return true;
+    }
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long mask[MASK_WORDS] = {};
+    int mode = MPOL_MODE_DEFAULT;
+    if (placement.policy == NumaPolicy::Interleave) {
+        // Only nodes with memory, the kernel rejects a mask naming any other
+        mode = MPOL_MODE_INTERLEAVE;
+        const MemoryNodes& nodes = memory_nodes();
+        for (size_t word = 0; word < MASK_WORDS; ++word) {
+            mask[word] = nodes.mask[word];
+        }
+    } else {
+        if (!numa_node_has_memory(placement.node)) {
+            return false;
+        }
+        mode = placement.policy == NumaPolicy::Bind ? MPOL_MODE_BIND : MPOL_MODE_PREFERRED;
+        mask[placement.node / MASK_BITS] |= 1ul << (placement.node % MASK_BITS);
+    }
+
+    // The kernel reads maxnode - 1 bits of the mask
+    return syscall(SYS_mbind, ptr, round_up(size, page_size()), mode, mask, MAX_NUMA_NODES + 1, 0u) == 0;
+#else
+    // Windows picks the node when memory is allocated (VirtualAllocExNuma), not
+    // for a range that is already reserved
+    (void)ptr;
+    (void)size;
+    return false;
+#endif
+}
+
+} // namespace memory
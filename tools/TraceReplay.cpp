@@ -0,0 +1,138 @@
+#include "memory/AllocationTrace.hpp"
+#include "memory/BuddyAllocator.hpp"
+#include "memory/FreeListAllocator.hpp"
+#include "memory/HeapAllocator.hpp"
+#include "memory/LinearAllocator.hpp"
+#include "memory/PoolAllocator.hpp"
+#include "memory/StackAllocator.hpp"
+#include "memory/TraceReplay.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <fmt/core.h>
+#include <new>
+
+/**
+ * @brief Replays an allocation trace against every allocator and prints what each one needed
+ *
+ * Usage: trace_replay <trace-file> [arena-bytes]
+ *
+ * Every traced allocator in the file is replayed on its own, against a fresh
+ * allocator of each kind over an arena of arena-bytes (64 MiB by default).
+ */
+
+namespace {
+
+constexpr size_t DEFAULT_ARENA_SIZE = 64 * 1024 * 1024;
+constexpr std::align_val_t ARENA_ALIGNMENT{4096};
+
+/**
+ * @brief Arena the allocators under test are created over
+ */
+struct ReplayArena {
+    unsigned char* data; ///< Start of the arena
+    size_t length;       ///< Length of the arena in bytes
+
+    explicit ReplayArena(size_t length)
+        : data(static_cast<unsigned char*>(::operator new(length, ARENA_ALIGNMENT))), length(length) {}
+    ~ReplayArena() { ::operator delete(data, ARENA_ALIGNMENT); }
+
+    ReplayArena(const ReplayArena&) = delete;
+    ReplayArena& operator=(const ReplayArena&) = delete;
+};
+
+void print_report(const char* name, const memory::ReplayReport& report) {
+    if (!report.applicable) {
+        fmt::print("  {:<18} not applicable, the trace frees out of LIFO order\n", name);
+        return;
+    }
+    fmt::print("  {:<18} {:>8} {:>14} {:>13.1f}% {:>14.0f}\n", name, report.failures, report.peak_footprint,
+               report.fragmentation() * 100.0, report.ops_per_second());
+}
+
+void print_unavailable(const char* name, memory::AllocatorError error) {
+    fmt::print("  {:<18} cannot be created for this trace (error {})\n", name, static_cast<int>(error));
+}
+
+void replay_all(const memory::ReplayProgram& program, ReplayArena& arena) {
+    fmt::print("  {:<18} {:>8} {:>14} {:>14} {:>14}\n", "allocator", "failures", "peak bytes", "fragmentation",
+               "ops/s");
+
+    {
+        auto allocator = memory::LinearAllocator::create(arena.data, arena.length);
+        print_report("LinearAllocator", memory::replay(program, allocator, arena.data));
+        // Hands the arena back (unpoisoned with MEMORY_ARENA_DEBUG) for the next allocator
+        allocator.destroy();
+    }
+    {
+        auto allocator = memory::StackAllocator::create(arena.data, arena.length);
+        print_report("StackAllocator", memory::replay(program, allocator, arena.data));
+    }
+    {
+        // One chunk has to hold the largest allocation of the trace
+        auto allocator = memory::PoolAllocator::create(arena.data, arena.length, program.max_size, program.max_align);
+        if (allocator) {
+            print_report("PoolAllocator", memory::replay(program, allocator.value(), arena.data));
+        } else {
+            print_unavailable("PoolAllocator", allocator.error());
+        }
+    }
+    {
+        auto allocator = memory::FreeListAllocator::create(arena.data, arena.length);
+        if (allocator) {
+            print_report("FreeListAllocator", memory::replay(program, allocator.value(), arena.data));
+        } else {
+            print_unavailable("FreeListAllocator", allocator.error());
+        }
+    }
+    {
+        auto allocator = memory::BuddyAllocator::create(arena.data, arena.length);
+        if (allocator) {
+            print_report("BuddyAllocator", memory::replay(program, allocator.value(), arena.data));
+        } else {
+            print_unavailable("BuddyAllocator", allocator.error());
+        }
+    }
+    {
+        // No backing buffer, so the footprint is the sum of malloc's usable sizes
+        memory::HeapAllocator allocator;
+        print_report("HeapAllocator", memory::replay(program, allocator));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fmt::print(stderr, "Usage: {} <trace-file> [arena-bytes]\n", argv[0]);
+        return 1;
+    }
+    size_t arena_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : DEFAULT_ARENA_SIZE;
+
+    std::FILE* file = std::fopen(argv[1], "rb");
+    if (file == nullptr) {
+        fmt::print(stderr, "Cannot open {}\n", argv[1]);
+        return 1;
+    }
+    auto events = memory::read_trace(file);
+    std::fclose(file);
+    if (!events) {
+        fmt::print(stderr, "Cannot read {}: {}\n", argv[1],
+                   events.error() == memory::TraceError::InvalidFormat ? "not a trace file" : "I/O error");
+        return 1;
+    }
+
+    fmt::print("{}: {} events, arena of {} bytes\n", argv[1], events->size(), arena_size);
+    ReplayArena arena(arena_size);
+    for (uint16_t id : memory::trace_allocators(events.value())) {
+        memory::ReplayProgram program = memory::ReplayProgram::compile(events.value(), id);
+        fmt::print("\nAllocator #{}: {} operations over {:.3f} ms, peak live {} bytes, largest {} bytes",
+                   id, program.ops.size(), static_cast<double>(program.duration_ns) / 1e6,
+                   program.peak_live_bytes, program.max_size);
+        if (program.skipped > 0) {
+            fmt::print(", {} events skipped", program.skipped);
+        }
+        fmt::print("\n");
+        replay_all(program, arena);
+    }
+    return 0;
+}